@@ -36,6 +36,20 @@ project "Core"
         }
     filter {}
 
+    filter { "system:linux" }
+        links {
+            "dl",
+        }
+    filter {}
+
+    filter { "system:not macosx" }
+        removefiles { "Private/Platform/MacOS/**" }
+    filter {}
+
+    filter { "system:not linux" }
+        removefiles { "Private/Platform/Linux/**" }
+    filter {}
+
     filter { "configurations:Debug" }
         runtime "Debug"
         optimize "Off"
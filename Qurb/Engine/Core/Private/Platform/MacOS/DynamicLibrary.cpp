@@ -63,10 +63,11 @@ namespace qurb
             return;
         }
 
-        if (dlclose(_nativeHandle) == -1)
+        if (dlclose(_nativeHandle) != 0)
         {
             Log::error("Failed to close dynamic library: {}: {}.", _name, dlerror());
         }
+        _nativeHandle = nullptr;
     }
 
     template <>
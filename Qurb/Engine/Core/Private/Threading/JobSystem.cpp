@@ -0,0 +1,265 @@
+#include "Threading/JobSystem.hpp"
+
+#include "Containers/Vector.hpp"
+
+namespace qurb
+{
+    namespace
+    {
+        thread_local const JobSystem* currentJobSystem = nullptr;
+        thread_local uint32           currentWorker    = 0;
+        thread_local uint32           randomState      = 0x9E3779B9u;
+
+        /// \brief A xorshift generator picking the first queue to steal from, so that thieves spread out.
+        auto nextRandom() -> uint32
+        {
+            randomState ^= randomState << 13;
+            randomState ^= randomState >> 17;
+            randomState ^= randomState << 5;
+            return randomState;
+        }
+    }
+
+    //------------------------------------------------------------------------------------------------------------------
+    // struct JobSystem::JobCache
+    //------------------------------------------------------------------------------------------------------------------
+
+    struct JobSystem::JobCache
+    {
+        static constexpr auto maxSize = usize(1024);
+
+        Vector<Job*> jobs;
+
+    public:
+        ~JobCache()
+        {
+            for (auto* job : jobs)
+            {
+                delete job;
+            }
+        }
+    };
+
+    thread_local JobSystem::JobCache JobSystem::_jobCache;
+
+    //------------------------------------------------------------------------------------------------------------------
+    // class JobSystem
+    //------------------------------------------------------------------------------------------------------------------
+
+    JobSystem::Worker::Worker()
+        : queue(queueCapacity)
+    {}
+
+    JobSystem::JobSystem(uint32 workerCount)
+        : _ownerThread(std::this_thread::get_id())
+        , _ownerQueue(queueCapacity)
+        , _workers(std::make_unique<Worker[]>(workerCount))
+        , _workerCount(workerCount)
+    {
+        for (uint32 i = 0; i < workerCount; ++i)
+        {
+            _workers[i].thread = std::thread([this, i] { workerLoop(i); });
+        }
+    }
+
+    JobSystem::~JobSystem()
+    {
+        _stopping.store(true, std::memory_order_seq_cst);
+        _jobEpoch.fetch_add(1, std::memory_order_seq_cst);
+        _jobEpoch.notify_all();
+
+        for (uint32 i = 0; i < _workerCount; ++i)
+        {
+            _workers[i].thread.join();
+        }
+    }
+
+    auto JobSystem::defaultWorkerCount() -> uint32
+    {
+        const auto hardwareThreads = std::thread::hardware_concurrency();
+        return hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+    }
+
+    auto JobSystem::workerCount() const -> uint32
+    {
+        return _workerCount;
+    }
+
+    auto JobSystem::wait(const JobCounter& counter) -> void
+    {
+        while (counter.load(std::memory_order_acquire) != 0)
+        {
+            if (not tryRunJob())
+            {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    auto JobSystem::allocateJob() -> Job*
+    {
+        if (_jobCache.jobs.empty())
+        {
+            return new Job();
+        }
+
+        auto* job = _jobCache.jobs.back();
+        _jobCache.jobs.popBack();
+        return job;
+    }
+
+    auto JobSystem::freeJob(Job* job) -> void
+    {
+        if (_jobCache.jobs.size() < JobCache::maxSize)
+        {
+            _jobCache.jobs.pushBack(job);
+        }
+        else
+        {
+            delete job;
+        }
+    }
+
+    auto JobSystem::push(Job* job) -> void
+    {
+        // Without workers the caller is the only thread able to make progress.
+        if (_workerCount == 0)
+        {
+            execute(job);
+            return;
+        }
+
+        if (auto* queue = localQueue())
+        {
+            // A full queue means plenty of pending work already, running the job now is as good as queuing it.
+            if (not queue->push(job))
+            {
+                execute(job);
+                return;
+            }
+        }
+        else
+        {
+            auto lock = std::scoped_lock(_sharedMutex);
+            _sharedJobs.push_back(job);
+            _sharedCount.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        _jobEpoch.fetch_add(1, std::memory_order_seq_cst);
+        if (_sleepers.load(std::memory_order_seq_cst) != 0)
+        {
+            _jobEpoch.notify_one();
+        }
+    }
+
+    auto JobSystem::execute(Job* job) -> void
+    {
+        auto* counter = job->counter;
+        job->run(job->payload);
+        freeJob(job);
+        counter->fetch_sub(1, std::memory_order_release);
+    }
+
+    auto JobSystem::tryRunJob() -> bool
+    {
+        auto* local = localQueue();
+        if (local != nullptr)
+        {
+            if (auto* job = local->pop())
+            {
+                execute(job);
+                return true;
+            }
+        }
+
+        if (_sharedCount.load(std::memory_order_relaxed) != 0)
+        {
+            auto* job = static_cast<Job*>(nullptr);
+            {
+                auto lock = std::scoped_lock(_sharedMutex);
+                if (not _sharedJobs.empty())
+                {
+                    job = _sharedJobs.front();
+                    _sharedJobs.pop_front();
+                    _sharedCount.fetch_sub(1, std::memory_order_relaxed);
+                }
+            }
+
+            if (job != nullptr)
+            {
+                execute(job);
+                return true;
+            }
+        }
+
+        // Queue 0 belongs to the creating thread, queue i + 1 to worker i.
+        const auto queueCount = _workerCount + 1;
+        const auto first      = nextRandom() % queueCount;
+        for (uint32 i = 0; i < queueCount; ++i)
+        {
+            const auto index  = (first + i) % queueCount;
+            auto&      victim = index == 0 ? _ownerQueue : _workers[index - 1].queue;
+            if (&victim == local)
+            {
+                continue;
+            }
+
+            if (auto* job = victim.steal())
+            {
+                execute(job);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    auto JobSystem::workerLoop(uint32 index) -> void
+    {
+        currentJobSystem = this;
+        currentWorker    = index;
+        randomState      = 0x9E3779B9u * (index + 2);
+
+        constexpr auto spinCount = 64;
+        while (true)
+        {
+            auto ranJob = false;
+            for (auto spin = 0; spin < spinCount and not ranJob; ++spin)
+            {
+                ranJob = tryRunJob();
+                if (not ranJob)
+                {
+                    std::this_thread::yield();
+                }
+            }
+
+            if (ranJob)
+            {
+                continue;
+            }
+
+            // Every queue was empty during the spin, so the queued jobs are drained before stopping.
+            if (_stopping.load(std::memory_order_seq_cst))
+            {
+                return;
+            }
+
+            // A push after the epoch is read changes it, so the wait returns immediately instead of missing the job.
+            const auto epoch = _jobEpoch.load(std::memory_order_seq_cst);
+            _sleepers.fetch_add(1, std::memory_order_seq_cst);
+            if (not tryRunJob() and not _stopping.load(std::memory_order_seq_cst))
+            {
+                _jobEpoch.wait(epoch, std::memory_order_seq_cst);
+            }
+            _sleepers.fetch_sub(1, std::memory_order_seq_cst);
+        }
+    }
+
+    auto JobSystem::localQueue() -> WorkStealingQueue<Job>*
+    {
+        if (currentJobSystem == this)
+        {
+            return &_workers[currentWorker].queue;
+        }
+        return std::this_thread::get_id() == _ownerThread ? &_ownerQueue : nullptr;
+    }
+}
@@ -0,0 +1,79 @@
+/// \file RadixSort.hpp
+
+#pragma once
+
+#include "CoreTypes.hpp"
+#include "Debug/Ensure.hpp"
+
+#include <algorithm>
+#include <array>
+#include <span>
+
+namespace qurb
+{
+    /// \brief Sorts `items` by increasing 64-bit key, keeping the order of equal keys.
+    ///
+    /// A least significant digit radix sort on bytes: linear in the item count, with one counting pass over the keys
+    /// and one scatter per byte. Bytes shared by every key are skipped, so keys using only their high and low bits
+    /// cost a couple of scatters.
+    ///
+    /// \param items The items to sort.
+    /// \param scratch A buffer of at least `items.size()` items, its content is unspecified afterwards.
+    /// \param key Returns the `uint64` key of an item, called several times per item.
+    template <typename T, typename F>
+    auto radixSort(std::span<T> items, std::span<T> scratch, F&& key) -> void
+    {
+        constexpr auto digitCount = usize(sizeof(uint64));
+        constexpr auto radix      = usize(256);
+
+        ensure(scratch.size() >= items.size(), "Radix sort scratch of {} items is too small for {} items.", scratch.size(), items.size());
+
+        const auto count = items.size();
+        if (count < 2)
+        {
+            return;
+        }
+
+        // Every histogram is built in a single read of the keys.
+        auto histograms = std::array<std::array<usize, radix>, digitCount>();
+        for (const auto& item : items)
+        {
+            const auto itemKey = static_cast<uint64>(key(item));
+            for (usize digit = 0; digit < digitCount; ++digit)
+            {
+                ++histograms[digit][(itemKey >> (digit * 8)) & 0xFF];
+            }
+        }
+
+        auto source      = items;
+        auto destination = scratch.first(count);
+        for (usize digit = 0; digit < digitCount; ++digit)
+        {
+            auto& histogram = histograms[digit];
+            if (std::ranges::find(histogram, count) != histogram.end())
+            {
+                continue;
+            }
+
+            // Turn the counts into the first output index of each bucket.
+            auto offset = usize(0);
+            for (auto& bucket : histogram)
+            {
+                const auto bucketCount = bucket;
+                bucket                 = offset;
+                offset += bucketCount;
+            }
+
+            for (auto& item : source)
+            {
+                destination[histogram[(static_cast<uint64>(key(item)) >> (digit * 8)) & 0xFF]++] = std::move(item);
+            }
+            std::swap(source, destination);
+        }
+
+        if (source.data() != items.data())
+        {
+            std::ranges::move(source, items.begin());
+        }
+    }
+}
@@ -103,6 +103,10 @@ namespace qurb
     private:
         static constexpr auto growthFactor = 1.5f;
 
+        /// \brief The capacity after growing once, at least one more than the current one: a capacity of one would stay
+        /// at one through `growthFactor` alone.
+        [[nodiscard]] constexpr auto grownCapacity() const noexcept -> usize;
+
         auto realloc(usize capacity) -> void;
 
     private:
@@ -410,7 +414,7 @@ namespace qurb
     {
         if (_size >= _capacity)
         {
-            realloc(_capacity * growthFactor);
+            realloc(grownCapacity());
         }
 
         new (&_data[_size]) T(value);
@@ -422,7 +426,7 @@ namespace qurb
     {
         if (_size >= _capacity)
         {
-            realloc(_capacity * growthFactor);
+            realloc(grownCapacity());
         }
 
         new (&_data[_size]) T(std::move(value));
@@ -435,7 +439,7 @@ namespace qurb
     {
         if (_size >= _capacity)
         {
-            realloc(_capacity * growthFactor);
+            realloc(grownCapacity());
         }
 
         new (&_data[_size]) T(std::forward<Args>(args)...);
@@ -481,6 +485,13 @@ namespace qurb
         _size = size;
     }
 
+    template <typename T>
+    constexpr auto Vector<T>::grownCapacity() const noexcept -> usize
+    {
+        const auto grown = static_cast<usize>(static_cast<float>(_capacity) * growthFactor);
+        return grown > _capacity ? grown : _capacity + 1;
+    }
+
     template <typename T>
     auto Vector<T>::realloc(usize capacity) -> void
     {
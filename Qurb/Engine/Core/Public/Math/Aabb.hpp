@@ -0,0 +1,181 @@
+/// \file Aabb.hpp
+
+#pragma once
+
+#include "CoreTypes.hpp"
+#include "Math/Frustum.hpp"
+#include "Math/Matrix4x4.hpp"
+#include "Math/Vector3.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace qurb::math
+{
+    /// \brief An axis aligned box given by its lower and upper corners.
+    struct Aabb
+    {
+        Vector3f lower = Vector3f::zero;
+        Vector3f upper = Vector3f::zero;
+
+    public:
+        [[nodiscard]] static auto fromCenterExtents(const Vector3f& center, const Vector3f& extents) -> Aabb;
+
+        [[nodiscard]] auto center() const -> Vector3f { return (lower + upper) * 0.5f; }
+
+        /// \brief Half the size of the box along each axis.
+        [[nodiscard]] auto extents() const -> Vector3f { return (upper - lower) * 0.5f; }
+
+        /// \brief The area of the faces of the box, the cost metric of bounding volume hierarchies.
+        [[nodiscard]] auto surfaceArea() const -> float32;
+
+        [[nodiscard]] auto contains(const Aabb& other) const -> bool;
+        [[nodiscard]] auto overlaps(const Aabb& other) const -> bool;
+
+        /// \brief The box grown by `margin` on every side.
+        [[nodiscard]] auto expanded(float32 margin) const -> Aabb;
+    };
+
+    /// \brief A half line starting at `origin`, `direction` need not be normalized.
+    struct Ray
+    {
+        Vector3f origin;
+        Vector3f direction;
+    };
+
+    /// \brief Where a box lies relative to a volume.
+    enum class Containment : uint8
+    {
+        Outside,
+        Intersecting,
+        Inside,
+    };
+
+    /// \brief The smallest box enclosing `lhs` and `rhs`.
+    [[nodiscard]] auto merge(const Aabb& lhs, const Aabb& rhs) -> Aabb;
+
+    /// \brief The box enclosing `box` once transformed by the affine `matrix`.
+    [[nodiscard]] auto transformAabb(const Matrix4x4f& matrix, const Aabb& box) -> Aabb;
+
+    [[nodiscard]] auto overlapsSphere(const Aabb& box, const Vector3f& center, float32 radius) -> bool;
+
+    /// \brief Classifies `box` against the planes of `frustum`, a box straddling any plane is `Intersecting`.
+    [[nodiscard]] auto classify(const Frustum& frustum, const Aabb& box) -> Containment;
+
+    /// \brief The slab test of a ray against `box`.
+    /// \param inverseDirection The inverse of each component of the ray direction, computed once per ray.
+    /// \param distance Set to the entry distance along the ray, in units of its direction, on a hit.
+    [[nodiscard]] auto intersectRay(
+        const Aabb& box, const Vector3f& origin, const Vector3f& inverseDirection, float32 maxDistance, float32& distance) -> bool;
+
+    //------------------------------------------------------------------------------------------------------------------
+    // struct Aabb
+    //------------------------------------------------------------------------------------------------------------------
+
+    inline auto Aabb::fromCenterExtents(const Vector3f& center, const Vector3f& extents) -> Aabb
+    {
+        return Aabb {.lower = center - extents, .upper = center + extents};
+    }
+
+    inline auto Aabb::surfaceArea() const -> float32
+    {
+        const auto size = upper - lower;
+        return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+    }
+
+    inline auto Aabb::contains(const Aabb& other) const -> bool
+    {
+        return lower.x <= other.lower.x and lower.y <= other.lower.y and lower.z <= other.lower.z and other.upper.x <= upper.x and
+               other.upper.y <= upper.y and other.upper.z <= upper.z;
+    }
+
+    inline auto Aabb::overlaps(const Aabb& other) const -> bool
+    {
+        return lower.x <= other.upper.x and other.lower.x <= upper.x and lower.y <= other.upper.y and other.lower.y <= upper.y and
+               lower.z <= other.upper.z and other.lower.z <= upper.z;
+    }
+
+    inline auto Aabb::expanded(float32 margin) const -> Aabb
+    {
+        return Aabb {.lower = lower - Vector3f(margin), .upper = upper + Vector3f(margin)};
+    }
+
+    //------------------------------------------------------------------------------------------------------------------
+    // Functions
+    //------------------------------------------------------------------------------------------------------------------
+
+    inline auto merge(const Aabb& lhs, const Aabb& rhs) -> Aabb
+    {
+        return Aabb {
+            .lower = Vector3f(std::min(lhs.lower.x, rhs.lower.x), std::min(lhs.lower.y, rhs.lower.y), std::min(lhs.lower.z, rhs.lower.z)),
+            .upper = Vector3f(std::max(lhs.upper.x, rhs.upper.x), std::max(lhs.upper.y, rhs.upper.y), std::max(lhs.upper.z, rhs.upper.z)),
+        };
+    }
+
+    inline auto transformAabb(const Matrix4x4f& matrix, const Aabb& box) -> Aabb
+    {
+        const auto& m       = matrix;
+        const auto  center  = box.center();
+        const auto  extents = box.extents();
+
+        // Each world extent sums the absolute contributions of the local ones.
+        const auto worldCenter = Vector3f(
+            m[0, 0] * center.x + m[0, 1] * center.y + m[0, 2] * center.z + m[0, 3],
+            m[1, 0] * center.x + m[1, 1] * center.y + m[1, 2] * center.z + m[1, 3],
+            m[2, 0] * center.x + m[2, 1] * center.y + m[2, 2] * center.z + m[2, 3]);
+        const auto worldExtents = Vector3f(
+            std::abs(m[0, 0]) * extents.x + std::abs(m[0, 1]) * extents.y + std::abs(m[0, 2]) * extents.z,
+            std::abs(m[1, 0]) * extents.x + std::abs(m[1, 1]) * extents.y + std::abs(m[1, 2]) * extents.z,
+            std::abs(m[2, 0]) * extents.x + std::abs(m[2, 1]) * extents.y + std::abs(m[2, 2]) * extents.z);
+        return Aabb::fromCenterExtents(worldCenter, worldExtents);
+    }
+
+    inline auto overlapsSphere(const Aabb& box, const Vector3f& center, float32 radius) -> bool
+    {
+        // The distance from the center to the closest point of the box.
+        const auto dx = center.x - std::clamp(center.x, box.lower.x, box.upper.x);
+        const auto dy = center.y - std::clamp(center.y, box.lower.y, box.upper.y);
+        const auto dz = center.z - std::clamp(center.z, box.lower.z, box.upper.z);
+        return dx * dx + dy * dy + dz * dz <= radius * radius;
+    }
+
+    inline auto classify(const Frustum& frustum, const Aabb& box) -> Containment
+    {
+        const auto center  = box.center();
+        const auto extents = box.extents();
+
+        auto containment = Containment::Inside;
+        for (const auto& plane : frustum.planes)
+        {
+            const auto distance = plane.x * center.x + plane.y * center.y + plane.z * center.z + plane.w;
+            const auto radius   = std::abs(plane.x) * extents.x + std::abs(plane.y) * extents.y + std::abs(plane.z) * extents.z;
+            if (distance + radius < 0.0f)
+            {
+                return Containment::Outside;
+            }
+            if (distance - radius < 0.0f)
+            {
+                containment = Containment::Intersecting;
+            }
+        }
+        return containment;
+    }
+
+    inline auto intersectRay(
+        const Aabb& box, const Vector3f& origin, const Vector3f& inverseDirection, float32 maxDistance, float32& distance) -> bool
+    {
+        auto entry = 0.0f;
+        auto exit  = maxDistance;
+        for (usize axis = 0; axis < 3; ++axis)
+        {
+            // Narrow `[entry, exit]` to the part of the ray between the two planes of the axis.
+            const auto lowerDistance = (box.lower[axis] - origin[axis]) * inverseDirection[axis];
+            const auto upperDistance = (box.upper[axis] - origin[axis]) * inverseDirection[axis];
+            entry                    = std::max(entry, std::min(lowerDistance, upperDistance));
+            exit                     = std::min(exit, std::max(lowerDistance, upperDistance));
+        }
+
+        distance = entry;
+        return entry <= exit;
+    }
+}
@@ -0,0 +1,413 @@
+/// \file Batch.hpp
+/// \brief Kernels processing many transforms, points or boxes per call from structure-of-arrays inputs.
+///
+/// Every component lives in its own array so that a register holds the same component of `batch::width` elements,
+/// 16 with AVX-512, 8 with AVX, 4 with SSE or NEON. The elements past the last full register go through the same
+/// computation one at a time.
+
+#pragma once
+
+#include "CoreTypes.hpp"
+#include "Debug/Ensure.hpp"
+#include "Math/Frustum.hpp"
+#include "Math/Matrix4x4.hpp"
+#include "Math/Simd.hpp"
+
+#include <cmath>
+#include <limits>
+#include <span>
+
+namespace qurb::math::batch
+{
+    /// \brief The translations, rotation quaternions and scales of a set of transforms, one array per component.
+    struct TransformStreams
+    {
+        std::span<const float32> positionX;
+        std::span<const float32> positionY;
+        std::span<const float32> positionZ;
+        std::span<const float32> rotationX;
+        std::span<const float32> rotationY;
+        std::span<const float32> rotationZ;
+        std::span<const float32> rotationW;
+        std::span<const float32> scaleX;
+        std::span<const float32> scaleY;
+        std::span<const float32> scaleZ;
+
+    public:
+        [[nodiscard]] auto size() const -> usize { return positionX.size(); }
+    };
+
+    /// \brief The coordinates of a set of points, one array per axis.
+    template <typename T>
+    struct PointStreams
+    {
+        std::span<T> x;
+        std::span<T> y;
+        std::span<T> z;
+
+    public:
+        [[nodiscard]] auto size() const -> usize { return x.size(); }
+    };
+
+    /// \brief Axis aligned boxes given by their centers and half extents, one array per component.
+    template <typename T>
+    struct BoxStreams
+    {
+        std::span<T> centerX;
+        std::span<T> centerY;
+        std::span<T> centerZ;
+        std::span<T> extentX;
+        std::span<T> extentY;
+        std::span<T> extentZ;
+
+    public:
+        [[nodiscard]] auto size() const -> usize { return centerX.size(); }
+
+        /// \brief The boxes `[offset, offset + count)`.
+        [[nodiscard]] auto subspan(usize offset, usize count) const -> BoxStreams
+        {
+            return BoxStreams {
+                .centerX = centerX.subspan(offset, count),
+                .centerY = centerY.subspan(offset, count),
+                .centerZ = centerZ.subspan(offset, count),
+                .extentX = extentX.subspan(offset, count),
+                .extentY = extentY.subspan(offset, count),
+                .extentZ = extentZ.subspan(offset, count),
+            };
+        }
+    };
+
+    /// \brief The number of elements processed per register.
+#if defined(QURB_SIMD_AVX512)
+    constexpr auto width = usize(16);
+#elif defined(QURB_SIMD_AVX)
+    constexpr auto width = usize(8);
+#elif defined(QURB_SIMD_SSE) || defined(QURB_SIMD_NEON)
+    constexpr auto width = usize(4);
+#else
+    constexpr auto width = usize(1);
+#endif
+
+    namespace detail
+    {
+#if defined(QURB_SIMD_AVX512)
+        using Wide = __m512;
+
+        inline auto load(const float32* data) -> Wide { return _mm512_loadu_ps(data); }
+        inline auto store(float32* data, Wide value) -> void { _mm512_storeu_ps(data, value); }
+        inline auto broadcast(float32 value) -> Wide { return _mm512_set1_ps(value); }
+        inline auto add(Wide lhs, Wide rhs) -> Wide { return _mm512_add_ps(lhs, rhs); }
+        inline auto sub(Wide lhs, Wide rhs) -> Wide { return _mm512_sub_ps(lhs, rhs); }
+        inline auto mul(Wide lhs, Wide rhs) -> Wide { return _mm512_mul_ps(lhs, rhs); }
+        inline auto div(Wide lhs, Wide rhs) -> Wide { return _mm512_div_ps(lhs, rhs); }
+        inline auto min(Wide lhs, Wide rhs) -> Wide { return _mm512_min_ps(lhs, rhs); }
+        inline auto multiplyAdd(Wide a, Wide b, Wide c) -> Wide { return _mm512_fmadd_ps(a, b, c); }
+#elif defined(QURB_SIMD_AVX)
+        using Wide = __m256;
+
+        inline auto load(const float32* data) -> Wide { return _mm256_loadu_ps(data); }
+        inline auto store(float32* data, Wide value) -> void { _mm256_storeu_ps(data, value); }
+        inline auto broadcast(float32 value) -> Wide { return _mm256_set1_ps(value); }
+        inline auto add(Wide lhs, Wide rhs) -> Wide { return _mm256_add_ps(lhs, rhs); }
+        inline auto sub(Wide lhs, Wide rhs) -> Wide { return _mm256_sub_ps(lhs, rhs); }
+        inline auto mul(Wide lhs, Wide rhs) -> Wide { return _mm256_mul_ps(lhs, rhs); }
+        inline auto div(Wide lhs, Wide rhs) -> Wide { return _mm256_div_ps(lhs, rhs); }
+        inline auto min(Wide lhs, Wide rhs) -> Wide { return _mm256_min_ps(lhs, rhs); }
+    #if defined(QURB_SIMD_AVX2)
+        inline auto multiplyAdd(Wide a, Wide b, Wide c) -> Wide { return _mm256_fmadd_ps(a, b, c); }
+    #else
+        inline auto multiplyAdd(Wide a, Wide b, Wide c) -> Wide { return _mm256_add_ps(_mm256_mul_ps(a, b), c); }
+    #endif
+#elif not defined(QURB_SIMD_SCALAR)
+        using Wide = simd::Float4;
+
+        using simd::add;
+        using simd::div;
+        using simd::load;
+        using simd::min;
+        using simd::mul;
+        using simd::multiplyAdd;
+        using simd::store;
+        using simd::sub;
+
+        inline auto broadcast(float32 value) -> Wide { return simd::set(value, value, value, value); }
+#endif
+
+        /// \brief The twelve varying elements of a transform matrix, the last row is always `(0, 0, 0, 1)`.
+        template <typename T>
+        struct AffineRows
+        {
+            T m00, m01, m02, m03;
+            T m10, m11, m12, m13;
+            T m20, m21, m22, m23;
+        };
+
+        /// \brief The rotation and scale of `math::transformMatrix`, written once for scalars and registers.
+        template <typename T, typename Ops>
+        inline auto compose(T px, T py, T pz, T qx, T qy, T qz, T qw, T sx, T sy, T sz, const Ops& ops) -> AffineRows<T>
+        {
+            const auto xx = ops.mul(qx, qx);
+            const auto yy = ops.mul(qy, qy);
+            const auto zz = ops.mul(qz, qz);
+            const auto xy = ops.mul(qx, qy);
+            const auto xz = ops.mul(qx, qz);
+            const auto yz = ops.mul(qy, qz);
+            const auto wx = ops.mul(qw, qx);
+            const auto wy = ops.mul(qw, qy);
+            const auto wz = ops.mul(qw, qz);
+
+            // Dividing by the squared norm normalizes the quaternion without a square root.
+            const auto one = ops.broadcast(1.0f);
+            const auto s   = ops.div(ops.broadcast(2.0f), ops.add(ops.add(xx, yy), ops.add(zz, ops.mul(qw, qw))));
+
+            return AffineRows<T> {
+                .m00 = ops.mul(ops.sub(one, ops.mul(s, ops.add(yy, zz))), sx),
+                .m01 = ops.mul(ops.mul(s, ops.sub(xy, wz)), sy),
+                .m02 = ops.mul(ops.mul(s, ops.add(xz, wy)), sz),
+                .m03 = px,
+                .m10 = ops.mul(ops.mul(s, ops.add(xy, wz)), sx),
+                .m11 = ops.mul(ops.sub(one, ops.mul(s, ops.add(xx, zz))), sy),
+                .m12 = ops.mul(ops.mul(s, ops.sub(yz, wx)), sz),
+                .m13 = py,
+                .m20 = ops.mul(ops.mul(s, ops.sub(xz, wy)), sx),
+                .m21 = ops.mul(ops.mul(s, ops.add(yz, wx)), sy),
+                .m22 = ops.mul(ops.sub(one, ops.mul(s, ops.add(xx, yy))), sz),
+                .m23 = pz,
+            };
+        }
+
+        struct ScalarOps
+        {
+            static auto broadcast(float32 value) -> float32 { return value; }
+            static auto add(float32 lhs, float32 rhs) -> float32 { return lhs + rhs; }
+            static auto sub(float32 lhs, float32 rhs) -> float32 { return lhs - rhs; }
+            static auto mul(float32 lhs, float32 rhs) -> float32 { return lhs * rhs; }
+            static auto div(float32 lhs, float32 rhs) -> float32 { return lhs / rhs; }
+        };
+
+#if not defined(QURB_SIMD_SCALAR)
+        struct WideOps
+        {
+            static auto broadcast(float32 value) -> Wide { return detail::broadcast(value); }
+            static auto add(Wide lhs, Wide rhs) -> Wide { return detail::add(lhs, rhs); }
+            static auto sub(Wide lhs, Wide rhs) -> Wide { return detail::sub(lhs, rhs); }
+            static auto mul(Wide lhs, Wide rhs) -> Wide { return detail::mul(lhs, rhs); }
+            static auto div(Wide lhs, Wide rhs) -> Wide { return detail::div(lhs, rhs); }
+        };
+
+        /// \brief Composes the `width` transforms starting at `first`.
+        inline auto composeRegister(const TransformStreams& transforms, usize first, Matrix4x4f* matrices) -> void
+        {
+            const auto rows = compose(
+                load(&transforms.positionX[first]),
+                load(&transforms.positionY[first]),
+                load(&transforms.positionZ[first]),
+                load(&transforms.rotationX[first]),
+                load(&transforms.rotationY[first]),
+                load(&transforms.rotationZ[first]),
+                load(&transforms.rotationW[first]),
+                load(&transforms.scaleX[first]),
+                load(&transforms.scaleY[first]),
+                load(&transforms.scaleZ[first]),
+                WideOps());
+
+            // Element `j` of every row register goes to matrix `j`: stage the rows, then transpose them four matrices
+            // at a time into whole matrix rows.
+            alignas(64) float32 staging[12][width];
+            store(staging[0], rows.m00);
+            store(staging[1], rows.m01);
+            store(staging[2], rows.m02);
+            store(staging[3], rows.m03);
+            store(staging[4], rows.m10);
+            store(staging[5], rows.m11);
+            store(staging[6], rows.m12);
+            store(staging[7], rows.m13);
+            store(staging[8], rows.m20);
+            store(staging[9], rows.m21);
+            store(staging[10], rows.m22);
+            store(staging[11], rows.m23);
+
+            const auto lastRow = simd::set(0.0f, 0.0f, 0.0f, 1.0f);
+            for (usize j = 0; j < width; j += 4)
+            {
+                for (usize row = 0; row < 3; ++row)
+                {
+                    auto c0 = simd::load(&staging[row * 4 + 0][j]);
+                    auto c1 = simd::load(&staging[row * 4 + 1][j]);
+                    auto c2 = simd::load(&staging[row * 4 + 2][j]);
+                    auto c3 = simd::load(&staging[row * 4 + 3][j]);
+                    simd::transpose(c0, c1, c2, c3);
+
+                    simd::store(matrices[j + 0].data() + row * 4, c0);
+                    simd::store(matrices[j + 1].data() + row * 4, c1);
+                    simd::store(matrices[j + 2].data() + row * 4, c2);
+                    simd::store(matrices[j + 3].data() + row * 4, c3);
+                }
+
+                simd::store(matrices[j + 0].data() + 12, lastRow);
+                simd::store(matrices[j + 1].data() + 12, lastRow);
+                simd::store(matrices[j + 2].data() + 12, lastRow);
+                simd::store(matrices[j + 3].data() + 12, lastRow);
+            }
+        }
+#endif
+    }
+
+    /// \brief Writes `translation x rotation x scale` for every transform, like `math::transformMatrix`. Quaternions
+    /// do not need to be normalized.
+    inline auto composeMatrices(const TransformStreams& transforms, std::span<Matrix4x4f> matrices) -> void
+    {
+        const auto count = transforms.size();
+        ensure(matrices.size() >= count, "Cannot compose {} transforms into {} matrices.", count, matrices.size());
+
+        usize i = 0;
+#if not defined(QURB_SIMD_SCALAR)
+        for (; i + width <= count; i += width)
+        {
+            detail::composeRegister(transforms, i, matrices.data() + i);
+        }
+#endif
+
+        for (; i < count; ++i)
+        {
+            const auto rows = detail::compose(
+                transforms.positionX[i],
+                transforms.positionY[i],
+                transforms.positionZ[i],
+                transforms.rotationX[i],
+                transforms.rotationY[i],
+                transforms.rotationZ[i],
+                transforms.rotationW[i],
+                transforms.scaleX[i],
+                transforms.scaleY[i],
+                transforms.scaleZ[i],
+                detail::ScalarOps());
+
+            auto* data = matrices[i].data();
+            data[0]    = rows.m00;
+            data[1]    = rows.m01;
+            data[2]    = rows.m02;
+            data[3]    = rows.m03;
+            data[4]    = rows.m10;
+            data[5]    = rows.m11;
+            data[6]    = rows.m12;
+            data[7]    = rows.m13;
+            data[8]    = rows.m20;
+            data[9]    = rows.m21;
+            data[10]   = rows.m22;
+            data[11]   = rows.m23;
+            data[12]   = 0.0f;
+            data[13]   = 0.0f;
+            data[14]   = 0.0f;
+            data[15]   = 1.0f;
+        }
+    }
+
+    /// \brief Writes `matrix * (point, 1)` for every point, `out` may alias `points`.
+    inline auto transformPoints(const Matrix4x4f& matrix, const PointStreams<const float32>& points, const PointStreams<float32>& out) -> void
+    {
+        const auto  count = points.size();
+        const auto* m     = matrix.data();
+        ensure(out.size() >= count, "Cannot transform {} points into {}.", count, out.size());
+
+        usize i = 0;
+#if not defined(QURB_SIMD_SCALAR)
+        using namespace detail;
+
+        const Wide rows[3][4] = {
+            {broadcast(m[0]), broadcast(m[1]), broadcast(m[2]), broadcast(m[3])},
+            {broadcast(m[4]), broadcast(m[5]), broadcast(m[6]), broadcast(m[7])},
+            {broadcast(m[8]), broadcast(m[9]), broadcast(m[10]), broadcast(m[11])},
+        };
+
+        for (; i + width <= count; i += width)
+        {
+            const auto x = load(&points.x[i]);
+            const auto y = load(&points.y[i]);
+            const auto z = load(&points.z[i]);
+
+            store(&out.x[i], multiplyAdd(rows[0][0], x, multiplyAdd(rows[0][1], y, multiplyAdd(rows[0][2], z, rows[0][3]))));
+            store(&out.y[i], multiplyAdd(rows[1][0], x, multiplyAdd(rows[1][1], y, multiplyAdd(rows[1][2], z, rows[1][3]))));
+            store(&out.z[i], multiplyAdd(rows[2][0], x, multiplyAdd(rows[2][1], y, multiplyAdd(rows[2][2], z, rows[2][3]))));
+        }
+#endif
+
+        for (; i < count; ++i)
+        {
+            const auto x = points.x[i];
+            const auto y = points.y[i];
+            const auto z = points.z[i];
+
+            out.x[i] = m[0] * x + (m[1] * y + (m[2] * z + m[3]));
+            out.y[i] = m[4] * x + (m[5] * y + (m[6] * z + m[7]));
+            out.z[i] = m[8] * x + (m[9] * y + (m[10] * z + m[11]));
+        }
+    }
+
+    /// \brief Writes 1 in `visible` for the boxes intersecting or inside `frustum`, 0 for the others.
+    ///
+    /// A box is outside when it lies entirely behind one of the planes: the signed distance of its center is lower
+    /// than the projection of its half extents on the plane normal. Boxes crossing the corners of the frustum outside
+    /// of it may be reported visible, never the other way around.
+    inline auto cullBoxes(const Frustum& frustum, const BoxStreams<const float32>& boxes, std::span<uint8> visible) -> void
+    {
+        const auto count = boxes.size();
+        ensure(visible.size() >= count, "Cannot cull {} boxes into {} flags.", count, visible.size());
+
+        usize i = 0;
+#if not defined(QURB_SIMD_SCALAR)
+        using namespace detail;
+
+        Wide planes[Frustum::planeCount][7];
+        for (usize p = 0; p < Frustum::planeCount; ++p)
+        {
+            const auto& plane = frustum.planes[p];
+            planes[p][0]      = broadcast(plane.x);
+            planes[p][1]      = broadcast(plane.y);
+            planes[p][2]      = broadcast(plane.z);
+            planes[p][3]      = broadcast(plane.w);
+            planes[p][4]      = broadcast(std::abs(plane.x));
+            planes[p][5]      = broadcast(std::abs(plane.y));
+            planes[p][6]      = broadcast(std::abs(plane.z));
+        }
+
+        for (; i + width <= count; i += width)
+        {
+            const auto cx = load(&boxes.centerX[i]);
+            const auto cy = load(&boxes.centerY[i]);
+            const auto cz = load(&boxes.centerZ[i]);
+            const auto ex = load(&boxes.extentX[i]);
+            const auto ey = load(&boxes.extentY[i]);
+            const auto ez = load(&boxes.extentZ[i]);
+
+            // The lowest distance plus radius over the planes, negative once any plane rejects the box.
+            auto nearest = broadcast(std::numeric_limits<float32>::max());
+            for (const auto& plane : planes)
+            {
+                const auto distance = multiplyAdd(plane[0], cx, multiplyAdd(plane[1], cy, multiplyAdd(plane[2], cz, plane[3])));
+                const auto radius   = multiplyAdd(plane[4], ex, multiplyAdd(plane[5], ey, mul(plane[6], ez)));
+                nearest             = min(nearest, add(distance, radius));
+            }
+
+            alignas(64) float32 staging[width];
+            store(staging, nearest);
+            for (usize j = 0; j < width; ++j)
+            {
+                visible[i + j] = staging[j] >= 0.0f;
+            }
+        }
+#endif
+
+        for (; i < count; ++i)
+        {
+            auto inside = true;
+            for (const auto& plane : frustum.planes)
+            {
+                const auto distance = plane.x * boxes.centerX[i] + (plane.y * boxes.centerY[i] + (plane.z * boxes.centerZ[i] + plane.w));
+                const auto radius   = std::abs(plane.x) * boxes.extentX[i] + (std::abs(plane.y) * boxes.extentY[i] + std::abs(plane.z) * boxes.extentZ[i]);
+                inside              = inside and distance + radius >= 0.0f;
+            }
+            visible[i] = inside;
+        }
+    }
+}
@@ -0,0 +1,58 @@
+/// \file Frustum.hpp
+
+#pragma once
+
+#include "CoreTypes.hpp"
+#include "Math/Matrix4x4.hpp"
+#include "Math/Vector4.hpp"
+
+#include <array>
+#include <cmath>
+
+namespace qurb::math
+{
+    /// \brief The six planes bounding the volume seen by a camera.
+    ///
+    /// A plane `(x, y, z, w)` keeps the points `p` with `x * p.x + y * p.y + z * p.z + w >= 0`, its normal points
+    /// inside the frustum and is normalized, so that the expression is the distance to the plane.
+    struct Frustum
+    {
+        static constexpr auto planeCount = usize(6);
+
+        std::array<Vector4f, planeCount> planes;  // Left, right, bottom, top, near and far.
+    };
+
+    /// \brief The frustum of a view projection matrix mapping the visible depths to `[0, 1]`, like `makePerspective`
+    /// and `makeOrthographic`. Planes are in the space the matrix transforms from, world space for `projection * view`.
+    inline auto makeFrustum(const Matrix4x4f& viewProjection) -> Frustum
+    {
+        const auto& m   = viewProjection;
+        const auto  row = [&](uint32 i) { return Vector4f(m[i, 0], m[i, 1], m[i, 2], m[i, 3]); };
+        const auto  r0  = row(0);
+        const auto  r1  = row(1);
+        const auto  r2  = row(2);
+        const auto  r3  = row(3);
+
+        // A clip space point is visible when -w <= x <= w, -w <= y <= w and 0 <= z <= w.
+        auto frustum = Frustum {
+            .planes = {
+                Vector4f(r3.x + r0.x, r3.y + r0.y, r3.z + r0.z, r3.w + r0.w),
+                Vector4f(r3.x - r0.x, r3.y - r0.y, r3.z - r0.z, r3.w - r0.w),
+                Vector4f(r3.x + r1.x, r3.y + r1.y, r3.z + r1.z, r3.w + r1.w),
+                Vector4f(r3.x - r1.x, r3.y - r1.y, r3.z - r1.z, r3.w - r1.w),
+                r2,
+                Vector4f(r3.x - r2.x, r3.y - r2.y, r3.z - r2.z, r3.w - r2.w),
+            },
+        };
+
+        for (auto& plane : frustum.planes)
+        {
+            const auto length = std::sqrt(plane.x * plane.x + plane.y * plane.y + plane.z * plane.z);
+            if (length > 0.0f)
+            {
+                plane = Vector4f(plane.x / length, plane.y / length, plane.z / length, plane.w / length);
+            }
+        }
+        return frustum;
+    }
+}
@@ -4,16 +4,21 @@
 
 #include "CoreTypes.hpp"
 #include "Debug/Ensure.hpp"
+#include "Math/Matrix4x4Kernels.hpp"
 #include "Math/Quaternion.hpp"
 #include "Math/TypeTraits.hpp"
 #include "Math/Vector4.hpp"
 
+#include <concepts>
 #include <format>
 #include <span>
 
 namespace qurb::math
 {
-    /// \brief A 4x4 matrix class.
+    /// \brief A 4x4 matrix class, stored row by row.
+    ///
+    /// The products, inverses and transforms of `Matrix4x4<float32>` run the vectorized kernels of
+    /// `Matrix4x4Kernels.hpp` outside of constant evaluation.
     /// \tparam T The type of the matrix elements. Must be a numeric type.
     template <Numeric T>
     class Matrix4x4
@@ -33,10 +38,16 @@ namespace qurb::math
         constexpr auto operator[](uint32 i, uint32 j) const noexcept -> const T&;
         constexpr auto operator[](uint32 i, uint32 j) noexcept -> T&;
 
-        auto inverse() const noexcept -> Matrix4x4<T>;
+        [[nodiscard]] constexpr auto transpose() const noexcept -> Matrix4x4<T>;
+
+        /// \brief The inverse of the matrix, which must be invertible.
+        [[nodiscard]] constexpr auto inverse() const noexcept -> Matrix4x4<T>;
+
+        /// \brief The inverse of an affine matrix, whose last row is `(0, 0, 0, 1)`. Cheaper than `inverse`.
+        [[nodiscard]] constexpr auto affineInverse() const noexcept -> Matrix4x4<T>;
 
     private:
-        T _data[16];
+        alignas(16) T _data[16];
     };
 
     using Matrix4x4f = Matrix4x4<float32>;
@@ -49,6 +60,7 @@ namespace qurb::math
 
     template <Numeric T>
     constexpr Matrix4x4<T>::Matrix4x4(T scalar) noexcept
+        : _data()
     {
         for (int32 i = 0; i < 4; ++i)
         {
@@ -83,63 +95,54 @@ namespace qurb::math
     }
 
     template <Numeric T>
-    auto Matrix4x4<T>::inverse() const noexcept -> Matrix4x4<T>
+    constexpr auto Matrix4x4<T>::transpose() const noexcept -> Matrix4x4<T>
+    {
+        auto res = Matrix4x4<T>();
+        if constexpr (std::same_as<T, float32>)
+        {
+            if !consteval
+            {
+                simd::transpose(_data, res._data);
+                return res;
+            }
+        }
+
+        scalar::transpose(_data, res._data);
+        return res;
+    }
+
+    template <Numeric T>
+    constexpr auto Matrix4x4<T>::inverse() const noexcept -> Matrix4x4<T>
+    {
+        auto res = Matrix4x4<T>();
+        if constexpr (std::same_as<T, float32>)
+        {
+            if !consteval
+            {
+                simd::inverse(_data, res._data);
+                return res;
+            }
+        }
+
+        scalar::inverse(_data, res._data);
+        return res;
+    }
+
+    template <Numeric T>
+    constexpr auto Matrix4x4<T>::affineInverse() const noexcept -> Matrix4x4<T>
     {
-        auto data = reinterpret_cast<const T(*)[4]>(_data);
-
-        T i0  = data[1][1] * data[3][3];
-        T i1  = data[3][2] * data[2][3];
-        T i2  = data[1][2] * data[3][3];
-        T i3  = data[3][2] * data[1][3];
-        T i4  = data[1][2] * data[2][3];
-        T i5  = data[1][1] * data[1][3];
-        T i6  = data[0][2] * data[3][3];
-        T i7  = data[3][2] * data[0][3];
-        T i8  = data[0][2] * data[2][3];
-        T i9  = data[1][1] * data[0][3];
-        T i10 = data[0][2] * data[1][3];
-        T i11 = data[1][2] * data[0][3];
-        T i12 = data[2][0] * data[3][1];
-        T i13 = data[3][0] * data[2][1];
-        T i14 = data[1][0] * data[3][1];
-        T i15 = data[3][0] * data[1][1];
-        T i16 = data[1][0] * data[2][1];
-        T i17 = data[2][0] * data[1][1];
-        T i18 = data[0][0] * data[3][1];
-        T i19 = data[3][0] * data[0][1];
-        T i20 = data[0][0] * data[2][1];
-        T i21 = data[2][0] * data[0][1];
-        T i22 = data[0][0] * data[1][1];
-        T i23 = data[1][0] * data[0][1];
-
-        Matrix4x4<T> inverse;
-        inverse[0, 0] = (i0 * data[1][1] + i3 * data[2][1] + i4 * data[3][1]) - (i1 * data[1][1] + i2 * data[2][1] + i5 * data[3][1]);
-        inverse[0, 1] = (i1 * data[0][1] + i6 * data[2][1] + i9 * data[3][1]) - (i0 * data[0][1] + i7 * data[2][1] + i8 * data[3][1]);
-        inverse[0, 2] = (i2 * data[0][1] + i7 * data[1][1] + i10 * data[3][1]) - (i3 * data[0][1] + i6 * data[1][1] + i11 * data[3][1]);
-        inverse[0, 3] = (i5 * data[0][1] + i8 * data[1][1] + i11 * data[2][1]) - (i4 * data[0][1] + i9 * data[1][1] + i10 * data[2][1]);
-
-        T d = T(1) / (data[0][0] * inverse[0, 0] + data[1][0] * inverse[0, 1] + data[2][0] * inverse[0, 2] + data[3][0] * inverse[3, 0]);
-
-        inverse[0, 0] = d * inverse[0, 0];
-        inverse[0, 1] = d * inverse[0, 1];
-        inverse[0, 2] = d * inverse[0, 2];
-        inverse[0, 3] = d * inverse[0, 3];
-
-        inverse[1, 0] = d * ((i1 * data[1][0] + i2 * data[2][0] + i5 * data[3][0]) - (i0 * data[1][0] + i3 * data[2][0] + i4 * data[3][0]));
-        inverse[1, 1] = d * ((i0 * data[0][0] + i7 * data[2][0] + i8 * data[3][0]) - (i1 * data[0][0] + i6 * data[2][0] + i9 * data[3][0]));
-        inverse[1, 2] = d * ((i3 * data[0][0] + i6 * data[1][0] + i11 * data[3][0]) - (i2 * data[0][0] + i7 * data[1][0] + i10 * data[3][0]));
-        inverse[1, 3] = d * ((i4 * data[0][0] + i9 * data[1][0] + i10 * data[2][0]) - (i5 * data[0][0] + i8 * data[1][0] + i11 * data[2][0]));
-
-        inverse[2, 0] = d * ((i12 * data[1][3] + i15 * data[2][3] + i16 * data[3][3]) - (i13 * data[1][3] + i14 * data[2][3] + i17 * data[3][3]));
-        inverse[2, 1] = d * ((i13 * data[3][0] + i18 * data[2][3] + i21 * data[3][3]) - (i12 * data[3][0] + i19 * data[2][3] + i20 * data[3][3]));
-        inverse[2, 2] = d * ((i14 * data[3][0] + i19 * data[1][3] + i22 * data[3][3]) - (i15 * data[3][0] + i18 * data[1][3] + i23 * data[3][3]));
-        inverse[2, 3] = d * ((i17 * data[3][0] + i20 * data[1][3] + i23 * data[2][3]) - (i16 * data[3][0] + i21 * data[1][3] + i22 * data[2][3]));
-
-        inverse[3, 0] = d * ((i14 * data[2][2] + i17 * data[3][2] + i13 * data[1][2]) - (i16 * data[3][2] + i12 * data[1][2] + i15 * data[2][2]));
-        inverse[3, 1] = d * ((i20 * data[3][2] + i12 * data[2][0] + i19 * data[2][2]) - (i18 * data[2][2] + i21 * data[3][2] + i13 * data[2][0]));
-        inverse[3, 2] = d * ((i18 * data[1][2] + i23 * data[3][2] + i15 * data[2][0]) - (i22 * data[3][2] + i14 * data[2][0] + i19 * data[1][2]));
-        inverse[3, 3] = d * ((i22 * data[2][2] + i16 * data[2][0] + i21 * data[1][2]) - (i20 * data[1][2] + i23 * data[2][2] + i17 * data[2][0]));
-        return inverse;
+        auto res = Matrix4x4<T>();
+        if constexpr (std::same_as<T, float32>)
+        {
+            if !consteval
+            {
+                simd::affineInverse(_data, res._data);
+                return res;
+            }
+        }
+
+        scalar::affineInverse(_data, res._data);
+        return res;
     }
 
     template <Numeric T>
@@ -185,8 +188,8 @@ namespace qurb::math
     {
         auto res = Matrix4x4<T>();
 
-        T* mat_data = mat.data();
-        T* res_data = res.data();
+        const T* mat_data = mat.data();
+        T*       res_data = res.data();
         for (uint32 i = 0; i < 16; ++i)
         {
             res_data[i] = -mat_data[i];
@@ -199,18 +202,16 @@ namespace qurb::math
     constexpr auto operator*(const Matrix4x4<T>& lhs, const Matrix4x4<T>& rhs) -> Matrix4x4<T>
     {
         auto res = Matrix4x4<T>();
-
-        for (uint32 i = 0; i < 4; ++i)
+        if constexpr (std::same_as<T, float32>)
         {
-            for (uint32 k = 0; k < 4; ++k)
+            if !consteval
             {
-                for (uint32 j = 0; j < 4; ++j)
-                {
-                    res[i, j] += lhs[i, k] * rhs[k, j];
-                }
+                simd::multiply(lhs.data(), rhs.data(), res.data());
+                return res;
             }
         }
 
+        scalar::multiply(lhs.data(), rhs.data(), res.data());
         return res;
     }
 
@@ -225,15 +226,16 @@ namespace qurb::math
     constexpr auto operator*(const Matrix4x4<T>& lhs, const Vector4<T>& rhs) -> Vector4<T>
     {
         auto res = Vector4<T>();
-
-        for (int32 i = 0; i < 4; ++i)
+        if constexpr (std::same_as<T, float32>)
         {
-            for (int32 j = 0; j < 4; ++j)
+            if !consteval
             {
-                res[i] += lhs[i, j] * rhs[j];
+                simd::transform(lhs.data(), &rhs.x, &res.x);
+                return res;
             }
         }
 
+        scalar::transform(lhs.data(), &rhs.x, &res.x);
         return res;
     }
 
@@ -293,6 +295,26 @@ namespace qurb::math
     {
         return rotationMatrix(Quaternion<T>(euler));
     }
+
+    /// \brief Equivalent to `translationMatrix(translation) * rotationMatrix(rotation) * scaleMatrix(scale)`, without
+    /// the two matrix products.
+    template <Real T>
+    constexpr auto transformMatrix(const Vector3<T>& translation, const Quaternion<T>& rotation, const Vector3<T>& scale) noexcept -> Matrix4x4<T>
+    {
+        auto res = rotationMatrix(rotation);
+
+        for (uint32 i = 0; i < 3; ++i)
+        {
+            res[i, 0] *= scale.x;
+            res[i, 1] *= scale.y;
+            res[i, 2] *= scale.z;
+        }
+
+        res[0, 3] = translation.x;
+        res[1, 3] = translation.y;
+        res[2, 3] = translation.z;
+        return res;
+    }
 }
 
 template <qurb::math::Numeric T>
@@ -0,0 +1,312 @@
+/// \file Matrix4x4Kernels.hpp
+/// \brief The 4x4 matrix operations on raw row-major arrays, used by `Matrix4x4`.
+///
+/// The `scalar` kernels are the reference implementation for every element type. The `simd` kernels handle `float32`
+/// with the instruction set selected in `Simd.hpp`, and forward to the scalar ones when none is available. Matrices
+/// transform column vectors, the translation is stored in the last column.
+
+#pragma once
+
+#include "CoreTypes.hpp"
+#include "Math/Simd.hpp"
+#include "Math/TypeTraits.hpp"
+
+namespace qurb::math::scalar
+{
+    /// \brief `out = lhs * rhs`, `out` must not alias the operands.
+    template <Numeric T>
+    constexpr auto multiply(const T* lhs, const T* rhs, T* out) noexcept -> void
+    {
+        for (uint32 i = 0; i < 4; ++i)
+        {
+            for (uint32 j = 0; j < 4; ++j)
+            {
+                out[i * 4 + j] =
+                    lhs[i * 4 + 0] * rhs[0 * 4 + j] + lhs[i * 4 + 1] * rhs[1 * 4 + j] + lhs[i * 4 + 2] * rhs[2 * 4 + j] + lhs[i * 4 + 3] * rhs[3 * 4 + j];
+            }
+        }
+    }
+
+    template <Numeric T>
+    constexpr auto transpose(const T* matrix, T* out) noexcept -> void
+    {
+        for (uint32 i = 0; i < 4; ++i)
+        {
+            for (uint32 j = 0; j < 4; ++j)
+            {
+                out[j * 4 + i] = matrix[i * 4 + j];
+            }
+        }
+    }
+
+    /// \brief `out = inverse(matrix)` by cofactor expansion, `matrix` must be invertible.
+    template <Numeric T>
+    constexpr auto inverse(const T* m, T* out) noexcept -> void
+    {
+        T inv[16];
+
+        inv[0]  = m[5] * m[10] * m[15] - m[5] * m[11] * m[14] - m[9] * m[6] * m[15] + m[9] * m[7] * m[14] + m[13] * m[6] * m[11] - m[13] * m[7] * m[10];
+        inv[4]  = -m[4] * m[10] * m[15] + m[4] * m[11] * m[14] + m[8] * m[6] * m[15] - m[8] * m[7] * m[14] - m[12] * m[6] * m[11] + m[12] * m[7] * m[10];
+        inv[8]  = m[4] * m[9] * m[15] - m[4] * m[11] * m[13] - m[8] * m[5] * m[15] + m[8] * m[7] * m[13] + m[12] * m[5] * m[11] - m[12] * m[7] * m[9];
+        inv[12] = -m[4] * m[9] * m[14] + m[4] * m[10] * m[13] + m[8] * m[5] * m[14] - m[8] * m[6] * m[13] - m[12] * m[5] * m[10] + m[12] * m[6] * m[9];
+        inv[1]  = -m[1] * m[10] * m[15] + m[1] * m[11] * m[14] + m[9] * m[2] * m[15] - m[9] * m[3] * m[14] - m[13] * m[2] * m[11] + m[13] * m[3] * m[10];
+        inv[5]  = m[0] * m[10] * m[15] - m[0] * m[11] * m[14] - m[8] * m[2] * m[15] + m[8] * m[3] * m[14] + m[12] * m[2] * m[11] - m[12] * m[3] * m[10];
+        inv[9]  = -m[0] * m[9] * m[15] + m[0] * m[11] * m[13] + m[8] * m[1] * m[15] - m[8] * m[3] * m[13] - m[12] * m[1] * m[11] + m[12] * m[3] * m[9];
+        inv[13] = m[0] * m[9] * m[14] - m[0] * m[10] * m[13] - m[8] * m[1] * m[14] + m[8] * m[2] * m[13] + m[12] * m[1] * m[10] - m[12] * m[2] * m[9];
+        inv[2]  = m[1] * m[6] * m[15] - m[1] * m[7] * m[14] - m[5] * m[2] * m[15] + m[5] * m[3] * m[14] + m[13] * m[2] * m[7] - m[13] * m[3] * m[6];
+        inv[6]  = -m[0] * m[6] * m[15] + m[0] * m[7] * m[14] + m[4] * m[2] * m[15] - m[4] * m[3] * m[14] - m[12] * m[2] * m[7] + m[12] * m[3] * m[6];
+        inv[10] = m[0] * m[5] * m[15] - m[0] * m[7] * m[13] - m[4] * m[1] * m[15] + m[4] * m[3] * m[13] + m[12] * m[1] * m[7] - m[12] * m[3] * m[5];
+        inv[14] = -m[0] * m[5] * m[14] + m[0] * m[6] * m[13] + m[4] * m[1] * m[14] - m[4] * m[2] * m[13] - m[12] * m[1] * m[6] + m[12] * m[2] * m[5];
+        inv[3]  = -m[1] * m[6] * m[11] + m[1] * m[7] * m[10] + m[5] * m[2] * m[11] - m[5] * m[3] * m[10] - m[9] * m[2] * m[7] + m[9] * m[3] * m[6];
+        inv[7]  = m[0] * m[6] * m[11] - m[0] * m[7] * m[10] - m[4] * m[2] * m[11] + m[4] * m[3] * m[10] + m[8] * m[2] * m[7] - m[8] * m[3] * m[6];
+        inv[11] = -m[0] * m[5] * m[11] + m[0] * m[7] * m[9] + m[4] * m[1] * m[11] - m[4] * m[3] * m[9] - m[8] * m[1] * m[7] + m[8] * m[3] * m[5];
+        inv[15] = m[0] * m[5] * m[10] - m[0] * m[6] * m[9] - m[4] * m[1] * m[10] + m[4] * m[2] * m[9] + m[8] * m[1] * m[6] - m[8] * m[2] * m[5];
+
+        const auto determinant = m[0] * inv[0] + m[1] * inv[4] + m[2] * inv[8] + m[3] * inv[12];
+        const auto scale       = T(1) / determinant;
+        for (uint32 i = 0; i < 16; ++i)
+        {
+            out[i] = inv[i] * scale;
+        }
+    }
+
+    /// \brief `out = inverse(matrix)` for a matrix whose last row is `(0, 0, 0, 1)`, the upper 3x3 block may hold any
+    /// invertible rotation, scale and shear.
+    template <Numeric T>
+    constexpr auto affineInverse(const T* m, T* out) noexcept -> void
+    {
+        // The columns of the inverse 3x3 block are the cross products of the rows, over the determinant.
+        const T c0[3] = {m[5] * m[10] - m[6] * m[9], m[6] * m[8] - m[4] * m[10], m[4] * m[9] - m[5] * m[8]};
+        const T c1[3] = {m[9] * m[2] - m[10] * m[1], m[10] * m[0] - m[8] * m[2], m[8] * m[1] - m[9] * m[0]};
+        const T c2[3] = {m[1] * m[6] - m[2] * m[5], m[2] * m[4] - m[0] * m[6], m[0] * m[5] - m[1] * m[4]};
+
+        const auto scale = T(1) / (m[0] * c0[0] + m[1] * c0[1] + m[2] * c0[2]);
+        for (uint32 i = 0; i < 3; ++i)
+        {
+            out[i * 4 + 0] = c0[i] * scale;
+            out[i * 4 + 1] = c1[i] * scale;
+            out[i * 4 + 2] = c2[i] * scale;
+            out[i * 4 + 3] = -(out[i * 4 + 0] * m[3] + out[i * 4 + 1] * m[7] + out[i * 4 + 2] * m[11]);
+        }
+
+        out[12] = T(0);
+        out[13] = T(0);
+        out[14] = T(0);
+        out[15] = T(1);
+    }
+
+    /// \brief `out = matrix * vector` for a column vector of four components.
+    template <Numeric T>
+    constexpr auto transform(const T* matrix, const T* vector, T* out) noexcept -> void
+    {
+        for (uint32 i = 0; i < 4; ++i)
+        {
+            out[i] = matrix[i * 4 + 0] * vector[0] + matrix[i * 4 + 1] * vector[1] + matrix[i * 4 + 2] * vector[2] + matrix[i * 4 + 3] * vector[3];
+        }
+    }
+}
+
+namespace qurb::math::simd
+{
+#if defined(QURB_SIMD_SCALAR)
+    inline auto multiply(const float32* lhs, const float32* rhs, float32* out) noexcept -> void
+    {
+        scalar::multiply(lhs, rhs, out);
+    }
+
+    inline auto transpose(const float32* matrix, float32* out) noexcept -> void
+    {
+        scalar::transpose(matrix, out);
+    }
+
+    inline auto inverse(const float32* matrix, float32* out) noexcept -> void
+    {
+        scalar::inverse(matrix, out);
+    }
+
+    inline auto affineInverse(const float32* matrix, float32* out) noexcept -> void
+    {
+        scalar::affineInverse(matrix, out);
+    }
+
+    inline auto transform(const float32* matrix, const float32* vector, float32* out) noexcept -> void
+    {
+        scalar::transform(matrix, vector, out);
+    }
+#else
+    /// \brief `out = lhs * rhs`, each row of the result is a combination of the rows of `rhs`.
+    inline auto multiply(const float32* lhs, const float32* rhs, float32* out) noexcept -> void
+    {
+    #if defined(QURB_SIMD_AVX)
+        // Two rows of the result per 256-bit register, `rhs` rows repeated in both lanes.
+        const auto b0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(rhs + 0));
+        const auto b1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(rhs + 4));
+        const auto b2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(rhs + 8));
+        const auto b3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(rhs + 12));
+
+        for (uint32 i = 0; i < 16; i += 8)
+        {
+            const auto a = _mm256_loadu_ps(lhs + i);
+
+            auto row = _mm256_mul_ps(_mm256_shuffle_ps(a, a, 0x00), b0);
+            row      = _mm256_add_ps(row, _mm256_mul_ps(_mm256_shuffle_ps(a, a, 0x55), b1));
+            row      = _mm256_add_ps(row, _mm256_mul_ps(_mm256_shuffle_ps(a, a, 0xAA), b2));
+            row      = _mm256_add_ps(row, _mm256_mul_ps(_mm256_shuffle_ps(a, a, 0xFF), b3));
+            _mm256_storeu_ps(out + i, row);
+        }
+    #else
+        const auto b0 = load(rhs + 0);
+        const auto b1 = load(rhs + 4);
+        const auto b2 = load(rhs + 8);
+        const auto b3 = load(rhs + 12);
+
+        for (uint32 i = 0; i < 16; i += 4)
+        {
+            const auto a = load(lhs + i);
+
+            auto row = mul(splat<0>(a), b0);
+            row      = multiplyAdd(splat<1>(a), b1, row);
+            row      = multiplyAdd(splat<2>(a), b2, row);
+            row      = multiplyAdd(splat<3>(a), b3, row);
+            store(out + i, row);
+        }
+    #endif
+    }
+
+    inline auto transpose(const float32* matrix, float32* out) noexcept -> void
+    {
+        auto r0 = load(matrix + 0);
+        auto r1 = load(matrix + 4);
+        auto r2 = load(matrix + 8);
+        auto r3 = load(matrix + 12);
+
+        simd::transpose(r0, r1, r2, r3);
+
+        store(out + 0, r0);
+        store(out + 4, r1);
+        store(out + 8, r2);
+        store(out + 12, r3);
+    }
+
+    namespace detail
+    {
+        // A 2x2 block (a, b, c, d) is the matrix | a b |
+        //                                        | c d |
+
+        /// \brief `lhs * rhs` on 2x2 blocks.
+        inline auto multiply2x2(Float4 lhs, Float4 rhs) -> Float4
+        {
+            return add(mul(lhs, swizzle<0, 3, 0, 3>(rhs)), mul(swizzle<1, 0, 3, 2>(lhs), swizzle<2, 1, 2, 1>(rhs)));
+        }
+
+        /// \brief `adjugate(lhs) * rhs` on 2x2 blocks.
+        inline auto adjugateMultiply2x2(Float4 lhs, Float4 rhs) -> Float4
+        {
+            return sub(mul(swizzle<3, 3, 0, 0>(lhs), rhs), mul(swizzle<1, 1, 2, 2>(lhs), swizzle<2, 3, 0, 1>(rhs)));
+        }
+
+        /// \brief `lhs * adjugate(rhs)` on 2x2 blocks.
+        inline auto multiplyAdjugate2x2(Float4 lhs, Float4 rhs) -> Float4
+        {
+            return sub(mul(lhs, swizzle<3, 0, 3, 0>(rhs)), mul(swizzle<1, 0, 3, 2>(lhs), swizzle<2, 1, 2, 1>(rhs)));
+        }
+    }
+
+    /// \brief `out = inverse(matrix)` by blockwise inversion of the four 2x2 blocks, `matrix` must be invertible.
+    inline auto inverse(const float32* matrix, float32* out) noexcept -> void
+    {
+        using namespace detail;
+
+        const auto r0 = load(matrix + 0);
+        const auto r1 = load(matrix + 4);
+        const auto r2 = load(matrix + 8);
+        const auto r3 = load(matrix + 12);
+
+        // | A B |
+        // | C D |
+        const auto a = shuffle<0, 1, 0, 1>(r0, r1);
+        const auto b = shuffle<2, 3, 2, 3>(r0, r1);
+        const auto c = shuffle<0, 1, 0, 1>(r2, r3);
+        const auto d = shuffle<2, 3, 2, 3>(r2, r3);
+
+        // The determinants of the blocks, (|A|, |B|, |C|, |D|).
+        const auto determinants =
+            sub(mul(shuffle<0, 2, 0, 2>(r0, r2), shuffle<1, 3, 1, 3>(r1, r3)), mul(shuffle<1, 3, 1, 3>(r0, r2), shuffle<0, 2, 0, 2>(r1, r3)));
+        const auto detA         = splat<0>(determinants);
+        const auto detB         = splat<1>(determinants);
+        const auto detC         = splat<2>(determinants);
+        const auto detD         = splat<3>(determinants);
+
+        const auto dc = adjugateMultiply2x2(d, c);
+        const auto ab = adjugateMultiply2x2(a, b);
+
+        // The adjugates of the blocks of the inverse, before the division by the determinant.
+        auto x = sub(mul(detD, a), multiply2x2(b, dc));
+        auto w = sub(mul(detA, d), multiply2x2(c, ab));
+        auto y = sub(mul(detB, c), multiplyAdjugate2x2(d, ab));
+        auto z = sub(mul(detC, b), multiplyAdjugate2x2(a, dc));
+
+        // |M| = |A| |D| + |B| |C| - tr((A# B) (D# C))
+        const auto trace       = horizontalSum(mul(ab, swizzle<0, 2, 1, 3>(dc)));
+        const auto determinant = sub(add(mul(detA, detD), mul(detB, detC)), trace);
+        const auto scale       = div(set(1.0f, -1.0f, -1.0f, 1.0f), determinant);
+
+        x = mul(x, scale);
+        y = mul(y, scale);
+        z = mul(z, scale);
+        w = mul(w, scale);
+
+        // Take the adjugates back while reassembling the rows.
+        store(out + 0, shuffle<3, 1, 3, 1>(x, y));
+        store(out + 4, shuffle<2, 0, 2, 0>(x, y));
+        store(out + 8, shuffle<3, 1, 3, 1>(z, w));
+        store(out + 12, shuffle<2, 0, 2, 0>(z, w));
+    }
+
+    /// \brief `out = inverse(matrix)` for a matrix whose last row is `(0, 0, 0, 1)`.
+    inline auto affineInverse(const float32* matrix, float32* out) noexcept -> void
+    {
+        const auto r0 = load(matrix + 0);
+        const auto r1 = load(matrix + 4);
+        const auto r2 = load(matrix + 8);
+
+        // The columns of the inverse 3x3 block are the cross products of the rows, over the determinant. The
+        // translations in the last lane of the rows cancel out in the cross products.
+        const auto c0    = cross(r1, r2);
+        const auto c1    = cross(r2, r0);
+        const auto c2    = cross(r0, r1);
+        const auto scale = div(set(1.0f, 1.0f, 1.0f, 1.0f), horizontalSum(mul(r0, c0)));
+
+        auto x = mul(c0, scale);
+        auto y = mul(c1, scale);
+        auto z = mul(c2, scale);
+
+        // -inverse(R) * t, with the last lane set to one.
+        const auto translation = set(matrix[3], matrix[7], matrix[11], 0.0f);
+        auto       t           = mul(x, splat<0>(translation));
+        t                      = multiplyAdd(y, splat<1>(translation), t);
+        t                      = multiplyAdd(z, splat<2>(translation), t);
+        t                      = sub(set(0.0f, 0.0f, 0.0f, 1.0f), t);
+
+        simd::transpose(x, y, z, t);
+
+        store(out + 0, x);
+        store(out + 4, y);
+        store(out + 8, z);
+        store(out + 12, t);
+    }
+
+    /// \brief `out = matrix * vector` for a column vector of four components.
+    inline auto transform(const float32* matrix, const float32* vector, float32* out) noexcept -> void
+    {
+        auto r0 = mul(load(matrix + 0), load(vector));
+        auto r1 = mul(load(matrix + 4), load(vector));
+        auto r2 = mul(load(matrix + 8), load(vector));
+        auto r3 = mul(load(matrix + 12), load(vector));
+
+        // Transposing the products leaves the terms of each dot product in one lane.
+        simd::transpose(r0, r1, r2, r3);
+        store(out, add(add(r0, r1), add(r2, r3)));
+    }
+#endif
+}
@@ -0,0 +1,274 @@
+/// \file Simd.hpp
+/// \brief Compile-time selection of the vector instruction set used by the math kernels.
+///
+/// Exactly one of `QURB_SIMD_NEON`, `QURB_SIMD_SSE` or `QURB_SIMD_SCALAR` is defined. On x86, `QURB_SIMD_AVX`,
+/// `QURB_SIMD_AVX2` (with FMA) and `QURB_SIMD_AVX512` are added on top of `QURB_SIMD_SSE` as the target supports them.
+/// Defining `QURB_DISABLE_SIMD` forces the scalar kernels.
+
+#pragma once
+
+#include "CoreTypes.hpp"
+
+#include <string_view>
+
+#if defined(QURB_DISABLE_SIMD)
+    #define QURB_SIMD_SCALAR
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64)
+    #define QURB_SIMD_NEON
+    #include <arm_neon.h>
+#elif defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+    #define QURB_SIMD_SSE
+    #if defined(__AVX__)
+        #define QURB_SIMD_AVX
+        #if defined(__AVX2__) && defined(__FMA__)
+            #define QURB_SIMD_AVX2
+        #endif
+        #if defined(__AVX512F__)
+            #define QURB_SIMD_AVX512
+        #endif
+        #include <immintrin.h>
+    #else
+        #include <emmintrin.h>
+    #endif
+#else
+    #define QURB_SIMD_SCALAR
+#endif
+
+namespace qurb::math::simd
+{
+#if defined(QURB_SIMD_NEON)
+    constexpr auto instructionSet = std::string_view("NEON");
+#elif defined(QURB_SIMD_AVX512)
+    constexpr auto instructionSet = std::string_view("AVX-512");
+#elif defined(QURB_SIMD_AVX2)
+    constexpr auto instructionSet = std::string_view("AVX2");
+#elif defined(QURB_SIMD_AVX)
+    constexpr auto instructionSet = std::string_view("AVX");
+#elif defined(QURB_SIMD_SSE)
+    constexpr auto instructionSet = std::string_view("SSE2");
+#else
+    constexpr auto instructionSet = std::string_view("Scalar");
+#endif
+
+    /// \brief Whether the vectorized kernels are compiled in.
+#if defined(QURB_SIMD_SCALAR)
+    constexpr auto enabled = false;
+#else
+    constexpr auto enabled = true;
+
+    //------------------------------------------------------------------------------------------------------------------
+    // Float4
+    //------------------------------------------------------------------------------------------------------------------
+
+    #if defined(QURB_SIMD_NEON)
+    using Float4 = float32x4_t;
+    #else
+    using Float4 = __m128;
+    #endif
+
+    inline auto load(const float32* data) -> Float4
+    {
+    #if defined(QURB_SIMD_NEON)
+        return vld1q_f32(data);
+    #else
+        return _mm_loadu_ps(data);
+    #endif
+    }
+
+    inline auto store(float32* data, Float4 value) -> void
+    {
+    #if defined(QURB_SIMD_NEON)
+        vst1q_f32(data, value);
+    #else
+        _mm_storeu_ps(data, value);
+    #endif
+    }
+
+    inline auto set(float32 x, float32 y, float32 z, float32 w) -> Float4
+    {
+    #if defined(QURB_SIMD_NEON)
+        const float32 data[4] = {x, y, z, w};
+        return vld1q_f32(data);
+    #else
+        return _mm_setr_ps(x, y, z, w);
+    #endif
+    }
+
+    inline auto add(Float4 lhs, Float4 rhs) -> Float4
+    {
+    #if defined(QURB_SIMD_NEON)
+        return vaddq_f32(lhs, rhs);
+    #else
+        return _mm_add_ps(lhs, rhs);
+    #endif
+    }
+
+    inline auto sub(Float4 lhs, Float4 rhs) -> Float4
+    {
+    #if defined(QURB_SIMD_NEON)
+        return vsubq_f32(lhs, rhs);
+    #else
+        return _mm_sub_ps(lhs, rhs);
+    #endif
+    }
+
+    inline auto mul(Float4 lhs, Float4 rhs) -> Float4
+    {
+    #if defined(QURB_SIMD_NEON)
+        return vmulq_f32(lhs, rhs);
+    #else
+        return _mm_mul_ps(lhs, rhs);
+    #endif
+    }
+
+    inline auto div(Float4 lhs, Float4 rhs) -> Float4
+    {
+    #if defined(QURB_SIMD_NEON)
+        return vdivq_f32(lhs, rhs);
+    #else
+        return _mm_div_ps(lhs, rhs);
+    #endif
+    }
+
+    inline auto min(Float4 lhs, Float4 rhs) -> Float4
+    {
+    #if defined(QURB_SIMD_NEON)
+        return vminq_f32(lhs, rhs);
+    #else
+        return _mm_min_ps(lhs, rhs);
+    #endif
+    }
+
+    inline auto max(Float4 lhs, Float4 rhs) -> Float4
+    {
+    #if defined(QURB_SIMD_NEON)
+        return vmaxq_f32(lhs, rhs);
+    #else
+        return _mm_max_ps(lhs, rhs);
+    #endif
+    }
+
+    inline auto broadcast(float32 value) -> Float4
+    {
+    #if defined(QURB_SIMD_NEON)
+        return vdupq_n_f32(value);
+    #else
+        return _mm_set1_ps(value);
+    #endif
+    }
+
+    //------------------------------------------------------------------------------------------------------------------
+    // Masks, lanes with every bit set where a comparison holds and cleared elsewhere
+    //------------------------------------------------------------------------------------------------------------------
+
+    inline auto greaterThan(Float4 lhs, Float4 rhs) -> Float4
+    {
+    #if defined(QURB_SIMD_NEON)
+        return vreinterpretq_f32_u32(vcgtq_f32(lhs, rhs));
+    #else
+        return _mm_cmpgt_ps(lhs, rhs);
+    #endif
+    }
+
+    inline auto lessThan(Float4 lhs, Float4 rhs) -> Float4
+    {
+    #if defined(QURB_SIMD_NEON)
+        return vreinterpretq_f32_u32(vcltq_f32(lhs, rhs));
+    #else
+        return _mm_cmplt_ps(lhs, rhs);
+    #endif
+    }
+
+    inline auto bitAnd(Float4 lhs, Float4 rhs) -> Float4
+    {
+    #if defined(QURB_SIMD_NEON)
+        return vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(lhs), vreinterpretq_u32_f32(rhs)));
+    #else
+        return _mm_and_ps(lhs, rhs);
+    #endif
+    }
+
+    /// \brief The lanes of `whenSet` where `mask` is set, of `whenCleared` elsewhere.
+    inline auto select(Float4 mask, Float4 whenSet, Float4 whenCleared) -> Float4
+    {
+    #if defined(QURB_SIMD_NEON)
+        return vbslq_f32(vreinterpretq_u32_f32(mask), whenSet, whenCleared);
+    #else
+        return _mm_or_ps(_mm_and_ps(mask, whenSet), _mm_andnot_ps(mask, whenCleared));
+    #endif
+    }
+
+    /// \brief One bit per lane of `mask`, lane 0 in the lowest bit.
+    inline auto moveMask(Float4 mask) -> uint32
+    {
+    #if defined(QURB_SIMD_NEON)
+        const int32 shifts[4] = {0, 1, 2, 3};
+        const auto  bits      = vshrq_n_u32(vreinterpretq_u32_f32(mask), 31);
+        return vaddvq_u32(vshlq_u32(bits, vld1q_s32(shifts)));
+    #else
+        return static_cast<uint32>(_mm_movemask_ps(mask));
+    #endif
+    }
+
+    /// \brief `a * b + c`, fused on NEON.
+    inline auto multiplyAdd(Float4 a, Float4 b, Float4 c) -> Float4
+    {
+    #if defined(QURB_SIMD_NEON)
+        return vfmaq_f32(c, a, b);
+    #else
+        return _mm_add_ps(_mm_mul_ps(a, b), c);
+    #endif
+    }
+
+    /// \brief `(a[X], a[Y], b[Z], b[W])`.
+    template <uint32 X, uint32 Y, uint32 Z, uint32 W>
+    inline auto shuffle(Float4 a, Float4 b) -> Float4
+    {
+    #if defined(QURB_SIMD_NEON)
+        return __builtin_shufflevector(a, b, X, Y, Z + 4, W + 4);
+    #else
+        return _mm_shuffle_ps(a, b, _MM_SHUFFLE(W, Z, Y, X));
+    #endif
+    }
+
+    /// \brief `(a[X], a[Y], a[Z], a[W])`.
+    template <uint32 X, uint32 Y, uint32 Z, uint32 W>
+    inline auto swizzle(Float4 a) -> Float4
+    {
+        return shuffle<X, Y, Z, W>(a, a);
+    }
+
+    /// \brief Every lane set to `a[I]`.
+    template <uint32 I>
+    inline auto splat(Float4 a) -> Float4
+    {
+        return shuffle<I, I, I, I>(a, a);
+    }
+
+    /// \brief Every lane set to the sum of the lanes of `a`.
+    inline auto horizontalSum(Float4 a) -> Float4
+    {
+        a = add(a, swizzle<1, 0, 3, 2>(a));
+        return add(a, swizzle<2, 3, 0, 1>(a));
+    }
+
+    inline auto transpose(Float4& r0, Float4& r1, Float4& r2, Float4& r3) -> void
+    {
+        const auto t0 = shuffle<0, 1, 0, 1>(r0, r1);
+        const auto t1 = shuffle<2, 3, 2, 3>(r0, r1);
+        const auto t2 = shuffle<0, 1, 0, 1>(r2, r3);
+        const auto t3 = shuffle<2, 3, 2, 3>(r2, r3);
+
+        r0 = shuffle<0, 2, 0, 2>(t0, t2);
+        r1 = shuffle<1, 3, 1, 3>(t0, t2);
+        r2 = shuffle<0, 2, 0, 2>(t1, t3);
+        r3 = shuffle<1, 3, 1, 3>(t1, t3);
+    }
+
+    /// \brief The cross product of the first three lanes, the last lane is zero.
+    inline auto cross(Float4 a, Float4 b) -> Float4
+    {
+        return sub(mul(swizzle<1, 2, 0, 3>(a), swizzle<2, 0, 1, 3>(b)), mul(swizzle<2, 0, 1, 3>(a), swizzle<1, 2, 0, 3>(b)));
+    }
+#endif
+}
@@ -59,6 +59,10 @@ namespace qurb
         return _name;
     }
 
+    /// \brief Defined by the platform, every other `loadFunction` casts its result.
+    template <>
+    auto DynamicLibrary::loadFunction<void*>(std::string_view name) -> void*;
+
     template <typename T>
     auto DynamicLibrary::loadFunction(std::string_view name) -> T
     {
@@ -0,0 +1,194 @@
+/// \file JobSystem.hpp
+
+#pragma once
+
+#include "CoreDefines.hpp"
+#include "CoreTypes.hpp"
+#include "Threading/WorkStealingQueue.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace qurb
+{
+    /// \brief Counts the jobs still running in a group, a group is complete when its counter reaches zero.
+    ///
+    /// Waiting on the counter of a group before submitting the jobs depending on it expresses the dependency.
+    using JobCounter = std::atomic<uint32>;
+
+    /// \brief Runs jobs on a fixed set of worker threads, balanced by work stealing.
+    ///
+    /// Each worker, and the thread that created the job system, owns a Chase-Lev deque: it pushes and pops its own jobs
+    /// at the bottom and steals the oldest jobs of the others when it runs out. Jobs submitted from any other thread go
+    /// through a shared queue. A thread waiting on a counter runs jobs until the counter reaches zero, so the main
+    /// thread contributes while it waits and jobs may submit and wait on nested work without starving the workers.
+    class QURB_API JobSystem final
+    {
+    public:
+        /// \brief Creates `workerCount` workers, by default one per hardware thread besides the calling one.
+        explicit JobSystem(uint32 workerCount = defaultWorkerCount());
+
+        /// \brief Stops the workers once every queued job has run.
+        ~JobSystem();
+
+        JobSystem(const JobSystem&)                    = delete;
+        auto operator=(const JobSystem&) -> JobSystem& = delete;
+
+    public:
+        [[nodiscard]] static auto defaultWorkerCount() -> uint32;
+
+        [[nodiscard]] auto workerCount() const -> uint32;
+
+        /// \brief Queues `function`, incrementing `counter` now and decrementing it once the function has run.
+        template <typename F>
+        auto submit(F&& function, JobCounter& counter) -> void;
+
+        /// \brief Runs jobs on the calling thread until `counter` reaches zero.
+        auto wait(const JobCounter& counter) -> void;
+
+        /// \brief Calls `function(begin, end)` on ranges of at most `grainSize` indices covering `[0, count)`, and waits.
+        ///
+        /// The range is split in halves recursively, the upper halves are queued and stolen by idle threads.
+        template <typename F>
+        auto parallelFor(usize count, usize grainSize, F&& function) -> void;
+
+        /// \brief Like `parallelFor` without waiting: `counter` reaches zero once every range ran. `function` must stay
+        /// alive until then.
+        template <typename F>
+        auto parallelFor(usize count, usize grainSize, const F& function, JobCounter& counter) -> void;
+
+    private:
+        /// \brief A type-erased job, the function is stored in place when it fits.
+        struct alignas(64) Job
+        {
+            static constexpr auto payloadSize = usize(48);
+
+            auto (*run)(void* payload) -> void;  // Calls, then destroys, the stored function.
+            JobCounter* counter;
+            alignas(std::max_align_t) std::byte payload[payloadSize];
+        };
+
+        /// \brief The finished jobs of a thread, reused by its next submissions.
+        struct JobCache;
+
+        struct Worker
+        {
+            WorkStealingQueue<Job> queue;
+            std::thread            thread;
+
+        public:
+            Worker();
+        };
+
+    private:
+        /// \brief Pops a recycled job of the calling thread, or allocates one.
+        static auto allocateJob() -> Job*;
+        static auto freeJob(Job* job) -> void;
+
+        template <typename F>
+        auto splitRange(usize begin, usize end, usize grainSize, const F& function, JobCounter& counter) -> void;
+
+        auto push(Job* job) -> void;
+        auto execute(Job* job) -> void;
+        auto tryRunJob() -> bool;
+        auto workerLoop(uint32 index) -> void;
+
+        /// \brief The queue owned by the calling thread, or `nullptr` outside of the creating thread and the workers.
+        auto localQueue() -> WorkStealingQueue<Job>*;
+
+    private:
+        static constexpr auto queueCapacity = usize(4096);
+
+    private:
+        static thread_local JobCache _jobCache;
+
+        std::thread::id           _ownerThread;
+        WorkStealingQueue<Job>    _ownerQueue;
+        std::unique_ptr<Worker[]> _workers;
+        uint32                    _workerCount;
+
+        std::mutex          _sharedMutex;
+        std::deque<Job*>    _sharedJobs;  // Submitted from threads owning no queue.
+        std::atomic<uint32> _sharedCount = 0;
+
+        std::atomic<uint32> _jobEpoch = 0;  // Bumped on every push, sleeping workers wait on it.
+        std::atomic<uint32> _sleepers = 0;
+        std::atomic<bool>   _stopping = false;
+    };
+
+    //------------------------------------------------------------------------------------------------------------------
+    // class JobSystem
+    //------------------------------------------------------------------------------------------------------------------
+
+    template <typename F>
+    auto JobSystem::submit(F&& function, JobCounter& counter) -> void
+    {
+        using Function = std::decay_t<F>;
+
+        counter.fetch_add(1, std::memory_order_relaxed);
+
+        auto* job    = allocateJob();
+        job->counter = &counter;
+        if constexpr (sizeof(Function) <= Job::payloadSize and alignof(Function) <= alignof(std::max_align_t))
+        {
+            new (job->payload) Function(std::forward<F>(function));
+            job->run = [](void* payload) {
+                auto* stored = std::launder(static_cast<Function*>(payload));
+                (*stored)();
+                stored->~Function();
+            };
+        }
+        else
+        {
+            new (job->payload) Function*(new Function(std::forward<F>(function)));
+            job->run = [](void* payload) {
+                auto* stored = *std::launder(static_cast<Function**>(payload));
+                (*stored)();
+                delete stored;
+            };
+        }
+
+        push(job);
+    }
+
+    template <typename F>
+    auto JobSystem::parallelFor(usize count, usize grainSize, F&& function) -> void
+    {
+        auto counter = JobCounter(0);
+        splitRange(0, count, std::max<usize>(grainSize, 1), function, counter);
+        wait(counter);
+    }
+
+    template <typename F>
+    auto JobSystem::parallelFor(usize count, usize grainSize, const F& function, JobCounter& counter) -> void
+    {
+        grainSize = std::max<usize>(grainSize, 1);
+        submit([this, count, grainSize, &function, &counter] { splitRange(0, count, grainSize, function, counter); }, counter);
+    }
+
+    template <typename F>
+    auto JobSystem::splitRange(usize begin, usize end, usize grainSize, const F& function, JobCounter& counter) -> void
+    {
+        // Keep the lower half and queue the upper one until the range is small enough, a thief steals the largest
+        // pending range first.
+        while (end - begin > grainSize)
+        {
+            const auto middle = begin + (end - begin) / 2;
+            submit([this, middle, end, grainSize, &function, &counter] { splitRange(middle, end, grainSize, function, counter); }, counter);
+            end = middle;
+        }
+
+        if (begin < end)
+        {
+            function(begin, end);
+        }
+    }
+}
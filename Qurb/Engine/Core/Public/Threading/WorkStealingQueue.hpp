@@ -0,0 +1,129 @@
+/// \file WorkStealingQueue.hpp
+
+#pragma once
+
+#include "CoreTypes.hpp"
+
+#include <atomic>
+#include <bit>
+#include <memory>
+
+namespace qurb
+{
+    /// \brief A bounded Chase-Lev deque of pointers.
+    ///
+    /// The owner thread pushes and pops at the bottom, in LIFO order, while any other thread steals from the top. Only
+    /// the owner may call `push` and `pop`, `steal` is safe from every thread.
+    ///
+    /// \tparam T The pointed type.
+    template <typename T>
+    class WorkStealingQueue final
+    {
+    public:
+        /// \brief Creates a queue holding up to `capacity` items, rounded up to a power of two.
+        explicit WorkStealingQueue(usize capacity);
+
+        WorkStealingQueue(const WorkStealingQueue&)                    = delete;
+        auto operator=(const WorkStealingQueue&) -> WorkStealingQueue& = delete;
+
+    public:
+        /// \brief Pushes `item` at the bottom, returns `false` when the queue is full. Owner only.
+        auto push(T* item) -> bool;
+
+        /// \brief Pops the most recently pushed item, or `nullptr` when the queue is empty. Owner only.
+        auto pop() -> T*;
+
+        /// \brief Takes the least recently pushed item, or `nullptr` when the queue is empty or another thread won the
+        /// race for it.
+        auto steal() -> T*;
+
+        [[nodiscard]] auto empty() const -> bool;
+
+    private:
+        // The owner and the thieves write different ends, keep them on different cache lines.
+        alignas(64) std::atomic<int64> _top    = 0;
+        alignas(64) std::atomic<int64> _bottom = 0;
+        alignas(64) usize _mask;
+        std::unique_ptr<std::atomic<T*>[]> _items;
+    };
+
+    //------------------------------------------------------------------------------------------------------------------
+    // class WorkStealingQueue
+    //------------------------------------------------------------------------------------------------------------------
+
+    template <typename T>
+    WorkStealingQueue<T>::WorkStealingQueue(usize capacity)
+        : _mask(std::bit_ceil(capacity) - 1)
+        , _items(std::make_unique<std::atomic<T*>[]>(_mask + 1))
+    {}
+
+    template <typename T>
+    auto WorkStealingQueue<T>::push(T* item) -> bool
+    {
+        const auto bottom = _bottom.load(std::memory_order_relaxed);
+        const auto top    = _top.load(std::memory_order_acquire);
+        if (static_cast<usize>(bottom - top) > _mask)
+        {
+            return false;
+        }
+
+        // The release store publishes the item, and what it points to, to the thieves reading `_bottom`.
+        _items[static_cast<usize>(bottom) & _mask].store(item, std::memory_order_relaxed);
+        _bottom.store(bottom + 1, std::memory_order_release);
+        return true;
+    }
+
+    template <typename T>
+    auto WorkStealingQueue<T>::pop() -> T*
+    {
+        // Reserve the bottom item first, a thief reading the old bottom afterwards races for it through `_top`.
+        const auto bottom = _bottom.load(std::memory_order_relaxed) - 1;
+        _bottom.store(bottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        auto top = _top.load(std::memory_order_relaxed);
+
+        if (top > bottom)
+        {
+            _bottom.store(bottom + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+
+        auto* item = _items[static_cast<usize>(bottom) & _mask].load(std::memory_order_relaxed);
+        if (top == bottom)
+        {
+            // The last item, the thieves may be taking it too.
+            if (not _top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            {
+                item = nullptr;
+            }
+            _bottom.store(bottom + 1, std::memory_order_relaxed);
+        }
+        return item;
+    }
+
+    template <typename T>
+    auto WorkStealingQueue<T>::steal() -> T*
+    {
+        auto top = _top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const auto bottom = _bottom.load(std::memory_order_acquire);
+
+        if (top >= bottom)
+        {
+            return nullptr;
+        }
+
+        auto* item = _items[static_cast<usize>(top) & _mask].load(std::memory_order_relaxed);
+        if (not _top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+        {
+            return nullptr;
+        }
+        return item;
+    }
+
+    template <typename T>
+    auto WorkStealingQueue<T>::empty() const -> bool
+    {
+        return _top.load(std::memory_order_relaxed) >= _bottom.load(std::memory_order_relaxed);
+    }
+}
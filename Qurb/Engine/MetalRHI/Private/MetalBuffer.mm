@@ -3,6 +3,9 @@
 #include <Debug/Ensure.hpp>
 #include <Log/Log.hpp>
 
+#include <cstddef>
+#include <cstring>
+
 namespace qurb::rhi::metal
 {
     Buffer::Buffer(Device* device, const BufferDescriptor& descriptor)
@@ -16,19 +19,21 @@ namespace qurb::rhi::metal
 
         ensure(_size > 0, "Cannot create a zero size Buffer.");
 
-        _cpuBuffer = ::operator new(_size);
-        if (descriptor.initialData != nullptr)
+        if (_usage == BufferUsage::Immutable)
         {
-            std::memcpy(_cpuBuffer, descriptor.initialData, _size);
+            ensure(descriptor.initialData != nullptr, "Immutable buffer requires initial data.");
         }
 
-        if (not _isSmallBuffer)
+        if (_isSmallBuffer)
         {
-            if (_usage == BufferUsage::Immutable)
+            _cpuBuffer = ::operator new(_size);
+            if (descriptor.initialData != nullptr)
             {
-                ensure(descriptor.initialData != nullptr, "Immutable buffer requires initial data.");
+                std::memcpy(_cpuBuffer, descriptor.initialData, _size);
             }
-
+        }
+        else
+        {
             MTLResourceOptions resourceOptions = MTLResourceStorageModeShared;
             if (descriptor.initialData != nullptr)
             {
@@ -48,11 +53,14 @@ namespace qurb::rhi::metal
             [_handle release];
         }
 
-        ::operator delete(_cpuBuffer, _size);
+        if (_cpuBuffer != nullptr)
+        {
+            ::operator delete(_cpuBuffer, _size);
+        }
         _device->release();
     }
 
-    auto Buffer::map() -> void*
+    auto Buffer::map(usize offset, usize size) -> void*
     {
         if (_usage == BufferUsage::Immutable)
         {
@@ -60,7 +68,10 @@ namespace qurb::rhi::metal
             return nullptr;
         }
 
-        return _cpuBuffer;
+        ensure(size <= _size and offset <= _size - size, "Mapped range out of the buffer.");
+
+        auto* data = _isSmallBuffer ? _cpuBuffer : [_handle contents];
+        return static_cast<std::byte*>(data) + offset;
     }
 
     auto Buffer::unmap() -> void
@@ -71,6 +82,17 @@ namespace qurb::rhi::metal
             return;
         }
 
-        std::memcpy([_handle contents], _cpuBuffer, _size);
+        // Shared storage is coherent, the writes to the mapped range are already visible to the GPU.
+    }
+
+    auto Buffer::flushRange(usize offset, usize size) -> void
+    {
+        if (_usage == BufferUsage::Immutable)
+        {
+            Log::warn("Cannot flush an immutable buffer");
+            return;
+        }
+
+        ensure(size <= _size and offset <= _size - size, "Flushed range out of the buffer.");
     }
 }
@@ -9,6 +9,7 @@
 #include "MetalTexture.hpp"
 
 #include <Debug/Ensure.hpp>
+#include <Log/Log.hpp>
 
 namespace qurb::rhi::metal
 {
@@ -17,6 +18,7 @@ namespace qurb::rhi::metal
         , _commandQueue(nil)
         , _colorBackBufferFormat(MTLPixelFormatBGRA8Unorm_sRGB)
         , _depthBackBufferFormat(MTLPixelFormatDepth32Float)
+        , _shaderCache(ShaderCache::defaultDirectory() / "Metal", shaderCacheVersion)
     {
         ensure(_handle != nil, "Failed to create system default device.");
 
@@ -26,6 +28,18 @@ namespace qurb::rhi::metal
 
     Device::~Device()
     {
+        const auto statistics = _shaderCache.statistics();
+        Log::info(
+            "Metal: Shader cache {}: {} hits loaded in {:.2f} ms, {} misses, {} rejected, {} stored",
+            _shaderCache.directory().string(),
+            statistics.hits,
+            statistics.loadMilliseconds,
+            statistics.misses,
+            statistics.rejected,
+            statistics.stores);
+
+        _pipelineCache.forEach([](id<MTLRenderPipelineState> renderPipelineState) { [renderPipelineState release]; });
+
         [_commandQueue release];
         [_handle release];
     }
@@ -18,7 +18,6 @@ namespace qurb::rhi::metal
         , _depthBiasClamp(0.0f)
         , _depthClipMode(MTLDepthClipModeClip)
         , _depthStencilState(nil)
-        , _renderPipelineState(nil)
     {
         _device->retain();
         // primitiveType_ =
@@ -58,20 +57,16 @@ namespace qurb::rhi::metal
     PipelineState::~PipelineState()
     {
         // [_depthStencilState release];
-        [_renderPipelineState release];
 
         _device->release();
     }
 
     auto PipelineState::bind(RenderTarget* renderTarget, id<MTLRenderCommandEncoder> renderCommandEncoder) -> void
     {
-        // renderPipelineStates_.try_emplace(renderTarget, createPipelineState(renderTarget));
-        // [renderCommandEncoder setRenderPipelineState:renderPipelineStates_[renderTarget]];
-
-        [_renderPipelineState release];
-
-        _renderPipelineState = createPipelineState(renderTarget);
-        [renderCommandEncoder setRenderPipelineState:_renderPipelineState];
+        // The cache owns the render pipeline states, they are released with the device.
+        const auto  key                 = PipelineKey {_descriptorHash, renderTarget->attachmentFormats()};
+        const auto& renderPipelineState = _device->pipelineCache().getOrCreate(key, [&] { return createPipelineState(renderTarget); });
+        [renderCommandEncoder setRenderPipelineState:renderPipelineState];
         // [renderCommandEncoder setDepthStencilState:_depthStencilState];
 
         // [renderCommandEncoder setStencilReferenceValue:stencilReference_];
@@ -124,9 +119,27 @@ namespace qurb::rhi::metal
             // rpd.stencilAttachmentPixelFormat = depthAttachment.format;
         }
 
-        NSError* error = nil;
+        // A warm start finds the GPU binaries in the archive of the program, only a miss compiles them and adds them.
+        if (shaderProgram->binaryArchive() != nil)
+        {
+            [rpd setBinaryArchives:@[shaderProgram->binaryArchive()]];
+        }
 
-        id<MTLRenderPipelineState> rps = [_device->handle() newRenderPipelineStateWithDescriptor:rpd error:&error];
+        NSError*                   error = nil;
+        id<MTLRenderPipelineState> rps   = nil;
+        if (shaderProgram->binaryArchiveLoaded())
+        {
+            rps = [_device->handle() newRenderPipelineStateWithDescriptor:rpd
+                                                                  options:MTLPipelineOptionFailOnBinaryArchiveMiss
+                                                               reflection:nil
+                                                                    error:&error];
+        }
+        if (rps == nil)
+        {
+            error = nil;
+            rps   = [_device->handle() newRenderPipelineStateWithDescriptor:rpd error:&error];
+            shaderProgram->addToBinaryArchive(rpd);
+        }
         [rpd release];
 
         ensure(error == nil, "Metal: Failed to create Render Pipeline State.");
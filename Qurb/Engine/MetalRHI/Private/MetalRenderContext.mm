@@ -100,7 +100,7 @@ namespace qurb::rhi::metal
         }
         else
         {
-            [_renderCommandEncoder setVertexBuffer:buffer->handle() offset:0 atIndex:slot];
+            [_renderCommandEncoder setVertexBuffer:buffer->handle() offset:offset atIndex:slot];
         }
     }
 
@@ -112,6 +112,19 @@ namespace qurb::rhi::metal
         [_renderCommandEncoder drawPrimitives:primitive vertexStart:firstVertex vertexCount:vertexCount];
     }
 
+    auto RenderContext::drawInstanced(uint32 vertexCount, uint32 firstVertex, uint32 instanceCount, uint32 firstInstance) -> void
+    {
+        ensure(_renderCommandEncoder != nil, "Render command encoder is nil.");
+
+        // `[[instance_id]]` includes the base instance.
+        const auto primitive = MTLPrimitiveTypeTriangle;
+        [_renderCommandEncoder drawPrimitives:primitive
+                                  vertexStart:firstVertex
+                                  vertexCount:vertexCount
+                                instanceCount:instanceCount
+                                 baseInstance:firstInstance];
+    }
+
     auto RenderContext::bindFragmentTexture(rhi::Texture* fragmentTexture, uint32 slot) -> void
     {
         ensure(_renderCommandEncoder != nil, "Render command encoder is nil.");
@@ -120,4 +133,14 @@ namespace qurb::rhi::metal
 
         [_renderCommandEncoder setFragmentTexture:texture->handle() atIndex:slot];
     }
+
+    auto RenderContext::executeCommandLists(std::span<const CommandList> commandLists) -> void
+    {
+        ensure(_renderCommandEncoder != nil, "Render command encoder is nil.");
+
+        for (const auto& commandList : commandLists)
+        {
+            commandList.forEach(CommandTranslator {*this});
+        }
+    }
 }
@@ -25,12 +25,14 @@ namespace qurb::rhi::metal
             _colorAttachments[0].texture = texture;
             _colorAttachments[0].format  = format;
         }
+        updateAttachmentFormats();
     }
 
     auto RenderTarget::setDepthTexture(id<MTLTexture> texture, MTLPixelFormat format) -> void
     {
         _depthAttachment.reset();
         _depthAttachment = Attachment(texture, format);
+        updateAttachmentFormats();
     }
 
     auto RenderTarget::renderPassDescriptor(const RenderPassDescriptor& descriptor) -> MTLRenderPassDescriptor*
@@ -56,4 +58,18 @@ namespace qurb::rhi::metal
 
         return renderPassDescriptor;
     }
+
+    auto RenderTarget::updateAttachmentFormats() -> void
+    {
+        _attachmentFormats            = AttachmentFormats();
+        _attachmentFormats.colorCount = static_cast<uint32>(_colorAttachments.size());
+        for (usize i = 0; i < _colorAttachments.size(); ++i)
+        {
+            _attachmentFormats.colors[i] = static_cast<uint32>(_colorAttachments[i].format);
+        }
+        if (_depthAttachment.has_value())
+        {
+            _attachmentFormats.depth = static_cast<uint32>(_depthAttachment->format);
+        }
+    }
 }
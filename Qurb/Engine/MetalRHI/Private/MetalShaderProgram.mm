@@ -1,7 +1,9 @@
 #include "MetalShaderProgram.hpp"
 
 #include <Debug/Ensure.hpp>
+#include <Log/Log.hpp>
 
+#include <chrono>
 #include <fstream>
 
 namespace qurb::rhi::metal
@@ -15,6 +17,9 @@ namespace qurb::rhi::metal
         , _vertexFunction(nil)
         , _fragmentFunction(nil)
         , _vertexDescriptor(nil)
+        , _binaryArchive(nil)
+        , _binaryArchiveLoaded(false)
+        , _binaryArchiveModified(false)
     {
         _device->retain();
 
@@ -24,6 +29,9 @@ namespace qurb::rhi::metal
 
     ShaderProgram::~ShaderProgram()
     {
+        storeBinaryArchive();
+
+        [_binaryArchive release];
         [_vertexDescriptor release];
         [_vertexFunction release];
         [_fragmentFunction release];
@@ -36,6 +44,7 @@ namespace qurb::rhi::metal
     {
         @autoreleasepool
         {
+            const auto    start          = std::chrono::steady_clock::now();
             const auto    shaderFileName = descriptor_.shaderName + ".metal";
             std::ifstream shaderFile(shaderFileName);
             ensure(shaderFile.is_open(), "Metal: Could not open shader file {}", shaderFileName);
@@ -45,6 +54,16 @@ namespace qurb::rhi::metal
             MTLCompileOptions* options = [MTLCompileOptions new];
             [options setLanguageVersion:MTLLanguageVersion3_2];
 
+            // GPU binaries are specific to the GPU and its driver, which come with the OS.
+            _cacheKey = ShaderCacheKeyHasher()
+                            .add(sourceCode)
+                            .add(static_cast<uint64>(MTLLanguageVersion3_2))
+                            .add(descriptor_.vertexFunctionName)
+                            .add(descriptor_.fragmentFunctionName)
+                            .add([[_device->handle() name] UTF8String])
+                            .add([[[NSProcessInfo processInfo] operatingSystemVersionString] UTF8String])
+                            .key();
+
             NSError*  error  = nil;
             NSString* source = [NSString stringWithCString:sourceCode.c_str() encoding:NSUTF8StringEncoding];
             _library         = [_device->handle() newLibraryWithSource:source options:options error:&error];
@@ -74,7 +93,102 @@ namespace qurb::rhi::metal
             }
 
             [options release];
+
+            loadBinaryArchive();
+
+            const auto elapsed = std::chrono::duration<float64, std::milli>(std::chrono::steady_clock::now() - start);
+            Log::info(
+                "Metal: Compiled {} in {:.2f} ms, {}",
+                descriptor_.shaderName,
+                elapsed.count(),
+                _binaryArchiveLoaded ? "pipeline binaries loaded from the shader cache" : "pipeline binaries not cached yet");
+        }
+    }
+
+    auto ShaderProgram::addToBinaryArchive(MTLRenderPipelineDescriptor* renderPipelineDescriptor) -> void
+    {
+        NSError* error = nil;
+        if ([_binaryArchive addRenderPipelineFunctionsWithDescriptor:renderPipelineDescriptor error:&error])
+        {
+            _binaryArchiveModified = true;
+        }
+    }
+
+    auto ShaderProgram::loadBinaryArchive() -> void
+    {
+        MTLBinaryArchiveDescriptor* archiveDescriptor = [MTLBinaryArchiveDescriptor new];
+
+        const auto archivePath = binaryArchivePath();
+        if (const auto artifact = _device->shaderCache().load(_cacheKey))
+        {
+            auto file = std::ofstream(archivePath, std::ios::binary | std::ios::trunc);
+            file.write(reinterpret_cast<const char*>(artifact->data()), static_cast<std::streamsize>(artifact->size()));
+            if (file.flush())
+            {
+                [archiveDescriptor setUrl:[NSURL fileURLWithPath:[NSString stringWithUTF8String:archivePath.c_str()]]];
+                _binaryArchiveLoaded = true;
+            }
+        }
+
+        NSError* error = nil;
+        _binaryArchive = [_device->handle() newBinaryArchiveWithDescriptor:archiveDescriptor error:&error];
+
+        // An archive Metal does not accept anymore is replaced by an empty one, stored again with this program.
+        if (_binaryArchive == nil and _binaryArchiveLoaded)
+        {
+            Log::warn("Metal: Discarding the cached binary archive of {}", descriptor_.shaderName);
+            [archiveDescriptor setUrl:nil];
+            _binaryArchive       = [_device->handle() newBinaryArchiveWithDescriptor:archiveDescriptor error:&error];
+            _binaryArchiveLoaded = false;
         }
+        [archiveDescriptor release];
+
+        auto removeError = std::error_code();
+        std::filesystem::remove(archivePath, removeError);
+    }
+
+    auto ShaderProgram::storeBinaryArchive() -> void
+    {
+        if (_binaryArchive == nil or not _binaryArchiveModified)
+        {
+            return;
+        }
+
+        @autoreleasepool
+        {
+            const auto archivePath = binaryArchivePath();
+
+            NSError* error = nil;
+            NSURL*   url   = [NSURL fileURLWithPath:[NSString stringWithUTF8String:archivePath.c_str()]];
+            if (not [_binaryArchive serializeToURL:url error:&error])
+            {
+                Log::warn("Metal: Could not serialize the binary archive of {}", descriptor_.shaderName);
+                return;
+            }
+
+            auto       sizeError = std::error_code();
+            const auto size      = std::filesystem::file_size(archivePath, sizeError);
+            if (not sizeError)
+            {
+                auto artifact = Vector<std::byte>();
+                artifact.resize(size);
+
+                auto file = std::ifstream(archivePath, std::ios::binary);
+                if (file.read(reinterpret_cast<char*>(artifact.data()), static_cast<std::streamsize>(artifact.size())))
+                {
+                    _device->shaderCache().store(_cacheKey, std::span<const std::byte>(artifact.data(), artifact.size()));
+                }
+            }
+
+            auto removeError = std::error_code();
+            std::filesystem::remove(archivePath, removeError);
+        }
+    }
+
+    auto ShaderProgram::binaryArchivePath() const -> std::filesystem::path
+    {
+        auto error = std::error_code();
+        return std::filesystem::temp_directory_path(error) / (_cacheKey.toString() + ".metallib");
     }
 
     auto ShaderProgram::createVertexDescriptor() -> void
@@ -11,6 +11,9 @@
 namespace qurb::rhi::metal
 {
     /// \brief The `Buffer` class.
+    ///
+    /// Its storage is shared with the GPU: maps return the Metal buffer contents, written in place without copies. Only
+    /// small buffers, set on the encoder by value, keep their bytes in CPU memory.
     class Buffer final : public rhi::Buffer
     {
     public:
@@ -21,8 +24,11 @@ namespace qurb::rhi::metal
         ~Buffer() override;
 
     public:
-        auto map() -> void* override;
+        using Base::map;
+
+        auto map(usize offset, usize size) -> void* override;
         auto unmap() -> void override;
+        auto flushRange(usize offset, usize size) -> void override;
 
         auto               handle() -> id<MTLBuffer>;
         [[nodiscard]] auto cpuBuffer() -> void*;
@@ -33,7 +39,7 @@ namespace qurb::rhi::metal
     private:
         Device*       _device;
         id<MTLBuffer> _handle;
-        void*         _cpuBuffer;
+        void*         _cpuBuffer;  // Small buffers only, which have no Metal buffer.
         bool          _isSmallBuffer;
     };
 
@@ -3,6 +3,8 @@
 #pragma once
 
 #include <RHI/Device.hpp>
+#include <RHI/PipelineCache.hpp>
+#include <RHI/ShaderCache.hpp>
 
 #import <Metal/Metal.h>
 
@@ -14,6 +16,9 @@ namespace qurb::rhi::metal
     public:
         using base = rhi::Device;
 
+        /// \brief The version of the binary archives in the shader cache, bumped when what they hold changes.
+        static constexpr auto shaderCacheVersion = uint32(1);
+
     public:
         Device();
         ~Device() override;
@@ -33,11 +38,19 @@ namespace qurb::rhi::metal
         [[nodiscard]] auto colorBackBufferFormat() const -> MTLPixelFormat;
         [[nodiscard]] auto depthBackBufferFormat() const -> MTLPixelFormat;
 
+        /// \brief The render pipeline states built by the pipeline states, per descriptor and attachment formats.
+        [[nodiscard]] auto pipelineCache() -> PipelineCache<id<MTLRenderPipelineState>>&;
+
+        /// \brief The binary archives of the shader programs, kept on disk across launches.
+        [[nodiscard]] auto shaderCache() -> ShaderCache&;
+
     private:
-        id<MTLDevice>       _handle;
-        id<MTLCommandQueue> _commandQueue;
-        MTLPixelFormat      _colorBackBufferFormat;
-        MTLPixelFormat      _depthBackBufferFormat;
+        id<MTLDevice>                             _handle;
+        id<MTLCommandQueue>                       _commandQueue;
+        MTLPixelFormat                            _colorBackBufferFormat;
+        MTLPixelFormat                            _depthBackBufferFormat;
+        PipelineCache<id<MTLRenderPipelineState>> _pipelineCache;
+        ShaderCache                               _shaderCache;
     };
 
     inline auto Device::handle() -> id<MTLDevice>
@@ -59,4 +72,14 @@ namespace qurb::rhi::metal
     {
         return _depthBackBufferFormat;
     }
+
+    inline auto Device::pipelineCache() -> PipelineCache<id<MTLRenderPipelineState>>&
+    {
+        return _pipelineCache;
+    }
+
+    inline auto Device::shaderCache() -> ShaderCache&
+    {
+        return _shaderCache;
+    }
 }
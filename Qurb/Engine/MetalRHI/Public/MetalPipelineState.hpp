@@ -11,8 +11,6 @@
 
 #import <Metal/Metal.h>
 
-#include <unordered_map>
-
 namespace qurb::rhi::metal
 {
     class PipelineState final : public rhi::PipelineState
@@ -25,7 +23,8 @@ namespace qurb::rhi::metal
         ~PipelineState() override;
 
     public:
-        // FIXME: Create infinite entries.
+        /// \brief Sets the render pipeline state for `renderTarget`, built on the first bind with its attachment formats
+        /// and shared through the pipeline cache of the device.
         auto bind(RenderTarget* renderTarget, id<MTLRenderCommandEncoder> renderCommandEncoder) -> void;
 
     private:
@@ -60,8 +59,6 @@ namespace qurb::rhi::metal
         float32          _depthBiasClamp;
         MTLDepthClipMode _depthClipMode;
 
-        id<MTLDepthStencilState>   _depthStencilState;
-        id<MTLRenderPipelineState> _renderPipelineState;
-        // std::unordered_map<MetalRenderTarget*, id<MTLRenderPipelineState>> _renderPipelineStates;
+        id<MTLDepthStencilState> _depthStencilState;
     };
 }
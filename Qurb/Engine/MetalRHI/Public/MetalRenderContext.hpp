@@ -45,6 +45,10 @@ namespace qurb::rhi::metal
 
         auto draw(uint32 vertexCount, uint32 firstVertex) -> void override;
 
+        auto drawInstanced(uint32 vertexCount, uint32 firstVertex, uint32 instanceCount, uint32 firstInstance) -> void override;
+
+        auto executeCommandLists(std::span<const CommandList> commandLists) -> void override;
+
     private:
         Device*                     _device;
         SwapChain*                  _swapChain;
@@ -5,6 +5,7 @@
 #include "MetalDevice.hpp"
 
 #include <Containers/Vector.hpp>
+#include <RHI/PipelineCache.hpp>
 #include <RHI/RenderTarget.hpp>
 
 #import <Metal/Metal.h>
@@ -27,6 +28,9 @@ namespace qurb::rhi::metal
         auto setDepthTexture(id<MTLTexture> texture, MTLPixelFormat format) -> void;
         auto renderPassDescriptor(const RenderPassDescriptor& descriptor) -> MTLRenderPassDescriptor*;
 
+        /// \brief The pixel formats of the attachments, part of the key of the pipelines rendering to them.
+        [[nodiscard]] auto attachmentFormats() const -> const AttachmentFormats&;
+
     private:
         friend class PipelineState;
 
@@ -39,9 +43,18 @@ namespace qurb::rhi::metal
             ~Attachment() { [texture release]; }
         };
 
+    private:
+        auto updateAttachmentFormats() -> void;
+
     private:
         Device*                   _device;
         Vector<Attachment>        _colorAttachments;
         std::optional<Attachment> _depthAttachment;
+        AttachmentFormats         _attachmentFormats;
     };
+
+    inline auto RenderTarget::attachmentFormats() const -> const AttachmentFormats&
+    {
+        return _attachmentFormats;
+    }
 }
@@ -2,8 +2,11 @@
 
 #include "MetalDevice.hpp"
 
+#include <RHI/ShaderCache.hpp>
 #include <RHI/ShaderProgram.hpp>
 
+#include <filesystem>
+
 #import <Metal/Metal.h>
 
 namespace qurb::rhi::metal
@@ -22,16 +25,35 @@ namespace qurb::rhi::metal
         auto fragmentFunction() const -> id<MTLFunction>;
         auto vertexDescriptor() const -> MTLVertexDescriptor*;
 
+        /// \brief The GPU binaries of the pipelines built with this program, loaded from the shader cache of the device.
+        auto binaryArchive() const -> id<MTLBinaryArchive>;
+
+        /// \brief Whether `binaryArchive` came from the shader cache, so that pipelines may be looked up in it first.
+        auto binaryArchiveLoaded() const -> bool;
+
+        /// \brief Adds the GPU binaries of a pipeline compiled without the archive, stored with the program's destruction.
+        auto addToBinaryArchive(MTLRenderPipelineDescriptor* renderPipelineDescriptor) -> void;
+
     private:
         auto compile() -> void;
         auto createVertexDescriptor() -> void;
 
+        auto loadBinaryArchive() -> void;
+        auto storeBinaryArchive() -> void;
+
+        /// \brief Where the archive is handed to and from Metal, which only reads and writes archives as files.
+        auto binaryArchivePath() const -> std::filesystem::path;
+
     private:
         Device*              _device;
         id<MTLLibrary>       _library;
         id<MTLFunction>      _vertexFunction;
         id<MTLFunction>      _fragmentFunction;
         MTLVertexDescriptor* _vertexDescriptor;
+        ShaderCacheKey       _cacheKey;
+        id<MTLBinaryArchive> _binaryArchive;
+        bool                 _binaryArchiveLoaded;
+        bool                 _binaryArchiveModified;
     };
 
     inline auto ShaderProgram::vertexFunction() const -> id<MTLFunction>
@@ -48,4 +70,14 @@ namespace qurb::rhi::metal
     {
         return _vertexDescriptor;
     }
+
+    inline auto ShaderProgram::binaryArchive() const -> id<MTLBinaryArchive>
+    {
+        return _binaryArchive;
+    }
+
+    inline auto ShaderProgram::binaryArchiveLoaded() const -> bool
+    {
+        return _binaryArchiveLoaded;
+    }
 }
@@ -0,0 +1,46 @@
+-- Qurb.NullRHI
+
+project "NullRHI"
+    kind "SharedLib"
+    language "C++"
+    cppdialect "C++23"
+
+    targetname "QurbNullRHI"
+    targetdir "%{wks.location}/Binaries/%{cfg.buildcfg}"
+    objdir "%{wks.location}/Binaries/Intermediate/%{cfg.buildcfg}"
+
+    files {
+        "Public/**.cpp",
+        "Public/**.hpp",
+        "Private/**.cpp",
+        "Private/**.hpp",
+    }
+
+    defines {
+        "QURB_NULL_RHI_EXPORT"
+    }
+
+    links {
+        "Core",
+        "Runtime",
+    }
+
+    includedirs {
+        "Public",
+        "Private",
+
+        include_dirs["Engine.Core"],
+        include_dirs["Engine.Runtime"],
+    }
+
+    filter { "configurations:Debug" }
+        runtime "Debug"
+        optimize "Off"
+        symbols "On"
+    filter {}
+
+    filter { "configurations:Release" }
+        runtime "Release"
+        optimize "On"
+        symbols "Off"
+    filter {}
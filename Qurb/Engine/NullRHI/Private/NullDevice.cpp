@@ -0,0 +1,126 @@
+#include "NullDevice.hpp"
+
+#include "NullBuffer.hpp"
+#include "NullPipelineState.hpp"
+#include "NullRenderContext.hpp"
+#include "NullRenderTarget.hpp"
+#include "NullShaderProgram.hpp"
+#include "NullSwapChain.hpp"
+#include "NullTexture.hpp"
+
+namespace qurb::rhi::null
+{
+    namespace
+    {
+        /// \brief The size of a texel of `format` in bytes.
+        constexpr auto texelSize(TextureFormat format) -> usize
+        {
+            switch (format)
+            {
+                using enum TextureFormat;
+
+                case R8Unorm:
+                case R8Snorm:
+                case R8Uint:
+                case R8Sint:          return 1;
+
+                case RG8Unorm:
+                case RG8Snorm:
+                case RG8Uint:
+                case RG8Sint:
+                case R16Unorm:
+                case R16Snorm:
+                case R16Uint:
+                case R16Sint:
+                case R16Float:
+                case D16Unorm:        return 2;
+
+                case RGBA16Unorm:
+                case RGBA16Snorm:
+                case RGBA16Uint:
+                case RGBA16Sint:
+                case RGBA16Float:
+                case RG32Uint:
+                case RG32Sint:
+                case RG32Float:
+                case D32Float_S8Uint: return 8;
+
+                case RGBA32Uint:
+                case RGBA32Sint:
+                case RGBA32Float:     return 16;
+
+                case Unknown:         return 0;
+
+                // The RGBA8 formats, the 32-bit single channel ones and the other depth formats.
+                default:              return 4;
+            }
+        }
+    }
+
+    auto Device::createRenderContext(const RenderContextDescriptor& descriptor) -> rhi::RenderContext*
+    {
+        _renderContextsCreated.fetch_add(1, std::memory_order_relaxed);
+        return new RenderContext(this, descriptor);
+    }
+
+    auto Device::createBuffer(const BufferDescriptor& descriptor) -> rhi::Buffer*
+    {
+        _buffersCreated.fetch_add(1, std::memory_order_relaxed);
+        _bufferBytesAllocated.fetch_add(descriptor.bufferSize, std::memory_order_relaxed);
+        return new Buffer(this, descriptor);
+    }
+
+    auto Device::createRenderTarget(const RenderTargetDescriptor&) -> rhi::RenderTarget*
+    {
+        _renderTargetsCreated.fetch_add(1, std::memory_order_relaxed);
+        return new RenderTarget();
+    }
+
+    auto Device::createSwapChain(const SwapChainDescriptor& descriptor) -> rhi::SwapChain*
+    {
+        _swapChainsCreated.fetch_add(1, std::memory_order_relaxed);
+        return new SwapChain(descriptor);
+    }
+
+    auto Device::createShaderProgram(const ShaderProgramDescriptor& descriptor) -> rhi::ShaderProgram*
+    {
+        _shaderProgramsCreated.fetch_add(1, std::memory_order_relaxed);
+        return new ShaderProgram(descriptor);
+    }
+
+    auto Device::createPipelineState(const PipelineStateDescriptor& descriptor) -> rhi::PipelineState*
+    {
+        _pipelineStatesCreated.fetch_add(1, std::memory_order_relaxed);
+        return new PipelineState(descriptor);
+    }
+
+    auto Device::createTexture(const TextureDescriptor& descriptor) -> rhi::Texture*
+    {
+        _texturesCreated.fetch_add(1, std::memory_order_relaxed);
+        if (descriptor.data != nullptr)
+        {
+            recordUpload(static_cast<usize>(descriptor.width) * descriptor.height * texelSize(descriptor.format));
+        }
+        return new Texture(descriptor);
+    }
+
+    auto Device::resetStatistics() -> void
+    {
+        for (auto* counter : {
+                 &_renderContextsCreated,
+                 &_buffersCreated,
+                 &_renderTargetsCreated,
+                 &_swapChainsCreated,
+                 &_shaderProgramsCreated,
+                 &_pipelineStatesCreated,
+                 &_texturesCreated,
+                 &_bufferBytesAllocated,
+                 &_bufferMaps,
+                 &_bytesUploaded,
+                 &_bytesFlushed,
+             })
+        {
+            counter->store(0, std::memory_order_relaxed);
+        }
+    }
+}
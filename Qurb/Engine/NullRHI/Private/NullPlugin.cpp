@@ -0,0 +1,11 @@
+#include "NullPlugin.hpp"
+
+using namespace qurb;
+
+extern "C"
+{
+    QURB_NULL_RHI_API auto createPlugin(DynamicLibrary* library) -> Plugin*
+    {
+        return new rhi::null::Plugin(std::move(*library));
+    }
+}
@@ -0,0 +1,11 @@
+#include "NullRenderBackend.hpp"
+
+#include "NullDevice.hpp"
+
+namespace qurb::rhi::null
+{
+    auto RenderBackend::createDevice() const -> rhi::Device*
+    {
+        return new Device();
+    }
+}
@@ -0,0 +1,124 @@
+#include "NullRenderContext.hpp"
+
+#include <Debug/Ensure.hpp>
+
+namespace qurb::rhi::null
+{
+    RenderContext::RenderContext(Device* device, const RenderContextDescriptor& descriptor)
+        : base(descriptor)
+        , _device(device)
+        , _swapChain(new SwapChain(descriptor.swapChainDescriptor))
+        , _renderTarget(nullptr)
+        , _inFrame(false)
+        , _inRenderPass(false)
+        , _statistics()
+    {
+        _device->retain();
+    }
+
+    RenderContext::~RenderContext()
+    {
+        _swapChain->release();
+        _device->release();
+    }
+
+    auto RenderContext::beginFrame() -> void
+    {
+        ensure(not _inFrame, "Frame already begun.");
+
+        _inFrame = true;
+    }
+
+    auto RenderContext::endFrame() -> void
+    {
+        ensure(_inFrame, "Frame not begun.");
+
+        _inFrame = false;
+        ++_statistics.frames;
+    }
+
+    auto RenderContext::present() -> void
+    {}
+
+    auto RenderContext::beginRenderPass(rhi::RenderTarget* renderTarget, const RenderPassDescriptor&) -> void
+    {
+        ensure(_inFrame, "Render pass outside of a frame.");
+        ensure(not _inRenderPass, "Render pass already begun.");
+        ensure(renderTarget != nullptr, "Render pass without a render target.");
+
+        _renderTarget = static_cast<RenderTarget*>(renderTarget);
+        _inRenderPass = true;
+        ++_statistics.renderPasses;
+    }
+
+    auto RenderContext::endRenderPass() -> void
+    {
+        ensure(_inRenderPass, "Render pass not begun.");
+
+        _renderTarget = nullptr;
+        _inRenderPass = false;
+    }
+
+    auto RenderContext::pushConstants(const void*, usize size) -> void
+    {
+        ensure(_inRenderPass, "Push constants outside of a render pass.");
+
+        _statistics.pushConstantBytes += size;
+    }
+
+    auto RenderContext::bindPipelineState(rhi::PipelineState* pipelineState) -> void
+    {
+        ensure(_inRenderPass, "Binding a pipeline state outside of a render pass.");
+        ensure(pipelineState != nullptr, "Binding a null pipeline state.");
+
+        const auto key = PipelineKey {pipelineState->descriptorHash(), _renderTarget->attachmentFormats()};
+        _device->pipelineCache().getOrCreate(key, [&] { return key.descriptorHash; });
+        ++_statistics.pipelineBinds;
+    }
+
+    auto RenderContext::bindVertexBuffer(rhi::Buffer* vertexBuffer, uint32, uint32) -> void
+    {
+        ensure(_inRenderPass, "Binding a vertex buffer outside of a render pass.");
+        ensure(vertexBuffer->type() == BufferType::Vertex, "Binding wrong buffer type.");
+
+        ++_statistics.vertexBufferBinds;
+    }
+
+    auto RenderContext::bindFragmentTexture(rhi::Texture* texture, uint32) -> void
+    {
+        ensure(_inRenderPass, "Binding a texture outside of a render pass.");
+        ensure(texture != nullptr, "Binding a null texture.");
+
+        ++_statistics.textureBinds;
+    }
+
+    auto RenderContext::draw(uint32 vertexCount, uint32) -> void
+    {
+        ensure(_inRenderPass, "Drawing outside of a render pass.");
+
+        ++_statistics.drawCalls;
+        _statistics.verticesDrawn += vertexCount;
+    }
+
+    auto RenderContext::drawInstanced(uint32 vertexCount, uint32, uint32 instanceCount, uint32) -> void
+    {
+        ensure(_inRenderPass, "Drawing outside of a render pass.");
+
+        ++_statistics.drawCalls;
+        ++_statistics.instancedDrawCalls;
+        _statistics.instancesDrawn += instanceCount;
+        _statistics.verticesDrawn += static_cast<uint64>(vertexCount) * instanceCount;
+    }
+
+    auto RenderContext::executeCommandLists(std::span<const CommandList> commandLists) -> void
+    {
+        ensure(_inRenderPass, "Executing command lists outside of a render pass.");
+
+        _statistics.commandListsExecuted += commandLists.size();
+
+        for (const auto& commandList : commandLists)
+        {
+            commandList.forEach(CommandTranslator {*this});
+        }
+    }
+}
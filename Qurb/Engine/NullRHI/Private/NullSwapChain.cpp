@@ -0,0 +1,19 @@
+#include "NullSwapChain.hpp"
+
+namespace qurb::rhi::null
+{
+    SwapChain::SwapChain(const SwapChainDescriptor& descriptor)
+        : base(descriptor)
+        , _renderTarget(new RenderTarget())
+    {}
+
+    SwapChain::~SwapChain()
+    {
+        _renderTarget->release();
+    }
+
+    auto SwapChain::nextRenderTarget() -> rhi::RenderTarget*
+    {
+        return _renderTarget;
+    }
+}
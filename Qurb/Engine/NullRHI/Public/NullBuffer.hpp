@@ -0,0 +1,45 @@
+/// \file NullBuffer.hpp
+
+#pragma once
+
+#include "NullDevice.hpp"
+#include "NullRHI.hpp"
+
+#include <RHI/Buffer.hpp>
+
+namespace qurb::rhi::null
+{
+    /// \brief A buffer living in CPU memory only. `unmap` counts the mapped range as uploaded and `flushRange` the flushed
+    /// one, like a backend making them visible to the GPU would. Persistent buffers are written in place, their maps
+    /// count nothing.
+    class QURB_NULL_RHI_API Buffer final : public rhi::Buffer
+    {
+    public:
+        using base = rhi::Buffer;
+
+    public:
+        Buffer(Device* device, const BufferDescriptor& descriptor);
+        ~Buffer() override;
+
+    public:
+        using base::map;
+
+        auto map(usize offset, usize size) -> void* override;
+        auto unmap() -> void override;
+        auto flushRange(usize offset, usize size) -> void override;
+
+        [[nodiscard]] auto data() const -> const void*;
+
+    private:
+        Device* _device;
+        void*   _data;
+        bool    _mapped;
+        usize   _mappedOffset;
+        usize   _mappedSize;
+    };
+
+    inline auto Buffer::data() const -> const void*
+    {
+        return _data;
+    }
+}
@@ -0,0 +1,121 @@
+/// \file NullDevice.hpp
+
+#pragma once
+
+#include "NullRHI.hpp"
+
+#include <RHI/Device.hpp>
+#include <RHI/PipelineCache.hpp>
+
+#include <atomic>
+
+namespace qurb::rhi::null
+{
+    /// \brief What a `Device` was asked to create and upload since its statistics were last reset.
+    struct DeviceStatistics
+    {
+        uint64 renderContextsCreated = 0;
+        uint64 buffersCreated        = 0;
+        uint64 renderTargetsCreated  = 0;
+        uint64 swapChainsCreated     = 0;
+        uint64 shaderProgramsCreated = 0;
+        uint64 pipelineStatesCreated = 0;
+        uint64 texturesCreated       = 0;
+        uint64 bufferBytesAllocated  = 0;
+        uint64 bufferMaps            = 0;
+        uint64 bytesUploaded         = 0;  // Initial data of buffers and textures, and mapped ranges on `unmap`.
+        uint64 bytesFlushed          = 0;  // Ranges of buffers flushed with `flushRange`.
+    };
+
+    /// \brief A device doing no GPU work. Its objects keep the CPU side of the contract, buffers keep their contents,
+    /// and every creation and upload is counted.
+    ///
+    /// The counters may be updated from several threads, like the render thread uploading a frame while the main thread
+    /// creates resources.
+    class QURB_NULL_RHI_API Device final : public rhi::Device
+    {
+    public:
+        using base = rhi::Device;
+
+    public:
+        Device()           = default;
+        ~Device() override = default;
+
+    public:
+        auto createRenderContext(const RenderContextDescriptor& descriptor) -> rhi::RenderContext* override;
+        auto createBuffer(const BufferDescriptor& descriptor) -> rhi::Buffer* override;
+        auto createRenderTarget(const RenderTargetDescriptor& descriptor) -> rhi::RenderTarget* override;
+        auto createSwapChain(const SwapChainDescriptor& descriptor) -> rhi::SwapChain* override;
+        auto createShaderProgram(const ShaderProgramDescriptor& descriptor) -> rhi::ShaderProgram* override;
+        auto createPipelineState(const PipelineStateDescriptor& descriptor) -> rhi::PipelineState* override;
+        auto createTexture(const TextureDescriptor& descriptor) -> rhi::Texture* override;
+
+        /// \brief A snapshot of the counters.
+        [[nodiscard]] auto statistics() const -> DeviceStatistics;
+        auto               resetStatistics() -> void;
+
+        auto recordMap() -> void;
+        auto recordUpload(usize size) -> void;
+        auto recordFlush(usize size) -> void;
+
+        /// \brief The backend pipelines built at bind time, one per pipeline state descriptor and attachment formats. The
+        /// null backend builds nothing, an entry holds the descriptor hash.
+        [[nodiscard]] auto pipelineCache() -> PipelineCache<uint64>&;
+
+    private:
+        using Counter = std::atomic<uint64>;
+
+    private:
+        Counter _renderContextsCreated = 0;
+        Counter _buffersCreated        = 0;
+        Counter _renderTargetsCreated  = 0;
+        Counter _swapChainsCreated     = 0;
+        Counter _shaderProgramsCreated = 0;
+        Counter _pipelineStatesCreated = 0;
+        Counter _texturesCreated       = 0;
+        Counter _bufferBytesAllocated  = 0;
+        Counter _bufferMaps            = 0;
+        Counter _bytesUploaded         = 0;
+        Counter _bytesFlushed          = 0;
+
+        PipelineCache<uint64> _pipelineCache;
+    };
+
+    inline auto Device::statistics() const -> DeviceStatistics
+    {
+        constexpr auto order = std::memory_order_relaxed;
+        return DeviceStatistics {
+            .renderContextsCreated = _renderContextsCreated.load(order),
+            .buffersCreated        = _buffersCreated.load(order),
+            .renderTargetsCreated  = _renderTargetsCreated.load(order),
+            .swapChainsCreated     = _swapChainsCreated.load(order),
+            .shaderProgramsCreated = _shaderProgramsCreated.load(order),
+            .pipelineStatesCreated = _pipelineStatesCreated.load(order),
+            .texturesCreated       = _texturesCreated.load(order),
+            .bufferBytesAllocated  = _bufferBytesAllocated.load(order),
+            .bufferMaps            = _bufferMaps.load(order),
+            .bytesUploaded         = _bytesUploaded.load(order),
+            .bytesFlushed          = _bytesFlushed.load(order),
+        };
+    }
+
+    inline auto Device::recordMap() -> void
+    {
+        _bufferMaps.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    inline auto Device::recordUpload(usize size) -> void
+    {
+        _bytesUploaded.fetch_add(size, std::memory_order_relaxed);
+    }
+
+    inline auto Device::recordFlush(usize size) -> void
+    {
+        _bytesFlushed.fetch_add(size, std::memory_order_relaxed);
+    }
+
+    inline auto Device::pipelineCache() -> PipelineCache<uint64>&
+    {
+        return _pipelineCache;
+    }
+}
@@ -0,0 +1,25 @@
+/// \file NullPipelineState.hpp
+
+#pragma once
+
+#include "NullRHI.hpp"
+
+#include <RHI/PipelineState.hpp>
+
+namespace qurb::rhi::null
+{
+    /// \brief A pipeline state creating nothing, it only keeps its descriptor.
+    class QURB_NULL_RHI_API PipelineState final : public rhi::PipelineState
+    {
+    public:
+        using base = rhi::PipelineState;
+
+    public:
+        explicit PipelineState(const PipelineStateDescriptor& descriptor);
+        ~PipelineState() override = default;
+    };
+
+    inline PipelineState::PipelineState(const PipelineStateDescriptor& descriptor)
+        : base(descriptor)
+    {}
+}
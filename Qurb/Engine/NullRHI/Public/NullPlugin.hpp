@@ -0,0 +1,53 @@
+/// \file NullPlugin.hpp
+
+#pragma once
+
+#include "NullRenderBackend.hpp"
+#include "NullRHI.hpp"
+
+#include <RHI/Plugin.hpp>
+
+namespace qurb::rhi::null
+{
+    /// \brief The `Plugin` class.
+    class QURB_NULL_RHI_API Plugin final : public rhi::Plugin
+    {
+    public:
+        using base = rhi::Plugin;
+
+    public:
+        explicit Plugin(DynamicLibrary&& library);
+        ~Plugin() override = default;
+
+    public:
+        auto name() const -> std::string_view override;
+        auto description() const -> std::string_view override;
+        auto version() const -> std::string_view override;
+
+        auto createRenderBackend() const -> rhi::RenderBackend* override;
+    };
+
+    inline Plugin::Plugin(DynamicLibrary&& library)
+        : base(std::move(library))
+    {}
+
+    inline auto Plugin::name() const -> std::string_view
+    {
+        return "Qurb Render Hardware Interface - Null";
+    }
+
+    inline auto Plugin::description() const -> std::string_view
+    {
+        return "Executes no GPU work and counts the calls it receives, for headless runs and benchmarks.";
+    }
+
+    inline auto Plugin::version() const -> std::string_view
+    {
+        return "0.1";
+    }
+
+    inline auto Plugin::createRenderBackend() const -> rhi::RenderBackend*
+    {
+        return new RenderBackend();
+    }
+}
@@ -0,0 +1,9 @@
+/// \file NullRHI.hpp
+
+#pragma once
+
+#ifdef QURB_NULL_RHI_EXPORT
+    #define QURB_NULL_RHI_API __attribute__((visibility("default")))
+#else
+    #define QURB_NULL_RHI_API
+#endif
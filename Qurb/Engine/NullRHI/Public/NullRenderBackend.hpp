@@ -0,0 +1,30 @@
+/// \file NullRenderBackend.hpp
+
+#pragma once
+
+#include "NullRHI.hpp"
+
+#include <RHI/RenderBackend.hpp>
+
+namespace qurb::rhi::null
+{
+    /// \brief The `RenderBackend` class.
+    class QURB_NULL_RHI_API RenderBackend final : public rhi::RenderBackend
+    {
+    public:
+        using base = rhi::RenderBackend;
+
+    public:
+        RenderBackend()           = default;
+        ~RenderBackend() override = default;
+
+    public:
+        auto type() const -> RenderBackendType override;
+        auto createDevice() const -> rhi::Device* override;
+    };
+
+    inline auto RenderBackend::type() const -> RenderBackendType
+    {
+        return RenderBackendType::Null;
+    }
+}
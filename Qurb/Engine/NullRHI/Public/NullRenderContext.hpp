@@ -0,0 +1,91 @@
+/// \file NullRenderContext.hpp
+
+#pragma once
+
+#include "NullDevice.hpp"
+#include "NullRHI.hpp"
+#include "NullSwapChain.hpp"
+
+#include <RHI/RenderContext.hpp>
+
+namespace qurb::rhi::null
+{
+    /// \brief What a `RenderContext` was asked to do since its statistics were last reset.
+    struct RenderContextStatistics
+    {
+        uint64 frames               = 0;
+        uint64 renderPasses         = 0;
+        uint64 commandListsExecuted = 0;
+        uint64 drawCalls            = 0;  // `draw` and `drawInstanced` calls, recorded in command lists or not.
+        uint64 instancedDrawCalls   = 0;
+        uint64 instancesDrawn       = 0;
+        uint64 verticesDrawn        = 0;  // Summed over the instances.
+        uint64 pipelineBinds        = 0;
+        uint64 vertexBufferBinds    = 0;
+        uint64 textureBinds         = 0;
+        uint64 pushConstantBytes    = 0;
+    };
+
+    /// \brief A render context executing nothing, it only counts the commands it receives. Binding a pipeline state looks
+    /// up the pipeline of the render target in the pipeline cache of the device, like a GPU backend would.
+    class QURB_NULL_RHI_API RenderContext final : public rhi::RenderContext
+    {
+    public:
+        using base = rhi::RenderContext;
+
+    public:
+        RenderContext(Device* device, const RenderContextDescriptor& descriptor);
+        ~RenderContext() override;
+
+    public:
+        auto swapChain() -> rhi::SwapChain* override;
+
+        auto beginFrame() -> void override;
+        auto endFrame() -> void override;
+
+        auto present() -> void override;
+
+        auto beginRenderPass(rhi::RenderTarget* renderTarget, const RenderPassDescriptor& descriptor) -> void override;
+        auto endRenderPass() -> void override;
+
+        auto pushConstants(const void* data, usize size) -> void override;
+
+        auto bindPipelineState(rhi::PipelineState* pipelineState) -> void override;
+
+        auto bindVertexBuffer(rhi::Buffer* vertexBuffer, uint32 slot, uint32 offset) -> void override;
+
+        auto bindFragmentTexture(rhi::Texture* texture, uint32 slot) -> void override;
+
+        auto draw(uint32 vertexCount, uint32 firstVertex) -> void override;
+
+        auto drawInstanced(uint32 vertexCount, uint32 firstVertex, uint32 instanceCount, uint32 firstInstance) -> void override;
+
+        auto executeCommandLists(std::span<const CommandList> commandLists) -> void override;
+
+        [[nodiscard]] auto statistics() const -> const RenderContextStatistics&;
+        auto               resetStatistics() -> void;
+
+    private:
+        Device*                 _device;
+        SwapChain*              _swapChain;
+        RenderTarget*           _renderTarget;  // Of the current render pass.
+        bool                    _inFrame;
+        bool                    _inRenderPass;
+        RenderContextStatistics _statistics;
+    };
+
+    inline auto RenderContext::swapChain() -> rhi::SwapChain*
+    {
+        return _swapChain;
+    }
+
+    inline auto RenderContext::statistics() const -> const RenderContextStatistics&
+    {
+        return _statistics;
+    }
+
+    inline auto RenderContext::resetStatistics() -> void
+    {
+        _statistics = RenderContextStatistics();
+    }
+}
@@ -0,0 +1,36 @@
+/// \file NullRenderTarget.hpp
+
+#pragma once
+
+#include "NullRHI.hpp"
+
+#include <RHI/PipelineCache.hpp>
+#include <RHI/RenderTarget.hpp>
+#include <RHI/TextureFormat.hpp>
+
+namespace qurb::rhi::null
+{
+    /// \brief A render target without attachments. Pipelines see the formats of a swap chain back buffer.
+    class QURB_NULL_RHI_API RenderTarget final : public rhi::RenderTarget
+    {
+    public:
+        using base = rhi::RenderTarget;
+
+    public:
+        RenderTarget()           = default;
+        ~RenderTarget() override = default;
+
+    public:
+        [[nodiscard]] auto attachmentFormats() const -> const AttachmentFormats&;
+    };
+
+    inline auto RenderTarget::attachmentFormats() const -> const AttachmentFormats&
+    {
+        static const auto formats = AttachmentFormats {
+            .colors     = {static_cast<uint32>(TextureFormat::BGRA8Unorm)},
+            .colorCount = 1,
+            .depth      = static_cast<uint32>(TextureFormat::D32Float),
+        };
+        return formats;
+    }
+}
@@ -0,0 +1,25 @@
+/// \file NullShaderProgram.hpp
+
+#pragma once
+
+#include "NullRHI.hpp"
+
+#include <RHI/ShaderProgram.hpp>
+
+namespace qurb::rhi::null
+{
+    /// \brief A shader program compiling nothing, it only keeps its descriptor.
+    class QURB_NULL_RHI_API ShaderProgram final : public rhi::ShaderProgram
+    {
+    public:
+        using base = rhi::ShaderProgram;
+
+    public:
+        explicit ShaderProgram(const ShaderProgramDescriptor& descriptor);
+        ~ShaderProgram() override = default;
+    };
+
+    inline ShaderProgram::ShaderProgram(const ShaderProgramDescriptor& descriptor)
+        : base(descriptor)
+    {}
+}
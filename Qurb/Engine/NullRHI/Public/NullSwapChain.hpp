@@ -0,0 +1,28 @@
+/// \file NullSwapChain.hpp
+
+#pragma once
+
+#include "NullRenderTarget.hpp"
+#include "NullRHI.hpp"
+
+#include <RHI/SwapChain.hpp>
+
+namespace qurb::rhi::null
+{
+    /// \brief A swap chain handing out the same render target every frame.
+    class QURB_NULL_RHI_API SwapChain final : public rhi::SwapChain
+    {
+    public:
+        using base = rhi::SwapChain;
+
+    public:
+        explicit SwapChain(const SwapChainDescriptor& descriptor);
+        ~SwapChain() override;
+
+    public:
+        auto nextRenderTarget() -> rhi::RenderTarget* override;
+
+    private:
+        RenderTarget* _renderTarget;
+    };
+}
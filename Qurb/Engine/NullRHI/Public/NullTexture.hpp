@@ -0,0 +1,52 @@
+/// \file NullTexture.hpp
+
+#pragma once
+
+#include "NullRHI.hpp"
+
+#include <RHI/Texture.hpp>
+
+namespace qurb::rhi::null
+{
+    /// \brief A texture without storage, it only keeps its size and format.
+    class QURB_NULL_RHI_API Texture final : public rhi::Texture
+    {
+    public:
+        using base = rhi::Texture;
+
+    public:
+        explicit Texture(const TextureDescriptor& descriptor);
+        ~Texture() override = default;
+
+    public:
+        [[nodiscard]] auto width() const -> uint32;
+        [[nodiscard]] auto height() const -> uint32;
+        [[nodiscard]] auto format() const -> TextureFormat;
+
+    private:
+        uint32        _width;
+        uint32        _height;
+        TextureFormat _format;
+    };
+
+    inline Texture::Texture(const TextureDescriptor& descriptor)
+        : _width(descriptor.width)
+        , _height(descriptor.height)
+        , _format(descriptor.format)
+    {}
+
+    inline auto Texture::width() const -> uint32
+    {
+        return _width;
+    }
+
+    inline auto Texture::height() const -> uint32
+    {
+        return _height;
+    }
+
+    inline auto Texture::format() const -> TextureFormat
+    {
+        return _format;
+    }
+}
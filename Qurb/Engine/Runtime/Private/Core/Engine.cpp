@@ -3,22 +3,44 @@
 #include "Containers/Vector.hpp"
 #include "Log/Log.hpp"
 
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstdlib>
+#include <string>
+
 namespace qurb
 {
+    namespace
+    {
+        /// \brief The value of the environment variable `name`, or `fallback` when it is not set.
+        auto environmentOr(const char* name, std::string_view fallback) -> std::string
+        {
+            const auto* value = std::getenv(name);
+            return value != nullptr and *value != '\0' ? std::string(value) : std::string(fallback);
+        }
+    }
+
     Engine::Engine(Application* application)
         : _application(application)
+        , _frameCount(0)
+        , _frameLimit(application->frameLimit())
         , _isRunning(false)
         , _isSuspended(true)
     {
         _application->_engine = this;
 
+        const auto renderBackend = environmentOr("QURB_RENDER_BACKEND", _application->renderBackend());
+        const auto frameLimit    = environmentOr("QURB_FRAME_LIMIT", "");
+        std::from_chars(frameLimit.data(), frameLimit.data() + frameLimit.size(), _frameLimit);
+
         // Plugins to load, should be parsed from a config file.
         const auto pluginsToLoad = Vector<std::string_view> {
-            "QurbMetalRHI",
+            renderBackend,
         };
         _pluginManager.loadPlugins(pluginsToLoad);
 
-        _renderer.loadBackend(_pluginManager, "QurbMetalRHI");
+        _renderer.loadBackend(_pluginManager, renderBackend);
 
         createWindow();
 
@@ -39,7 +61,15 @@ namespace qurb
         _isRunning   = true;
         _isSuspended = false;
 
-        auto deltaTime = 0.0f;
+        // In pipelined mode the application renders on the pipeline thread while the main thread updates ahead.
+        const auto& frameLoop     = _application->frameLoop();
+        auto        framePipeline = std::unique_ptr<FramePipeline>();
+        if (frameLoop.mode == FrameLoopMode::Pipelined)
+        {
+            framePipeline = std::make_unique<FramePipeline>(frameLoop.slotCount(), [this](uint32 slot) { _application->render(slot); });
+        }
+
+        constexpr auto reportPeriodMilliseconds = 5000.0;
 
         _clock.start();
         while (_isRunning)
@@ -51,16 +81,79 @@ namespace qurb
                 continue;
             }
 
-            _clock.update();
-            deltaTime = _clock.deltaTime();
+            runFrame(framePipeline.get());
 
-            _application->update(deltaTime);
-            _application->render();
+            // Headless runs stop after a fixed number of frames, as if the user closed the windows.
+            if (_frameLimit != 0 and ++_frameCount >= _frameLimit)
+            {
+                std::ranges::for_each(_windows, &Window::close);
+            }
+
+            if (_frameStatistics.totalMilliseconds() >= reportPeriodMilliseconds)
+            {
+                _frameStatistics.log(frameLoop);
+                _frameStatistics.reset();
+            }
 
-            // Destroy window that should be closed
-            destroyClosedWindows();
-            _isRunning = not _windows.empty();
+            // The render thread may still use the window of a submitted frame.
+            const auto anyWindowClosing = std::ranges::any_of(_windows, [](const Window& window) { return window.shouldClose(); });
+            if (anyWindowClosing and framePipeline != nullptr)
+            {
+                framePipeline->flush();
+            }
+
+            // Destroy window that should be closed. The last ones outlive the run, the application may still use them
+            // when it shuts down.
+            _isRunning = not std::ranges::all_of(_windows, &Window::shouldClose);
+            if (_isRunning)
+            {
+                destroyClosedWindows();
+            }
+        }
+    }
+
+    auto Engine::runFrame(FramePipeline* framePipeline) -> void
+    {
+        using Clock    = std::chrono::steady_clock;
+        using Duration = std::chrono::duration<float64, std::milli>;
+
+        _clock.update();
+        const auto deltaTime = static_cast<float32>(_clock.deltaTime());
+
+        auto timings = FrameTimings {
+            .frame = deltaTime * 1000.0,
+        };
+
+        auto       slot  = uint32(0);
+        const auto start = Clock::now();
+        if (framePipeline != nullptr)
+        {
+            // The slot was last rendered `slotCount` frames ago, its render time is reported with this frame.
+            slot           = framePipeline->acquireSlot();
+            timings.render = framePipeline->renderMilliseconds(slot);
         }
+        const auto acquired = Clock::now();
+
+        _application->update(deltaTime);
+        const auto updated = Clock::now();
+
+        _application->extract(slot);
+        const auto extracted = Clock::now();
+
+        if (framePipeline != nullptr)
+        {
+            framePipeline->submit(slot);
+        }
+        else
+        {
+            _application->render(slot);
+            timings.render = Duration(Clock::now() - extracted).count();
+        }
+
+        timings.wait    = Duration(acquired - start).count();
+        timings.update  = Duration(updated - acquired).count();
+        timings.extract = Duration(extracted - updated).count();
+        _frameStatistics.addFrame(timings);
     }
 
     auto Engine::createWindow() -> void
@@ -0,0 +1,154 @@
+#include "Core/FramePipeline.hpp"
+
+#include "Debug/Ensure.hpp"
+#include "Log/Log.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+namespace qurb
+{
+    auto toString(FrameLoopMode mode) -> std::string_view
+    {
+        switch (mode)
+        {
+            case FrameLoopMode::Serial:
+                return "serial";
+            case FrameLoopMode::Pipelined:
+                return "pipelined";
+        }
+        return "unknown";
+    }
+
+    //------------------------------------------------------------------------------------------------------------------
+    // class FrameStatistics
+    //------------------------------------------------------------------------------------------------------------------
+
+    auto FrameStatistics::addFrame(const FrameTimings& timings) -> void
+    {
+        _total.frame += timings.frame;
+        _total.update += timings.update;
+        _total.extract += timings.extract;
+        _total.render += timings.render;
+        _total.wait += timings.wait;
+        _slowestFrame = std::max(_slowestFrame, timings.frame);
+        ++_frameCount;
+    }
+
+    auto FrameStatistics::log(const FrameLoopDescriptor& descriptor) const -> void
+    {
+        if (_frameCount == 0)
+        {
+            return;
+        }
+
+        const auto average = this->average();
+        Log::info(
+            "Frame loop {} ({} slots): {:.1f} fps, frame {:.2f} ms (slowest {:.2f} ms), update {:.2f} ms, extract {:.2f} ms, render {:.2f} ms, "
+            "waiting {:.2f} ms",
+            toString(descriptor.mode),
+            descriptor.slotCount(),
+            1000.0 / average.frame,
+            average.frame,
+            _slowestFrame,
+            average.update,
+            average.extract,
+            average.render,
+            average.wait);
+    }
+
+    auto FrameStatistics::reset() -> void
+    {
+        *this = FrameStatistics();
+    }
+
+    auto FrameStatistics::average() const -> FrameTimings
+    {
+        if (_frameCount == 0)
+        {
+            return FrameTimings();
+        }
+
+        const auto count = static_cast<float64>(_frameCount);
+        return FrameTimings {
+            .frame   = _total.frame / count,
+            .update  = _total.update / count,
+            .extract = _total.extract / count,
+            .render  = _total.render / count,
+            .wait    = _total.wait / count,
+        };
+    }
+
+    //------------------------------------------------------------------------------------------------------------------
+    // class FramePipeline
+    //------------------------------------------------------------------------------------------------------------------
+
+    FramePipeline::FramePipeline(uint32 slotCount, RenderStage renderStage)
+        : _renderStage(std::move(renderStage))
+        , _slotCount(slotCount)
+        , _renderMilliseconds(slotCount, 0.0)
+        , _freeSlots(slotCount)
+        , _submittedSlots(0)
+    {
+        ensure(slotCount >= 1 and slotCount <= FrameLoopDescriptor::maxFramesInFlight, "Unsupported frame slot count {}.", slotCount);
+
+        _renderThread = std::thread([this] { renderLoop(); });
+    }
+
+    FramePipeline::~FramePipeline()
+    {
+        flush();
+
+        _stopping.store(true, std::memory_order_release);
+        _submittedSlots.release();
+        _renderThread.join();
+    }
+
+    auto FramePipeline::acquireSlot() -> uint32
+    {
+        _freeSlots.acquire();
+        return static_cast<uint32>(_submittedFrames % _slotCount);
+    }
+
+    auto FramePipeline::submit(uint32 slot) -> void
+    {
+        ensure(slot == _submittedFrames % _slotCount, "Frame slot {} submitted out of order.", slot);
+
+        ++_submittedFrames;
+        _submittedSlots.release();
+    }
+
+    auto FramePipeline::flush() -> void
+    {
+        for (auto rendered = _renderedFrames.load(std::memory_order_acquire); rendered != _submittedFrames;
+             rendered      = _renderedFrames.load(std::memory_order_acquire))
+        {
+            _renderedFrames.wait(rendered, std::memory_order_acquire);
+        }
+    }
+
+    auto FramePipeline::renderLoop() -> void
+    {
+        using Clock    = std::chrono::steady_clock;
+        using Duration = std::chrono::duration<float64, std::milli>;
+
+        // Slots are submitted round robin, the render thread follows the same order.
+        for (uint64 frame = 0;; ++frame)
+        {
+            _submittedSlots.acquire();
+            if (_stopping.load(std::memory_order_acquire))
+            {
+                return;
+            }
+
+            const auto slot  = static_cast<uint32>(frame % _slotCount);
+            const auto start = Clock::now();
+            _renderStage(slot);
+            _renderMilliseconds[slot] = Duration(Clock::now() - start).count();
+
+            _renderedFrames.fetch_add(1, std::memory_order_release);
+            _renderedFrames.notify_all();
+            _freeSlots.release();
+        }
+    }
+}
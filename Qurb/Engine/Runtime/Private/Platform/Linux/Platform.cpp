@@ -0,0 +1,20 @@
+#include "Platform/Platform.hpp"
+
+namespace qurb
+{
+    /// \brief Without a window system there is nothing to connect to nor events to poll.
+    struct Platform::NativeHandle
+    {};
+
+    Platform::Platform()
+        : _nativeHandle(new NativeHandle)
+    {}
+
+    Platform::~Platform()
+    {
+        delete _nativeHandle;
+    }
+
+    auto Platform::pollEvents() -> void
+    {}
+}
@@ -0,0 +1,31 @@
+#include "Platform/Window.hpp"
+
+#include "Log/Log.hpp"
+#include "Platform/Linux/NativeWindow.hpp"
+#include "RHI/RenderContext.hpp"
+
+namespace qurb
+{
+    Window::Window(const WindowDescriptor& descriptor)
+        : _nativeHandle(std::make_unique<NativeHandle>())
+        , _renderContext(nullptr)
+        , _title(descriptor.title)
+        , _size(descriptor.size)
+        , _shouldClose(false)
+    {
+        Log::trace("Headless window created");
+    }
+
+    Window::~Window()
+    {
+        if (_renderContext)
+        {
+            _renderContext->release();
+        }
+
+        Log::trace("Window destroyed");
+    }
+
+    Window::Window(Window&&) noexcept                          = default;
+    auto Window::operator=(Window&& other) noexcept -> Window& = default;
+}
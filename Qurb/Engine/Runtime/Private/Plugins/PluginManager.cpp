@@ -7,9 +7,14 @@ namespace qurb
 {
     using CreatePluginFunction = Plugin* (*) (DynamicLibrary*);
 
+    PluginManager::~PluginManager()
+    {
+        unloadPlugins();
+    }
+
     auto PluginManager::loadPlugins(const Vector<std::string_view>& pluginNames) -> void
     {
-        _plugins.clear();
+        unloadPlugins();
         _plugins.reserve(pluginNames.size());
 
         for (auto pluginName : pluginNames)
@@ -51,4 +56,14 @@ namespace qurb
             plugin->initialize();
         }
     }
+
+    auto PluginManager::unloadPlugins() -> void
+    {
+        // Unload in the reverse order of loading, the library is closed when it goes out of scope.
+        while (not _plugins.empty())
+        {
+            auto library = std::move(_plugins.back()->_library);
+            _plugins.popBack();
+        }
+    }
 }
@@ -0,0 +1,84 @@
+#include "RHI/FrameAllocator.hpp"
+
+#include "Debug/Ensure.hpp"
+
+#include <bit>
+
+namespace qurb::rhi
+{
+    FrameAllocator::FrameAllocator(Device* device, uint32 frameCount, usize frameSize)
+        : _device(device)
+        , _frameCount(frameCount)
+        , _frameSize(0)
+        , _buffer(nullptr)
+        , _data(nullptr)
+        , _frame(0)
+        , _regionOffset(0)
+        , _offset(0)
+        , _retiredBuffers()
+    {
+        ensure(_frameCount > 0, "A frame allocator needs at least one frame.");
+
+        _device->retain();
+
+        // Regions stay aligned to the largest alignment of the allocations, so that the offsets in the buffer are too.
+        _frameSize = (std::max(frameSize, defaultAlignment) + defaultAlignment - 1) & ~(defaultAlignment - 1);
+        createBuffer();
+    }
+
+    FrameAllocator::~FrameAllocator()
+    {
+        for (const auto& retired : _retiredBuffers)
+        {
+            retired.buffer->release();
+        }
+        _buffer->release();
+        _device->release();
+    }
+
+    auto FrameAllocator::beginFrame(usize frameSize) -> void
+    {
+        ++_frame;
+
+        // Buffers replaced at least `frameCount` frames ago are no longer read.
+        for (usize i = 0; i < _retiredBuffers.size();)
+        {
+            if (_retiredBuffers[i].lastFrame + _frameCount <= _frame)
+            {
+                _retiredBuffers[i].buffer->release();
+                _retiredBuffers[i] = _retiredBuffers.back();
+                _retiredBuffers.popBack();
+            }
+            else
+            {
+                ++i;
+            }
+        }
+
+        if (frameSize > _frameSize)
+        {
+            _retiredBuffers.pushBack(RetiredBuffer {_buffer, _frame - 1});
+
+            // Grow geometrically, so that a growing scene reallocates a few times only.
+            _frameSize = std::bit_ceil(frameSize);
+            _frameSize = (_frameSize + defaultAlignment - 1) & ~(defaultAlignment - 1);
+            createBuffer();
+        }
+
+        _regionOffset = static_cast<usize>(_frame % _frameCount) * _frameSize;
+        _offset.store(0, std::memory_order_relaxed);
+    }
+
+    auto FrameAllocator::createBuffer() -> void
+    {
+        _buffer = _device->createBuffer(
+            BufferDescriptor {
+                .initialData = nullptr,
+                .bufferSize  = _frameSize * _frameCount,
+                .bufferType  = BufferType::Vertex,
+                .bufferUsage = BufferUsage::Persistent,
+            });
+        _data = static_cast<std::byte*>(_buffer->map());
+        ensure(_data != nullptr, "The buffer of a frame allocator must be mappable.");
+    }
+}
@@ -0,0 +1,108 @@
+#include "RHI/PipelineState.hpp"
+
+#include "RHI/ShaderProgram.hpp"
+
+#include <string_view>
+#include <type_traits>
+
+namespace qurb::rhi
+{
+    namespace
+    {
+        /// \brief FNV-1a, fed field by field so that padding and the address of objects never reach the hash.
+        class Hasher
+        {
+        public:
+            template <typename T>
+                requires std::is_arithmetic_v<T> or std::is_enum_v<T>
+            auto add(T value) -> Hasher&
+            {
+                return addBytes(&value, sizeof(value));
+            }
+
+            auto add(std::string_view string) -> Hasher&
+            {
+                add(string.size());
+                return addBytes(string.data(), string.size());
+            }
+
+            [[nodiscard]] auto value() const -> uint64 { return _hash; }
+
+        private:
+            auto addBytes(const void* data, usize size) -> Hasher&
+            {
+                const auto* bytes = static_cast<const uint8*>(data);
+                for (usize i = 0; i < size; ++i)
+                {
+                    _hash = (_hash ^ bytes[i]) * 0x100000001B3ull;
+                }
+                return *this;
+            }
+
+        private:
+            uint64 _hash = 0xCBF29CE484222325ull;
+        };
+
+        auto hashStencil(Hasher& hasher, const DepthStencilOperationDescriptor& descriptor) -> void
+        {
+            hasher.add(descriptor.stencilFailOp)
+                .add(descriptor.depthFailOp)
+                .add(descriptor.passOp)
+                .add(descriptor.stencilFunc)
+                .add(descriptor.readMask)
+                .add(descriptor.writeMask)
+                .add(descriptor.reference);
+        }
+    }
+
+    auto hashPipelineStateDescriptor(const PipelineStateDescriptor& descriptor) -> uint64
+    {
+        auto hasher = Hasher();
+        hasher.add(descriptor.primitiveTopology);
+
+        const auto& depthStencil = descriptor.depthStencil;
+        hasher.add(depthStencil.depthTestEnabled)
+            .add(depthStencil.depthWriteEnabled)
+            .add(depthStencil.depthFunction)
+            .add(depthStencil.stencilTestEnabled);
+        hashStencil(hasher, depthStencil.frontFace);
+        hashStencil(hasher, depthStencil.backFace);
+
+        const auto& rasterizer = descriptor.rasterizer;
+        hasher.add(rasterizer.fillMode)
+            .add(rasterizer.cullMode)
+            .add(rasterizer.depthBias)
+            .add(rasterizer.depthBiasClamp)
+            .add(rasterizer.slopeScaleDepthBias)
+            .add(rasterizer.depthClipEnabled)
+            .add(rasterizer.scissorTestEnabled);
+
+        hasher.add(descriptor.blend.renderTargets.size());
+        for (const auto& renderTarget : descriptor.blend.renderTargets)
+        {
+            hasher.add(renderTarget.sourceBlend)
+                .add(renderTarget.destinationBlend)
+                .add(renderTarget.blendOperation)
+                .add(renderTarget.sourceAlphaBlend)
+                .add(renderTarget.destinationAlphaBlend)
+                .add(renderTarget.alphaBlendOperation)
+                .add(renderTarget.writeMask.to_ulong())
+                .add(renderTarget.blendingEnabled);
+        }
+
+        // The shader program by what it was created from, the same program loaded twice hashes the same.
+        hasher.add(descriptor.shaderProgram != nullptr);
+        if (descriptor.shaderProgram != nullptr)
+        {
+            const auto& shaderProgram = descriptor.shaderProgram->descriptor();
+            hasher.add(shaderProgram.shaderName).add(shaderProgram.vertexFunctionName).add(shaderProgram.fragmentFunctionName);
+            hasher.add(shaderProgram.bufferLayout.size());
+            for (const auto& element : shaderProgram.bufferLayout)
+            {
+                hasher.add(element.dataType).add(element.name);
+            }
+        }
+
+        return hasher.value();
+    }
+}
@@ -0,0 +1,309 @@
+#include "RHI/ShaderCache.hpp"
+
+#include "Log/Log.hpp"
+#include "Platform/Detection.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <format>
+#include <fstream>
+#include <functional>
+#include <system_error>
+#include <thread>
+
+#ifdef QURB_PLATFORM_WINDOWS
+    #include <process.h>
+#else
+    #include <unistd.h>
+#endif
+
+namespace qurb::rhi
+{
+    namespace
+    {
+        /// \brief Starts every entry, in the byte order of the machine that wrote it: one of the other order fails the
+        /// version checks.
+        struct EntryHeader
+        {
+            std::array<char, 4> magic;
+            uint32              formatVersion;
+            uint32              backendVersion;
+            uint32              headerSize;
+            uint64              keyHigh;
+            uint64              keyLow;
+            uint64              payloadSize;
+            uint64              payloadChecksum;
+        };
+
+        constexpr auto entryMagic = std::array<char, 4> {'Q', 'S', 'H', 'C'};
+
+        /// \brief A checksum of the payload, eight bytes per step so that checking a hit stays cheap next to reading it.
+        auto checksum(std::span<const std::byte> data) -> uint64
+        {
+            auto hash = 0xCBF29CE484222325ull ^ data.size();
+            auto mix  = [&](uint64 word) {
+                hash = (hash ^ word) * 0x100000001B3ull;
+                hash ^= hash >> 29;
+            };
+
+            auto offset = usize(0);
+            for (; offset + sizeof(uint64) <= data.size(); offset += sizeof(uint64))
+            {
+                auto word = uint64(0);
+                std::memcpy(&word, data.data() + offset, sizeof(uint64));
+                mix(word);
+            }
+            if (offset < data.size())
+            {
+                auto word = uint64(0);
+                std::memcpy(&word, data.data() + offset, data.size() - offset);
+                mix(word);
+            }
+            return hash;
+        }
+
+        /// \brief Identifies the calling process in the name of its temporary files.
+        auto processId() -> uint64
+        {
+#ifdef QURB_PLATFORM_WINDOWS
+            return static_cast<uint64>(_getpid());
+#else
+            return static_cast<uint64>(getpid());
+#endif
+        }
+    }
+
+    //------------------------------------------------------------------------------------------------------------------
+    // struct ShaderCacheKey
+    //------------------------------------------------------------------------------------------------------------------
+
+    auto ShaderCacheKey::toString() const -> std::string
+    {
+        return std::format("{:016x}{:016x}", high, low);
+    }
+
+    //------------------------------------------------------------------------------------------------------------------
+    // class ShaderCacheKeyHasher
+    //------------------------------------------------------------------------------------------------------------------
+
+    auto ShaderCacheKeyHasher::add(std::string_view string) -> ShaderCacheKeyHasher&
+    {
+        add(static_cast<uint64>(string.size()));
+        addBytes(string.data(), string.size());
+        return *this;
+    }
+
+    auto ShaderCacheKeyHasher::add(uint64 value) -> ShaderCacheKeyHasher&
+    {
+        addBytes(&value, sizeof(value));
+        return *this;
+    }
+
+    auto ShaderCacheKeyHasher::key() const -> ShaderCacheKey
+    {
+        return ShaderCacheKey {_high, _low};
+    }
+
+    auto ShaderCacheKeyHasher::addBytes(const void* data, usize size) -> void
+    {
+        // Two FNV-1a lanes with different primes, so that a collision of one is not a collision of the other.
+        const auto* bytes = static_cast<const uint8*>(data);
+        for (usize i = 0; i < size; ++i)
+        {
+            _high = (_high ^ bytes[i]) * 0x100000001B3ull;
+            _low  = (_low ^ bytes[i]) * 0x9E3779B97F4A7C15ull;
+        }
+    }
+
+    //------------------------------------------------------------------------------------------------------------------
+    // class ShaderCache
+    //------------------------------------------------------------------------------------------------------------------
+
+    auto ShaderCache::defaultDirectory() -> std::filesystem::path
+    {
+        const auto* value = std::getenv("QURB_SHADER_CACHE");
+        return value != nullptr and *value != '\0' ? std::filesystem::path(value) : std::filesystem::path("ShaderCache");
+    }
+
+    ShaderCache::ShaderCache(std::filesystem::path directory, uint32 backendVersion)
+        : _directory(std::move(directory))
+        , _backendVersion(backendVersion)
+        , _hits(0)
+        , _misses(0)
+        , _rejected(0)
+        , _stores(0)
+        , _loadNanoseconds(0)
+        , _createNanoseconds(0)
+    {
+        auto error = std::error_code();
+        std::filesystem::create_directories(_directory, error);
+        if (error)
+        {
+            Log::warn("Shader cache: Could not create {}: {}", _directory.string(), error.message());
+        }
+    }
+
+    auto ShaderCache::load(const ShaderCacheKey& key) -> std::optional<Vector<std::byte>>
+    {
+        const auto start     = now();
+        const auto entryPath = path(key);
+
+        auto file = std::ifstream(entryPath, std::ios::binary);
+        if (not file.is_open())
+        {
+            _misses.fetch_add(1, std::memory_order_relaxed);
+            return std::nullopt;
+        }
+
+        auto header = EntryHeader();
+        if (not file.read(reinterpret_cast<char*>(&header), sizeof(header)) or header.magic != entryMagic)
+        {
+            file.close();
+            reject(entryPath, "not a shader cache entry");
+            return std::nullopt;
+        }
+        if (header.formatVersion != formatVersion or header.backendVersion != _backendVersion or header.headerSize != sizeof(EntryHeader))
+        {
+            file.close();
+            reject(entryPath, std::format("version {}.{}, expected {}.{}", header.formatVersion, header.backendVersion, formatVersion, _backendVersion));
+            return std::nullopt;
+        }
+        if (header.keyHigh != key.high or header.keyLow != key.low)
+        {
+            file.close();
+            reject(entryPath, "stored under another key");
+            return std::nullopt;
+        }
+
+        // Checked before allocating, a corrupt size must not allocate gigabytes.
+        auto error = std::error_code();
+        if (std::filesystem::file_size(entryPath, error) != sizeof(EntryHeader) + header.payloadSize or error)
+        {
+            file.close();
+            reject(entryPath, "truncated or oversized");
+            return std::nullopt;
+        }
+
+        auto payload = Vector<std::byte>();
+        payload.resize(header.payloadSize);
+        if (not file.read(reinterpret_cast<char*>(payload.data()), static_cast<std::streamsize>(payload.size())))
+        {
+            file.close();
+            reject(entryPath, "truncated");
+            return std::nullopt;
+        }
+        if (checksum(std::span<const std::byte>(payload.data(), payload.size())) != header.payloadChecksum)
+        {
+            file.close();
+            reject(entryPath, "checksum mismatch");
+            return std::nullopt;
+        }
+
+        _hits.fetch_add(1, std::memory_order_relaxed);
+        _loadNanoseconds.fetch_add(now() - start, std::memory_order_relaxed);
+        return payload;
+    }
+
+    auto ShaderCache::store(const ShaderCacheKey& key, std::span<const std::byte> artifact) -> bool
+    {
+        const auto entryPath = path(key);
+
+        // Written beside the entry under a name of this process and thread, then renamed over it in one step.
+        auto temporaryPath = entryPath;
+        temporaryPath += std::format(".{:x}.{:x}.tmp", processId(), std::hash<std::thread::id>()(std::this_thread::get_id()));
+
+        const auto header = EntryHeader {
+            .magic           = entryMagic,
+            .formatVersion   = formatVersion,
+            .backendVersion  = _backendVersion,
+            .headerSize      = sizeof(EntryHeader),
+            .keyHigh         = key.high,
+            .keyLow          = key.low,
+            .payloadSize     = artifact.size(),
+            .payloadChecksum = checksum(artifact),
+        };
+
+        {
+            auto file = std::ofstream(temporaryPath, std::ios::binary | std::ios::trunc);
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            file.write(reinterpret_cast<const char*>(artifact.data()), static_cast<std::streamsize>(artifact.size()));
+            if (not file.flush())
+            {
+                file.close();
+                auto error = std::error_code();
+                std::filesystem::remove(temporaryPath, error);
+                Log::warn("Shader cache: Could not write {}", temporaryPath.string());
+                return false;
+            }
+        }
+
+        auto error = std::error_code();
+        std::filesystem::rename(temporaryPath, entryPath, error);
+        if (error)
+        {
+            std::filesystem::remove(temporaryPath, error);
+            Log::warn("Shader cache: Could not store {}: {}", entryPath.string(), error.message());
+            return false;
+        }
+
+        _stores.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    auto ShaderCache::clear() -> void
+    {
+        auto error = std::error_code();
+        for (const auto& entry : std::filesystem::directory_iterator(_directory, error))
+        {
+            if (entry.path().extension() == ".bin")
+            {
+                std::filesystem::remove(entry.path(), error);
+            }
+        }
+    }
+
+    auto ShaderCache::statistics() const -> ShaderCacheStatistics
+    {
+        return ShaderCacheStatistics {
+            .hits               = _hits.load(std::memory_order_relaxed),
+            .misses             = _misses.load(std::memory_order_relaxed),
+            .rejected           = _rejected.load(std::memory_order_relaxed),
+            .stores             = _stores.load(std::memory_order_relaxed),
+            .loadMilliseconds   = static_cast<float64>(_loadNanoseconds.load(std::memory_order_relaxed)) / 1e6,
+            .createMilliseconds = static_cast<float64>(_createNanoseconds.load(std::memory_order_relaxed)) / 1e6,
+        };
+    }
+
+    auto ShaderCache::resetStatistics() -> void
+    {
+        _hits.store(0, std::memory_order_relaxed);
+        _misses.store(0, std::memory_order_relaxed);
+        _rejected.store(0, std::memory_order_relaxed);
+        _stores.store(0, std::memory_order_relaxed);
+        _loadNanoseconds.store(0, std::memory_order_relaxed);
+        _createNanoseconds.store(0, std::memory_order_relaxed);
+    }
+
+    auto ShaderCache::path(const ShaderCacheKey& key) const -> std::filesystem::path
+    {
+        return _directory / (key.toString() + ".bin");
+    }
+
+    auto ShaderCache::reject(const std::filesystem::path& path, std::string_view reason) -> void
+    {
+        Log::warn("Shader cache: Discarding {}, {}", path.string(), reason);
+
+        auto error = std::error_code();
+        std::filesystem::remove(path, error);
+        _rejected.fetch_add(1, std::memory_order_relaxed);
+        _misses.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    auto ShaderCache::now() -> uint64
+    {
+        const auto time = std::chrono::steady_clock::now().time_since_epoch();
+        return static_cast<uint64>(std::chrono::duration_cast<std::chrono::nanoseconds>(time).count());
+    }
+}
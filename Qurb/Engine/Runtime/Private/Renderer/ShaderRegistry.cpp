@@ -0,0 +1,125 @@
+#include "Renderer/ShaderRegistry.hpp"
+
+#include "Containers/Vector.hpp"
+
+namespace qurb
+{
+    ShaderRegistry::ShaderRegistry(rhi::Device* device, JobSystem* jobSystem)
+        : _device(device)
+        , _jobSystem(jobSystem)
+        , _requests(0)
+        , _ready(0)
+    {
+        _device->retain();
+    }
+
+    ShaderRegistry::~ShaderRegistry()
+    {
+        waitIdle();
+
+        for (auto& [key, entry] : _entries)
+        {
+            if (auto* program = entry->program.load(std::memory_order_acquire))
+            {
+                program->release();
+            }
+        }
+
+        _device->release();
+    }
+
+    auto ShaderRegistry::request(const rhi::ShaderProgramDescriptor& descriptor) -> ShaderHandle
+    {
+        _requests.fetch_add(1, std::memory_order_relaxed);
+
+        auto key  = makeKey(descriptor);
+        auto lock = std::scoped_lock(_mutex);
+        if (const auto it = _entries.find(key); it != _entries.end())
+        {
+            return ShaderHandle(it->second.get());
+        }
+
+        auto& entry      = *_entries.emplace(std::move(key), std::make_unique<ShaderHandle::Entry>()).first->second;
+        entry.descriptor = descriptor;
+
+        // Queued under the lock, so that a concurrent request of the same program finds it pending. Entries are never
+        // removed, the job may keep a reference to this one.
+        if (_jobSystem != nullptr and _jobSystem->workerCount() > 0)
+        {
+            _jobSystem->submit([this, &entry] { compile(entry); }, entry.pending);
+        }
+        else
+        {
+            compile(entry);
+        }
+        return ShaderHandle(&entry);
+    }
+
+    auto ShaderRegistry::load(const rhi::ShaderProgramDescriptor& descriptor) -> rhi::Ref<rhi::ShaderProgram>
+    {
+        const auto handle = request(descriptor);
+        wait(handle);
+        return handle.program();
+    }
+
+    auto ShaderRegistry::wait(const ShaderHandle& handle) -> void
+    {
+        if (_jobSystem != nullptr)
+        {
+            _jobSystem->wait(handle._entry->pending);
+        }
+    }
+
+    auto ShaderRegistry::waitIdle() -> void
+    {
+        if (_jobSystem == nullptr)
+        {
+            return;
+        }
+
+        // Waited on outside of the lock, the jobs run meanwhile may request other programs.
+        auto entries = Vector<const ShaderHandle::Entry*>();
+        {
+            auto lock = std::scoped_lock(_mutex);
+            for (const auto& [key, entry] : _entries)
+            {
+                entries.pushBack(entry.get());
+            }
+        }
+        for (const auto* entry : entries)
+        {
+            _jobSystem->wait(entry->pending);
+        }
+    }
+
+    auto ShaderRegistry::statistics() const -> ShaderRegistryStatistics
+    {
+        auto lock = std::scoped_lock(_mutex);
+        return ShaderRegistryStatistics {
+            .requests = _requests.load(std::memory_order_relaxed),
+            .programs = _entries.size(),
+            .ready    = _ready.load(std::memory_order_relaxed),
+        };
+    }
+
+    auto ShaderRegistry::makeKey(const rhi::ShaderProgramDescriptor& descriptor) -> std::string
+    {
+        // Separated by a character no name contains, so that two descriptors never pack the same.
+        auto key = std::string();
+        key.append(descriptor.shaderName).push_back('\0');
+        key.append(descriptor.vertexFunctionName).push_back('\0');
+        key.append(descriptor.fragmentFunctionName).push_back('\0');
+        for (const auto& element : descriptor.bufferLayout)
+        {
+            key.push_back(static_cast<char>(element.dataType));
+            key.append(element.name).push_back('\0');
+        }
+        return key;
+    }
+
+    auto ShaderRegistry::compile(ShaderHandle::Entry& entry) -> void
+    {
+        entry.program.store(_device->createShaderProgram(entry.descriptor), std::memory_order_release);
+        _ready.fetch_add(1, std::memory_order_relaxed);
+    }
+}
@@ -0,0 +1,218 @@
+#include "Scene/ArchetypeStorage.hpp"
+
+#include <algorithm>
+#include <new>
+
+namespace qurb
+{
+    namespace
+    {
+        constexpr auto cacheLineSize = usize(64);
+
+        auto alignUp(usize value, usize alignment) -> usize
+        {
+            return (value + alignment - 1) / alignment * alignment;
+        }
+    }
+
+    //------------------------------------------------------------------------------------------------------------------
+    // class Archetype
+    //------------------------------------------------------------------------------------------------------------------
+
+    Archetype::Archetype(const ComponentSignature& signature)
+        : _signature(signature)
+    {
+        std::fill(std::begin(_edges), std::end(_edges), invalidIndex);
+
+        auto rowSize = sizeof(EntityId);
+        for (usize componentId = 0; componentId < maxComponentTypes; ++componentId)
+        {
+            if (signature.test(componentId))
+            {
+                const auto& info = ComponentType::info(componentId);
+                ensure(info.alignment <= cacheLineSize, "Component {} is over-aligned for archetype chunks.", componentId);
+
+                _componentIds.pushBack(componentId);
+                rowSize += info.size;
+            }
+        }
+
+        // Start from the capacity ignoring padding, then shrink until every cache line aligned column fits.
+        const auto layoutSize = [this](usize capacity) {
+            auto offset = capacity * sizeof(EntityId);
+            for (const auto componentId : _componentIds)
+            {
+                offset                      = alignUp(offset, cacheLineSize);
+                _columnOffsets[componentId] = offset;
+                offset += capacity * ComponentType::info(componentId).size;
+            }
+            return offset;
+        };
+
+        auto capacity = chunkSize / rowSize;
+        while (capacity > 0 and layoutSize(capacity) > chunkSize)
+        {
+            --capacity;
+        }
+
+        ensure(capacity > 0, "Archetype rows of {} bytes do not fit in a {} bytes chunk.", rowSize, chunkSize);
+        _chunkCapacity = static_cast<uint32>(capacity);
+    }
+
+    Archetype::~Archetype()
+    {
+        for (uint32 row = 0; row < _size; ++row)
+        {
+            for (const auto componentId : _componentIds)
+            {
+                ComponentType::info(componentId).destroy(component(componentId, row));
+            }
+        }
+
+        for (auto* chunk : _chunks)
+        {
+            ::operator delete(chunk, std::align_val_t(cacheLineSize));
+        }
+    }
+
+    auto Archetype::allocateRow(EntityId id) -> uint32
+    {
+        if (_size == _chunks.size() * _chunkCapacity)
+        {
+            _chunks.pushBack(static_cast<uint8*>(::operator new(chunkSize, std::align_val_t(cacheLineSize))));
+        }
+
+        const auto row                                         = _size++;
+        entities(row / _chunkCapacity)[row % _chunkCapacity] = id;
+        return row;
+    }
+
+    auto Archetype::removeRow(uint32 row) -> EntityId
+    {
+        for (const auto componentId : _componentIds)
+        {
+            ComponentType::info(componentId).destroy(component(componentId, row));
+        }
+
+        auto       moved = invalidEntityId;
+        const auto last  = _size - 1;
+        if (row != last)
+        {
+            for (const auto componentId : _componentIds)
+            {
+                const auto& info = ComponentType::info(componentId);
+                info.moveConstruct(component(componentId, row), component(componentId, last));
+                info.destroy(component(componentId, last));
+            }
+
+            moved                                                  = entities(last / _chunkCapacity)[last % _chunkCapacity];
+            entities(row / _chunkCapacity)[row % _chunkCapacity] = moved;
+        }
+        --_size;
+
+        // Keep one spare chunk so that an entity oscillating on a chunk boundary does not reallocate every time.
+        if (_chunks.size() > chunkCount() + 1)
+        {
+            ::operator delete(_chunks.back(), std::align_val_t(cacheLineSize));
+            _chunks.popBack();
+        }
+
+        return moved;
+    }
+
+    auto Archetype::memoryUsage() const -> usize
+    {
+        return _chunks.size() * chunkSize + _chunks.capacity() * sizeof(uint8*) + _componentIds.capacity() * sizeof(usize);
+    }
+
+    //------------------------------------------------------------------------------------------------------------------
+    // class ArchetypeStorage
+    //------------------------------------------------------------------------------------------------------------------
+
+    ArchetypeStorage::ArchetypeStorage()
+    {
+        _archetypes.pushBack(std::make_unique<Archetype>(ComponentSignature()));
+        _archetypeIndices.emplace(ComponentSignature(), 0);
+    }
+
+    auto ArchetypeStorage::createEntity(EntityId id) -> void
+    {
+        const auto index = entityIndex(id);
+        while (index >= _locations.size())
+        {
+            _locations.pushBack(EntityLocation {.archetype = Archetype::invalidIndex, .row = Archetype::invalidIndex});
+        }
+
+        _locations[index] = EntityLocation {.archetype = 0, .row = _archetypes[0]->allocateRow(id)};
+    }
+
+    auto ArchetypeStorage::destroyEntity(EntityId id) -> void
+    {
+        auto& location = _locations[entityIndex(id)];
+
+        const auto moved = _archetypes[location.archetype]->removeRow(location.row);
+        if (moved != invalidEntityId)
+        {
+            _locations[entityIndex(moved)].row = location.row;
+        }
+
+        location = EntityLocation {.archetype = Archetype::invalidIndex, .row = Archetype::invalidIndex};
+    }
+
+    auto ArchetypeStorage::memoryUsage() const -> usize
+    {
+        auto bytes = _locations.capacity() * sizeof(EntityLocation) + _archetypes.capacity() * sizeof(std::unique_ptr<Archetype>);
+        for (const auto& archetype : _archetypes)
+        {
+            bytes += sizeof(Archetype) + archetype->memoryUsage();
+        }
+        return bytes;
+    }
+
+    auto ArchetypeStorage::neighbour(uint32 archetype, usize componentId) -> uint32
+    {
+        auto& source = *_archetypes[archetype];
+        if (source.edge(componentId) != Archetype::invalidIndex)
+        {
+            return source.edge(componentId);
+        }
+
+        auto signature = source.signature();
+        signature.flip(componentId);
+
+        auto [it, inserted] = _archetypeIndices.try_emplace(signature, static_cast<uint32>(_archetypes.size()));
+        if (inserted)
+        {
+            _archetypes.pushBack(std::make_unique<Archetype>(signature));
+        }
+
+        source.edge(componentId)                 = it->second;
+        _archetypes[it->second]->edge(componentId) = archetype;
+        return it->second;
+    }
+
+    auto ArchetypeStorage::migrate(EntityId id, uint32 archetype) -> uint32
+    {
+        const auto location    = _locations[entityIndex(id)];
+        auto&      source      = *_archetypes[location.archetype];
+        auto&      destination = *_archetypes[archetype];
+
+        const auto row = destination.allocateRow(id);
+        for (const auto componentId : source.componentIds())
+        {
+            if (destination.signature().test(componentId))
+            {
+                ComponentType::info(componentId).moveConstruct(destination.component(componentId, row), source.component(componentId, location.row));
+            }
+        }
+
+        const auto moved = source.removeRow(location.row);
+        if (moved != invalidEntityId)
+        {
+            _locations[entityIndex(moved)].row = location.row;
+        }
+
+        _locations[entityIndex(id)] = EntityLocation {.archetype = archetype, .row = row};
+        return row;
+    }
+}
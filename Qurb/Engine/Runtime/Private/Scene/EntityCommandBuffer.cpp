@@ -0,0 +1,230 @@
+#include "Scene/EntityCommandBuffer.hpp"
+
+#include "Debug/Ensure.hpp"
+#include "Scene/Entity.hpp"
+
+#include <algorithm>
+
+namespace qurb
+{
+    namespace
+    {
+        auto nextBufferUid() -> uint64
+        {
+            static auto counter = std::atomic<uint64>(0);
+            return ++counter;
+        }
+
+        auto alignUp(usize value, usize alignment) -> usize
+        {
+            return (value + alignment - 1) / alignment * alignment;
+        }
+    }
+
+    //------------------------------------------------------------------------------------------------------------------
+    // struct EntityCommandBuffer::Stream
+    //------------------------------------------------------------------------------------------------------------------
+
+    auto EntityCommandBuffer::Stream::allocate(usize size, usize alignment) -> void*
+    {
+        ensure(size + alignment <= blockSize, "Component of {} bytes is too large for a command buffer block.", size);
+
+        // Blocks are kept across playbacks, walk them before allocating a new one.
+        while (true)
+        {
+            if (blockIndex == blocks.size())
+            {
+                blocks.pushBack(std::make_unique<uint8[]>(blockSize));
+            }
+
+            const auto address = reinterpret_cast<usize>(blocks[blockIndex].get());
+            const auto offset  = alignUp(address + blockOffset, alignment) - address;
+            if (offset + size <= blockSize)
+            {
+                blockOffset = offset + size;
+                return blocks[blockIndex].get() + offset;
+            }
+
+            ++blockIndex;
+            blockOffset = 0;
+        }
+    }
+
+    auto EntityCommandBuffer::Stream::reset() -> void
+    {
+        commands.clear();
+        blockIndex  = 0;
+        blockOffset = 0;
+    }
+
+    //------------------------------------------------------------------------------------------------------------------
+    // class EntityCommandBuffer
+    //------------------------------------------------------------------------------------------------------------------
+
+    EntityCommandBuffer::EntityCommandBuffer()
+        : _uid(nextBufferUid())
+    {}
+
+    EntityCommandBuffer::~EntityCommandBuffer()
+    {
+        // Components recorded but never played back still have to be destroyed.
+        for (auto& commandStream : _streams)
+        {
+            for (const auto& command : commandStream->commands)
+            {
+                if (command.type == CommandType::Add)
+                {
+                    ComponentType::info(command.componentId).destroy(command.component);
+                }
+            }
+        }
+    }
+
+    auto EntityCommandBuffer::createEntity() -> EntityId
+    {
+        return makeEntityId(_pendingCount.fetch_add(1, std::memory_order_relaxed), reservedEntityGeneration);
+    }
+
+    auto EntityCommandBuffer::destroyEntity(EntityId id) -> void
+    {
+        stream().commands.pushBack(Command {
+            .entity      = id,
+            .operations  = nullptr,
+            .component   = nullptr,
+            .componentId = 0,
+            .type        = CommandType::Destroy,
+        });
+    }
+
+    auto EntityCommandBuffer::playback(EntityRegistery& registery) -> void
+    {
+        // Entities first, so that component commands can refer to them.
+        const auto pendingCount = _pendingCount.exchange(0, std::memory_order_relaxed);
+        registery.reserve(reservedCapacity(registery.entityCount() + pendingCount, registery.capacity()));
+
+        _createdEntities.clear();
+        _createdEntities.reserve(pendingCount);
+        for (uint32 i = 0; i < pendingCount; ++i)
+        {
+            _createdEntities.pushBack(registery.createEntity().id());
+        }
+
+        _sortedCommands.clear();
+        for (const auto& commandStream : _streams)
+        {
+            for (const auto& command : commandStream->commands)
+            {
+                _sortedCommands.pushBack(command);
+            }
+        }
+
+        // Destroys last, then grouped by component and entity. The sort is stable so one thread's commands on the same
+        // entity and component stay in order.
+        std::stable_sort(_sortedCommands.begin(), _sortedCommands.end(), [](const Command& lhs, const Command& rhs) {
+            const auto lhsDestroy = lhs.type == CommandType::Destroy;
+            const auto rhsDestroy = rhs.type == CommandType::Destroy;
+            if (lhsDestroy != rhsDestroy)
+            {
+                return rhsDestroy;
+            }
+            if (lhs.componentId != rhs.componentId)
+            {
+                return lhs.componentId < rhs.componentId;
+            }
+            return entityIndex(lhs.entity) < entityIndex(rhs.entity);
+        });
+
+        for (usize i = 0; i < _sortedCommands.size(); ++i)
+        {
+            auto& command = _sortedCommands[i];
+
+            if (command.type == CommandType::Destroy)
+            {
+                registery.destroyEntity(resolve(command.entity));
+                continue;
+            }
+
+            // Reserve the pool once for every add of this component type.
+            if (i == 0 or _sortedCommands[i - 1].componentId != command.componentId or _sortedCommands[i - 1].type == CommandType::Destroy)
+            {
+                usize addCount = 0;
+                for (auto j = i; j < _sortedCommands.size(); ++j)
+                {
+                    const auto& next = _sortedCommands[j];
+                    if (next.componentId != command.componentId or next.type == CommandType::Destroy)
+                    {
+                        break;
+                    }
+                    addCount += next.type == CommandType::Add;
+                }
+                command.operations->reserve(registery, addCount);
+            }
+
+            // Commands on an entity destroyed before playback are dropped.
+            const auto entity = resolve(command.entity);
+            if (registery.isAlive(entity))
+            {
+                if (command.type == CommandType::Add)
+                {
+                    command.operations->add(registery, entity, command.component);
+                }
+                else
+                {
+                    command.operations->remove(registery, entity);
+                }
+            }
+
+            if (command.type == CommandType::Add)
+            {
+                ComponentType::info(command.componentId).destroy(command.component);
+            }
+        }
+
+        for (auto& commandStream : _streams)
+        {
+            commandStream->reset();
+        }
+    }
+
+    auto EntityCommandBuffer::empty() const -> bool
+    {
+        if (_pendingCount.load(std::memory_order_relaxed) != 0)
+        {
+            return false;
+        }
+
+        return std::all_of(_streams.begin(), _streams.end(), [](const auto& commandStream) { return commandStream->commands.empty(); });
+    }
+
+    auto EntityCommandBuffer::stream() -> Stream&
+    {
+        // Streams live as long as the buffer, so the last one used by this thread can be cached by buffer uid.
+        thread_local auto cachedUid    = uint64(0);
+        thread_local auto cachedStream = static_cast<Stream*>(nullptr);
+
+        if (cachedUid == _uid)
+        {
+            return *cachedStream;
+        }
+
+        auto lock = std::scoped_lock(_mutex);
+
+        const auto thread = std::this_thread::get_id();
+        auto       it     = std::find_if(_streams.begin(), _streams.end(), [&](const auto& commandStream) { return commandStream->thread == thread; });
+        if (it == _streams.end())
+        {
+            _streams.pushBack(std::make_unique<Stream>());
+            _streams.back()->thread = thread;
+            it                      = &_streams.back();
+        }
+
+        cachedUid    = _uid;
+        cachedStream = it->get();
+        return *cachedStream;
+    }
+
+    auto EntityCommandBuffer::resolve(EntityId id) const -> EntityId
+    {
+        return isPending(id) ? _createdEntities[entityIndex(id)] : id;
+    }
+}
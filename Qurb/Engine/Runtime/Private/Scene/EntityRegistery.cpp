@@ -2,23 +2,97 @@
 
 #include "Scene/Entity.hpp"
 
+#include <bit>
+
 namespace qurb
 {
+    EntityRegistery::EntityRegistery(EntityStorageType storageType)
+        : _storageType(storageType)
+        , _archetypeStorage(storageType == EntityStorageType::Archetypes ? std::make_unique<ArchetypeStorage>() : nullptr)
+    {}
+
     auto EntityRegistery::createEntity() -> Entity
     {
         auto entityId = invalidEntityId;
 
-        if (_freeEntities.empty())
+        if (_freeHead == endOfFreeList)
         {
-            _entitiesMask.emplaceBack();
-            entityId = _entitiesMask.size() - 1;
+            const auto index = static_cast<uint32>(_slots.size());
+            ensure(index != endOfFreeList, "Too many entities.");
+
+            entityId = makeEntityId(index, 0);
+            _slots.pushBack(entityId);
+            _signatures.emplaceBack();
         }
         else
         {
-            entityId = *_freeEntities.begin();
-            _freeEntities.erase(entityId);
+            // A free slot already carries the generation of its next entity.
+            const auto index = _freeHead;
+            entityId         = makeEntityId(index, entityGeneration(_slots[index]));
+            _freeHead        = entityIndex(_slots[index]);
+            _slots[index]    = entityId;
+        }
+
+        if (_archetypeStorage != nullptr)
+        {
+            _archetypeStorage->createEntity(entityId);
         }
 
+        ++_aliveCount;
         return Entity(*this, entityId);
     }
+
+    auto EntityRegistery::destroyEntity(EntityId id) -> void
+    {
+        if (not isAlive(id))
+        {
+            return;
+        }
+
+        const auto index = entityIndex(id);
+        auto&      mask  = _signatures[index];
+
+        for (auto bits = mask.to_ullong(); bits != 0; bits &= bits - 1)
+        {
+            ++_componentVersions[std::countr_zero(bits)];
+        }
+
+        if (_archetypeStorage != nullptr)
+        {
+            _archetypeStorage->destroyEntity(id);
+        }
+        else
+        {
+            for (usize componentId = 0; mask.any() and componentId < _componentPools.size(); ++componentId)
+            {
+                if (mask.test(componentId))
+                {
+                    _componentPools[componentId]->remove(id);
+                    mask.reset(componentId);
+                }
+            }
+        }
+        mask.reset();
+
+        const auto generation = entityGeneration(id) + 1;
+        _slots[index]         = makeEntityId(_freeHead, generation == reservedEntityGeneration ? 0 : generation);
+        _freeHead             = index;
+        --_aliveCount;
+    }
+
+    auto EntityRegistery::reserve(usize entityCount) -> void
+    {
+        _slots.reserve(entityCount);
+        _signatures.reserve(entityCount);
+    }
+
+    auto EntityRegistery::memoryUsage() const -> usize
+    {
+        auto bytes = _signatures.capacity() * sizeof(ComponentSignature) + _slots.capacity() * sizeof(EntityId);
+        for (const auto& pool : _componentPools)
+        {
+            bytes += pool != nullptr ? pool->memoryUsage() : 0;
+        }
+        return bytes + (_archetypeStorage != nullptr ? _archetypeStorage->memoryUsage() : 0);
+    }
 }
@@ -0,0 +1,247 @@
+#include "Scene/RenderExtractor.hpp"
+
+#include "Algorithm/RadixSort.hpp"
+#include "Debug/Ensure.hpp"
+#include "Math/Batch.hpp"
+#include "Scene/Components.hpp"
+
+#include <cmath>
+#include <functional>
+#include <utility>
+
+namespace qurb
+{
+    auto RenderExtractor::MeshKeyHash::operator()(const MeshKey& key) const -> usize
+    {
+        return std::hash<const void*>()(key.first) ^ (usize(key.second) * 0x9E3779B97F4A7C15ull);
+    }
+
+    auto RenderExtractor::MaterialKeyHash::operator()(const MaterialKey& key) const -> usize
+    {
+        const auto hasher = std::hash<const void*>();
+        return hasher(key.first) ^ (hasher(key.second) * 0x9E3779B97F4A7C15ull);
+    }
+
+    RenderExtractor::RenderExtractor(JobSystem* jobSystem)
+        : _jobSystem(jobSystem)
+    {}
+
+    auto RenderExtractor::extract(Scene& scene, RenderPacket& packet) -> void
+    {
+        packet.clear();
+        packet.frameIndex = _frameIndex++;
+        _meshHandles.clear();
+        _pipelineHandles.clear();
+        _materialHandles.clear();
+        _cullDraws.clear();
+        _localCenters.clear();
+        _localExtents.clear();
+
+        auto& registery       = scene.registery();
+        auto& transformSystem = scene.transformSystem();
+
+        // The first camera placed by the transform system is the one rendered.
+        for (auto [transformComponent, cameraComponent] : registery.view<TransformComponent, CameraComponent>())
+        {
+            if (transformComponent.worldIndex() == TransformComponent::invalidWorldIndex)
+            {
+                continue;
+            }
+
+            packet.view = RenderView {
+                .viewMatrix       = transformSystem.worldMatrix(transformComponent).affineInverse(),
+                .projectionMatrix = cameraComponent.projection(),
+                .valid            = true,
+            };
+            break;
+        }
+
+        const auto& viewMatrix = packet.view.viewMatrix;
+
+        auto drawables = registery.view<TransformComponent, MeshComponent, MaterialComponent>();
+        packet.worldMatrices.reserve(drawables.walkSize());
+        packet.draws.reserve(drawables.walkSize());
+
+        // Handles are numbered in order of first use, so the same scene always yields the same packet.
+        const auto addDraw = [&](TransformComponent& transformComponent, MeshComponent& meshComponent, MaterialComponent& materialComponent) {
+            const auto [meshIt, newMesh] = _meshHandles.try_emplace(
+                MeshKey(meshComponent.vertexBuffer, meshComponent.vertexCount),
+                static_cast<uint32>(packet.meshes.size()));
+            if (newMesh)
+            {
+                ensure(packet.meshes.size() < sortKey::maxMeshes, "More than {} meshes in a render packet.", sortKey::maxMeshes);
+                packet.meshes.pushBack(RenderMesh {.vertexBuffer = meshComponent.vertexBuffer, .vertexCount = meshComponent.vertexCount});
+            }
+
+            const auto [materialIt, newMaterial] = _materialHandles.try_emplace(
+                MaterialKey(materialComponent.shaderProgram, materialComponent.pipelineState),
+                static_cast<uint32>(packet.materials.size()));
+            if (newMaterial)
+            {
+                const auto [pipelineIt, newPipeline] =
+                    _pipelineHandles.try_emplace(materialComponent.pipelineState, static_cast<uint32>(packet.pipelines.size()));
+                if (newPipeline)
+                {
+                    ensure(packet.pipelines.size() < sortKey::maxPipelines, "More than {} pipelines in a render packet.", sortKey::maxPipelines);
+                    packet.pipelines.pushBack(RenderPipeline {.pipelineState = materialComponent.pipelineState});
+                }
+
+                ensure(packet.materials.size() < sortKey::maxMaterials, "More than {} materials in a render packet.", sortKey::maxMaterials);
+                packet.materials.pushBack(RenderMaterial {.pipeline = pipelineIt->second});
+            }
+
+            const auto  mesh        = meshIt->second;
+            const auto  material    = materialIt->second;
+            const auto  transform   = static_cast<uint32>(packet.worldMatrices.size());
+            const auto& worldMatrix = transformSystem.worldMatrix(transformComponent);
+
+            // The view space depth of the origin of the draw.
+            const auto depth =
+                viewMatrix[2, 0] * worldMatrix[0, 3] + viewMatrix[2, 1] * worldMatrix[1, 3] + viewMatrix[2, 2] * worldMatrix[2, 3] + viewMatrix[2, 3];
+
+            packet.worldMatrices.pushBack(worldMatrix);
+            packet.draws.pushBack(RenderDraw {
+                .sortKey   = makeSortKey(RenderPassType::Opaque, packet.materials[material].pipeline, material, mesh, depth),
+                .mesh      = mesh,
+                .material  = material,
+                .transform = transform,
+            });
+        };
+
+        const auto addPlacedDraw = [&](TransformComponent& transformComponent, MeshComponent& meshComponent, MaterialComponent& materialComponent) {
+            // Not placed by the transform system yet, there is no world matrix to draw it with.
+            if (transformComponent.worldIndex() != TransformComponent::invalidWorldIndex)
+            {
+                addDraw(transformComponent, meshComponent, materialComponent);
+            }
+        };
+
+        // Without a camera there is no frustum, every draw is kept and bounds are not needed.
+        if (not packet.view.valid)
+        {
+            drawables.each(addPlacedDraw);
+        }
+        else
+        {
+            // Bounded and unbounded drawables are walked apart, so that no bounds are looked up per draw.
+            registery.view<TransformComponent, MeshComponent, MaterialComponent, BoundsComponent>().each(
+                [&](TransformComponent& transformComponent, MeshComponent& meshComponent, MaterialComponent& materialComponent, BoundsComponent& bounds) {
+                    if (transformComponent.worldIndex() == TransformComponent::invalidWorldIndex)
+                    {
+                        return;
+                    }
+
+                    addDraw(transformComponent, meshComponent, materialComponent);
+                    _cullDraws.pushBack(static_cast<uint32>(packet.draws.size() - 1));
+                    _localCenters.pushBack(bounds.center);
+                    _localExtents.pushBack(bounds.extents);
+                });
+            drawables.exclude<BoundsComponent>().each(addPlacedDraw);
+        }
+
+        if (not _cullDraws.empty())
+        {
+            cullDraws(math::makeFrustum(packet.view.projectionMatrix * viewMatrix), packet);
+        }
+
+        _sortScratch.resize(packet.draws.size());
+        radixSort(std::span(packet.draws), std::span(_sortScratch), [](const RenderDraw& draw) { return draw.sortKey; });
+
+        batchDraws(packet);
+    }
+
+    auto RenderExtractor::cullDraws(const math::Frustum& frustum, RenderPacket& packet) -> void
+    {
+        const auto count = _cullDraws.size();
+        for (auto& stream : _worldBounds)
+        {
+            stream.resize(count);
+        }
+        _visibility.resize(count);
+
+        if (_jobSystem != nullptr and count >= parallelCullingThreshold)
+        {
+            // Ranges of whole registers, only the last one has a scalar tail.
+            constexpr auto grainSize = usize(4'096);
+            static_assert(grainSize % math::batch::width == 0);
+            _jobSystem->parallelFor(count, grainSize, [&](usize begin, usize end) { cullRange(frustum, packet, begin, end); });
+        }
+        else
+        {
+            cullRange(frustum, packet, 0, count);
+        }
+
+        // Drop the culled draws, their world matrices are left out by `batchDraws`.
+        _culled.clear();
+        _culled.resize(packet.draws.size(), 0);
+        for (usize i = 0; i < count; ++i)
+        {
+            _culled[_cullDraws[i]] = _visibility[i] == 0;
+        }
+
+        usize kept = 0;
+        for (usize i = 0; i < packet.draws.size(); ++i)
+        {
+            if (_culled[i] == 0)
+            {
+                packet.draws[kept++] = packet.draws[i];
+            }
+        }
+        packet.culledDrawCount = static_cast<uint32>(packet.draws.size() - kept);
+        packet.draws.resize(kept);
+    }
+
+    auto RenderExtractor::cullRange(const math::Frustum& frustum, const RenderPacket& packet, usize begin, usize end) -> void
+    {
+        auto& [centerX, centerY, centerZ, extentX, extentY, extentZ] = _worldBounds;
+        for (auto i = begin; i < end; ++i)
+        {
+            const auto& m       = packet.worldMatrices[packet.draws[_cullDraws[i]].transform];
+            const auto& center  = _localCenters[i];
+            const auto& extents = _localExtents[i];
+
+            // The box enclosing the transformed box: each world extent sums the absolute contributions of the local ones.
+            centerX[i] = m[0, 0] * center.x + m[0, 1] * center.y + m[0, 2] * center.z + m[0, 3];
+            centerY[i] = m[1, 0] * center.x + m[1, 1] * center.y + m[1, 2] * center.z + m[1, 3];
+            centerZ[i] = m[2, 0] * center.x + m[2, 1] * center.y + m[2, 2] * center.z + m[2, 3];
+            extentX[i] = std::abs(m[0, 0]) * extents.x + std::abs(m[0, 1]) * extents.y + std::abs(m[0, 2]) * extents.z;
+            extentY[i] = std::abs(m[1, 0]) * extents.x + std::abs(m[1, 1]) * extents.y + std::abs(m[1, 2]) * extents.z;
+            extentZ[i] = std::abs(m[2, 0]) * extents.x + std::abs(m[2, 1]) * extents.y + std::abs(m[2, 2]) * extents.z;
+        }
+
+        const auto boxes = math::batch::BoxStreams<const float32> {
+            .centerX = centerX,
+            .centerY = centerY,
+            .centerZ = centerZ,
+            .extentX = extentX,
+            .extentY = extentY,
+            .extentZ = extentZ,
+        };
+        math::batch::cullBoxes(frustum, boxes.subspan(begin, end - begin), std::span(_visibility).subspan(begin, end - begin));
+    }
+
+    auto RenderExtractor::batchDraws(RenderPacket& packet) -> void
+    {
+        // Store the world matrices in draw order, the instances of a batch are then contiguous.
+        const auto drawCount = static_cast<uint32>(packet.draws.size());
+        _matrixScratch.resize(drawCount);
+        for (uint32 i = 0; i < drawCount; ++i)
+        {
+            auto& draw        = packet.draws[i];
+            _matrixScratch[i] = packet.worldMatrices[draw.transform];
+            draw.transform    = i;
+        }
+        std::swap(packet.worldMatrices, _matrixScratch);
+
+        // Draws sharing a material and a mesh are next to each other once sorted.
+        for (uint32 i = 0; i < drawCount; ++i)
+        {
+            const auto& draw = packet.draws[i];
+            if (packet.batches.empty() or packet.batches.back().mesh != draw.mesh or packet.batches.back().material != draw.material)
+            {
+                packet.batches.pushBack(RenderBatch {.mesh = draw.mesh, .material = draw.material, .firstInstance = i, .instanceCount = 0});
+            }
+            ++packet.batches.back().instanceCount;
+        }
+    }
+}
@@ -0,0 +1,68 @@
+#include "Scene/RenderPacket.hpp"
+
+namespace qurb
+{
+    namespace
+    {
+        /// \brief FNV-1a over raw bytes.
+        auto hashBytes(uint64 hash, const void* data, usize size) -> uint64
+        {
+            const auto* bytes = static_cast<const uint8*>(data);
+            for (usize i = 0; i < size; ++i)
+            {
+                hash = (hash ^ bytes[i]) * 0x100000001B3ull;
+            }
+            return hash;
+        }
+
+        template <typename T>
+        auto hashVector(uint64 hash, const Vector<T>& vector) -> uint64
+        {
+            const auto size = vector.size();
+            hash            = hashBytes(hash, &size, sizeof(size));
+            return hashBytes(hash, vector.data(), vector.size() * sizeof(T));
+        }
+    }
+
+    auto RenderPacket::clear() -> void
+    {
+        view = RenderView();
+        meshes.clear();
+        pipelines.clear();
+        materials.clear();
+        worldMatrices.clear();
+        draws.clear();
+        batches.clear();
+        culledDrawCount = 0;
+    }
+
+    auto RenderPacket::checksum() const -> uint64
+    {
+        // Structures with padding are hashed field by field, the frame index is left out on purpose.
+        auto hash = 0xCBF29CE484222325ull;
+        hash      = hashBytes(hash, &view.valid, sizeof(bool));
+        hash      = hashBytes(hash, view.viewMatrix.data(), sizeof(math::Matrix4x4f));
+        hash      = hashBytes(hash, view.projectionMatrix.data(), sizeof(math::Matrix4x4f));
+        hash      = hashBytes(hash, &culledDrawCount, sizeof(culledDrawCount));
+        hash      = hashVector(hash, worldMatrices);
+
+        for (const auto& mesh : meshes)
+        {
+            hash = hashBytes(hash, &mesh.vertexBuffer, sizeof(mesh.vertexBuffer));
+            hash = hashBytes(hash, &mesh.vertexCount, sizeof(mesh.vertexCount));
+        }
+        for (const auto& pipeline : pipelines)
+        {
+            hash = hashBytes(hash, &pipeline.pipelineState, sizeof(pipeline.pipelineState));
+        }
+        hash = hashVector(hash, materials);
+        for (const auto& draw : draws)
+        {
+            hash = hashBytes(hash, &draw.sortKey, sizeof(draw.sortKey));
+            hash = hashBytes(hash, &draw.mesh, sizeof(draw.mesh));
+            hash = hashBytes(hash, &draw.material, sizeof(draw.material));
+            hash = hashBytes(hash, &draw.transform, sizeof(draw.transform));
+        }
+        return hashVector(hash, batches);
+    }
+}
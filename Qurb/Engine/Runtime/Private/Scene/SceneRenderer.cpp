@@ -3,9 +3,16 @@
 #include "Log/Log.hpp"
 #include "Scene/Components.hpp"
 
+#include <algorithm>
+
 namespace qurb
 {
-    auto SceneRenderer::render(rhi::RenderContext* renderContext) -> void
+    auto SceneRenderer::extract(RenderPacket& packet) -> void
+    {
+        _extractor.extract(_scene, packet);
+    }
+
+    auto SceneRenderer::render(rhi::RenderContext* renderContext, const RenderPacket& packet) -> void
     {
         static auto renderPassDescriptor = rhi::RenderPassDescriptor {
             .clearColor = Color::black,
@@ -18,36 +25,114 @@ namespace qurb
         // Geometry render pass.
         renderContext->beginRenderPass(renderTarget, renderPassDescriptor);
 
-        // Render all renderable objects in the scene here.
-        for (auto& entity : _scene._entities)
+        // The region of this frame holds the camera constants and every world matrix, with room for their alignment.
+        const auto constantsSize = 2 * sizeof(math::Matrix4x4f);
+        const auto instancesSize = packet.worldMatrices.size() * sizeof(math::Matrix4x4f);
+        _frameAllocator.beginFrame(constantsSize + instancesSize + 2 * rhi::FrameAllocator::defaultAlignment);
+
+        // Write the camera constants, before any draw depends on them.
+        if (packet.view.valid)
         {
-            auto& transformComponent = entity.getComponent<TransformComponent>();
+            const auto constants = _frameAllocator.allocateArray<math::Matrix4x4f>(2);
+            constants.as<math::Matrix4x4f>()[0] = packet.view.viewMatrix;
+            constants.as<math::Matrix4x4f>()[1] = packet.view.projectionMatrix;
 
-            const auto& transformMatrix = transformComponent.transformMatrix();
+            renderContext->bindVertexBuffer(constants.buffer, sceneConstantsSlot, static_cast<uint32>(constants.offset));
+        }
 
-            if (entity.hasComponent<CameraComponent>())
-            {
-                auto& cameraComponent = entity.getComponent<CameraComponent>();
+        // Write the world matrices of the frame at once, each batch draws a range of them.
+        if (not packet.batches.empty())
+        {
+            const auto instances = _frameAllocator.allocateArray<math::Matrix4x4f>(packet.worldMatrices.size());
+            std::ranges::copy(packet.worldMatrices, instances.as<math::Matrix4x4f>());
 
-                auto* data = _sceneConstantsBuffer->map<math::Matrix4x4f>();
-                data[0]    = transformMatrix.inverse();
-                data[1]    = cameraComponent.projection();
-                _sceneConstantsBuffer->unmap();
+            renderContext->bindVertexBuffer(instances.buffer, instanceBufferSlot, static_cast<uint32>(instances.offset));
+        }
 
-                renderContext->bindVertexBuffer(_sceneConstantsBuffer, 2, 0);
-            }
+        // Record the batches into command lists, in parallel for large packets, and submit them in order.
+        const auto listCount = (packet.batches.size() + batchesPerCommandList - 1) / batchesPerCommandList;
+        while (_commandLists.size() < listCount)
+        {
+            _commandLists.emplaceBack();
+        }
+        _commandListStatistics.resize(listCount);
 
-            if (entity.hasComponents<MeshComponent, MaterialComponent>())
+        auto recordList = [&](usize list) {
+            const auto begin = list * batchesPerCommandList;
+            const auto end   = std::min(begin + batchesPerCommandList, packet.batches.size());
+            _commandLists[list].reset();
+            _commandListStatistics[list] = RenderStatistics();
+            recordBatches(_commandLists[list], _commandListStatistics[list], packet, begin, end);
+        };
+        if (_jobSystem != nullptr and listCount > 1)
+        {
+            _jobSystem->parallelFor(listCount, 1, [&](usize begin, usize end) {
+                for (auto list = begin; list < end; ++list)
+                {
+                    recordList(list);
+                }
+            });
+        }
+        else
+        {
+            for (usize list = 0; list < listCount; ++list)
             {
-                auto [meshComponent, materialComponent] = entity.getComponents<MeshComponent, MaterialComponent>();
-
-                renderContext->bindPipelineState(materialComponent.pipelineState);
-                renderContext->pushConstants(&transformMatrix, sizeof(math::Matrix4x4f));
-                renderContext->bindVertexBuffer(meshComponent.vertexBuffer, 0, 0);
-                renderContext->draw(meshComponent.vertexCount, 0);
+                recordList(list);
             }
         }
 
+        _statistics = RenderStatistics {.drawsCulled = packet.culledDrawCount};
+        for (const auto& statistics : _commandListStatistics)
+        {
+            _statistics.drawsIssued += statistics.drawsIssued;
+            _statistics.instancesDrawn += statistics.instancesDrawn;
+            _statistics.pipelineBinds += statistics.pipelineBinds;
+            _statistics.vertexBufferBinds += statistics.vertexBufferBinds;
+            _statistics.bindsAvoided += statistics.bindsAvoided;
+        }
+
+        renderContext->executeCommandLists(std::span(_commandLists.data(), listCount));
+
         renderContext->endRenderPass();
     }
+
+    auto SceneRenderer::recordBatches(rhi::CommandList& commandList, RenderStatistics& statistics, const RenderPacket& packet, usize begin, usize end)
+        -> void
+    {
+        // The batches are sorted by state, only bind what changed since the previous batch.
+        auto* boundPipelineState = static_cast<rhi::PipelineState*>(nullptr);
+        auto* boundVertexBuffer  = static_cast<rhi::Buffer*>(nullptr);
+        for (auto i = begin; i < end; ++i)
+        {
+            const auto& batch         = packet.batches[i];
+            const auto& mesh          = packet.meshes[batch.mesh];
+            auto*       pipelineState = packet.pipelines[packet.materials[batch.material].pipeline].pipelineState;
+
+            if (pipelineState != boundPipelineState)
+            {
+                commandList.bindPipelineState(pipelineState);
+                boundPipelineState = pipelineState;
+                ++statistics.pipelineBinds;
+            }
+            else
+            {
+                ++statistics.bindsAvoided;
+            }
+
+            if (mesh.vertexBuffer != boundVertexBuffer)
+            {
+                commandList.bindVertexBuffer(mesh.vertexBuffer, vertexBufferSlot, 0);
+                boundVertexBuffer = mesh.vertexBuffer;
+                ++statistics.vertexBufferBinds;
+            }
+            else
+            {
+                ++statistics.bindsAvoided;
+            }
+
+            commandList.drawInstanced(mesh.vertexCount, 0, batch.instanceCount, batch.firstInstance);
+            ++statistics.drawsIssued;
+            statistics.instancesDrawn += batch.instanceCount;
+        }
+    }
 }
@@ -0,0 +1,547 @@
+#include "Scene/SpatialIndex.hpp"
+
+#include "Scene/Components.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace qurb
+{
+    SpatialIndex::SpatialIndex(float32 margin)
+        : _margin(margin)
+    {}
+
+    auto SpatialIndex::insert(EntityId entity, const math::Aabb& bounds) -> ProxyId
+    {
+        const auto leaf = allocateNode();
+        auto&      node = _nodes[leaf];
+        node.bounds     = bounds.expanded(_margin);
+        node.entity     = entity;
+        node.stamp      = _stamp;
+
+        insertLeaf(leaf);
+        ++_proxyCount;
+        return leaf;
+    }
+
+    auto SpatialIndex::remove(ProxyId proxy) -> void
+    {
+        ensure(proxy < _nodes.size() and _nodes[proxy].height == 0, "{} is not a proxy of the spatial index.", proxy);
+
+        removeLeaf(proxy);
+        freeNode(proxy);
+        --_proxyCount;
+    }
+
+    auto SpatialIndex::move(ProxyId proxy, const math::Aabb& bounds) -> bool
+    {
+        ensure(proxy < _nodes.size() and _nodes[proxy].height == 0, "{} is not a proxy of the spatial index.", proxy);
+
+        if (_nodes[proxy].bounds.contains(bounds))
+        {
+            return false;
+        }
+
+        removeLeaf(proxy);
+        _nodes[proxy].bounds = bounds.expanded(_margin);
+        insertLeaf(proxy);
+        return true;
+    }
+
+    auto SpatialIndex::clear() -> void
+    {
+        _nodes.clear();
+        _entityProxies.clear();
+        _pendingLeaves.clear();
+        _root       = invalidNode;
+        _freeHead   = invalidNode;
+        _proxyCount = 0;
+    }
+
+    auto SpatialIndex::rebuild() -> void
+    {
+        // Keep the leaves, in the tree or pending, and drop every internal node.
+        _buildLeaves.clear();
+        for (uint32 i = 0; i < _nodes.size(); ++i)
+        {
+            if (_nodes[i].height == 0)
+            {
+                _buildLeaves.pushBack(BuildLeaf {.node = i, .centroid = _nodes[i].bounds.center()});
+            }
+            else if (_nodes[i].height != freeHeight)
+            {
+                freeNode(i);
+            }
+        }
+
+        _root = _buildLeaves.empty() ? invalidNode : build(0, _buildLeaves.size(), 0);
+        if (_root != invalidNode)
+        {
+            _nodes[_root].parent = invalidNode;
+        }
+    }
+
+    auto SpatialIndex::update(EntityRegistery& registery, const TransformSystem& transformSystem) -> void
+    {
+        ++_stamp;
+        _reinsertedCount = 0;
+        _pendingLeaves.clear();
+
+        // Sized once for every slot, growing per entity would copy the proxies for each new index.
+        if (_entityProxies.size() < registery.slotCount())
+        {
+            _entityProxies.resize(registery.slotCount(), invalidNode);
+        }
+
+        usize seenCount = 0;
+        registery.view<TransformComponent, BoundsComponent>().each(
+            [&](EntityId id, TransformComponent& transformComponent, BoundsComponent& boundsComponent) {
+                // Not placed by the transform system yet.
+                if (transformComponent.worldIndex() == TransformComponent::invalidWorldIndex)
+                {
+                    return;
+                }
+
+                const auto index = entityIndex(id);
+                const auto worldBounds = [&] {
+                    const auto localBounds = math::Aabb::fromCenterExtents(boundsComponent.center, boundsComponent.extents);
+                    return math::transformAabb(transformSystem.worldMatrix(transformComponent), localBounds);
+                };
+
+                ++seenCount;
+                auto& proxy = _entityProxies[index];
+                if (proxy != invalidNode and _nodes[proxy].entity == id)
+                {
+                    _nodes[proxy].stamp = _stamp;
+                    if (transformSystem.updated(transformComponent) and move(proxy, worldBounds()))
+                    {
+                        ++_reinsertedCount;
+                    }
+                    return;
+                }
+
+                // The slot still maps to the leaf of a destroyed entity.
+                if (proxy != invalidNode)
+                {
+                    remove(proxy);
+                }
+
+                // New leaves are inserted at the end, all at once when they are the majority.
+                proxy       = allocateNode();
+                auto& node  = _nodes[proxy];
+                node.bounds = worldBounds().expanded(_margin);
+                node.entity = id;
+                node.stamp  = _stamp;
+                _pendingLeaves.pushBack(proxy);
+                ++_proxyCount;
+            });
+
+        // Every tracked entity maps to its own leaf, so there are more leaves than seen entities only when some are gone.
+        if (_proxyCount > seenCount)
+        {
+            for (uint32 i = 0; i < _nodes.size(); ++i)
+            {
+                const auto& node = _nodes[i];
+                if (node.height != 0 or node.stamp == _stamp)
+                {
+                    continue;
+                }
+
+                const auto index = entityIndex(node.entity);
+                if (index < _entityProxies.size() and _entityProxies[index] == i)
+                {
+                    _entityProxies[index] = invalidNode;
+                }
+                remove(i);
+            }
+        }
+
+        if (_pendingLeaves.size() > _proxyCount - _pendingLeaves.size())
+        {
+            rebuild();
+        }
+        else
+        {
+            for (const auto leaf : _pendingLeaves)
+            {
+                insertLeaf(leaf);
+            }
+        }
+        _pendingLeaves.clear();
+    }
+
+    auto SpatialIndex::raycast(const math::Ray& ray, float32 maxDistance) const -> RayHit
+    {
+        struct Entry
+        {
+            uint32  node;
+            float32 distance;
+        };
+
+        auto hit = RayHit();
+        if (_root == invalidNode)
+        {
+            return hit;
+        }
+
+        const auto inverseDirection = math::Vector3f(1.0f / ray.direction.x, 1.0f / ray.direction.y, 1.0f / ray.direction.z);
+        auto       closest          = maxDistance;
+
+        auto  stack = std::array<Entry, maxDepth>();
+        usize size  = 0;
+        if (auto distance = 0.0f; math::intersectRay(_nodes[_root].bounds, ray.origin, inverseDirection, closest, distance))
+        {
+            stack[size++] = Entry {.node = _root, .distance = distance};
+        }
+
+        while (size > 0)
+        {
+            const auto entry = stack[--size];
+            if (entry.distance > closest)
+            {
+                continue;
+            }
+
+            const auto& node = _nodes[entry.node];
+            if (node.leaf())
+            {
+                hit     = RayHit {.entity = node.entity, .distance = entry.distance};
+                closest = entry.distance;
+                continue;
+            }
+
+            // Push the farther child first, so that the nearer one is popped next and shrinks `closest` sooner.
+            auto children = std::array<Entry, 2>();
+            auto count    = usize(0);
+            for (const auto child : node.children)
+            {
+                if (auto distance = 0.0f; math::intersectRay(_nodes[child].bounds, ray.origin, inverseDirection, closest, distance))
+                {
+                    children[count++] = Entry {.node = child, .distance = distance};
+                }
+            }
+            if (count == 2 and children[0].distance < children[1].distance)
+            {
+                std::swap(children[0], children[1]);
+            }
+
+            ensure(size + count <= maxDepth, "Spatial index deeper than {} levels.", maxDepth);
+            for (usize i = 0; i < count; ++i)
+            {
+                stack[size++] = children[i];
+            }
+        }
+        return hit;
+    }
+
+    auto SpatialIndex::areaRatio() const -> float32
+    {
+        if (_root == invalidNode or _nodes[_root].leaf())
+        {
+            return 0.0f;
+        }
+
+        auto area = 0.0f;
+        for (const auto& node : _nodes)
+        {
+            if (node.height > 0)
+            {
+                area += node.bounds.surfaceArea();
+            }
+        }
+        return area / _nodes[_root].bounds.surfaceArea();
+    }
+
+    auto SpatialIndex::allocateNode() -> uint32
+    {
+        auto index = _freeHead;
+        if (index == invalidNode)
+        {
+            index = static_cast<uint32>(_nodes.size());
+            ensure(index != invalidNode, "Too many spatial index nodes.");
+            _nodes.emplaceBack();
+        }
+        else
+        {
+            _freeHead = _nodes[index].parent;
+        }
+
+        _nodes[index] = Node {
+            .bounds   = math::Aabb(),
+            .entity   = invalidEntityId,
+            .parent   = invalidNode,
+            .children = {invalidNode, invalidNode},
+            .height   = 0,
+            .stamp    = 0,
+        };
+        return index;
+    }
+
+    auto SpatialIndex::freeNode(uint32 node) -> void
+    {
+        _nodes[node].parent = _freeHead;
+        _nodes[node].height = freeHeight;
+        _freeHead           = node;
+    }
+
+    auto SpatialIndex::insertLeaf(uint32 leaf) -> void
+    {
+        if (_root == invalidNode)
+        {
+            _root               = leaf;
+            _nodes[leaf].parent = invalidNode;
+            return;
+        }
+
+        // Walk down to the sibling that grows the tree surface the least, an internal node is only descended into while
+        // pairing the leaf with one of its children costs less than pairing it with the node itself.
+        const auto leafBounds = _nodes[leaf].bounds;
+        auto       sibling    = _root;
+        while (not _nodes[sibling].leaf())
+        {
+            const auto& node         = _nodes[sibling];
+            const auto  area         = node.bounds.surfaceArea();
+            const auto  combinedArea = math::merge(node.bounds, leafBounds).surfaceArea();
+            const auto  cost         = 2.0f * combinedArea;
+            const auto  inheritance  = 2.0f * (combinedArea - area);  // Paid by every ancestor of a deeper pairing.
+
+            const auto childCost = [&](uint32 child) {
+                const auto& childNode = _nodes[child];
+                const auto  enlarged  = math::merge(childNode.bounds, leafBounds).surfaceArea();
+                return (childNode.leaf() ? enlarged : enlarged - childNode.bounds.surfaceArea()) + inheritance;
+            };
+
+            const auto cost0 = childCost(node.children[0]);
+            const auto cost1 = childCost(node.children[1]);
+            if (cost < cost0 and cost < cost1)
+            {
+                break;
+            }
+            sibling = cost0 < cost1 ? node.children[0] : node.children[1];
+        }
+
+        const auto oldParent = _nodes[sibling].parent;
+        const auto newParent = allocateNode();
+
+        auto& parentNode    = _nodes[newParent];
+        parentNode.bounds   = math::merge(leafBounds, _nodes[sibling].bounds);
+        parentNode.parent   = oldParent;
+        parentNode.children = {sibling, leaf};
+        parentNode.height   = _nodes[sibling].height + 1;
+
+        if (oldParent == invalidNode)
+        {
+            _root = newParent;
+        }
+        else
+        {
+            auto& children                           = _nodes[oldParent].children;
+            children[children[0] == sibling ? 0 : 1] = newParent;
+        }
+        _nodes[sibling].parent = newParent;
+        _nodes[leaf].parent    = newParent;
+
+        refitAncestors(newParent);
+    }
+
+    auto SpatialIndex::removeLeaf(uint32 leaf) -> void
+    {
+        if (leaf == _root)
+        {
+            _root = invalidNode;
+            return;
+        }
+
+        // The sibling takes the place of the parent.
+        const auto parent      = _nodes[leaf].parent;
+        const auto grandParent = _nodes[parent].parent;
+        const auto sibling     = _nodes[parent].children[_nodes[parent].children[0] == leaf ? 1 : 0];
+
+        _nodes[sibling].parent = grandParent;
+        _nodes[leaf].parent    = invalidNode;
+        freeNode(parent);
+
+        if (grandParent == invalidNode)
+        {
+            _root = sibling;
+            return;
+        }
+
+        auto& children                          = _nodes[grandParent].children;
+        children[children[0] == parent ? 0 : 1] = sibling;
+        refitAncestors(grandParent);
+    }
+
+    auto SpatialIndex::refitAncestors(uint32 node) -> void
+    {
+        for (auto index = node; index != invalidNode;)
+        {
+            index = balance(index);
+
+            auto&       current = _nodes[index];
+            const auto& child0  = _nodes[current.children[0]];
+            const auto& child1  = _nodes[current.children[1]];
+            current.bounds      = math::merge(child0.bounds, child1.bounds);
+            current.height      = 1 + std::max(child0.height, child1.height);
+            index               = current.parent;
+        }
+    }
+
+    auto SpatialIndex::balance(uint32 a) -> uint32
+    {
+        auto& nodeA = _nodes[a];
+        if (nodeA.leaf() or nodeA.height < 2)
+        {
+            return a;
+        }
+
+        const auto difference = _nodes[nodeA.children[1]].height - _nodes[nodeA.children[0]].height;
+        if (difference >= -1 and difference <= 1)
+        {
+            return a;
+        }
+
+        // The taller child `c` takes the place of `a`, which becomes its first child. The taller grandchild stays under
+        // `c`, the other one replaces `c` under `a`.
+        const auto tall  = difference > 1 ? 1 : 0;
+        const auto b     = nodeA.children[1 - tall];
+        const auto c     = nodeA.children[tall];
+        auto&      nodeC = _nodes[c];
+
+        const auto f    = nodeC.children[0];
+        const auto g    = nodeC.children[1];
+        const auto keep = _nodes[f].height > _nodes[g].height ? f : g;
+        const auto move = keep == f ? g : f;
+
+        nodeC.children[0] = a;
+        nodeC.parent      = nodeA.parent;
+        nodeA.parent      = c;
+        if (nodeC.parent == invalidNode)
+        {
+            _root = c;
+        }
+        else
+        {
+            auto& children                     = _nodes[nodeC.parent].children;
+            children[children[0] == a ? 0 : 1] = c;
+        }
+
+        nodeC.children[1]    = keep;
+        nodeA.children[tall] = move;
+        _nodes[move].parent  = a;
+
+        nodeA.bounds = math::merge(_nodes[b].bounds, _nodes[move].bounds);
+        nodeA.height = 1 + std::max(_nodes[b].height, _nodes[move].height);
+        nodeC.bounds = math::merge(nodeA.bounds, _nodes[keep].bounds);
+        nodeC.height = 1 + std::max(nodeA.height, _nodes[keep].height);
+        return c;
+    }
+
+    auto SpatialIndex::build(usize begin, usize end, uint32 depth) -> uint32
+    {
+        const auto count = end - begin;
+        if (count == 1)
+        {
+            return _buildLeaves[begin].node;
+        }
+
+        // Split along the axis where the centroids spread the most.
+        auto centroidBounds = math::Aabb {.lower = _buildLeaves[begin].centroid, .upper = _buildLeaves[begin].centroid};
+        for (auto i = begin + 1; i < end; ++i)
+        {
+            const auto& centroid = _buildLeaves[i].centroid;
+            centroidBounds       = math::merge(centroidBounds, math::Aabb {.lower = centroid, .upper = centroid});
+        }
+
+        const auto spread = centroidBounds.upper - centroidBounds.lower;
+        const auto axis   = spread.x >= spread.y and spread.x >= spread.z ? usize(0) : (spread.y >= spread.z ? usize(1) : usize(2));
+        const auto first  = _buildLeaves.begin() + begin;
+        const auto last   = _buildLeaves.begin() + end;
+
+        auto split = begin + count / 2;
+        if (count <= medianSplitThreshold or depth >= medianSplitDepth or spread[axis] <= 0.0f)
+        {
+            std::nth_element(first, _buildLeaves.begin() + split, last, [axis](const BuildLeaf& lhs, const BuildLeaf& rhs) {
+                return lhs.centroid[axis] < rhs.centroid[axis];
+            });
+        }
+        else
+        {
+            struct Bin
+            {
+                math::Aabb bounds;
+                usize      count = 0;
+            };
+
+            const auto origin   = centroidBounds.lower[axis];
+            const auto scale    = static_cast<float32>(binCount) / spread[axis];
+            const auto binIndex = [&](const BuildLeaf& leaf) {
+                return std::min(binCount - 1, static_cast<usize>((leaf.centroid[axis] - origin) * scale));
+            };
+
+            auto bins = std::array<Bin, binCount>();
+            for (auto i = begin; i < end; ++i)
+            {
+                auto&       bin    = bins[binIndex(_buildLeaves[i])];
+                const auto& bounds = _nodes[_buildLeaves[i].node].bounds;
+                bin.bounds         = bin.count == 0 ? bounds : math::merge(bin.bounds, bounds);
+                ++bin.count;
+            }
+
+            // The cost of splitting after bin `i` is the area of each side times its leaf count.
+            auto rightCosts = std::array<float32, binCount>();
+            auto rightBounds = math::Aabb();
+            auto rightCount  = usize(0);
+            for (auto i = binCount - 1; i > 0; --i)
+            {
+                if (bins[i].count != 0)
+                {
+                    rightBounds = rightCount == 0 ? bins[i].bounds : math::merge(rightBounds, bins[i].bounds);
+                    rightCount += bins[i].count;
+                }
+                rightCosts[i - 1] = rightCount == 0 ? 0.0f : rightBounds.surfaceArea() * static_cast<float32>(rightCount);
+            }
+
+            auto bestBin    = binCount;
+            auto bestCost   = 0.0f;
+            auto leftBounds = math::Aabb();
+            auto leftCount  = usize(0);
+            for (usize i = 0; i + 1 < binCount; ++i)
+            {
+                if (bins[i].count != 0)
+                {
+                    leftBounds = leftCount == 0 ? bins[i].bounds : math::merge(leftBounds, bins[i].bounds);
+                    leftCount += bins[i].count;
+                }
+                if (leftCount == 0 or leftCount == count)
+                {
+                    continue;
+                }
+
+                const auto cost = leftBounds.surfaceArea() * static_cast<float32>(leftCount) + rightCosts[i];
+                if (bestBin == binCount or cost < bestCost)
+                {
+                    bestBin  = i;
+                    bestCost = cost;
+                }
+            }
+
+            // The centroids spread along the axis, so the first and last bins are never empty and a split exists.
+            const auto middle = std::partition(first, last, [&](const BuildLeaf& leaf) { return binIndex(leaf) <= bestBin; });
+            split             = begin + static_cast<usize>(middle - first);
+        }
+
+        const auto left  = build(begin, split, depth + 1);
+        const auto right = build(split, end, depth + 1);
+        const auto node  = allocateNode();
+
+        auto& parent    = _nodes[node];
+        parent.bounds   = math::merge(_nodes[left].bounds, _nodes[right].bounds);
+        parent.children = {left, right};
+        parent.height   = 1 + std::max(_nodes[left].height, _nodes[right].height);
+
+        _nodes[left].parent  = node;
+        _nodes[right].parent = node;
+        return node;
+    }
+}
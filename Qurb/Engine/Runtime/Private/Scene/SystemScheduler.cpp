@@ -0,0 +1,120 @@
+#include "Scene/SystemScheduler.hpp"
+
+#include "Log/Log.hpp"
+
+#include <chrono>
+
+namespace qurb
+{
+    namespace
+    {
+        using Clock    = std::chrono::steady_clock;
+        using Duration = std::chrono::duration<float64, std::milli>;
+    }
+
+    SystemScheduler::SystemScheduler(JobSystem& jobSystem)
+        : _jobSystem(jobSystem)
+    {}
+
+    auto SystemScheduler::addSystem(std::string name, const SystemAccess& access, SystemFunction function) -> void
+    {
+        _systems.pushBack(System {
+            .function        = std::move(function),
+            .access          = access,
+            .successors      = {},
+            .dependencyCount = 0,
+        });
+        _timings.pushBack(SystemTiming {.name = std::move(name), .milliseconds = 0.0});
+        _graphDirty = true;
+    }
+
+    auto SystemScheduler::run(EntityRegistery& registery, float32 deltaTime) -> void
+    {
+        if (_graphDirty)
+        {
+            buildGraph();
+        }
+
+        const auto start   = Clock::now();
+        const auto context = SystemContext(registery, _commands, _jobSystem, deltaTime);
+
+        auto counter = JobCounter(0);
+        for (uint32 i = 0; i < _systems.size(); ++i)
+        {
+            _pendingDependencies[i].store(_systems[i].dependencyCount, std::memory_order_relaxed);
+        }
+        for (uint32 i = 0; i < _systems.size(); ++i)
+        {
+            if (_systems[i].dependencyCount == 0)
+            {
+                schedule(i, context, counter);
+            }
+        }
+        _jobSystem.wait(counter);
+
+        _commands.playback(registery);
+
+        _frameMilliseconds = Duration(Clock::now() - start).count();
+    }
+
+    auto SystemScheduler::logTimings() const -> void
+    {
+        auto serialMilliseconds = 0.0;
+        for (const auto& timing : _timings)
+        {
+            Log::info("System {:<32} {:>8.3f} ms", timing.name, timing.milliseconds);
+            serialMilliseconds += timing.milliseconds;
+        }
+
+        Log::info(
+            "Systems ran in {:.3f} ms for {:.3f} ms of work (x{:.2f}) on {} workers",
+            _frameMilliseconds,
+            serialMilliseconds,
+            _frameMilliseconds > 0.0 ? serialMilliseconds / _frameMilliseconds : 0.0,
+            _jobSystem.workerCount());
+    }
+
+    auto SystemScheduler::buildGraph() -> void
+    {
+        for (auto& system : _systems)
+        {
+            system.successors.clear();
+            system.dependencyCount = 0;
+        }
+
+        for (uint32 j = 0; j < _systems.size(); ++j)
+        {
+            for (uint32 i = 0; i < j; ++i)
+            {
+                if (_systems[i].access.conflictsWith(_systems[j].access))
+                {
+                    _systems[i].successors.pushBack(j);
+                    ++_systems[j].dependencyCount;
+                }
+            }
+        }
+
+        _pendingDependencies = std::make_unique<JobCounter[]>(_systems.size());
+        _graphDirty          = false;
+    }
+
+    auto SystemScheduler::schedule(uint32 system, const SystemContext& context, JobCounter& counter) -> void
+    {
+        _jobSystem.submit(
+            [this, system, &context, &counter] {
+                const auto start = Clock::now();
+                _systems[system].function(context);
+                _timings[system].milliseconds = Duration(Clock::now() - start).count();
+
+                // Successors are queued before this job completes, so `counter` cannot reach zero in between.
+                for (const auto successor : _systems[system].successors)
+                {
+                    if (_pendingDependencies[successor].fetch_sub(1, std::memory_order_acq_rel) == 1)
+                    {
+                        schedule(successor, context, counter);
+                    }
+                }
+            },
+            counter);
+    }
+}
@@ -0,0 +1,359 @@
+#include "Scene/TransformSystem.hpp"
+
+#include "Debug/Ensure.hpp"
+#include "Math/Batch.hpp"
+
+#include <algorithm>
+#include <span>
+
+namespace qurb
+{
+    auto TransformSystem::setParent(EntityRegistery& registery, EntityId child, EntityId parent) -> void
+    {
+        ensure(registery.isAlive(child), "Cannot reparent the stale entity {}.", child);
+        ensure(parent == invalidEntityId or registery.isAlive(parent), "Cannot parent {} to the stale entity {}.", child, parent);
+
+        // Walk up from the new parent, meeting the child would make a cycle.
+        for (auto ancestor = parent; ancestor != invalidEntityId;)
+        {
+            ensure(ancestor != child, "Parenting {} to {} would create a cycle.", child, parent);
+            ancestor = registery.hasComponent<ParentComponent>(ancestor) ? registery.getComponent<ParentComponent>(ancestor).parent : invalidEntityId;
+        }
+
+        // With archetype storage adding a component moves the entity, so no component reference is kept across adds.
+        if (registery.hasComponent<ParentComponent>(child))
+        {
+            const auto previous = registery.getComponent<ParentComponent>(child).parent;
+            if (previous == parent)
+            {
+                return;
+            }
+
+            if (registery.hasComponent<ChildrenComponent>(previous))
+            {
+                auto&      siblings = registery.getComponent<ChildrenComponent>(previous).children;
+                const auto it       = std::find(siblings.begin(), siblings.end(), child);
+                if (it != siblings.end())
+                {
+                    siblings.erase(it);
+                }
+            }
+        }
+
+        if (parent == invalidEntityId)
+        {
+            registery.removeComponent<ParentComponent>(child);
+        }
+        else
+        {
+            if (not registery.hasComponent<ParentComponent>(child))
+            {
+                registery.addComponent<ParentComponent>(child);
+            }
+            registery.getComponent<ParentComponent>(child).parent = parent;
+
+            if (not registery.hasComponent<ChildrenComponent>(parent))
+            {
+                registery.addComponent<ChildrenComponent>(parent);
+            }
+            registery.getComponent<ChildrenComponent>(parent).children.pushBack(child);
+        }
+
+        if (registery.hasComponent<TransformComponent>(child))
+        {
+            registery.getComponent<TransformComponent>(child)._worldDirty = true;
+        }
+        _hierarchyChanged = true;
+    }
+
+    auto TransformSystem::update(EntityRegistery& registery) -> void
+    {
+        // The flags of the previous update are kept for `updated`, clear the ones that were set.
+        for (const auto node : _updatedNodes)
+        {
+            _dirtyNodes[node] = 0;
+        }
+        _updatedNodes.clear();
+
+        // Transforms or parents added or removed since the last rebuild invalidate the order and the world indices.
+        if (_hierarchyChanged or registery.componentVersion<TransformComponent>() != _transformVersion or
+            registery.componentVersion<ParentComponent>() != _parentVersion)
+        {
+            rebuild(registery);
+            return;
+        }
+
+        collectChangedNodes(registery);
+        if (_changedNodes.empty())
+        {
+            return;
+        }
+
+        // Many changes: one pass over every node in order is cheaper than sorting them and walking their subtrees.
+        if (_changedNodes.size() * 4 >= _nodes.size())
+        {
+            collectStaleLocals(registery);
+            composeLocalMatrices();
+            for (const auto node : _changedNodes)
+            {
+                _dirtyNodes[node] = 1;
+            }
+            updateDirtyNodes(registery);
+            return;
+        }
+
+        // Components do not move until the end of the update, the pointers gathered here stay valid.
+        for (const auto node : _changedNodes)
+        {
+            auto& transformComponent = registery.getComponent<TransformComponent>(_nodes[node].entity);
+            if (transformComponent._localDirty)
+            {
+                _staleLocals.pushBack(&transformComponent);
+            }
+        }
+        composeLocalMatrices();
+
+        // Parents first, a changed node below another one was already recomputed with the subtree of its ancestor.
+        std::sort(_changedNodes.begin(), _changedNodes.end());
+        for (const auto node : _changedNodes)
+        {
+            if (_dirtyNodes[node] == 0)
+            {
+                updateSubtree(registery, node);
+            }
+        }
+    }
+
+    auto TransformSystem::collectChangedNodes(EntityRegistery& registery) -> void
+    {
+        _changedNodes.clear();
+
+        const auto count = _changes._count.exchange(0, std::memory_order_relaxed);
+        if (count <= _changes._indices.size())
+        {
+            for (usize i = 0; i < count; ++i)
+            {
+                _changedNodes.pushBack(_changes._indices[i]);
+            }
+            return;
+        }
+
+        // Only a transform pushed twice overflows the list, fall back to looking at every transform once.
+        registery.each<TransformComponent>([&](const TransformComponent& transformComponent) {
+            if (transformComponent._worldDirty)
+            {
+                _changedNodes.pushBack(transformComponent._worldIndex);
+            }
+        });
+    }
+
+    auto TransformSystem::updateSubtree(EntityRegistery& registery, uint32 root) -> void
+    {
+        _subtreeStack.clear();
+        _subtreeStack.pushBack(root);
+        while (not _subtreeStack.empty())
+        {
+            const auto index = _subtreeStack.back();
+            _subtreeStack.popBack();
+
+            const auto& node               = _nodes[index];
+            auto&       transformComponent = registery.getComponent<TransformComponent>(node.entity);
+            const auto& localMatrix        = transformComponent.transformMatrix();
+
+            _worldMatrices[index]          = node.parent == invalidNode ? localMatrix : _worldMatrices[node.parent] * localMatrix;
+            _dirtyNodes[index]             = 1;
+            transformComponent._worldDirty = false;
+            _updatedNodes.pushBack(index);
+
+            for (auto child = node.firstChild; child < node.firstChild + node.childCount; ++child)
+            {
+                _subtreeStack.pushBack(child);
+            }
+        }
+    }
+
+    auto TransformSystem::rebuild(EntityRegistery& registery) -> void
+    {
+        collectStaleLocals(registery);
+        composeLocalMatrices();
+
+        _nodes.clear();
+
+        // Roots first: transforms without a parent, or whose parent is gone or has no transform.
+        registery.each<TransformComponent>([&](EntityId id, TransformComponent& transformComponent) {
+            transformComponent._worldIndex = invalidNode;
+
+            if (registery.hasComponent<ParentComponent>(id))
+            {
+                const auto parent = registery.getComponent<ParentComponent>(id).parent;
+                if (registery.hasComponent<TransformComponent>(parent))
+                {
+                    return;
+                }
+            }
+
+            transformComponent._worldIndex = static_cast<uint32>(_nodes.size());
+            _nodes.pushBack(Node {.entity = id, .parent = invalidNode, .firstChild = 0, .childCount = 0});
+        });
+
+        // Then breadth first, the children of every node are appended together after it.
+        auto expand = [&](uint32 first) {
+            for (auto i = first; i < _nodes.size(); ++i)
+            {
+                const auto entity = _nodes[i].entity;
+                if (not registery.hasComponent<ChildrenComponent>(entity))
+                {
+                    continue;
+                }
+
+                // Children destroyed or moved to another parent are pruned, the lists do not grow under spawn and despawn.
+                auto&      children   = registery.getComponent<ChildrenComponent>(entity).children;
+                auto*      kept       = children.begin();
+                const auto firstChild = static_cast<uint32>(_nodes.size());
+                for (const auto child : children)
+                {
+                    if (not registery.hasComponent<ParentComponent>(child) or registery.getComponent<ParentComponent>(child).parent != entity)
+                    {
+                        continue;
+                    }
+                    *kept++ = child;
+
+                    if (registery.hasComponent<TransformComponent>(child))
+                    {
+                        registery.getComponent<TransformComponent>(child)._worldIndex = static_cast<uint32>(_nodes.size());
+                        _nodes.pushBack(Node {.entity = child, .parent = i, .firstChild = 0, .childCount = 0});
+                    }
+                }
+                children.erase(kept, children.end());
+
+                _nodes[i].firstChild = firstChild;
+                _nodes[i].childCount = static_cast<uint32>(_nodes.size()) - firstChild;
+            }
+        };
+        expand(0);
+
+        // A transform whose parent does not list it among its children was not reached, it is treated as a root.
+        const auto reachedCount = static_cast<uint32>(_nodes.size());
+        registery.each<TransformComponent>([&](EntityId id, TransformComponent& transformComponent) {
+            if (transformComponent._worldIndex == invalidNode)
+            {
+                transformComponent._worldIndex = static_cast<uint32>(_nodes.size());
+                _nodes.pushBack(Node {.entity = id, .parent = invalidNode, .firstChild = 0, .childCount = 0});
+            }
+        });
+        expand(reachedCount);
+
+        _worldMatrices.resize(_nodes.size());
+        _dirtyNodes.resize(_nodes.size());
+        std::fill(_dirtyNodes.begin(), _dirtyNodes.end(), uint8(1));
+        updateDirtyNodes(registery);
+
+        // One slot per transform, a transform is pushed once between two updates.
+        _changes._indices.resize(_nodes.size());
+        _changes._count.store(0, std::memory_order_relaxed);
+
+        _transformVersion = registery.componentVersion<TransformComponent>();
+        _parentVersion    = registery.componentVersion<ParentComponent>();
+        _hierarchyChanged = false;
+    }
+
+    auto TransformSystem::updateDirtyNodes(EntityRegistery& registery) -> void
+    {
+        // Parents come first, so a node is dirty once its own flag or its parent's is set.
+        for (uint32 i = 0; i < _nodes.size(); ++i)
+        {
+            const auto& node = _nodes[i];
+            if (node.parent != invalidNode and _dirtyNodes[node.parent] != 0)
+            {
+                _dirtyNodes[i] = 1;
+            }
+            if (_dirtyNodes[i] == 0)
+            {
+                continue;
+            }
+
+            auto&       transformComponent = registery.getComponent<TransformComponent>(node.entity);
+            const auto& localMatrix        = transformComponent.transformMatrix();
+
+            _worldMatrices[i]              = node.parent == invalidNode ? localMatrix : _worldMatrices[node.parent] * localMatrix;
+            transformComponent._worldDirty = false;
+            transformComponent._changes    = &_changes;
+            _updatedNodes.pushBack(i);
+        }
+    }
+
+    auto TransformSystem::collectStaleLocals(EntityRegistery& registery) -> void
+    {
+        registery.each<TransformComponent>([&](TransformComponent& transformComponent) {
+            if (transformComponent._localDirty)
+            {
+                _staleLocals.pushBack(&transformComponent);
+            }
+        });
+    }
+
+    auto TransformSystem::composeLocalMatrices() -> void
+    {
+        const auto count = _staleLocals.size();
+        if (count == 0)
+        {
+            return;
+        }
+
+        // The euler to quaternion conversion stays scalar, the matrices are then built `math::batch::width` at a time.
+        _localStreams.resize(count * 10);
+        auto stream = [&](usize component) {
+            return std::span<float32>(_localStreams.data() + component * count, count);
+        };
+
+        const auto positionX = stream(0);
+        const auto positionY = stream(1);
+        const auto positionZ = stream(2);
+        const auto rotationX = stream(3);
+        const auto rotationY = stream(4);
+        const auto rotationZ = stream(5);
+        const auto rotationW = stream(6);
+        const auto scaleX    = stream(7);
+        const auto scaleY    = stream(8);
+        const auto scaleZ    = stream(9);
+        for (usize i = 0; i < count; ++i)
+        {
+            const auto* transformComponent = _staleLocals[i];
+            const auto  rotation           = math::QuaternionF(transformComponent->_eulerAngles);
+
+            positionX[i] = transformComponent->_position.x;
+            positionY[i] = transformComponent->_position.y;
+            positionZ[i] = transformComponent->_position.z;
+            rotationX[i] = rotation.x();
+            rotationY[i] = rotation.y();
+            rotationZ[i] = rotation.z();
+            rotationW[i] = rotation.w();
+            scaleX[i]    = transformComponent->_scale.x;
+            scaleY[i]    = transformComponent->_scale.y;
+            scaleZ[i]    = transformComponent->_scale.z;
+        }
+
+        _localMatrices.resize(count);
+        math::batch::composeMatrices(
+            math::batch::TransformStreams {
+                .positionX = positionX,
+                .positionY = positionY,
+                .positionZ = positionZ,
+                .rotationX = rotationX,
+                .rotationY = rotationY,
+                .rotationZ = rotationZ,
+                .rotationW = rotationW,
+                .scaleX    = scaleX,
+                .scaleY    = scaleY,
+                .scaleZ    = scaleZ,
+            },
+            std::span(_localMatrices.data(), count));
+
+        for (usize i = 0; i < count; ++i)
+        {
+            _staleLocals[i]->_localMatrix = _localMatrices[i];
+            _staleLocals[i]->_localDirty  = false;
+        }
+        _staleLocals.clear();
+    }
+}
@@ -2,20 +2,36 @@
 
 #pragma once
 
+#include "Core/FramePipeline.hpp"
 #include "CoreDefines.hpp"
 #include "CoreTypes.hpp"
+#include "Platform/Detection.hpp"
 
 #include <memory>
 #include <string>
+#include <string_view>
 
 namespace qurb
 {
     class Engine;
 
+    /// \brief The render backend plugin of the platform, the null backend where no GPU backend exists yet.
+#ifdef QURB_PLATFORM_MACOS
+    inline constexpr auto defaultRenderBackend = std::string_view("QurbMetalRHI");
+#else
+    inline constexpr auto defaultRenderBackend = std::string_view("QurbNullRHI");
+#endif
+
     /// \brief Descriptor for an application.
+    ///
+    /// The `QURB_RENDER_BACKEND` and `QURB_FRAME_LIMIT` environment variables override `renderBackend` and `frameLimit`,
+    /// which lets a build machine run any application headlessly on the null backend for a few frames.
     struct QURB_API ApplicationDescriptor
     {
-        std::string name;
+        std::string         name;
+        FrameLoopDescriptor frameLoop;
+        std::string         renderBackend = std::string(defaultRenderBackend);  // The name of the plugin library.
+        uint64              frameLimit    = 0;                                   // Zero runs until the windows close.
     };
 
     /// \brief Base class for all applications.
@@ -32,22 +48,54 @@ namespace qurb
         virtual auto shutdown() -> void   = 0;
 
         virtual auto update(float32 deltaTime) -> void = 0;
-        virtual auto render() -> void                  = 0;
+
+        /// \brief Copies what the render of the frame needs into the render packet of `slot`, once `update` is done.
+        ///
+        /// In pipelined mode `render` runs on another thread while the next frames are updated, it must only read the
+        /// packet. `slot` is lower than `frameLoop().slotCount()`.
+        virtual auto extract(uint32 slot) -> void { static_cast<void>(slot); }
+
+        /// \brief Renders the packet extracted in `slot`.
+        virtual auto render(uint32 slot) -> void = 0;
 
     public:
         [[nodiscard]] auto name() const -> const std::string&;
+        [[nodiscard]] auto frameLoop() const -> const FrameLoopDescriptor&;
+        [[nodiscard]] auto renderBackend() const -> const std::string&;
+        [[nodiscard]] auto frameLimit() const -> uint64;
 
     protected:
-        std::string _name;
-        Engine*     _engine;
+        std::string         _name;
+        FrameLoopDescriptor _frameLoop;
+        std::string         _renderBackend;
+        uint64              _frameLimit;
+        Engine*             _engine;
     };
 
     inline Application::Application(const ApplicationDescriptor& descriptor)
         : _name(descriptor.name)
+        , _frameLoop(descriptor.frameLoop)
+        , _renderBackend(descriptor.renderBackend)
+        , _frameLimit(descriptor.frameLimit)
     {}
 
     inline auto Application::name() const -> const std::string&
     {
         return _name;
     }
+
+    inline auto Application::frameLoop() const -> const FrameLoopDescriptor&
+    {
+        return _frameLoop;
+    }
+
+    inline auto Application::renderBackend() const -> const std::string&
+    {
+        return _renderBackend;
+    }
+
+    inline auto Application::frameLimit() const -> uint64
+    {
+        return _frameLimit;
+    }
 }
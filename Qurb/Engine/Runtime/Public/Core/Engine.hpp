@@ -3,12 +3,14 @@
 #pragma once
 
 #include "Core/Application.hpp"
+#include "Core/FramePipeline.hpp"
 #include "CoreDefines.hpp"
 #include "Misc/Clock.hpp"
 #include "Platform/Platform.hpp"
 #include "Platform/Window.hpp"
 #include "Plugins/PluginManager.hpp"
 #include "Renderer/Renderer.hpp"
+#include "Threading/JobSystem.hpp"
 
 #include <list>
 #include <memory>
@@ -23,6 +25,10 @@ namespace qurb
     public:
         auto activeWindow() -> Window&;
         auto renderer() -> Renderer&;
+        auto jobSystem() -> JobSystem&;
+
+        /// \brief The frame timings accumulated since the last periodic report.
+        auto frameStatistics() const -> const FrameStatistics&;
 
     private:
         friend auto ::main(int argc, const char** argv) -> int;
@@ -31,21 +37,26 @@ namespace qurb
         ~Engine();
 
         auto run() -> void;
+        auto runFrame(FramePipeline* framePipeline) -> void;
         auto createWindow() -> void;
         auto destroyClosedWindows() -> void;
         auto onWindowResize(const WindowResizeEvent& e) -> bool;
 
     private:
         Platform      _platform;
+        PluginManager _pluginManager;  // Declared first, the backend of the renderer lives in a plugin library.
         Renderer      _renderer;
-        PluginManager _pluginManager;
+        JobSystem     _jobSystem;
 
         std::list<Window>            _windows;
         std::unique_ptr<Application> _application;
 
-        Clock _clock;
-        bool  _isRunning;
-        bool  _isSuspended;
+        Clock           _clock;
+        FrameStatistics _frameStatistics;
+        uint64          _frameCount;
+        uint64          _frameLimit;  // Zero runs until the windows close.
+        bool            _isRunning;
+        bool            _isSuspended;
     };
 
     inline auto Engine::activeWindow() -> Window&
@@ -58,4 +69,14 @@ namespace qurb
     {
         return _renderer;
     }
+
+    inline auto Engine::jobSystem() -> JobSystem&
+    {
+        return _jobSystem;
+    }
+
+    inline auto Engine::frameStatistics() const -> const FrameStatistics&
+    {
+        return _frameStatistics;
+    }
 }
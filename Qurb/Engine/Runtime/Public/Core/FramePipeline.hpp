@@ -0,0 +1,131 @@
+/// \file FramePipeline.hpp
+
+#pragma once
+
+#include "Containers/Vector.hpp"
+#include "CoreDefines.hpp"
+#include "CoreTypes.hpp"
+
+#include <atomic>
+#include <functional>
+#include <semaphore>
+#include <string_view>
+#include <thread>
+
+namespace qurb
+{
+    /// \brief How the engine schedules the simulation and rendering of a frame.
+    enum class FrameLoopMode : uint8
+    {
+        /// \brief Update, extract and render one after the other on the main thread.
+        Serial,
+
+        /// \brief Render on a dedicated thread, overlapping with the update of the following frames.
+        Pipelined,
+    };
+
+    /// \brief The `FrameLoopDescriptor` struct.
+    struct QURB_API FrameLoopDescriptor
+    {
+        static constexpr auto maxFramesInFlight = uint32(4);
+
+        FrameLoopMode mode = FrameLoopMode::Serial;
+
+        /// \brief The number of render packets in pipelined mode, 2 for double and 3 for triple buffering. The render
+        /// thread lags the simulation by at most `framesInFlight - 1` frames.
+        uint32 framesInFlight = 2;
+
+    public:
+        /// \brief The number of frame slots the application must provide render packets for.
+        [[nodiscard]] auto slotCount() const -> uint32 { return mode == FrameLoopMode::Serial ? 1 : framesInFlight; }
+    };
+
+    [[nodiscard]] auto toString(FrameLoopMode mode) -> std::string_view;
+
+    /// \brief The time spent in each stage of a frame, in milliseconds.
+    struct QURB_API FrameTimings
+    {
+        float64 frame   = 0.0;  // From the start of a frame to the start of the next one.
+        float64 update  = 0.0;
+        float64 extract = 0.0;
+        float64 render  = 0.0;  // On the render thread in pipelined mode.
+        float64 wait    = 0.0;  // Blocked on a free frame slot, pipelined mode only.
+    };
+
+    /// \brief Accumulates frame timings over a reporting period.
+    class QURB_API FrameStatistics final
+    {
+    public:
+        FrameStatistics() = default;
+
+    public:
+        auto addFrame(const FrameTimings& timings) -> void;
+
+        /// \brief Logs the averages and the slowest frame since the last reset.
+        auto log(const FrameLoopDescriptor& descriptor) const -> void;
+
+        auto reset() -> void;
+
+        [[nodiscard]] auto frameCount() const -> uint32 { return _frameCount; }
+        [[nodiscard]] auto totalMilliseconds() const -> float64 { return _total.frame; }
+
+        /// \brief The average timings since the last reset.
+        [[nodiscard]] auto average() const -> FrameTimings;
+
+    private:
+        FrameTimings _total;
+        float64      _slowestFrame = 0.0;
+        uint32       _frameCount   = 0;
+    };
+
+    /// \brief Runs the render stage of the frames on a dedicated thread.
+    ///
+    /// The simulation thread acquires a free slot, extracts the frame into it and submits it. The render thread
+    /// renders the submitted slots in order and releases them. With `slotCount` slots the simulation runs up to
+    /// `slotCount - 1` frames ahead of the render.
+    class QURB_API FramePipeline final
+    {
+    public:
+        using RenderStage = std::function<void(uint32 slot)>;
+
+    public:
+        FramePipeline(uint32 slotCount, RenderStage renderStage);
+
+        /// \brief Renders every submitted frame, then stops the render thread.
+        ~FramePipeline();
+
+        FramePipeline(const FramePipeline&)                    = delete;
+        auto operator=(const FramePipeline&) -> FramePipeline& = delete;
+
+    public:
+        /// \brief Blocks until the render thread is done with the next slot and returns it.
+        [[nodiscard]] auto acquireSlot() -> uint32;
+
+        /// \brief Hands the slot returned by the last `acquireSlot` to the render thread.
+        auto submit(uint32 slot) -> void;
+
+        /// \brief Blocks until every submitted frame was rendered.
+        auto flush() -> void;
+
+        /// \brief The render time of the last frame rendered in `slot`, valid once `acquireSlot` returned it.
+        [[nodiscard]] auto renderMilliseconds(uint32 slot) const -> float64 { return _renderMilliseconds[slot]; }
+
+    private:
+        auto renderLoop() -> void;
+
+    private:
+        using Semaphore = std::counting_semaphore<FrameLoopDescriptor::maxFramesInFlight>;
+
+    private:
+        RenderStage     _renderStage;
+        uint32          _slotCount;
+        uint64          _submittedFrames = 0;
+        Vector<float64> _renderMilliseconds;  // Written by the render thread, read once the slot is acquired again.
+
+        Semaphore           _freeSlots;
+        Semaphore           _submittedSlots;
+        std::atomic<uint64> _renderedFrames = 0;
+        std::atomic<bool>   _stopping       = false;
+        std::thread         _renderThread;
+    };
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include "Platform/Detection.hpp"
+#include "Platform/Window.hpp"
+
+#ifdef QURB_PLATFORM_LINUX
+
+namespace qurb
+{
+    /// \brief Linux windows are headless for now, they own no system resource.
+    struct Window::NativeHandle
+    {};
+}
+
+#else
+    #error "Trying to include a Linux specific header"
+#endif
@@ -2,12 +2,13 @@
 
 #pragma once
 
+#include "CoreDefines.hpp"
 #include "Platform/Window.hpp"
 
 namespace qurb
 {
     /// \brief The `Platform` class
-    class Platform final
+    class QURB_API Platform final
     {
     public:
         struct NativeHandle;
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "CoreDefines.hpp"
 #include "Events/EventDispatcher.hpp"
 #include "Events/WindowEvents.hpp"
 #include "Math/Vector2.hpp"
@@ -25,7 +26,7 @@ namespace qurb
     };
 
     /// \brief The `Window` class.
-    class Window final
+    class QURB_API Window final
     {
     public:
         struct NativeHandle;
@@ -27,6 +27,9 @@ namespace qurb
 
         virtual auto initialize() -> void {}
 
+    private:
+        friend class PluginManager;
+
     private:
         DynamicLibrary _library;
     };
@@ -1,16 +1,18 @@
 #pragma once
 
 #include "Containers/Vector.hpp"
+#include "CoreDefines.hpp"
 #include "Plugins/Plugin.hpp"
 
 #include <memory>
 
 namespace qurb
 {
-    class PluginManager
+    class QURB_API PluginManager
     {
     public:
         PluginManager() = default;
+        ~PluginManager();
 
         PluginManager(const PluginManager&)                    = delete;
         auto operator=(const PluginManager&) -> PluginManager& = delete;
@@ -21,6 +23,9 @@ namespace qurb
 
         auto initializePlugins() -> void;
 
+        /// \brief Destroys the plugins, then closes their libraries, which hold the code of the plugin destructors.
+        auto unloadPlugins() -> void;
+
     private:
         Vector<std::unique_ptr<Plugin>> _plugins;
     };
@@ -21,7 +21,8 @@ namespace qurb::rhi
     {
         None,
         Dynamic,
-        Immutable
+        Immutable,
+        Persistent,  // Mapped for its whole life: `map` returns the memory the GPU reads, written without `unmap`.
     };
 
     /// \brief The `BufferDescriptor` struct.
@@ -53,8 +54,20 @@ namespace qurb::rhi
         template <typename T>
         auto map() -> T*;
 
-        virtual auto map() -> void*  = 0;
-        virtual auto unmap() -> void = 0;
+        /// \brief Maps the whole buffer, like `map(0, size())`.
+        auto map() -> void*;
+
+        /// \brief Maps `size` bytes from `offset` and returns a pointer to the byte at `offset`, or null for an immutable
+        /// buffer.
+        ///
+        /// A dynamic buffer maps one range at a time, `unmap` makes the writes to that range only visible to the GPU. A
+        /// persistent buffer returns the memory the GPU reads: it is written in place and never unmapped.
+        virtual auto map(usize offset, usize size) -> void* = 0;
+        virtual auto unmap() -> void                        = 0;
+
+        /// \brief Makes the writes to `size` bytes from `offset` visible to the GPU without unmapping: anywhere in a
+        /// persistent buffer, or within the mapped range of a dynamic one.
+        virtual auto flushRange(usize offset, usize size) -> void = 0;
 
     protected:
         usize       _size;
@@ -100,6 +113,11 @@ namespace qurb::rhi
         return _usage;
     }
 
+    inline auto Buffer::map() -> void*
+    {
+        return map(0, _size);
+    }
+
     template <typename T>
     auto Buffer::map() -> T*
     {
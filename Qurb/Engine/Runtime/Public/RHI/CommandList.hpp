@@ -0,0 +1,300 @@
+/// \file CommandList.hpp
+
+#pragma once
+
+#include "Containers/Vector.hpp"
+#include "CoreDefines.hpp"
+#include "CoreTypes.hpp"
+#include "Debug/Ensure.hpp"
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <new>
+
+namespace qurb::rhi
+{
+    class Buffer;
+    class PipelineState;
+    class Texture;
+
+    /// \brief The `CommandType` enum.
+    enum class CommandType : uint8
+    {
+        PushConstants,
+        BindPipelineState,
+        BindVertexBuffer,
+        BindFragmentTexture,
+        Draw,
+        DrawInstanced,
+    };
+
+    /// \brief Records the commands of a render pass to submit later with `RenderContext::executeCommandLists`.
+    ///
+    /// The commands are packed one after the other in blocks of an arena kept across `reset`, so recording allocates
+    /// nothing once the list has grown to the size of a frame. Each list is recorded by one thread, several lists may be
+    /// recorded in parallel. The objects referenced by the commands are not retained, they must outlive the submission.
+    ///
+    /// Backends decode a list with `forEach`, which calls a visitor with each command in recording order.
+    class QURB_API CommandList final
+    {
+    public:
+        struct PushConstants
+        {
+            const void* data;  // Within the list, copied when recorded.
+            usize       size;
+        };
+
+        struct BindPipelineState
+        {
+            PipelineState* pipelineState;
+        };
+
+        struct BindVertexBuffer
+        {
+            Buffer* vertexBuffer;
+            uint32  slot;
+            uint32  offset;
+        };
+
+        struct BindFragmentTexture
+        {
+            Texture* texture;
+            uint32   slot;
+        };
+
+        struct Draw
+        {
+            uint32 vertexCount;
+            uint32 firstVertex;
+        };
+
+        struct DrawInstanced
+        {
+            uint32 vertexCount;
+            uint32 firstVertex;
+            uint32 instanceCount;
+            uint32 firstInstance;
+        };
+
+        /// \brief The largest push constants a command can hold.
+        static constexpr auto maxPushConstantsSize = usize(4096);
+
+    public:
+        CommandList() = default;
+
+        CommandList(const CommandList&)                    = delete;
+        auto operator=(const CommandList&) -> CommandList& = delete;
+
+        CommandList(CommandList&&) noexcept                    = default;
+        auto operator=(CommandList&&) noexcept -> CommandList& = default;
+
+    public:
+        auto pushConstants(const void* data, usize size) -> void;
+
+        auto bindPipelineState(PipelineState* pipelineState) -> void;
+
+        auto bindVertexBuffer(Buffer* vertexBuffer, uint32 slot, uint32 offset) -> void;
+
+        auto bindFragmentTexture(Texture* texture, uint32 slot) -> void;
+
+        auto draw(uint32 vertexCount, uint32 firstVertex) -> void;
+
+        auto drawInstanced(uint32 vertexCount, uint32 firstVertex, uint32 instanceCount, uint32 firstInstance) -> void;
+
+        /// \brief Forgets the recorded commands, keeping the arena.
+        auto reset() -> void;
+
+        /// \brief Calls `visitor` with each command, as one of the command structs, in recording order.
+        template <typename Visitor>
+        auto forEach(Visitor&& visitor) const -> void;
+
+        [[nodiscard]] auto empty() const -> bool { return _commandCount == 0; }
+
+        [[nodiscard]] auto commandCount() const -> usize { return _commandCount; }
+
+    private:
+        /// \brief Precedes every command in the arena, the command follows at `commandAlignment`.
+        struct Header
+        {
+            CommandType type;
+            uint32      size;  // Of the header and the command, padded to `commandAlignment`.
+        };
+
+        struct Block
+        {
+            std::unique_ptr<std::byte[]> data;
+            usize                        size = 0;
+        };
+
+    private:
+        /// \brief Reserves a command of `payloadSize` bytes, and returns where the payload goes.
+        auto allocate(CommandType type, usize payloadSize) -> std::byte*;
+
+        template <typename T>
+        auto record(CommandType type, const T& command) -> void;
+
+    private:
+        static constexpr auto blockSize        = usize(16 * 1024);
+        static constexpr auto commandAlignment = alignof(void*);  // Of every command, and of the payload after its header.
+
+    private:
+        Vector<Block> _blocks;
+        usize         _blockIndex   = 0;  // The block being recorded into.
+        usize         _commandCount = 0;
+    };
+
+    /// \brief A `CommandList::forEach` visitor issuing each command on `context`, through the methods of the same name.
+    ///
+    /// On a backend's final render context the calls are direct, the whole list translates in one loop.
+    template <typename Context>
+    struct CommandTranslator
+    {
+        Context& context;
+
+    public:
+        auto operator()(const CommandList::PushConstants& command) const -> void { context.pushConstants(command.data, command.size); }
+
+        auto operator()(const CommandList::BindPipelineState& command) const -> void { context.bindPipelineState(command.pipelineState); }
+
+        auto operator()(const CommandList::BindVertexBuffer& command) const -> void
+        {
+            context.bindVertexBuffer(command.vertexBuffer, command.slot, command.offset);
+        }
+
+        auto operator()(const CommandList::BindFragmentTexture& command) const -> void
+        {
+            context.bindFragmentTexture(command.texture, command.slot);
+        }
+
+        auto operator()(const CommandList::Draw& command) const -> void { context.draw(command.vertexCount, command.firstVertex); }
+
+        auto operator()(const CommandList::DrawInstanced& command) const -> void
+        {
+            context.drawInstanced(command.vertexCount, command.firstVertex, command.instanceCount, command.firstInstance);
+        }
+    };
+
+    //------------------------------------------------------------------------------------------------------------------
+    // class CommandList
+    //------------------------------------------------------------------------------------------------------------------
+
+    inline auto CommandList::pushConstants(const void* data, usize size) -> void
+    {
+        ensure(size <= maxPushConstantsSize, "Push constants of {} bytes are too large for a command list.", size);
+
+        auto* payload = allocate(CommandType::PushConstants, sizeof(usize) + size);
+        std::memcpy(payload, &size, sizeof(usize));
+        std::memcpy(payload + sizeof(usize), data, size);
+    }
+
+    inline auto CommandList::bindPipelineState(PipelineState* pipelineState) -> void
+    {
+        record(CommandType::BindPipelineState, BindPipelineState {pipelineState});
+    }
+
+    inline auto CommandList::bindVertexBuffer(Buffer* vertexBuffer, uint32 slot, uint32 offset) -> void
+    {
+        record(CommandType::BindVertexBuffer, BindVertexBuffer {vertexBuffer, slot, offset});
+    }
+
+    inline auto CommandList::bindFragmentTexture(Texture* texture, uint32 slot) -> void
+    {
+        record(CommandType::BindFragmentTexture, BindFragmentTexture {texture, slot});
+    }
+
+    inline auto CommandList::draw(uint32 vertexCount, uint32 firstVertex) -> void
+    {
+        record(CommandType::Draw, Draw {vertexCount, firstVertex});
+    }
+
+    inline auto CommandList::drawInstanced(uint32 vertexCount, uint32 firstVertex, uint32 instanceCount, uint32 firstInstance)
+        -> void
+    {
+        record(CommandType::DrawInstanced, DrawInstanced {vertexCount, firstVertex, instanceCount, firstInstance});
+    }
+
+    inline auto CommandList::reset() -> void
+    {
+        for (usize i = 0; i < _blocks.size() and i <= _blockIndex; ++i)
+        {
+            _blocks[i].size = 0;
+        }
+        _blockIndex   = 0;
+        _commandCount = 0;
+    }
+
+    template <typename Visitor>
+    auto CommandList::forEach(Visitor&& visitor) const -> void
+    {
+        for (usize i = 0; i < _blocks.size() and i <= _blockIndex; ++i)
+        {
+            const auto* data = _blocks[i].data.get();
+            const auto* end  = data + _blocks[i].size;
+            while (data != end)
+            {
+                const auto* header  = std::launder(reinterpret_cast<const Header*>(data));
+                const auto* payload = data + commandAlignment;
+                switch (header->type)
+                {
+                case CommandType::PushConstants:
+                {
+                    auto size = usize(0);
+                    std::memcpy(&size, payload, sizeof(usize));
+                    visitor(PushConstants {payload + sizeof(usize), size});
+                    break;
+                }
+                case CommandType::BindPipelineState:
+                    visitor(*std::launder(reinterpret_cast<const BindPipelineState*>(payload)));
+                    break;
+                case CommandType::BindVertexBuffer:
+                    visitor(*std::launder(reinterpret_cast<const BindVertexBuffer*>(payload)));
+                    break;
+                case CommandType::BindFragmentTexture:
+                    visitor(*std::launder(reinterpret_cast<const BindFragmentTexture*>(payload)));
+                    break;
+                case CommandType::Draw:
+                    visitor(*std::launder(reinterpret_cast<const Draw*>(payload)));
+                    break;
+                case CommandType::DrawInstanced:
+                    visitor(*std::launder(reinterpret_cast<const DrawInstanced*>(payload)));
+                    break;
+                }
+                data += header->size;
+            }
+        }
+    }
+
+    inline auto CommandList::allocate(CommandType type, usize payloadSize) -> std::byte*
+    {
+        static_assert(sizeof(Header) <= commandAlignment);
+
+        const auto size = (commandAlignment + payloadSize + commandAlignment - 1) / commandAlignment * commandAlignment;
+
+        // Blocks are kept across resets, move to the next one before allocating a new one.
+        if (_blocks.empty() or _blocks[_blockIndex].size + size > blockSize)
+        {
+            if (not _blocks.empty())
+            {
+                ++_blockIndex;
+            }
+            if (_blockIndex == _blocks.size())
+            {
+                _blocks.pushBack(Block {std::make_unique<std::byte[]>(blockSize), 0});
+            }
+        }
+
+        auto& block = _blocks[_blockIndex];
+        auto* data  = block.data.get() + block.size;
+        new (data) Header {type, static_cast<uint32>(size)};
+        block.size += size;
+        ++_commandCount;
+        return data + commandAlignment;
+    }
+
+    template <typename T>
+    auto CommandList::record(CommandType type, const T& command) -> void
+    {
+        new (allocate(type, sizeof(T))) T(command);
+    }
+}
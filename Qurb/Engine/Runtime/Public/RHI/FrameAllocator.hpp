@@ -0,0 +1,141 @@
+/// \file FrameAllocator.hpp
+
+#pragma once
+
+#include "Containers/Vector.hpp"
+#include "CoreDefines.hpp"
+#include "CoreTypes.hpp"
+#include "RHI/Buffer.hpp"
+#include "RHI/Device.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+
+namespace qurb::rhi
+{
+    /// \brief A range of the frame's region of a `FrameAllocator`: where to write, and what to bind to read it. Empty
+    /// when the region was full.
+    struct FrameAllocation
+    {
+        Buffer* buffer = nullptr;
+        usize   offset = 0;        // Within `buffer`, to bind the allocation at.
+        void*   data   = nullptr;  // Mapped, written in place.
+        usize   size   = 0;
+
+    public:
+        explicit operator bool() const { return buffer != nullptr; }
+
+        template <typename T>
+        [[nodiscard]] auto as() const -> T*
+        {
+            return static_cast<T*>(data);
+        }
+    };
+
+    /// \brief Suballocates the constants and vertices written every frame from one persistently mapped buffer.
+    ///
+    /// The buffer is split in `frameCount` regions used in turn, one per frame. The region of a frame is reused
+    /// `frameCount` frames later, once the GPU is done reading it, which the render contexts guarantee by waiting on their
+    /// frame boundary with the same count. Within a frame, allocations bump an atomic offset: any thread may allocate,
+    /// without locks, maps or copies.
+    ///
+    /// `beginFrame` is called by one thread, before the allocations of the frame.
+    class QURB_API FrameAllocator final
+    {
+    public:
+        /// \brief The alignment of the allocations, which every backend accepts as the offset of a buffer binding.
+        static constexpr auto defaultAlignment = usize(256);
+
+    public:
+        /// \param frameCount The frames the GPU may be reading at once.
+        /// \param frameSize The initial size of a region, grown by `beginFrame` when a frame needs more.
+        FrameAllocator(Device* device, uint32 frameCount, usize frameSize);
+        ~FrameAllocator();
+
+        FrameAllocator(const FrameAllocator&)                    = delete;
+        auto operator=(const FrameAllocator&) -> FrameAllocator& = delete;
+
+    public:
+        /// \brief Moves to the region of the next frame, at least `frameSize` bytes large.
+        ///
+        /// Growing replaces the buffer of every region, the previous one is released once the frames reading it are done.
+        auto beginFrame(usize frameSize = 0) -> void;
+
+        /// \brief `size` bytes of the frame's region at an offset multiple of `alignment`, a power of two, or an empty
+        /// allocation when the region is full.
+        auto allocate(usize size, usize alignment = defaultAlignment) -> FrameAllocation;
+
+        /// \brief `count` elements of `T`, like `allocate`.
+        template <typename T>
+        auto allocateArray(usize count) -> FrameAllocation;
+
+        [[nodiscard]] auto frameCount() const -> uint32 { return _frameCount; }
+
+        [[nodiscard]] auto frameSize() const -> usize { return _frameSize; }
+
+        /// \brief The bytes of the frame's region allocated so far, alignment included.
+        [[nodiscard]] auto bytesAllocated() const -> usize;
+
+        [[nodiscard]] auto buffer() const -> Buffer* { return _buffer; }
+
+    private:
+        /// \brief A buffer replaced by a larger one, kept until the frames reading it are done.
+        struct RetiredBuffer
+        {
+            Buffer* buffer;
+            uint64  lastFrame;
+        };
+
+    private:
+        auto createBuffer() -> void;
+
+    private:
+        Device*               _device;
+        uint32                _frameCount;
+        usize                 _frameSize;
+        Buffer*               _buffer;
+        std::byte*            _data;          // Mapped for the life of `_buffer`.
+        uint64                _frame;
+        usize                 _regionOffset;  // Of the frame's region within `_buffer`.
+        std::atomic<usize>    _offset;        // Within the frame's region.
+        Vector<RetiredBuffer> _retiredBuffers;
+    };
+
+    //------------------------------------------------------------------------------------------------------------------
+    // class FrameAllocator
+    //------------------------------------------------------------------------------------------------------------------
+
+    inline auto FrameAllocator::allocate(usize size, usize alignment) -> FrameAllocation
+    {
+        auto offset = _offset.load(std::memory_order_relaxed);
+        auto begin  = usize(0);
+        do
+        {
+            begin = (offset + alignment - 1) & ~(alignment - 1);
+            if (begin + size > _frameSize)
+            {
+                return FrameAllocation();
+            }
+        }
+        while (not _offset.compare_exchange_weak(offset, begin + size, std::memory_order_relaxed));
+
+        return FrameAllocation {
+            .buffer = _buffer,
+            .offset = _regionOffset + begin,
+            .data   = _data + _regionOffset + begin,
+            .size   = size,
+        };
+    }
+
+    template <typename T>
+    auto FrameAllocator::allocateArray(usize count) -> FrameAllocation
+    {
+        return allocate(count * sizeof(T), std::max(usize(alignof(T)), defaultAlignment));
+    }
+
+    inline auto FrameAllocator::bytesAllocated() const -> usize
+    {
+        return std::min(_offset.load(std::memory_order_relaxed), _frameSize);
+    }
+}
@@ -2,11 +2,16 @@
 
 #include "CoreTypes.hpp"
 
+#include <atomic>
 #include <type_traits>
+#include <utility>
 
 namespace qurb::rhi
 {
     /// \brief The `Object` class.
+    ///
+    /// The retain count is atomic: objects are created on worker threads, like the shader programs compiled by the
+    /// `ShaderRegistry`, and retain the device while the main thread does.
     class Object
     {
     public:
@@ -26,7 +31,7 @@ namespace qurb::rhi
         [[nodiscard]] auto retainCount() const -> uint64;
 
     private:
-        uint64 _retainCount;
+        std::atomic<uint64> _retainCount;
     };
 
     /// \brief The `Ref` class.
@@ -89,7 +94,7 @@ namespace qurb::rhi
 
     inline auto Object::release() -> void
     {
-        if (--_retainCount == 0)
+        if (_retainCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
         {
             delete this;
         }
@@ -97,12 +102,12 @@ namespace qurb::rhi
 
     inline auto Object::retain() -> void
     {
-        ++_retainCount;
+        _retainCount.fetch_add(1, std::memory_order_relaxed);
     }
 
     inline auto Object::retainCount() const -> uint64
     {
-        return _retainCount;
+        return _retainCount.load(std::memory_order_relaxed);
     }
 
     //-----------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,264 @@
+/// \file PipelineCache.hpp
+
+#pragma once
+
+#include "Containers/Vector.hpp"
+#include "CoreDefines.hpp"
+#include "CoreTypes.hpp"
+#include "RHI/PipelineState.hpp"
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+
+namespace qurb::rhi
+{
+    /// \brief The formats of the attachments a pipeline renders to, in the backend's own format values.
+    struct AttachmentFormats
+    {
+        static constexpr auto maxColorAttachments = uint32(8);
+
+        std::array<uint32, maxColorAttachments> colors     = {};
+        uint32                                  colorCount = 0;
+        uint32                                  depth      = 0;  // Zero without a depth attachment.
+
+    public:
+        auto operator==(const AttachmentFormats&) const -> bool = default;
+    };
+
+    /// \brief Identifies the backend pipeline built for a pipeline state descriptor and the attachments it renders to.
+    struct PipelineKey
+    {
+        uint64            descriptorHash;
+        AttachmentFormats attachmentFormats;
+
+    public:
+        auto operator==(const PipelineKey&) const -> bool = default;
+
+        /// \brief Mixes the descriptor hash with the formats, for the cache table only.
+        [[nodiscard]] auto hash() const -> uint64;
+    };
+
+    /// \brief The lookups of a `PipelineCache` since its statistics were last reset.
+    struct PipelineCacheStatistics
+    {
+        uint64 hits    = 0;
+        uint64 misses  = 0;  // Lookups that created a pipeline.
+        uint64 entries = 0;
+    };
+
+    /// \brief Keeps the backend pipelines `T` built for each `PipelineKey`, so that each is created once.
+    ///
+    /// Lookups are lock-free: the entries live in an open addressing table of atomic pointers, published once built and
+    /// never removed. Only a miss takes the lock to create the pipeline. A table that fills up is replaced by a larger
+    /// one, the old tables stay alive until the cache is destroyed for the lookups still walking them.
+    template <typename T>
+    class PipelineCache final
+    {
+    public:
+        PipelineCache();
+        ~PipelineCache() = default;
+
+        PipelineCache(const PipelineCache&)                    = delete;
+        auto operator=(const PipelineCache&) -> PipelineCache& = delete;
+
+    public:
+        /// \brief The pipeline of `key`, created by `create()` on the first lookup.
+        template <typename F>
+        auto getOrCreate(const PipelineKey& key, F&& create) -> const T&;
+
+        /// \brief The pipeline of `key`, or null, without counting the lookup.
+        [[nodiscard]] auto find(const PipelineKey& key) const -> const T*;
+
+        /// \brief Calls `function` with each pipeline, like before destroying them. Must not run concurrently with a miss.
+        template <typename F>
+        auto forEach(F&& function) -> void;
+
+        [[nodiscard]] auto statistics() const -> PipelineCacheStatistics;
+        auto               resetStatistics() -> void;
+
+    private:
+        struct Entry
+        {
+            PipelineKey key;
+            uint64      hash;
+            T           value;
+        };
+
+        struct Table
+        {
+            usize                                  mask;
+            std::unique_ptr<std::atomic<Entry*>[]> slots;  // Null when free.
+        };
+
+    private:
+        static auto makeTable(usize capacity) -> std::unique_ptr<Table>;
+
+        static auto lookup(const Table& table, const PipelineKey& key, uint64 hash) -> Entry*;
+
+        /// \brief Publishes `entry` in `table`, which has a free slot.
+        static auto insert(Table& table, Entry* entry) -> void;
+
+    private:
+        static constexpr auto initialCapacity = usize(64);
+
+    private:
+        std::atomic<Table*>            _table;
+        mutable std::mutex             _mutex;   // Serializes the misses.
+        Vector<std::unique_ptr<Table>> _tables;  // The current one last.
+        Vector<std::unique_ptr<Entry>> _entries;
+        std::atomic<uint64>            _hits;
+        std::atomic<uint64>            _misses;
+    };
+
+    //------------------------------------------------------------------------------------------------------------------
+    // struct PipelineKey
+    //------------------------------------------------------------------------------------------------------------------
+
+    inline auto PipelineKey::hash() const -> uint64
+    {
+        auto value = descriptorHash;
+        auto mix   = [&](uint64 word) {
+            value = (value ^ word) * 0x9E3779B97F4A7C15ull;
+            value ^= value >> 32;
+        };
+
+        mix(attachmentFormats.colorCount | static_cast<uint64>(attachmentFormats.depth) << 32);
+        for (uint32 i = 0; i < attachmentFormats.colorCount; ++i)
+        {
+            mix(attachmentFormats.colors[i]);
+        }
+        return value;
+    }
+
+    //------------------------------------------------------------------------------------------------------------------
+    // class PipelineCache
+    //------------------------------------------------------------------------------------------------------------------
+
+    template <typename T>
+    PipelineCache<T>::PipelineCache()
+        : _table(nullptr)
+        , _hits(0)
+        , _misses(0)
+    {
+        _tables.pushBack(makeTable(initialCapacity));
+        _table.store(_tables.back().get(), std::memory_order_release);
+    }
+
+    template <typename T>
+    template <typename F>
+    auto PipelineCache<T>::getOrCreate(const PipelineKey& key, F&& create) -> const T&
+    {
+        const auto hash = key.hash();
+        if (auto* entry = lookup(*_table.load(std::memory_order_acquire), key, hash))
+        {
+            _hits.fetch_add(1, std::memory_order_relaxed);
+            return entry->value;
+        }
+
+        auto lock = std::scoped_lock(_mutex);
+
+        // Another thread may have created it since the lookup.
+        auto* table = _table.load(std::memory_order_relaxed);
+        if (auto* entry = lookup(*table, key, hash))
+        {
+            _hits.fetch_add(1, std::memory_order_relaxed);
+            return entry->value;
+        }
+
+        _misses.fetch_add(1, std::memory_order_relaxed);
+        _entries.pushBack(std::make_unique<Entry>(Entry {key, hash, create()}));
+        auto* entry = _entries.back().get();
+
+        // Keep the table at most half full, so that the probes stay short.
+        if (_entries.size() * 2 > table->mask + 1)
+        {
+            _tables.pushBack(makeTable((table->mask + 1) * 2));
+            table = _tables.back().get();
+            for (auto& existing : _entries)
+            {
+                insert(*table, existing.get());
+            }
+            _table.store(table, std::memory_order_release);
+        }
+        else
+        {
+            insert(*table, entry);
+        }
+        return entry->value;
+    }
+
+    template <typename T>
+    auto PipelineCache<T>::find(const PipelineKey& key) const -> const T*
+    {
+        auto* entry = lookup(*_table.load(std::memory_order_acquire), key, key.hash());
+        return entry != nullptr ? &entry->value : nullptr;
+    }
+
+    template <typename T>
+    template <typename F>
+    auto PipelineCache<T>::forEach(F&& function) -> void
+    {
+        auto lock = std::scoped_lock(_mutex);
+        for (auto& entry : _entries)
+        {
+            function(entry->value);
+        }
+    }
+
+    template <typename T>
+    auto PipelineCache<T>::statistics() const -> PipelineCacheStatistics
+    {
+        auto lock = std::scoped_lock(_mutex);
+        return PipelineCacheStatistics {
+            .hits    = _hits.load(std::memory_order_relaxed),
+            .misses  = _misses.load(std::memory_order_relaxed),
+            .entries = _entries.size(),
+        };
+    }
+
+    template <typename T>
+    auto PipelineCache<T>::resetStatistics() -> void
+    {
+        _hits.store(0, std::memory_order_relaxed);
+        _misses.store(0, std::memory_order_relaxed);
+    }
+
+    template <typename T>
+    auto PipelineCache<T>::makeTable(usize capacity) -> std::unique_ptr<Table>
+    {
+        auto table   = std::make_unique<Table>();
+        table->mask  = capacity - 1;
+        table->slots = std::make_unique<std::atomic<Entry*>[]>(capacity);
+        return table;
+    }
+
+    template <typename T>
+    auto PipelineCache<T>::lookup(const Table& table, const PipelineKey& key, uint64 hash) -> Entry*
+    {
+        for (auto slot = hash & table.mask;; slot = (slot + 1) & table.mask)
+        {
+            auto* entry = table.slots[slot].load(std::memory_order_acquire);
+            if (entry == nullptr)
+            {
+                return nullptr;
+            }
+            if (entry->hash == hash and entry->key == key)
+            {
+                return entry;
+            }
+        }
+    }
+
+    template <typename T>
+    auto PipelineCache<T>::insert(Table& table, Entry* entry) -> void
+    {
+        auto slot = entry->hash & table.mask;
+        while (table.slots[slot].load(std::memory_order_relaxed) != nullptr)
+        {
+            slot = (slot + 1) & table.mask;
+        }
+        table.slots[slot].store(entry, std::memory_order_release);
+    }
+}
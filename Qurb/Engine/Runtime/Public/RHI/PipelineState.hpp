@@ -3,6 +3,7 @@
 #pragma once
 
 #include "Containers/Vector.hpp"
+#include "CoreDefines.hpp"
 #include "RHI/Object.hpp"
 
 #include <bitset>
@@ -205,13 +206,34 @@ namespace qurb::rhi
 
         virtual ~PipelineState() = default;
 
+    public:
+        [[nodiscard]] auto descriptor() const -> const PipelineStateDescriptor&;
+
+        /// \brief `hashPipelineStateDescriptor` of the descriptor, the key of the backend pipelines in a `PipelineCache`.
+        [[nodiscard]] auto descriptorHash() const -> uint64;
+
     protected:
         PipelineStateDescriptor _descriptor;
+        uint64                  _descriptorHash;
     };
 
     using PipelineStateRef = Ref<PipelineState>;
 
+    /// \brief A hash of `descriptor` stable across runs: the shader program is hashed by its descriptor, not by address.
+    QURB_API auto hashPipelineStateDescriptor(const PipelineStateDescriptor& descriptor) -> uint64;
+
     inline PipelineState::PipelineState(const PipelineStateDescriptor& descriptor)
         : _descriptor(descriptor)
+        , _descriptorHash(hashPipelineStateDescriptor(descriptor))
     {}
+
+    inline auto PipelineState::descriptor() const -> const PipelineStateDescriptor&
+    {
+        return _descriptor;
+    }
+
+    inline auto PipelineState::descriptorHash() const -> uint64
+    {
+        return _descriptorHash;
+    }
 }
@@ -10,6 +10,8 @@ namespace qurb::rhi
     enum class RenderBackendType
     {
         None,
+        Null,
+        Software,
         Metal,
         Vulkan,
         D3D12,
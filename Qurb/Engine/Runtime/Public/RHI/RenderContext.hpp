@@ -4,6 +4,7 @@
 
 #include "CoreTypes.hpp"
 #include "RHI/Buffer.hpp"
+#include "RHI/CommandList.hpp"
 #include "RHI/Object.hpp"
 #include "RHI/PipelineState.hpp"
 #include "RHI/RenderPass.hpp"
@@ -12,6 +13,8 @@
 #include "RHI/SwapChain.hpp"
 #include "RHI/Texture.hpp"
 
+#include <span>
+
 namespace qurb
 {
     class Window;
@@ -55,6 +58,17 @@ namespace qurb::rhi
 
         virtual auto draw(uint32 vertexCount, uint32 firstVertex) -> void = 0;
 
+        /// \brief Draws `instanceCount` instances of the bound vertices. The shaders see instance indices starting at
+        /// `firstInstance`, which lets the draws of a frame share one buffer of per instance data.
+        virtual auto drawInstanced(uint32 vertexCount, uint32 firstVertex, uint32 instanceCount, uint32 firstInstance) -> void = 0;
+
+        /// \brief Executes the commands of `commandLists` in the current render pass, one list after the other, as if
+        /// they were issued on this context. What a list binds stays bound for the next ones.
+        ///
+        /// The default translation calls the methods above for each command. Backends override it to decode the lists
+        /// in one loop into their own encoding.
+        virtual auto executeCommandLists(std::span<const CommandList> commandLists) -> void;
+
     protected:
         Window& _window;
     };
@@ -69,4 +83,12 @@ namespace qurb::rhi
     {
         return _window;
     }
+
+    inline auto RenderContext::executeCommandLists(std::span<const CommandList> commandLists) -> void
+    {
+        for (const auto& commandList : commandLists)
+        {
+            commandList.forEach(CommandTranslator {*this});
+        }
+    }
 }
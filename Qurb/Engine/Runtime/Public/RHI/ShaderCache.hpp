@@ -0,0 +1,145 @@
+/// \file ShaderCache.hpp
+
+#pragma once
+
+#include "Containers/Vector.hpp"
+#include "CoreDefines.hpp"
+#include "CoreTypes.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace qurb::rhi
+{
+    /// \brief Identifies a compiled shader artifact by the content it was compiled from: 128 bits of the source and
+    /// options, so that an edited shader or a changed option never loads a stale artifact.
+    struct QURB_API ShaderCacheKey
+    {
+        uint64 high = 0;
+        uint64 low  = 0;
+
+    public:
+        auto operator==(const ShaderCacheKey&) const -> bool = default;
+
+        /// \brief The 32 hexadecimal digits of the key, the name of its file in the cache.
+        [[nodiscard]] auto toString() const -> std::string;
+    };
+
+    /// \brief Builds a `ShaderCacheKey` from everything a compilation depends on, fed in a fixed order.
+    class QURB_API ShaderCacheKeyHasher
+    {
+    public:
+        /// \brief Adds `string` and its length, so that consecutive strings cannot run into each other.
+        auto add(std::string_view string) -> ShaderCacheKeyHasher&;
+
+        auto add(uint64 value) -> ShaderCacheKeyHasher&;
+
+        [[nodiscard]] auto key() const -> ShaderCacheKey;
+
+    private:
+        auto addBytes(const void* data, usize size) -> void;
+
+    private:
+        uint64 _high = 0xCBF29CE484222325ull;
+        uint64 _low  = 0x84222325CBF29CE4ull;
+    };
+
+    /// \brief The activity of a `ShaderCache` since its statistics were last reset.
+    struct ShaderCacheStatistics
+    {
+        uint64  hits               = 0;
+        uint64  misses             = 0;    // Including the rejected entries.
+        uint64  rejected           = 0;    // Entries that were corrupt, truncated or of another version.
+        uint64  stores             = 0;
+        float64 loadMilliseconds   = 0.0;  // Spent reading and checking the hits.
+        float64 createMilliseconds = 0.0;  // Spent compiling and storing the misses of `loadOrCreate`.
+    };
+
+    /// \brief Keeps the compiled shader artifacts of a backend on disk, so that a warm start loads what a cold start
+    /// compiled.
+    ///
+    /// Each artifact is a file named after its key, starting with a header holding the format version of the cache, the
+    /// version of the backend artifacts, the key and the size and checksum of the payload. A file that fails any of these
+    /// checks is logged, deleted and reported as a miss, so that the artifact is compiled and stored again. Files are
+    /// written to a temporary name and renamed, a crash or a concurrent writer never leaves a partial entry behind.
+    ///
+    /// Loads and stores may be called from any thread.
+    class QURB_API ShaderCache final
+    {
+    public:
+        /// \brief Bumped when the layout of the entries changes.
+        static constexpr auto formatVersion = uint32(1);
+
+        /// \brief The root of the caches: `QURB_SHADER_CACHE` when set, `ShaderCache` in the working directory otherwise.
+        static auto defaultDirectory() -> std::filesystem::path;
+
+    public:
+        /// \param directory Where the entries of the backend live, created when missing.
+        /// \param backendVersion Bumped by the backend when its artifacts change, entries of other versions are rejected.
+        ShaderCache(std::filesystem::path directory, uint32 backendVersion);
+
+        ShaderCache(const ShaderCache&)                    = delete;
+        auto operator=(const ShaderCache&) -> ShaderCache& = delete;
+
+    public:
+        /// \brief The artifact stored for `key`, or nothing when it is missing or was rejected.
+        auto load(const ShaderCacheKey& key) -> std::optional<Vector<std::byte>>;
+
+        /// \brief Stores `artifact` for `key`, replacing any previous entry. Returns false, logged, when it cannot be
+        /// written: the cache is an optimization, a read-only directory only costs the next start its compiles.
+        auto store(const ShaderCacheKey& key, std::span<const std::byte> artifact) -> bool;
+
+        /// \brief The artifact of `key`, loaded or else returned by `create()` and stored.
+        template <typename F>
+        auto loadOrCreate(const ShaderCacheKey& key, F&& create) -> Vector<std::byte>;
+
+        /// \brief Deletes every entry.
+        auto clear() -> void;
+
+        [[nodiscard]] auto directory() const -> const std::filesystem::path& { return _directory; }
+
+        [[nodiscard]] auto statistics() const -> ShaderCacheStatistics;
+        auto               resetStatistics() -> void;
+
+    private:
+        [[nodiscard]] auto path(const ShaderCacheKey& key) const -> std::filesystem::path;
+
+        auto reject(const std::filesystem::path& path, std::string_view reason) -> void;
+
+        static auto now() -> uint64;
+
+    private:
+        std::filesystem::path _directory;
+        uint32                _backendVersion;
+        std::atomic<uint64>   _hits;
+        std::atomic<uint64>   _misses;
+        std::atomic<uint64>   _rejected;
+        std::atomic<uint64>   _stores;
+        std::atomic<uint64>   _loadNanoseconds;
+        std::atomic<uint64>   _createNanoseconds;
+    };
+
+    //------------------------------------------------------------------------------------------------------------------
+    // class ShaderCache
+    //------------------------------------------------------------------------------------------------------------------
+
+    template <typename F>
+    auto ShaderCache::loadOrCreate(const ShaderCacheKey& key, F&& create) -> Vector<std::byte>
+    {
+        if (auto artifact = load(key))
+        {
+            return std::move(*artifact);
+        }
+
+        const auto start    = now();
+        auto       artifact = create();
+        store(key, std::span<const std::byte>(artifact.data(), artifact.size()));
+        _createNanoseconds.fetch_add(now() - start, std::memory_order_relaxed);
+        return artifact;
+    }
+}
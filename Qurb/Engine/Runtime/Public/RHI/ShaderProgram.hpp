@@ -74,6 +74,9 @@ namespace qurb::rhi
         explicit ShaderProgram(const ShaderProgramDescriptor& descriptor);
         virtual ~ShaderProgram() = default;
 
+    public:
+        [[nodiscard]] auto descriptor() const -> const ShaderProgramDescriptor&;
+
     protected:
         ShaderProgramDescriptor descriptor_;
     };
@@ -83,4 +86,9 @@ namespace qurb::rhi
     inline ShaderProgram::ShaderProgram(const ShaderProgramDescriptor& descriptor)
         : descriptor_(descriptor)
     {}
+
+    inline auto ShaderProgram::descriptor() const -> const ShaderProgramDescriptor&
+    {
+        return descriptor_;
+    }
 }
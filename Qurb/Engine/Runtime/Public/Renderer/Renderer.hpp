@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "CoreDefines.hpp"
 #include "Platform/Window.hpp"
 #include "Plugins/PluginManager.hpp"
 #include "RHI/Device.hpp"
@@ -13,7 +14,7 @@
 
 namespace qurb
 {
-    class Renderer final
+    class QURB_API Renderer final
     {
     public:
         Renderer();
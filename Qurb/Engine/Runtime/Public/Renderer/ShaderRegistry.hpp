@@ -0,0 +1,136 @@
+/// \file ShaderRegistry.hpp
+
+#pragma once
+
+#include "CoreDefines.hpp"
+#include "CoreTypes.hpp"
+#include "RHI/Device.hpp"
+#include "RHI/ShaderProgram.hpp"
+#include "Threading/JobSystem.hpp"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace qurb
+{
+    class ShaderRegistry;
+
+    /// \brief The requests of a `ShaderRegistry` since it was created.
+    struct ShaderRegistryStatistics
+    {
+        uint64 requests = 0;
+        uint64 programs = 0;  // Unique descriptors, each compiled once.
+        uint64 ready    = 0;  // Programs whose compile has finished.
+    };
+
+    /// \brief A program of a `ShaderRegistry`, shared by every request of the same descriptor.
+    class QURB_API ShaderHandle final
+    {
+    public:
+        ShaderHandle() = default;
+
+    public:
+        /// \brief Whether the program has been compiled.
+        [[nodiscard]] auto ready() const -> bool;
+
+        /// \brief The compiled program, null until `ready`.
+        [[nodiscard]] auto program() const -> rhi::Ref<rhi::ShaderProgram>;
+
+        explicit operator bool() const { return _entry != nullptr; }
+
+        auto operator==(const ShaderHandle&) const -> bool = default;
+
+    private:
+        friend class ShaderRegistry;
+
+        struct Entry;
+
+        explicit ShaderHandle(const Entry* entry);
+
+    private:
+        const Entry* _entry = nullptr;
+    };
+
+    /// \brief Interns the shader programs of a device by shader name, entry points and buffer layout, so that loading
+    /// scales with the unique shaders rather than the materials using them.
+    ///
+    /// The first request of a descriptor queues its compile on the job system and returns at once, so that requesting the
+    /// programs of a level up front prefetches them. Materials and pipelines hold the program itself: take it from `load`,
+    /// or from the handle once it is ready. Without a job system, or without workers to run it, the program is compiled by
+    /// the request. Requests may come from any thread.
+    class QURB_API ShaderRegistry final
+    {
+    public:
+        /// \param jobSystem Compiles the programs on its workers, may be null.
+        explicit ShaderRegistry(rhi::Device* device, JobSystem* jobSystem = nullptr);
+
+        /// \brief Waits for the compiles in flight and releases every program.
+        ~ShaderRegistry();
+
+        ShaderRegistry(const ShaderRegistry&)                    = delete;
+        auto operator=(const ShaderRegistry&) -> ShaderRegistry& = delete;
+
+    public:
+        /// \brief The program of `descriptor`, compiled in the background on the first request.
+        auto request(const rhi::ShaderProgramDescriptor& descriptor) -> ShaderHandle;
+
+        /// \brief The program of `descriptor`, waiting for its compile.
+        auto load(const rhi::ShaderProgramDescriptor& descriptor) -> rhi::Ref<rhi::ShaderProgram>;
+
+        /// \brief Waits for the compile of `handle`, running jobs meanwhile.
+        auto wait(const ShaderHandle& handle) -> void;
+
+        /// \brief Waits for every compile in flight.
+        auto waitIdle() -> void;
+
+        [[nodiscard]] auto statistics() const -> ShaderRegistryStatistics;
+
+    private:
+        /// \brief What identifies a program: the name, the entry points and the layout of the descriptor, packed.
+        static auto makeKey(const rhi::ShaderProgramDescriptor& descriptor) -> std::string;
+
+        auto compile(ShaderHandle::Entry& entry) -> void;
+
+    private:
+        rhi::Device*                                                          _device;
+        JobSystem*                                                            _jobSystem;
+        mutable std::mutex                                                    _mutex;  // Guards the entries.
+        std::unordered_map<std::string, std::unique_ptr<ShaderHandle::Entry>> _entries;
+        std::atomic<uint64>                                                   _requests;
+        std::atomic<uint64>                                                   _ready;
+    };
+
+    //------------------------------------------------------------------------------------------------------------------
+    // class ShaderHandle
+    //------------------------------------------------------------------------------------------------------------------
+
+    /// \brief A program and the compile producing it, owned by the registry.
+    struct ShaderHandle::Entry
+    {
+        rhi::ShaderProgramDescriptor     descriptor;
+        std::atomic<rhi::ShaderProgram*> program = nullptr;  // Published once compiled, released with the registry.
+        JobCounter                       pending = 0;
+    };
+
+    inline ShaderHandle::ShaderHandle(const Entry* entry)
+        : _entry(entry)
+    {}
+
+    inline auto ShaderHandle::ready() const -> bool
+    {
+        return _entry->program.load(std::memory_order_acquire) != nullptr;
+    }
+
+    inline auto ShaderHandle::program() const -> rhi::Ref<rhi::ShaderProgram>
+    {
+        auto* program = _entry->program.load(std::memory_order_acquire);
+        if (program != nullptr)
+        {
+            program->retain();
+        }
+        return rhi::Ref<rhi::ShaderProgram>(program);
+    }
+}
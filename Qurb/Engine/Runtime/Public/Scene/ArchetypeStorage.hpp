@@ -0,0 +1,220 @@
+/// \file ArchetypeStorage.hpp
+
+#pragma once
+
+#include "Containers/Vector.hpp"
+#include "CoreDefines.hpp"
+#include "CoreTypes.hpp"
+#include "Debug/Ensure.hpp"
+#include "Scene/ComponentType.hpp"
+#include "Scene/EntityId.hpp"
+
+#include <limits>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+
+namespace qurb
+{
+    //==================================================================================================================
+    // Class : Archetype
+    //==================================================================================================================
+
+    /// \brief Every entity owning exactly the same set of components, stored column by column in fixed-size chunks.
+    ///
+    /// A chunk holds `chunkCapacity()` rows: the entity ids first, then one tightly packed array per component, each
+    /// starting on a cache line. Rows are kept dense across chunks, so only the last chunk can be partially filled.
+    class QURB_API Archetype final
+    {
+    public:
+        static constexpr auto chunkSize    = usize(16 * 1024);
+        static constexpr auto invalidIndex = std::numeric_limits<uint32>::max();
+
+    public:
+        explicit Archetype(const ComponentSignature& signature);
+        ~Archetype();
+
+        Archetype(const Archetype&)                    = delete;
+        auto operator=(const Archetype&) -> Archetype& = delete;
+
+    public:
+        [[nodiscard]] auto signature() const -> const ComponentSignature& { return _signature; }
+        [[nodiscard]] auto componentIds() const -> const Vector<usize>& { return _componentIds; }
+
+        [[nodiscard]] auto size() const -> uint32 { return _size; }
+        [[nodiscard]] auto empty() const -> bool { return _size == 0; }
+
+        [[nodiscard]] auto chunkCapacity() const -> uint32 { return _chunkCapacity; }
+
+        /// \brief The number of chunks holding at least one row.
+        [[nodiscard]] auto chunkCount() const -> uint32 { return (_size + _chunkCapacity - 1) / _chunkCapacity; }
+
+        /// \brief The number of rows used in the chunk at `chunk`.
+        [[nodiscard]] auto chunkRows(uint32 chunk) const -> uint32;
+
+        [[nodiscard]] auto entities(uint32 chunk) const -> EntityId*;
+
+        /// \brief The column of `T` in the chunk at `chunk`, the archetype must own `T`.
+        template <typename T>
+        [[nodiscard]] auto column(uint32 chunk) const -> T*;
+
+        [[nodiscard]] auto component(usize componentId, uint32 row) const -> void*;
+
+        /// \brief The archetype reached by toggling `componentId`, `invalidIndex` until the storage first resolves it.
+        [[nodiscard]] auto edge(usize componentId) -> uint32& { return _edges[componentId]; }
+
+        /// \brief Appends a row for `id` and returns its index, the components of the row are left unconstructed.
+        auto allocateRow(EntityId id) -> uint32;
+
+        /// \brief Destroys the components at `row` and moves the last row into the hole.
+        /// \return The entity moved into `row`, or `invalidEntityId` if `row` was the last one.
+        auto removeRow(uint32 row) -> EntityId;
+
+        /// \brief The number of bytes allocated by the chunks.
+        [[nodiscard]] auto memoryUsage() const -> usize;
+
+    private:
+        auto address(usize offset, usize stride, uint32 row) const -> void*;
+
+    private:
+        ComponentSignature _signature;
+        Vector<usize>      _componentIds;
+        usize              _columnOffsets[maxComponentTypes] = {};
+        uint32             _edges[maxComponentTypes]         = {};
+        Vector<uint8*>     _chunks;
+        uint32             _chunkCapacity = 0;
+        uint32             _size          = 0;
+    };
+
+    //==================================================================================================================
+    // Class : ArchetypeStorage
+    //==================================================================================================================
+
+    /// \brief Component storage grouping entities by archetype, an alternative to one `ComponentPool` per component.
+    ///
+    /// Iterating several components only walks the chunks of matching archetypes, with every column contiguous, at the
+    /// cost of moving the entity to another archetype each time a component is added or removed.
+    class QURB_API ArchetypeStorage final
+    {
+    public:
+        ArchetypeStorage();
+
+        ArchetypeStorage(const ArchetypeStorage&)                    = delete;
+        auto operator=(const ArchetypeStorage&) -> ArchetypeStorage& = delete;
+
+    public:
+        /// \brief Places `id` in the archetype without components.
+        auto createEntity(EntityId id) -> void;
+
+        /// \brief Destroys the components of `id` and removes it from its archetype.
+        auto destroyEntity(EntityId id) -> void;
+
+        template <typename T, typename... Args>
+        auto add(EntityId id, Args&&... args) -> T&;
+
+        template <typename T>
+        auto get(EntityId id) -> T&;
+
+        template <typename T>
+        auto remove(EntityId id) -> void;
+
+        [[nodiscard]] auto archetypes() const -> const Vector<std::unique_ptr<Archetype>>& { return _archetypes; }
+
+        /// \brief The number of bytes allocated by the archetypes and the entity locations.
+        [[nodiscard]] auto memoryUsage() const -> usize;
+
+    private:
+        struct EntityLocation
+        {
+            uint32 archetype;
+            uint32 row;
+        };
+
+    private:
+        /// \brief The index of the archetype reached from `archetype` by toggling `componentId`, created on first use.
+        auto neighbour(uint32 archetype, usize componentId) -> uint32;
+
+        /// \brief Moves `id` and the components shared by both archetypes to `archetype`, returns the new row.
+        auto migrate(EntityId id, uint32 archetype) -> uint32;
+
+    private:
+        Vector<std::unique_ptr<Archetype>>             _archetypes;
+        std::unordered_map<ComponentSignature, uint32> _archetypeIndices;
+        Vector<EntityLocation>                         _locations;  // Indexed by entity index.
+    };
+
+    //------------------------------------------------------------------------------------------------------------------
+    // class Archetype
+    //------------------------------------------------------------------------------------------------------------------
+
+    inline auto Archetype::chunkRows(uint32 chunk) const -> uint32
+    {
+        const auto begin = chunk * _chunkCapacity;
+        return _size - begin < _chunkCapacity ? _size - begin : _chunkCapacity;
+    }
+
+    inline auto Archetype::entities(uint32 chunk) const -> EntityId*
+    {
+        return reinterpret_cast<EntityId*>(_chunks[chunk]);
+    }
+
+    template <typename T>
+    auto Archetype::column(uint32 chunk) const -> T*
+    {
+        return reinterpret_cast<T*>(_chunks[chunk] + _columnOffsets[ComponentType::id<T>()]);
+    }
+
+    inline auto Archetype::component(usize componentId, uint32 row) const -> void*
+    {
+        return address(_columnOffsets[componentId], ComponentType::info(componentId).size, row);
+    }
+
+    inline auto Archetype::address(usize offset, usize stride, uint32 row) const -> void*
+    {
+        return _chunks[row / _chunkCapacity] + offset + (row % _chunkCapacity) * stride;
+    }
+
+    //------------------------------------------------------------------------------------------------------------------
+    // class ArchetypeStorage
+    //------------------------------------------------------------------------------------------------------------------
+
+    template <typename T, typename... Args>
+    auto ArchetypeStorage::add(EntityId id, Args&&... args) -> T&
+    {
+        const auto componentId = ComponentType::id<T>();
+        const auto location    = _locations[entityIndex(id)];
+        auto&      archetype   = *_archetypes[location.archetype];
+
+        if (archetype.signature().test(componentId))
+        {
+            auto* component = static_cast<T*>(archetype.component(componentId, location.row));
+            std::destroy_at(component);
+            return *std::construct_at(component, std::forward<Args>(args)...);
+        }
+
+        const auto target = neighbour(location.archetype, componentId);
+        const auto row    = migrate(id, target);
+        return *std::construct_at(static_cast<T*>(_archetypes[target]->component(componentId, row)), std::forward<Args>(args)...);
+    }
+
+    template <typename T>
+    auto ArchetypeStorage::get(EntityId id) -> T&
+    {
+        const auto location = _locations[entityIndex(id)];
+        return *static_cast<T*>(_archetypes[location.archetype]->component(ComponentType::id<T>(), location.row));
+    }
+
+    template <typename T>
+    auto ArchetypeStorage::remove(EntityId id) -> void
+    {
+        const auto componentId = ComponentType::id<T>();
+        const auto location    = _locations[entityIndex(id)];
+
+        if (not _archetypes[location.archetype]->signature().test(componentId))
+        {
+            return;
+        }
+
+        migrate(id, neighbour(location.archetype, componentId));
+    }
+}
@@ -0,0 +1,307 @@
+/// \file ComponentPool.hpp
+
+#pragma once
+
+#include "Containers/Vector.hpp"
+#include "CoreTypes.hpp"
+#include "Debug/Ensure.hpp"
+#include "Scene/EntityId.hpp"
+
+#include <limits>
+#include <memory>
+#include <utility>
+
+namespace qurb
+{
+    //==================================================================================================================
+    // Class : SparseSet
+    //==================================================================================================================
+
+    /// \brief A set of entities stored as a packed array plus a paged entity to dense index map.
+    ///
+    /// Membership tests, insertions and removals are O(1). Removal swaps the last element into the hole so the dense
+    /// array never contains gaps, and the sparse map is allocated page by page so that a single entity with a large id
+    /// does not reserve memory for every entity before it. The sparse map is keyed by entity index while the dense array
+    /// keeps the full handle, so a stale handle is rejected by comparing it with the stored one.
+    class SparseSet
+    {
+    public:
+        static constexpr auto invalidIndex = std::numeric_limits<uint32>::max();
+        static constexpr auto pageSize     = usize(4096);
+
+    public:
+        SparseSet() = default;
+        virtual ~SparseSet() = default;
+
+        SparseSet(const SparseSet&)                    = delete;
+        auto operator=(const SparseSet&) -> SparseSet& = delete;
+
+    public:
+        [[nodiscard]] auto size() const -> usize;
+        [[nodiscard]] auto empty() const -> bool;
+        [[nodiscard]] auto contains(EntityId id) const -> bool;
+        /// \brief The dense index of `id`, or `invalidIndex` if `id` is not in the set.
+        [[nodiscard]] auto index(EntityId id) const -> uint32;
+
+        /// \brief The entities of the set, in dense order.
+        [[nodiscard]] auto entities() const -> const Vector<EntityId>&;
+
+        /// \brief The number of bytes allocated by the set.
+        [[nodiscard]] virtual auto memoryUsage() const -> usize;
+
+        virtual auto remove(EntityId id) -> void;
+
+        /// \brief Makes room for `capacity` entities so that adding them does not reallocate.
+        virtual auto reserve(usize capacity) -> void;
+
+        /// \brief The number of entities the set holds without reallocating.
+        [[nodiscard]] auto capacity() const -> usize;
+
+    protected:
+        /// \brief The dense index stored for the slot of `id`, without checking the generation.
+        [[nodiscard]] auto sparseIndex(EntityId id) const -> uint32;
+
+        /// \brief Appends `id` to the dense array and returns its index.
+        auto insert(EntityId id) -> uint32;
+
+        /// \brief Moves the last entity into the slot at `index` and pops the dense array.
+        auto swapAndPop(uint32 index) -> void;
+
+        auto sparseSlot(EntityId id) -> uint32&;
+
+    private:
+        Vector<EntityId>       _dense;
+        Vector<Vector<uint32>> _sparsePages;
+    };
+
+    //==================================================================================================================
+    // Class : ComponentPool
+    //==================================================================================================================
+
+    /// \brief A `SparseSet` storing one `T` per entity in a packed array parallel to the entities.
+    template <typename T>
+    class ComponentPool final : public SparseSet
+    {
+    public:
+        ComponentPool() = default;
+
+    public:
+        template <typename... Args>
+        auto add(EntityId id, Args&&... args) -> T&;
+
+        /// \brief The component of `id`, which must be in the pool.
+        auto at(EntityId id) -> T&;
+        auto at(EntityId id) const -> const T&;
+
+        auto remove(EntityId id) -> void override;
+        auto reserve(usize capacity) -> void override;
+
+        [[nodiscard]] auto memoryUsage() const -> usize override;
+
+        /// \brief The components of the pool, in the same order as `entities()`.
+        [[nodiscard]] auto components() -> Vector<T>&;
+        [[nodiscard]] auto components() const -> const Vector<T>&;
+
+        auto begin() -> T*;
+        auto end() -> T*;
+
+    private:
+        Vector<T> _components;
+    };
+
+    //------------------------------------------------------------------------------------------------------------------
+    // class SparseSet
+    //------------------------------------------------------------------------------------------------------------------
+
+    inline auto SparseSet::size() const -> usize
+    {
+        return _dense.size();
+    }
+
+    inline auto SparseSet::empty() const -> bool
+    {
+        return _dense.empty();
+    }
+
+    inline auto SparseSet::contains(EntityId id) const -> bool
+    {
+        return index(id) != invalidIndex;
+    }
+
+    inline auto SparseSet::index(EntityId id) const -> uint32
+    {
+        const auto denseIndex = sparseIndex(id);
+        return denseIndex != invalidIndex and _dense[denseIndex] == id ? denseIndex : invalidIndex;
+    }
+
+    inline auto SparseSet::entities() const -> const Vector<EntityId>&
+    {
+        return _dense;
+    }
+
+    inline auto SparseSet::memoryUsage() const -> usize
+    {
+        auto bytes = _dense.capacity() * sizeof(EntityId) + _sparsePages.capacity() * sizeof(Vector<uint32>);
+        for (const auto& page : _sparsePages)
+        {
+            bytes += page.capacity() * sizeof(uint32);
+        }
+        return bytes;
+    }
+
+    inline auto SparseSet::remove(EntityId id) -> void
+    {
+        const auto denseIndex = index(id);
+        if (denseIndex != invalidIndex)
+        {
+            swapAndPop(denseIndex);
+        }
+    }
+
+    inline auto SparseSet::reserve(usize capacity) -> void
+    {
+        _dense.reserve(capacity);
+    }
+
+    inline auto SparseSet::capacity() const -> usize
+    {
+        return _dense.capacity();
+    }
+
+    inline auto SparseSet::sparseIndex(EntityId id) const -> uint32
+    {
+        const auto page = entityIndex(id) / pageSize;
+        if (page >= _sparsePages.size() or _sparsePages[page].empty())
+        {
+            return invalidIndex;
+        }
+
+        return _sparsePages[page][entityIndex(id) % pageSize];
+    }
+
+    inline auto SparseSet::insert(EntityId id) -> uint32
+    {
+        ensure(not contains(id), "Entity {} is already in the set.", id);
+
+        const auto denseIndex = static_cast<uint32>(_dense.size());
+        _dense.pushBack(id);
+        sparseSlot(id) = denseIndex;
+        return denseIndex;
+    }
+
+    inline auto SparseSet::swapAndPop(uint32 index) -> void
+    {
+        const auto removed = _dense[index];
+        const auto last    = _dense.back();
+
+        _dense[index]       = last;
+        sparseSlot(last)    = index;
+        sparseSlot(removed) = invalidIndex;
+        _dense.popBack();
+    }
+
+    inline auto SparseSet::sparseSlot(EntityId id) -> uint32&
+    {
+        const auto page = entityIndex(id) / pageSize;
+        while (page >= _sparsePages.size())
+        {
+            _sparsePages.emplaceBack();
+        }
+
+        auto& sparsePage = _sparsePages[page];
+        if (sparsePage.empty())
+        {
+            sparsePage.resize(pageSize, invalidIndex);
+        }
+
+        return sparsePage[entityIndex(id) % pageSize];
+    }
+
+    //------------------------------------------------------------------------------------------------------------------
+    // class ComponentPool
+    //------------------------------------------------------------------------------------------------------------------
+
+    template <typename T>
+    template <typename... Args>
+    auto ComponentPool<T>::add(EntityId id, Args&&... args) -> T&
+    {
+        const auto denseIndex = index(id);
+        if (denseIndex != invalidIndex)
+        {
+            std::destroy_at(&_components[denseIndex]);
+            return *std::construct_at(&_components[denseIndex], std::forward<Args>(args)...);
+        }
+
+        insert(id);
+        return _components.emplaceBack(std::forward<Args>(args)...);
+    }
+
+    template <typename T>
+    auto ComponentPool<T>::at(EntityId id) -> T&
+    {
+        return _components[sparseIndex(id)];
+    }
+
+    template <typename T>
+    auto ComponentPool<T>::at(EntityId id) const -> const T&
+    {
+        return _components[sparseIndex(id)];
+    }
+
+    template <typename T>
+    auto ComponentPool<T>::remove(EntityId id) -> void
+    {
+        const auto denseIndex = index(id);
+        if (denseIndex == invalidIndex)
+        {
+            return;
+        }
+
+        // Components are not required to be assignable, so relocate the last one by construction.
+        if (denseIndex != _components.size() - 1)
+        {
+            std::destroy_at(&_components[denseIndex]);
+            std::construct_at(&_components[denseIndex], std::move(_components.back()));
+        }
+        _components.popBack();
+
+        swapAndPop(denseIndex);
+    }
+
+    template <typename T>
+    auto ComponentPool<T>::reserve(usize capacity) -> void
+    {
+        SparseSet::reserve(capacity);
+        _components.reserve(capacity);
+    }
+
+    template <typename T>
+    auto ComponentPool<T>::memoryUsage() const -> usize
+    {
+        return SparseSet::memoryUsage() + _components.capacity() * sizeof(T);
+    }
+
+    template <typename T>
+    auto ComponentPool<T>::components() -> Vector<T>&
+    {
+        return _components;
+    }
+
+    template <typename T>
+    auto ComponentPool<T>::components() const -> const Vector<T>&
+    {
+        return _components;
+    }
+
+    template <typename T>
+    auto ComponentPool<T>::begin() -> T*
+    {
+        return _components.begin();
+    }
+
+    template <typename T>
+    auto ComponentPool<T>::end() -> T*
+    {
+        return _components.end();
+    }
+}
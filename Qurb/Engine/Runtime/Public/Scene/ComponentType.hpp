@@ -0,0 +1,92 @@
+/// \file ComponentType.hpp
+
+#pragma once
+
+#include "CoreDefines.hpp"
+#include "CoreTypes.hpp"
+#include "Debug/Exceptions.hpp"
+
+#include <atomic>
+#include <bitset>
+#include <new>
+#include <utility>
+
+namespace qurb
+{
+    /// \brief The maximum number of distinct component types known by the engine.
+    constexpr usize maxComponentTypes = 64;
+
+    /// \brief A fixed-width set of component ids, bit `i` is set when the entity owns the component of id `i`.
+    using ComponentSignature = std::bitset<maxComponentTypes>;
+
+    /// \brief The type-erased operations needed to store a component in raw memory.
+    struct ComponentInfo
+    {
+        usize size;
+        usize alignment;
+        auto (*moveConstruct)(void* destination, void* source) -> void;
+        auto (*destroy)(void* component) -> void;
+    };
+
+    /// \brief Assigns a dense id to every component type, in order of first use.
+    class QURB_API ComponentType final
+    {
+    public:
+        ComponentType() = delete;
+
+    public:
+        template <typename T>
+        static auto id() -> usize;
+
+        template <typename... Ts>
+        static auto signature() -> const ComponentSignature&;
+
+        static auto info(usize id) -> const ComponentInfo&;
+
+    private:
+        template <typename T>
+        static auto registerType() -> usize;
+
+    private:
+        static inline std::atomic<usize> _counter                   = 0;
+        static inline ComponentInfo      _infos[maxComponentTypes] = {};
+    };
+
+    template <typename T>
+    auto ComponentType::id() -> usize
+    {
+        static const usize id = registerType<T>();
+        return id;
+    }
+
+    template <typename... Ts>
+    auto ComponentType::signature() -> const ComponentSignature&
+    {
+        static const ComponentSignature signature = (ComponentSignature() | ... | (ComponentSignature(1) << id<Ts>()));
+        return signature;
+    }
+
+    inline auto ComponentType::info(usize id) -> const ComponentInfo&
+    {
+        return _infos[id];
+    }
+
+    template <typename T>
+    auto ComponentType::registerType() -> usize
+    {
+        // Checked in every build, `_infos` would be written out of bounds.
+        const auto id = _counter++;
+        if (id >= maxComponentTypes)
+        {
+            throw Exception("Too many component types, increase maxComponentTypes.");
+        }
+
+        _infos[id] = ComponentInfo {
+            .size          = sizeof(T),
+            .alignment     = alignof(T),
+            .moveConstruct = [](void* destination, void* source) { new (destination) T(std::move(*static_cast<T*>(source))); },
+            .destroy       = [](void* component) { static_cast<T*>(component)->~T(); },
+        };
+        return id;
+    }
+}
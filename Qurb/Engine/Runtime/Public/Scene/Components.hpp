@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "Containers/Vector.hpp"
 #include "CoreDefines.hpp"
 #include "Math/Matrix4x4.hpp"
 #include "Math/Vector3.hpp"
@@ -9,6 +10,14 @@
 #include "RHI/PipelineState.hpp"
 #include "RHI/ShaderProgram.hpp"
 #include "Scene/Camera.hpp"
+#include "Scene/EntityId.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <span>
+#include <string>
 
 namespace qurb
 {
@@ -22,30 +31,184 @@ namespace qurb
         TagComponent(TagComponent&&)      = default;
     };
 
+    /// \brief The world indices of the transforms changed since the last `TransformSystem::update`, pushed by their
+    /// setters from any thread.
+    ///
+    /// A transform is pushed once, when it first becomes dirty. The list holds one slot per transform of the system, so
+    /// that it never reallocates between updates, a push past the end only counts.
+    class QURB_API TransformChangeList final
+    {
+    public:
+        auto push(uint32 worldIndex) -> void;
+
+    private:
+        friend class TransformSystem;
+
+    private:
+        Vector<uint32>     _indices;
+        std::atomic<usize> _count = 0;
+    };
+
+    inline auto TransformChangeList::push(uint32 worldIndex) -> void
+    {
+        const auto slot = _count.fetch_add(1, std::memory_order_relaxed);
+        if (slot < _indices.size())
+        {
+            _indices[slot] = worldIndex;
+        }
+    }
+
+    /// \brief The position, rotation and scale of an entity, relative to its parent when it has a `ParentComponent`.
+    ///
+    /// Every setter marks the transform dirty, the local matrix is only rebuilt on the next `transformMatrix` and the
+    /// world matrix on the next `TransformSystem::update`. Once updated, a transform reports its first change of a frame
+    /// to the change list of its system, which must therefore outlive the changes.
     struct QURB_API TransformComponent
     {
-        math::Vector3f position    = math::Vector3f::zero;
-        math::Vector3f eulerAngles = math::Vector3f::zero;
-        math::Vector3f scale       = math::Vector3f::one;
+    public:
+        static constexpr auto invalidWorldIndex = std::numeric_limits<uint32>::max();
 
     public:
         TransformComponent() = default;
 
+        /// \brief A copy is a new transform, without a world matrix until the next `TransformSystem::update`.
+        TransformComponent(const TransformComponent& other);
+        auto operator=(const TransformComponent& other) -> TransformComponent&;
+
+        /// \brief Moves relocate a transform within the component storage, it keeps its world matrix.
+        TransformComponent(TransformComponent&&)                    = default;
+        auto operator=(TransformComponent&&) -> TransformComponent& = default;
+
     public:
+        [[nodiscard]] auto position() const -> const math::Vector3f& { return _position; }
+        [[nodiscard]] auto eulerAngles() const -> const math::Vector3f& { return _eulerAngles; }
+        [[nodiscard]] auto scale() const -> const math::Vector3f& { return _scale; }
+
+        auto setPosition(const math::Vector3f& position) -> void;
+        auto setEulerAngles(const math::Vector3f& eulerAngles) -> void;
+        auto setScale(const math::Vector3f& scale) -> void;
+
+        auto translate(const math::Vector3f& translation) -> void;
+        auto rotate(const math::Vector3f& eulerAngles) -> void;
+
+        /// \brief The local matrix, translation x rotation x scale, recomputed only after a change.
         [[nodiscard]] auto transformMatrix() -> const math::Matrix4x4f&;
 
+        /// \brief Whether the transform changed since the last `TransformSystem::update`.
+        [[nodiscard]] auto dirty() const -> bool { return _worldDirty; }
+
+        /// \brief The index of the world matrix in `TransformSystem::worldMatrices`, or `invalidWorldIndex` until the
+        /// transform system first updated the entity.
+        [[nodiscard]] auto worldIndex() const -> uint32 { return _worldIndex; }
+
+    private:
+        auto markDirty() -> void;
+
     private:
-        math::Matrix4x4f _transform;
+        friend class TransformSystem;
+
+    private:
+        math::Vector3f       _position    = math::Vector3f::zero;
+        math::Vector3f       _eulerAngles = math::Vector3f::zero;
+        math::Vector3f       _scale       = math::Vector3f::one;
+        math::Matrix4x4f     _localMatrix = math::Matrix4x4f::identity;
+        uint32               _worldIndex  = invalidWorldIndex;
+        TransformChangeList* _changes     = nullptr;  // Of the system which assigned `_worldIndex`.
+        bool                 _localDirty  = true;
+        bool                 _worldDirty  = true;
     };
 
+    inline TransformComponent::TransformComponent(const TransformComponent& other)
+        : _position(other._position)
+        , _eulerAngles(other._eulerAngles)
+        , _scale(other._scale)
+        , _localMatrix(other._localMatrix)
+        , _worldIndex(invalidWorldIndex)
+        , _changes(nullptr)
+        , _localDirty(other._localDirty)
+        , _worldDirty(true)
+    {}
+
+    inline auto TransformComponent::operator=(const TransformComponent& other) -> TransformComponent&
+    {
+        _position    = other._position;
+        _eulerAngles = other._eulerAngles;
+        _scale       = other._scale;
+        markDirty();
+        return *this;
+    }
+
+    inline auto TransformComponent::setPosition(const math::Vector3f& position) -> void
+    {
+        _position = position;
+        markDirty();
+    }
+
+    inline auto TransformComponent::setEulerAngles(const math::Vector3f& eulerAngles) -> void
+    {
+        _eulerAngles = eulerAngles;
+        markDirty();
+    }
+
+    inline auto TransformComponent::setScale(const math::Vector3f& scale) -> void
+    {
+        _scale = scale;
+        markDirty();
+    }
+
+    inline auto TransformComponent::translate(const math::Vector3f& translation) -> void
+    {
+        _position += translation;
+        markDirty();
+    }
+
+    inline auto TransformComponent::rotate(const math::Vector3f& eulerAngles) -> void
+    {
+        _eulerAngles += eulerAngles;
+        markDirty();
+    }
+
     inline auto TransformComponent::transformMatrix() -> const math::Matrix4x4f&
     {
-        _transform = translationMatrix(position);
-        _transform *= rotationMatrix(eulerAngles);
-        _transform *= scaleMatrix(scale);
-        return _transform;
+        if (_localDirty)
+        {
+            _localMatrix = math::transformMatrix(_position, math::QuaternionF(_eulerAngles), _scale);
+            _localDirty  = false;
+        }
+        return _localMatrix;
     }
 
+    inline auto TransformComponent::markDirty() -> void
+    {
+        _localDirty = true;
+        if (not _worldDirty)
+        {
+            _worldDirty = true;
+            if (_changes != nullptr)
+            {
+                _changes->push(_worldIndex);
+            }
+        }
+    }
+
+    /// \brief The parent of an entity in the transform hierarchy, kept in sync by `TransformSystem::setParent`.
+    struct QURB_API ParentComponent
+    {
+        EntityId parent = invalidEntityId;
+
+    public:
+        ParentComponent() = default;
+    };
+
+    /// \brief The children of an entity in the transform hierarchy, kept in sync by `TransformSystem::setParent`.
+    struct QURB_API ChildrenComponent
+    {
+        Vector<EntityId> children;
+
+    public:
+        ChildrenComponent() = default;
+    };
+
     struct QURB_API MeshComponent
     {
         rhi::Buffer* vertexBuffer;
@@ -65,6 +228,45 @@ namespace qurb
         MaterialComponent() = default;
     };
 
+    /// \brief The axis aligned box enclosing the mesh of an entity, in its local space.
+    ///
+    /// Entities without bounds are never culled.
+    struct QURB_API BoundsComponent
+    {
+        math::Vector3f center  = math::Vector3f::zero;
+        math::Vector3f extents = math::Vector3f::zero;  // Half the size of the box along each axis.
+
+    public:
+        BoundsComponent() = default;
+
+        /// \brief The smallest box enclosing `positions`, the vertex positions of a mesh.
+        [[nodiscard]] static auto fromPoints(std::span<const math::Vector3f> positions) -> BoundsComponent;
+
+        /// \brief The radius of the sphere centered on the box and enclosing it.
+        [[nodiscard]] auto radius() const -> float32 { return std::sqrt(math::dot(extents, extents)); }
+    };
+
+    inline auto BoundsComponent::fromPoints(std::span<const math::Vector3f> positions) -> BoundsComponent
+    {
+        if (positions.empty())
+        {
+            return BoundsComponent();
+        }
+
+        auto lower = positions.front();
+        auto upper = positions.front();
+        for (const auto& position : positions)
+        {
+            lower = math::Vector3f(std::min(lower.x, position.x), std::min(lower.y, position.y), std::min(lower.z, position.z));
+            upper = math::Vector3f(std::max(upper.x, position.x), std::max(upper.y, position.y), std::max(upper.z, position.z));
+        }
+
+        auto bounds    = BoundsComponent();
+        bounds.center  = (lower + upper) * 0.5f;
+        bounds.extents = (upper - lower) * 0.5f;
+        return bounds;
+    }
+
     struct QURB_API NativeScriptComponent
 
     {
@@ -5,13 +5,10 @@
 #include "CoreDefines.hpp"
 #include "Scene/EntityRegistery.hpp"
 
-#include <limits>
 #include <tuple>
 
 namespace qurb
 {
-    constexpr auto invalidEntityId = std::numeric_limits<EntityId>::max();
-
     // \brief The `Entity` class.
     class QURB_API Entity final
     {
@@ -21,6 +18,9 @@ namespace qurb
     public:
         [[nodiscard]] auto id() const -> EntityId { return _id; }
 
+        /// \brief Returns `false` once the entity has been destroyed, even if its slot was reused since.
+        [[nodiscard]] auto isAlive() const -> bool { return _registery.isAlive(_id); }
+
         template <typename T, typename... Args>
         auto addComponent(Args&&... args) -> T&;
 
@@ -0,0 +1,182 @@
+/// \file EntityCommandBuffer.hpp
+
+#pragma once
+
+#include "Containers/Vector.hpp"
+#include "CoreDefines.hpp"
+#include "CoreTypes.hpp"
+#include "Scene/ComponentType.hpp"
+#include "Scene/EntityId.hpp"
+#include "Scene/EntityRegistery.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <utility>
+
+namespace qurb
+{
+    /// \brief Records structural changes to apply to an `EntityRegistery` later, at a point where nothing iterates it.
+    ///
+    /// Recording is thread-safe: every thread appends to its own stream, components are moved into a per-stream arena.
+    /// `playback` creates the recorded entities, then applies the component commands sorted by component type so that
+    /// each pool is reserved once, and finally destroys entities. Commands on the same entity and component keep the
+    /// order in which one thread recorded them.
+    class QURB_API EntityCommandBuffer final
+    {
+    public:
+        EntityCommandBuffer();
+        ~EntityCommandBuffer();
+
+        EntityCommandBuffer(const EntityCommandBuffer&)                    = delete;
+        auto operator=(const EntityCommandBuffer&) -> EntityCommandBuffer& = delete;
+
+    public:
+        /// \brief Records the creation of an entity.
+        /// \return A pending handle, only valid in commands of this buffer until the next `playback`.
+        auto createEntity() -> EntityId;
+
+        auto destroyEntity(EntityId id) -> void;
+
+        template <typename T, typename... Args>
+        auto addComponent(EntityId id, Args&&... args) -> void;
+
+        template <typename T>
+        auto removeComponent(EntityId id) -> void;
+
+        /// \brief Applies and clears every recorded command. Must not run concurrently with recording.
+        auto playback(EntityRegistery& registery) -> void;
+
+        /// \brief The entities created by the last `playback`, indexed like the pending handles.
+        [[nodiscard]] auto createdEntities() const -> const Vector<EntityId>& { return _createdEntities; }
+
+        [[nodiscard]] auto empty() const -> bool;
+
+        [[nodiscard]] static auto isPending(EntityId id) -> bool;
+
+    private:
+        enum class CommandType : uint8
+        {
+            Add,
+            Remove,
+            Destroy,
+        };
+
+        /// \brief The typed registery calls of one component type.
+        struct ComponentOperations
+        {
+            auto (*add)(EntityRegistery& registery, EntityId id, void* component) -> void;
+            auto (*remove)(EntityRegistery& registery, EntityId id) -> void;
+            auto (*reserve)(EntityRegistery& registery, usize count) -> void;
+        };
+
+        struct Command
+        {
+            EntityId                   entity;
+            const ComponentOperations* operations;
+            void*                      component;
+            uint32                     componentId;
+            CommandType                type;
+        };
+
+        /// \brief The commands recorded by one thread, and the arena holding their components.
+        struct Stream
+        {
+            std::thread::id                  thread;
+            Vector<Command>                  commands;
+            Vector<std::unique_ptr<uint8[]>> blocks;
+            usize                            blockIndex  = 0;
+            usize                            blockOffset = 0;
+
+        public:
+            auto allocate(usize size, usize alignment) -> void*;
+            auto reset() -> void;
+        };
+
+    private:
+        template <typename T>
+        static auto operations() -> const ComponentOperations&;
+
+        /// \brief The capacity to reserve for `needed` elements: unchanged when it is enough, else at least doubled so
+        /// that playing back small batches one after the other does not reallocate every time.
+        [[nodiscard]] static auto reservedCapacity(usize needed, usize capacity) -> usize;
+
+        /// \brief The stream of the calling thread, created on its first command.
+        auto stream() -> Stream&;
+
+        auto resolve(EntityId id) const -> EntityId;
+
+    private:
+        static constexpr auto blockSize = usize(64 * 1024);
+
+    private:
+        const uint64                    _uid;  // Distinguishes buffers in the thread-local stream cache.
+        std::mutex                      _mutex;
+        Vector<std::unique_ptr<Stream>> _streams;
+        std::atomic<uint32>             _pendingCount = 0;
+        Vector<EntityId>                _createdEntities;
+        Vector<Command>                 _sortedCommands;  // Playback scratch, kept to avoid reallocating every frame.
+    };
+
+    //------------------------------------------------------------------------------------------------------------------
+    // class EntityCommandBuffer
+    //------------------------------------------------------------------------------------------------------------------
+
+    template <typename T, typename... Args>
+    auto EntityCommandBuffer::addComponent(EntityId id, Args&&... args) -> void
+    {
+        auto& commandStream = stream();
+        auto* component     = new (commandStream.allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+
+        commandStream.commands.pushBack(Command {
+            .entity      = id,
+            .operations  = &operations<T>(),
+            .component   = component,
+            .componentId = static_cast<uint32>(ComponentType::id<T>()),
+            .type        = CommandType::Add,
+        });
+    }
+
+    template <typename T>
+    auto EntityCommandBuffer::removeComponent(EntityId id) -> void
+    {
+        stream().commands.pushBack(Command {
+            .entity      = id,
+            .operations  = &operations<T>(),
+            .component   = nullptr,
+            .componentId = static_cast<uint32>(ComponentType::id<T>()),
+            .type        = CommandType::Remove,
+        });
+    }
+
+    inline auto EntityCommandBuffer::isPending(EntityId id) -> bool
+    {
+        return id != invalidEntityId and entityGeneration(id) == reservedEntityGeneration;
+    }
+
+    inline auto EntityCommandBuffer::reservedCapacity(usize needed, usize capacity) -> usize
+    {
+        return needed <= capacity ? capacity : std::max(needed, capacity * 2);
+    }
+
+    template <typename T>
+    auto EntityCommandBuffer::operations() -> const ComponentOperations&
+    {
+        static const auto componentOperations = ComponentOperations {
+            .add    = [](EntityRegistery& registery, EntityId id, void* component) { registery.addComponent<T>(id, std::move(*static_cast<T*>(component))); },
+            .remove = [](EntityRegistery& registery, EntityId id) { registery.removeComponent<T>(id); },
+            .reserve =
+                [](EntityRegistery& registery, usize count) {
+                    if (registery.storageType() == EntityStorageType::ComponentPools)
+                    {
+                        auto& pool = registery.componentPool<T>();
+                        pool.reserve(reservedCapacity(pool.size() + count, pool.capacity()));
+                    }
+                },
+        };
+        return componentOperations;
+    }
+}
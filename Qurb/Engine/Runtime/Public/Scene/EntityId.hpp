@@ -0,0 +1,37 @@
+/// \file EntityId.hpp
+
+#pragma once
+
+#include "CoreTypes.hpp"
+
+#include <limits>
+
+namespace qurb
+{
+    /// \brief A generational entity handle: the slot index in the low 32 bits, the slot generation in the high 32 bits.
+    ///
+    /// Destroying an entity bumps the generation of its slot, so a handle kept to a destroyed entity never compares
+    /// equal to the handle of the entity that reuses the slot.
+    using EntityId = uint64;
+
+    constexpr auto invalidEntityId = std::numeric_limits<EntityId>::max();
+
+    /// \brief A generation never given to a live entity, used by handles that do not name a registery slot.
+    constexpr auto reservedEntityGeneration = std::numeric_limits<uint32>::max();
+
+    /// \brief The slot of `id` in the registery and component storage arrays.
+    constexpr auto entityIndex(EntityId id) -> uint32
+    {
+        return static_cast<uint32>(id);
+    }
+
+    constexpr auto entityGeneration(EntityId id) -> uint32
+    {
+        return static_cast<uint32>(id >> 32);
+    }
+
+    constexpr auto makeEntityId(uint32 index, uint32 generation) -> EntityId
+    {
+        return (static_cast<EntityId>(generation) << 32) | index;
+    }
+}
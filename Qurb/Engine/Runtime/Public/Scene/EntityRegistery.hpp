@@ -3,50 +3,67 @@
 #include "Containers/Vector.hpp"
 #include "CoreDefines.hpp"
 #include "CoreTypes.hpp"
+#include "Debug/Ensure.hpp"
 #include "Debug/Exceptions.hpp"
 #include "Log/Log.hpp"
+#include "Scene/ArchetypeStorage.hpp"
+#include "Scene/ComponentPool.hpp"
+#include "Scene/ComponentType.hpp"
+#include "Scene/EntityId.hpp"
+#include "Scene/View.hpp"
 
+#include <array>
 #include <format>
+#include <limits>
+#include <memory>
 #include <tuple>
-#include <unordered_set>
-#include <vector>
 
 namespace qurb
 {
     class Entity;
 
-    using EntityId = uint64;
+    /// \brief How an `EntityRegistery` lays out the components of its entities.
+    enum class EntityStorageType : uint8
+    {
+        ComponentPools,  ///< One sparse set per component type, cheap add and remove.
+        Archetypes,      ///< Entities grouped by component set in 16 KiB chunks, cheap multi-component iteration.
+    };
 
-    class ComponentPool
+    class QURB_API EntityRegistery
     {
     public:
-        ComponentPool(usize stride = 0)
-            : _stride(stride)
-            , _data()
-        {}
+        explicit EntityRegistery(EntityStorageType storageType = EntityStorageType::ComponentPools);
+
+        EntityRegistery(const EntityRegistery&)                    = delete;
+        auto operator=(const EntityRegistery&) -> EntityRegistery& = delete;
 
     public:
-        template <typename T, typename... Args>
-        auto add(EntityId id, usize entityCount, Args&&... args) -> T&;
+        /// \brief Creates an entity, reusing the slot of a destroyed one when possible.
+        auto createEntity() -> Entity;
 
-        template <typename T>
-        auto at(uint64 index) -> T&;
+        /// \brief Destroys every component of `id` and releases its slot, making every copy of the handle stale.
+        auto destroyEntity(EntityId id) -> void;
 
-        template <typename T>
-        auto at(uint64 index) const -> const T&;
+        /// \brief Returns `false` for a handle that was never created or whose entity was destroyed.
+        [[nodiscard]] auto isAlive(EntityId id) const -> bool;
 
-    private:
-        usize         _stride;
-        Vector<uint8> _data;
-    };
+        [[nodiscard]] auto entityCount() const -> usize { return _aliveCount; }
 
-    class QURB_API EntityRegistery
-    {
-    public:
-        EntityRegistery() = default;
+        /// \brief Makes room for `entityCount` entity slots so that creating them does not reallocate.
+        auto reserve(usize entityCount) -> void;
 
-    public:
-        auto createEntity() -> Entity;
+        /// \brief The number of entity slots in use or free, every entity index is below it.
+        [[nodiscard]] auto slotCount() const -> usize { return _slots.size(); }
+
+        /// \brief The number of entity slots available without reallocating.
+        [[nodiscard]] auto capacity() const -> usize { return _slots.capacity(); }
+
+        [[nodiscard]] auto storageType() const -> EntityStorageType { return _storageType; }
+
+        /// \brief Returns the pool storing every `T`, creating it on first use.
+        /// \note Only available with `EntityStorageType::ComponentPools`.
+        template <typename T>
+        auto componentPool() -> ComponentPool<T>&;
 
         template <typename T, typename... Args>
         auto addComponent(EntityId id, Args&&... args) -> T&;
@@ -61,104 +78,107 @@ namespace qurb
         auto removeComponent(EntityId id) -> void;
 
         template <typename T>
-        auto hasComponent(EntityId id) -> bool;
+        [[nodiscard]] auto hasComponent(EntityId id) const -> bool;
 
         template <typename... Ts>
-        auto hasComponents(EntityId id) -> bool;
+        [[nodiscard]] auto hasComponents(EntityId id) const -> bool;
+
+        [[nodiscard]] auto signature(EntityId id) const -> const ComponentSignature&;
+
+        /// \brief Incremented every time a `T` is added to or removed from an entity, destroyed entities included, so
+        /// that systems caching per-entity state detect structural changes without scanning the components.
+        template <typename T>
+        [[nodiscard]] auto componentVersion() const -> uint64;
+
+        /// \brief A range over every entity owning all of `Ts`, yielding a `std::tuple<Ts&...>` per entity.
+        template <typename... Ts>
+        auto view() -> View<Ts...>;
+
+        /// \brief Calls `function(Ts&...)`, or `function(EntityId, Ts&...)`, for every entity owning all of `Ts`, whatever
+        /// the storage type.
+        template <typename... Ts, typename F>
+        auto each(F&& function) -> void;
+
+        /// \brief The number of bytes allocated by the signatures and the component storage.
+        [[nodiscard]] auto memoryUsage() const -> usize;
 
     private:
-        class Component
-        {
-        public:
-            template <typename T>
-            static auto id() -> usize
-            {
-                static const usize id = _counter++;
-                return id;
-            }
-
-        private:
-            static inline usize _counter = 0;
-        };
+        /// \brief The pool storing every `T`, or null if no entity ever had a `T`.
+        template <typename T>
+        auto findComponentPool() -> ComponentPool<T>*;
 
+    private:
         friend class std::formatter<EntityRegistery>;
 
     private:
-        Vector<ComponentPool>        _componentPools;  // One per component type.
-        Vector<std::vector<bool>>    _entitiesMask;    // One per entity, each vector contains a mask for component presence.
-        std::unordered_set<EntityId> _freeEntities;
+        static constexpr auto endOfFreeList = std::numeric_limits<uint32>::max();
+
+    private:
+        EntityStorageType                     _storageType;
+        Vector<std::unique_ptr<SparseSet>>    _componentPools;          // Indexed by component id, null until the component is first added.
+        std::unique_ptr<ArchetypeStorage>     _archetypeStorage;        // Only with EntityStorageType::Archetypes.
+        Vector<ComponentSignature>            _signatures;              // One per entity index, contiguous so that queries are a single masked AND.
+        Vector<EntityId>                      _slots;                   // Live slots hold their handle, free ones the next free index and next generation.
+        std::array<uint64, maxComponentTypes> _componentVersions = {};  // Indexed by component id.
+        uint32                                _freeHead          = endOfFreeList;
+        usize                                 _aliveCount        = 0;
     };
 
     //-----------------------------------------------------------------------------------------------------------------
-    // class ComponentPool
+    // class EntityRegistery
     //-----------------------------------------------------------------------------------------------------------------
 
-    template <typename T, typename... Args>
-    auto ComponentPool::add(EntityId id, usize entityCount, Args&&... args) -> T&
+    template <typename T>
+    auto EntityRegistery::componentPool() -> ComponentPool<T>&
     {
-        if (_data.size() < entityCount * _stride)
+        ensure(_storageType == EntityStorageType::ComponentPools, "Component pools are not available with archetype storage.");
+
+        const auto componentId = ComponentType::id<T>();
+
+        while (componentId >= _componentPools.size())
         {
-            _data.resize(entityCount * _stride);
+            _componentPools.emplaceBack(nullptr);
         }
 
-        // Here id should be less than entityCount.
-        new (&_data[_stride * id]) T(std::forward<Args>(args)...);
-        return at<T>(id);
-    }
-
-    template <typename T>
-    auto ComponentPool::at(uint64 index) -> T&
-    {
-        auto& component = _data[index * _stride];
-        return reinterpret_cast<T&>(component);
-    }
+        auto& pool = _componentPools[componentId];
+        if (pool == nullptr)
+        {
+            pool = std::make_unique<ComponentPool<T>>();
+        }
 
-    template <typename T>
-    auto ComponentPool::at(uint64 index) const -> const T&
-    {
-        const auto& component = _data[index * _stride];
-        return reinterpret_cast<const T&>(component);
+        return static_cast<ComponentPool<T>&>(*pool);
     }
 
-    //-----------------------------------------------------------------------------------------------------------------
-    // class EntityRegistery
-    //-----------------------------------------------------------------------------------------------------------------
-
     template <typename T, typename... Args>
     auto EntityRegistery::addComponent(EntityId id, Args&&... args) -> T&
     {
-        const auto componentId = Component::id<T>();
+        ensure(isAlive(id), "Cannot add a component to the stale entity {}.", id);
 
-        // if (hasComponent<T>(id))
-        // {
-        //     return _componentPools[componentId].template at<T>(id);
-        // }
+        _signatures[entityIndex(id)].set(ComponentType::id<T>());
+        ++_componentVersions[ComponentType::id<T>()];
 
-        if (componentId >= _componentPools.size())
+        if (_storageType == EntityStorageType::Archetypes)
         {
-            _componentPools.emplaceBack(sizeof(T));
+            return _archetypeStorage->add<T>(id, std::forward<Args>(args)...);
         }
-
-        if (componentId >= _entitiesMask[id].size())
-        {
-            _entitiesMask[id].resize(componentId + 1, false);
-        }
-
-        _entitiesMask[id][componentId] = true;
-        return _componentPools[componentId].template add<T>(id, _entitiesMask.size(), std::forward<Args>(args)...);
+        return componentPool<T>().add(id, std::forward<Args>(args)...);
     }
 
     template <typename T>
     auto EntityRegistery::getComponent(EntityId id) -> T&
     {
-        const auto componentId = Component::id<T>();
+        const auto componentId = ComponentType::id<T>();
 
         if (not hasComponent<T>(id))
         {
             throw Exception(std::format("Entity {} does not have the requested component {}.", id, typeid(T).name()));
         }
 
-        return _componentPools[componentId].template at<T>(id);
+        if (_storageType == EntityStorageType::Archetypes)
+        {
+            return _archetypeStorage->get<T>(id);
+        }
+        return static_cast<ComponentPool<T>&>(*_componentPools[componentId]).at(id);
     }
 
     template <typename... Ts>
@@ -170,39 +190,78 @@ namespace qurb
     template <typename T>
     auto EntityRegistery::removeComponent(EntityId id) -> void
     {
-        const auto componentId = Component::id<T>();
+        const auto componentId = ComponentType::id<T>();
 
         if (not hasComponent<T>(id))
         {
             return;
         }
 
-        _entitiesMask[id][componentId] = false;
+        _signatures[entityIndex(id)].reset(componentId);
+        ++_componentVersions[componentId];
+
+        if (_storageType == EntityStorageType::Archetypes)
+        {
+            _archetypeStorage->remove<T>(id);
+            return;
+        }
+        _componentPools[componentId]->remove(id);
     }
 
     template <typename T>
-    auto EntityRegistery::hasComponent(EntityId id) -> bool
+    auto EntityRegistery::hasComponent(EntityId id) const -> bool
     {
-        const auto componentId = Component::id<T>();
+        return isAlive(id) and _signatures[entityIndex(id)].test(ComponentType::id<T>());
+    }
 
-        if (componentId >= _componentPools.size())
-        {
-            return false;
-        }
+    template <typename... Ts>
+    auto EntityRegistery::hasComponents(EntityId id) const -> bool
+    {
+        const auto& required = ComponentType::signature<Ts...>();
+        return isAlive(id) and (_signatures[entityIndex(id)] & required) == required;
+    }
+
+    inline auto EntityRegistery::isAlive(EntityId id) const -> bool
+    {
+        return entityIndex(id) < _slots.size() and _slots[entityIndex(id)] == id;
+    }
 
-        auto& entityMask = _entitiesMask[id];
-        if (componentId >= entityMask.size())
+    inline auto EntityRegistery::signature(EntityId id) const -> const ComponentSignature&
+    {
+        return _signatures[entityIndex(id)];
+    }
+
+    template <typename T>
+    auto EntityRegistery::componentVersion() const -> uint64
+    {
+        return _componentVersions[ComponentType::id<T>()];
+    }
+
+    template <typename... Ts>
+    auto EntityRegistery::view() -> View<Ts...>
+    {
+        if (_storageType == EntityStorageType::Archetypes)
         {
-            entityMask.resize(componentId + 1, false);
+            return View<Ts...>(*_archetypeStorage);
         }
+        return View<Ts...>(_signatures, findComponentPool<Ts>()...);
+    }
 
-        return entityMask[componentId];
+    template <typename... Ts, typename F>
+    auto EntityRegistery::each(F&& function) -> void
+    {
+        view<Ts...>().each(std::forward<F>(function));
     }
 
-    template <typename... Ts>
-    auto EntityRegistery::hasComponents(EntityId id) -> bool
+    template <typename T>
+    auto EntityRegistery::findComponentPool() -> ComponentPool<T>*
     {
-        return (hasComponent<Ts>(id) && ...);
+        const auto componentId = ComponentType::id<T>();
+        if (componentId >= _componentPools.size())
+        {
+            return nullptr;
+        }
+        return static_cast<ComponentPool<T>*>(_componentPools[componentId].get());
     }
 }
 
@@ -215,7 +274,7 @@ struct std::formatter<qurb::EntityRegistery>
     auto format(const qurb::EntityRegistery& r, FormatContext& ctx) const
     {
         auto out = ctx.out();
-        out      = std::format_to(out, "EntityRegistery with {} component pools and {} entities", r._componentPools.size(), r._entitiesMask.size());
+        out      = std::format_to(out, "EntityRegistery with {} component pools and {} entities", r._componentPools.size(), r._aliveCount);
         return out;
     }
 };
@@ -0,0 +1,86 @@
+/// \file RenderExtractor.hpp
+
+#pragma once
+
+#include "CoreDefines.hpp"
+#include "CoreTypes.hpp"
+#include "Math/Frustum.hpp"
+#include "RHI/ShaderProgram.hpp"
+#include "Scene/RenderPacket.hpp"
+#include "Scene/Scene.hpp"
+#include "Threading/JobSystem.hpp"
+
+#include <unordered_map>
+#include <utility>
+
+namespace qurb
+{
+    /// \brief Builds the `RenderPacket` of a scene.
+    ///
+    /// Reads the first camera and every entity with a transform, a mesh and a material, drops the draws whose
+    /// `BoundsComponent` lies outside of the camera frustum, then radix sorts the draws by sort key and groups the draws
+    /// sharing a material and a mesh into batches. Extraction must run while the scene is not updated, the packet is
+    /// independent of the scene afterwards.
+    class QURB_API RenderExtractor final
+    {
+    public:
+        /// \brief Below this many bounded draws culling runs on the calling thread only.
+        static constexpr auto parallelCullingThreshold = usize(16'384);
+
+    public:
+        /// \param jobSystem Spreads the culling of large scenes over its workers, culls on the calling thread when null.
+        explicit RenderExtractor(JobSystem* jobSystem = nullptr);
+
+        RenderExtractor(const RenderExtractor&)                    = delete;
+        auto operator=(const RenderExtractor&) -> RenderExtractor& = delete;
+
+    public:
+        /// \brief Replaces the content of `packet` with the current state of `scene`.
+        auto extract(Scene& scene, RenderPacket& packet) -> void;
+
+    private:
+        /// \brief Removes the draws of `_cullDraws` whose bounds are outside of `frustum`.
+        auto cullDraws(const math::Frustum& frustum, RenderPacket& packet) -> void;
+
+        /// \brief Transforms the bounds `[begin, end)` to world space and tests them against `frustum`.
+        auto cullRange(const math::Frustum& frustum, const RenderPacket& packet, usize begin, usize end) -> void;
+
+        auto batchDraws(RenderPacket& packet) -> void;
+
+    private:
+        // Meshes may draw different ranges of a shared vertex buffer.
+        using MeshKey = std::pair<const rhi::Buffer*, uint32>;
+
+        struct MeshKeyHash
+        {
+            auto operator()(const MeshKey& key) const -> usize;
+        };
+
+        using MaterialKey = std::pair<const rhi::ShaderProgram*, const rhi::PipelineState*>;
+
+        struct MaterialKeyHash
+        {
+            auto operator()(const MaterialKey& key) const -> usize;
+        };
+
+    private:
+        JobSystem*               _jobSystem;
+        uint64                   _frameIndex = 0;
+        Vector<RenderDraw>       _sortScratch;
+        Vector<math::Matrix4x4f> _matrixScratch;
+
+        // The draws with bounds, their local bounds and, once culled, their world bounds in structure of arrays and
+        // their visibility, then whether each draw of the packet was culled.
+        Vector<uint32>         _cullDraws;
+        Vector<math::Vector3f> _localCenters;
+        Vector<math::Vector3f> _localExtents;
+        Vector<float32>        _worldBounds[6];
+        Vector<uint8>          _visibility;
+        Vector<uint8>          _culled;
+
+        // Resource to handle maps of the packet being built, kept to reuse their buckets.
+        std::unordered_map<MeshKey, uint32, MeshKeyHash>         _meshHandles;
+        std::unordered_map<const rhi::PipelineState*, uint32>    _pipelineHandles;
+        std::unordered_map<MaterialKey, uint32, MaterialKeyHash> _materialHandles;
+    };
+}
@@ -0,0 +1,136 @@
+/// \file RenderPacket.hpp
+
+#pragma once
+
+#include "Containers/Vector.hpp"
+#include "CoreDefines.hpp"
+#include "CoreTypes.hpp"
+#include "Math/Matrix4x4.hpp"
+#include "RHI/Buffer.hpp"
+#include "RHI/PipelineState.hpp"
+
+#include <algorithm>
+#include <bit>
+
+namespace qurb
+{
+    /// \brief A geometry referenced by the draws of a `RenderPacket`.
+    struct RenderMesh
+    {
+        rhi::Buffer* vertexBuffer;
+        uint32       vertexCount;
+    };
+
+    /// \brief A pipeline state referenced by the materials of a `RenderPacket`.
+    struct RenderPipeline
+    {
+        rhi::PipelineState* pipelineState;
+    };
+
+    /// \brief A material referenced by the draws of a `RenderPacket`.
+    struct RenderMaterial
+    {
+        uint32 pipeline;  // Index in `RenderPacket::pipelines`.
+    };
+
+    /// \brief One draw of a `RenderPacket`, its handles index the tables of the packet.
+    struct RenderDraw
+    {
+        uint64 sortKey;
+        uint32 mesh;       // Index in `RenderPacket::meshes`.
+        uint32 material;   // Index in `RenderPacket::materials`.
+        uint32 transform;  // Index in `RenderPacket::worldMatrices`.
+    };
+
+    /// \brief Consecutive draws sharing a material and a mesh, rendered with a single instanced draw.
+    struct RenderBatch
+    {
+        uint32 mesh;           // Index in `RenderPacket::meshes`.
+        uint32 material;       // Index in `RenderPacket::materials`.
+        uint32 firstInstance;  // Index of the world matrix of the first instance in `RenderPacket::worldMatrices`.
+        uint32 instanceCount;
+    };
+
+    /// \brief The camera a `RenderPacket` is rendered from.
+    struct RenderView
+    {
+        math::Matrix4x4f viewMatrix       = math::Matrix4x4f::identity;
+        math::Matrix4x4f projectionMatrix = math::Matrix4x4f::identity;
+        bool             valid            = false;
+    };
+
+    /// \brief Everything needed to render one frame, copied out of the scene by `SceneRenderer::extract`.
+    ///
+    /// The packet is immutable once extracted: rendering reads it only, so the scene can be updated meanwhile, and
+    /// several threads may record commands from it. Each mesh and material appears once in its table, the draws refer
+    /// to them by index. The draws are sorted by increasing sort key and the world matrices are stored in draw order, so
+    /// that the instances of a batch are contiguous. The referenced RHI objects must stay alive until the
+    /// frames using them are rendered.
+    struct QURB_API RenderPacket
+    {
+        uint64                   frameIndex = 0;
+        RenderView               view;
+        Vector<RenderMesh>       meshes;
+        Vector<RenderPipeline>   pipelines;
+        Vector<RenderMaterial>   materials;
+        Vector<math::Matrix4x4f> worldMatrices;
+        Vector<RenderDraw>       draws;
+        Vector<RenderBatch>      batches;
+        uint32                   culledDrawCount = 0;  // Draws left out because they were outside of the view frustum.
+
+    public:
+        /// \brief Empties the packet, keeping its memory for the next frame.
+        auto clear() -> void;
+
+        /// \brief A hash of the whole content, equal for two extractions of the same scene state. Used to check that
+        /// a captured frame replays identically.
+        [[nodiscard]] auto checksum() const -> uint64;
+    };
+
+    /// \brief The passes a draw can belong to, rendered in this order.
+    enum class RenderPassType : uint8
+    {
+        Opaque,
+    };
+
+    /// \brief The layout of `RenderDraw::sortKey`, from the most to the least significant bits.
+    ///
+    /// Sorting by key renders the passes in order, then groups the draws sharing a pipeline state, a material and a
+    /// mesh so that consecutive draws rebind as little as possible. The depth comes last, ordering the draws of a same
+    /// state front to back.
+    namespace sortKey
+    {
+        constexpr auto passBits     = uint32(4);
+        constexpr auto pipelineBits = uint32(12);
+        constexpr auto materialBits = uint32(16);
+        constexpr auto meshBits     = uint32(16);
+        constexpr auto depthBits    = uint32(16);
+
+        constexpr auto depthShift    = uint32(0);
+        constexpr auto meshShift     = depthShift + depthBits;
+        constexpr auto materialShift = meshShift + meshBits;
+        constexpr auto pipelineShift = materialShift + materialBits;
+        constexpr auto passShift     = pipelineShift + pipelineBits;
+
+        static_assert(passShift + passBits == 64);
+
+        constexpr auto maxPipelines = uint32(1) << pipelineBits;
+        constexpr auto maxMaterials = uint32(1) << materialBits;
+        constexpr auto maxMeshes    = uint32(1) << meshBits;
+
+        /// \brief The top bits of a non negative float, which order like the float itself. Negative depths, behind the
+        /// camera, map to zero.
+        [[nodiscard]] constexpr auto quantizeDepth(float32 depth) -> uint64
+        {
+            return std::bit_cast<uint32>(std::max(depth, 0.0f)) >> (32 - depthBits);
+        }
+    }
+
+    /// \brief The sort key of a draw, `pipeline`, `material` and `mesh` being handles of its packet.
+    [[nodiscard]] constexpr auto makeSortKey(RenderPassType pass, uint32 pipeline, uint32 material, uint32 mesh, float32 depth) -> uint64
+    {
+        return (static_cast<uint64>(pass) << sortKey::passShift) | (static_cast<uint64>(pipeline) << sortKey::pipelineShift)
+             | (static_cast<uint64>(material) << sortKey::materialShift) | (static_cast<uint64>(mesh) << sortKey::meshShift)
+             | (sortKey::quantizeDepth(depth) << sortKey::depthShift);
+    }
+}
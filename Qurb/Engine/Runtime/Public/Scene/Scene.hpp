@@ -5,6 +5,11 @@
 #include "Scene/Components.hpp"
 #include "Scene/Entity.hpp"
 #include "Scene/EntityRegistery.hpp"
+#include "Scene/SpatialIndex.hpp"
+#include "Scene/TransformSystem.hpp"
+
+#include <algorithm>
+#include <memory>
 
 namespace qurb
 {
@@ -12,7 +17,7 @@ namespace qurb
     class QURB_API Scene final
     {
     public:
-        Scene();
+        explicit Scene(EntityStorageType storageType = EntityStorageType::ComponentPools);
 
         Scene(const Scene&)                    = delete;
         auto operator=(const Scene&) -> Scene& = delete;
@@ -20,13 +25,62 @@ namespace qurb
     public:
         auto createEntity() -> Entity
         {
-            auto entity = _entityRegistery.createEntity();
+            auto       entity = _entityRegistery.createEntity();
+            const auto index  = entityIndex(entity.id());
+            if (index >= _entityPositions.size())
+            {
+                if (index >= _entityPositions.capacity())
+                {
+                    // Grown geometrically, an exact resize would copy every position for each new index.
+                    _entityPositions.reserve(std::max(usize(index) + 1, _entityPositions.capacity() * 2));
+                }
+                _entityPositions.resize(index + 1);
+            }
+            _entityPositions[index] = static_cast<uint32>(_entities.size());
             _entities.pushBack(entity);
             return entity;
         }
 
+        /// \brief Destroys `entity`, its slot is recycled by the next `createEntity`. Entities of the scene must be
+        /// destroyed here rather than through the registery, which would leave them in `entities`.
+        auto destroyEntity(Entity entity) -> void
+        {
+            // Entities created through a command buffer are not listed, their position is stale or out of range.
+            const auto index = entityIndex(entity.id());
+            if (index < _entityPositions.size())
+            {
+                const auto position = _entityPositions[index];
+                if (position < _entities.size() and _entities[position].id() == entity.id())
+                {
+                    // `Entity` holds a reference and is not assignable, relocate the last one by construction.
+                    if (position + 1 != _entities.size())
+                    {
+                        std::destroy_at(&_entities[position]);
+                        std::construct_at(&_entities[position], _entities.back());
+                        _entityPositions[entityIndex(_entities[position].id())] = position;
+                    }
+                    _entities.popBack();
+                }
+            }
+            _entityRegistery.destroyEntity(entity.id());
+        }
+
+        /// \brief Attaches `child` to `parent` in the transform hierarchy.
+        auto setParent(Entity child, Entity parent) -> void { _transformSystem.setParent(_entityRegistery, child.id(), parent.id()); }
+
+        /// \brief Detaches `child` from its parent, making it a root of the transform hierarchy.
+        auto clearParent(Entity child) -> void { _transformSystem.setParent(_entityRegistery, child.id(), invalidEntityId); }
+
         auto registery() -> EntityRegistery& { return _entityRegistery; }
 
+        auto transformSystem() -> TransformSystem& { return _transformSystem; }
+
+        /// \brief The world bounds of the entities with a `BoundsComponent`, current after `updateSpatialIndex`.
+        auto spatialIndex() -> SpatialIndex& { return _spatialIndex; }
+
+        /// \brief Refits the spatial index to the world matrices of the last `TransformSystem::update`.
+        auto updateSpatialIndex() -> void { _spatialIndex.update(_entityRegistery, _transformSystem); }
+
         auto entities() -> Vector<Entity>& { return _entities; }
 
     private:
@@ -34,11 +88,17 @@ namespace qurb
 
     private:
         EntityRegistery _entityRegistery;
+        TransformSystem _transformSystem;
+        SpatialIndex    _spatialIndex;
         Vector<Entity>  _entities;
+        Vector<uint32>  _entityPositions;  // Of each entity in `_entities`, indexed by entity index.
     };
 
-    inline Scene::Scene()
-        : _entityRegistery()
+    inline Scene::Scene(EntityStorageType storageType)
+        : _entityRegistery(storageType)
+        , _transformSystem()
+        , _spatialIndex()
         , _entities()
+        , _entityPositions()
     {}
 }
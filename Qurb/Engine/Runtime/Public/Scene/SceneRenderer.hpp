@@ -1,49 +1,102 @@
 #pragma once
 
+#include "Containers/Vector.hpp"
 #include "CoreDefines.hpp"
 #include "Math/Matrix4x4.hpp"
 #include "RHI/Buffer.hpp"
+#include "RHI/CommandList.hpp"
 #include "RHI/Device.hpp"
+#include "RHI/FrameAllocator.hpp"
 #include "RHI/RenderContext.hpp"
+#include "Scene/RenderExtractor.hpp"
+#include "Scene/RenderPacket.hpp"
 #include "Scene/Scene.hpp"
 
 namespace qurb
 {
+    /// \brief The commands submitted by the last `SceneRenderer::render`.
+    struct QURB_API RenderStatistics
+    {
+        uint32 drawsIssued       = 0;  // Instanced draw calls.
+        uint32 instancesDrawn    = 0;
+        uint32 pipelineBinds     = 0;
+        uint32 vertexBufferBinds = 0;
+        uint32 bindsAvoided      = 0;  // Binds skipped because the same object was already bound.
+        uint32 drawsCulled       = 0;  // Draws outside of the view frustum, left out at extraction.
+    };
+
+    /// \brief Renders the packets extracted from a scene.
+    ///
+    /// Every batch of the packet is one instanced draw. The vertex shaders find the vertices in buffer
+    /// `vertexBufferSlot`, the world matrices of the frame in buffer `instanceBufferSlot`, indexed by instance, and the
+    /// view and projection matrices in buffer `sceneConstantsSlot`. The matrices are written in place in the frame's
+    /// region of a `FrameAllocator`.
+    ///
+    /// The batches are recorded into command lists of `batchesPerCommandList` batches, in parallel when a job system is
+    /// given, and submitted in order.
     class QURB_API SceneRenderer
     {
     public:
-        SceneRenderer(Scene& scene, rhi::Device* device);
+        static constexpr auto vertexBufferSlot   = uint32(0);
+        static constexpr auto instanceBufferSlot = uint32(1);
+        static constexpr auto sceneConstantsSlot = uint32(2);
+
+        /// \brief The regions of the frame allocator rotate over the frames the GPU may still be reading, like the frame
+        /// boundary semaphore of the render contexts.
+        static constexpr auto framesInFlight = uint32(3);
+
+        /// \brief The batches recorded by one job.
+        static constexpr auto batchesPerCommandList = usize(1'024);
+
+    public:
+        /// \param jobSystem Spreads the frustum culling and the command recording of large scenes over its workers, may
+        /// be null.
+        SceneRenderer(Scene& scene, rhi::Device* device, JobSystem* jobSystem = nullptr);
         ~SceneRenderer();
 
     public:
-        /// \brief Renders the scene.
+        /// \brief Copies what the render needs out of the scene into `packet`.
+        auto extract(RenderPacket& packet) -> void;
+
+        /// \brief Renders a packet, without reading the scene. May run on another thread than `extract`.
         /// \param renderContext The render context.
-        auto render(rhi::RenderContext* renderContext) -> void;
+        /// \param packet A packet filled by `extract`.
+        auto render(rhi::RenderContext* renderContext, const RenderPacket& packet) -> void;
+
+        /// \brief The statistics of the last `render`, to read on the thread rendering.
+        [[nodiscard]] auto statistics() const -> const RenderStatistics& { return _statistics; }
+
+    private:
+        /// \brief Records the batches `[begin, end)` of `packet` into `commandList`, which starts with nothing bound.
+        static auto recordBatches(rhi::CommandList& commandList, RenderStatistics& statistics, const RenderPacket& packet, usize begin, usize end)
+            -> void;
 
     private:
-        Scene&       _scene;
-        rhi::Device* _device;
-        rhi::Buffer* _sceneConstantsBuffer;
+        Scene&                   _scene;
+        rhi::Device*             _device;
+        JobSystem*               _jobSystem;
+        rhi::FrameAllocator      _frameAllocator;
+        RenderExtractor          _extractor;
+        Vector<rhi::CommandList> _commandLists;        // Kept across frames, with their arenas.
+        Vector<RenderStatistics> _commandListStatistics;
+        RenderStatistics         _statistics;
     };
 
-    inline SceneRenderer::SceneRenderer(Scene& scene, rhi::Device* device)
+    inline SceneRenderer::SceneRenderer(Scene& scene, rhi::Device* device, JobSystem* jobSystem)
         : _scene(scene)
         , _device(device)
-        , _sceneConstantsBuffer(nullptr)
+        , _jobSystem(jobSystem)
+        , _frameAllocator(device, framesInFlight, 64 * 1024)
+        , _extractor(jobSystem)
+        , _commandLists()
+        , _commandListStatistics()
+        , _statistics()
     {
         _device->retain();
-        _sceneConstantsBuffer = _device->createBuffer(
-            rhi::BufferDescriptor {
-                .bufferSize  = 2 * sizeof(math::Matrix4x4f),
-                .bufferType  = rhi::BufferType::Vertex,
-                .bufferUsage = rhi::BufferUsage::Dynamic,
-                .initialData = nullptr,
-            });
     }
 
     inline SceneRenderer::~SceneRenderer()
     {
         _device->release();
-        _sceneConstantsBuffer->release();
     }
 }
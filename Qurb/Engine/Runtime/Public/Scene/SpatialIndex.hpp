@@ -0,0 +1,308 @@
+/// \file SpatialIndex.hpp
+
+#pragma once
+
+#include "Containers/Vector.hpp"
+#include "CoreDefines.hpp"
+#include "CoreTypes.hpp"
+#include "Debug/Ensure.hpp"
+#include "Math/Aabb.hpp"
+#include "Math/Frustum.hpp"
+#include "Scene/EntityId.hpp"
+#include "Scene/EntityRegistery.hpp"
+#include "Scene/TransformSystem.hpp"
+
+#include <array>
+#include <limits>
+
+namespace qurb
+{
+    /// \brief The closest entity hit by a ray.
+    struct RayHit
+    {
+        EntityId entity   = invalidEntityId;
+        float32  distance = 0.0f;  // Along the ray, in units of its direction.
+
+    public:
+        [[nodiscard]] auto hit() const -> bool { return entity != invalidEntityId; }
+    };
+
+    /// \brief A dynamic bounding volume hierarchy over the world bounds of entities, answering box, sphere, frustum and
+    /// ray queries.
+    ///
+    /// Leaves store the world box of an entity enlarged by a margin, so that a small motion stays within the leaf and
+    /// does not touch the tree. A leaf that moves out of its box is removed and reinserted where it grows the surface area
+    /// of the tree the least, and tree rotations keep it balanced. `rebuild` builds the whole tree again top-down with the
+    /// surface area heuristic, `update` does so when most leaves are new, like on the first update of a scene.
+    ///
+    /// Either feed the index by hand with `insert`, `move` and `remove`, or let `update` track a scene, `update` removes
+    /// the leaves it did not create. Queries do not modify the index and can run from several threads at once.
+    class QURB_API SpatialIndex final
+    {
+    public:
+        using ProxyId = uint32;
+
+        static constexpr auto invalidProxy = std::numeric_limits<ProxyId>::max();
+
+        /// \brief How much leaves are enlarged on each side, in world units.
+        static constexpr auto defaultMargin = 0.1f;
+
+    public:
+        explicit SpatialIndex(float32 margin = defaultMargin);
+
+        SpatialIndex(const SpatialIndex&)                    = delete;
+        auto operator=(const SpatialIndex&) -> SpatialIndex& = delete;
+
+    public:
+        /// \brief Adds a leaf holding `entity` with the world box `bounds`.
+        auto insert(EntityId entity, const math::Aabb& bounds) -> ProxyId;
+
+        auto remove(ProxyId proxy) -> void;
+
+        /// \brief Updates the world box of `proxy`.
+        /// \return Whether the leaf had to be reinserted, false when `bounds` still fits in its enlarged box.
+        auto move(ProxyId proxy, const math::Aabb& bounds) -> bool;
+
+        auto clear() -> void;
+
+        /// \brief Rebuilds the tree over the current leaves with a binned surface area heuristic.
+        auto rebuild() -> void;
+
+        /// \brief Tracks the entities with a `TransformComponent` and a `BoundsComponent`, inserting the new ones,
+        /// refitting those whose world matrix `transformSystem` recomputed and removing the others.
+        ///
+        /// Runs after `TransformSystem::update`. A changed `BoundsComponent` is only picked up when its transform changes.
+        auto update(EntityRegistery& registery, const TransformSystem& transformSystem) -> void;
+
+        /// \brief Calls `function(EntityId)` for every entity whose enlarged box overlaps `box`.
+        template <typename F>
+        auto queryBox(const math::Aabb& box, F&& function) const -> void;
+
+        /// \brief Calls `function(EntityId)` for every entity whose enlarged box overlaps the sphere.
+        template <typename F>
+        auto querySphere(const math::Vector3f& center, float32 radius, F&& function) const -> void;
+
+        /// \brief Calls `function(EntityId)` for every entity whose enlarged box is not outside of `frustum`, the
+        /// subtrees entirely inside are reported without further tests.
+        template <typename F>
+        auto queryFrustum(const math::Frustum& frustum, F&& function) const -> void;
+
+        /// \brief Calls `function(EntityId, float32 distance)` for every entity whose enlarged box the ray enters before
+        /// `maxDistance`, in no particular order.
+        template <typename F>
+        auto queryRay(const math::Ray& ray, float32 maxDistance, F&& function) const -> void;
+
+        /// \brief The entity whose enlarged box the ray enters first, visiting the closest subtrees first.
+        [[nodiscard]] auto raycast(const math::Ray& ray, float32 maxDistance = std::numeric_limits<float32>::max()) const -> RayHit;
+
+        [[nodiscard]] auto entity(ProxyId proxy) const -> EntityId { return _nodes[proxy].entity; }
+
+        /// \brief The enlarged box of `proxy`.
+        [[nodiscard]] auto bounds(ProxyId proxy) const -> const math::Aabb& { return _nodes[proxy].bounds; }
+
+        [[nodiscard]] auto proxyCount() const -> usize { return _proxyCount; }
+
+        /// \brief The number of edges from the root to the deepest leaf.
+        [[nodiscard]] auto height() const -> uint32 { return _root == invalidNode ? 0 : static_cast<uint32>(_nodes[_root].height); }
+
+        /// \brief The surface area of the internal nodes over the one of the root, lower is better.
+        [[nodiscard]] auto areaRatio() const -> float32;
+
+        /// \brief The number of leaves reinserted by the last `update`.
+        [[nodiscard]] auto reinsertedCount() const -> usize { return _reinsertedCount; }
+
+    private:
+        struct Node
+        {
+            math::Aabb            bounds;
+            EntityId              entity;    // Leaves only.
+            uint32                parent;    // The next free node once the node is free.
+            std::array<uint32, 2> children;  // invalidNode for leaves.
+            int32                 height;    // Zero for leaves, freeHeight once the node is free.
+            uint32                stamp;     // The last update that saw the entity of a leaf.
+
+        public:
+            [[nodiscard]] auto leaf() const -> bool { return children[0] == invalidNode; }
+        };
+
+        /// \brief A leaf and the centroid of its box, sorted in place by `build`.
+        struct BuildLeaf
+        {
+            uint32         node;
+            math::Vector3f centroid;
+        };
+
+    private:
+        auto allocateNode() -> uint32;
+        auto freeNode(uint32 node) -> void;
+
+        auto insertLeaf(uint32 leaf) -> void;
+        auto removeLeaf(uint32 leaf) -> void;
+
+        /// \brief Refits the boxes and heights from `node` up to the root, rotating unbalanced nodes on the way.
+        auto refitAncestors(uint32 node) -> void;
+
+        /// \brief Rotates the node up when its children heights differ by more than one, returns the root of the subtree.
+        auto balance(uint32 node) -> uint32;
+
+        /// \brief Builds the subtree over `_buildLeaves[begin, end)` and returns its root.
+        auto build(usize begin, usize end, uint32 depth) -> uint32;
+
+        /// \brief Depth first traversal, calls `visit(node)` on every node reached and descends into the internal nodes
+        /// for which it returns true.
+        template <typename V>
+        auto traverse(V&& visit) const -> void;
+
+    private:
+        static constexpr auto invalidNode = std::numeric_limits<uint32>::max();
+        static constexpr auto freeHeight  = -1;
+
+        /// \brief The traversal stack holds at most one pending sibling per level.
+        static constexpr auto maxDepth = usize(256);
+
+        /// \brief Number of candidate split planes per axis of the surface area heuristic.
+        static constexpr auto binCount = usize(16);
+
+        /// \brief Below this many leaves, or past this depth, a subtree is split at the median centroid, which bounds
+        /// the height of badly clustered scenes.
+        static constexpr auto medianSplitThreshold = usize(4);
+        static constexpr auto medianSplitDepth     = uint32(64);
+
+    private:
+        Vector<Node>      _nodes;
+        Vector<uint32>    _entityProxies;  // Indexed by entity index, the leaf of the last entity seen in the slot.
+        Vector<uint32>    _pendingLeaves;  // Leaves created by `update` and not yet in the tree.
+        Vector<BuildLeaf> _buildLeaves;
+        uint32            _root            = invalidNode;
+        uint32            _freeHead        = invalidNode;
+        uint32            _stamp           = 0;
+        usize             _proxyCount      = 0;
+        usize             _reinsertedCount = 0;
+        float32           _margin;
+    };
+
+    //------------------------------------------------------------------------------------------------------------------
+    // class SpatialIndex
+    //------------------------------------------------------------------------------------------------------------------
+
+    template <typename V>
+    auto SpatialIndex::traverse(V&& visit) const -> void
+    {
+        if (_root == invalidNode)
+        {
+            return;
+        }
+
+        auto  stack = std::array<uint32, maxDepth>();
+        usize size  = 0;
+
+        stack[size++] = _root;
+        while (size > 0)
+        {
+            const auto  index = stack[--size];
+            const auto& node  = _nodes[index];
+            if (visit(index) and not node.leaf())
+            {
+                ensure(size + 2 <= maxDepth, "Spatial index deeper than {} levels.", maxDepth);
+                stack[size++] = node.children[1];
+                stack[size++] = node.children[0];
+            }
+        }
+    }
+
+    template <typename F>
+    auto SpatialIndex::queryBox(const math::Aabb& box, F&& function) const -> void
+    {
+        traverse([&](uint32 index) {
+            const auto& node = _nodes[index];
+            if (not node.bounds.overlaps(box))
+            {
+                return false;
+            }
+            if (node.leaf())
+            {
+                function(node.entity);
+            }
+            return true;
+        });
+    }
+
+    template <typename F>
+    auto SpatialIndex::querySphere(const math::Vector3f& center, float32 radius, F&& function) const -> void
+    {
+        traverse([&](uint32 index) {
+            const auto& node = _nodes[index];
+            if (not math::overlapsSphere(node.bounds, center, radius))
+            {
+                return false;
+            }
+            if (node.leaf())
+            {
+                function(node.entity);
+            }
+            return true;
+        });
+    }
+
+    template <typename F>
+    auto SpatialIndex::queryFrustum(const math::Frustum& frustum, F&& function) const -> void
+    {
+        // A subtree inside the frustum is walked once more without plane tests.
+        auto reportAll = [&](uint32 subtree) {
+            auto  stack = std::array<uint32, maxDepth>();
+            usize size  = 0;
+
+            stack[size++] = subtree;
+            while (size > 0)
+            {
+                const auto& node = _nodes[stack[--size]];
+                if (node.leaf())
+                {
+                    function(node.entity);
+                    continue;
+                }
+                stack[size++] = node.children[1];
+                stack[size++] = node.children[0];
+            }
+        };
+
+        traverse([&](uint32 index) {
+            const auto& node        = _nodes[index];
+            const auto  containment = math::classify(frustum, node.bounds);
+            if (containment == math::Containment::Outside)
+            {
+                return false;
+            }
+            if (node.leaf())
+            {
+                function(node.entity);
+                return false;
+            }
+            if (containment == math::Containment::Inside)
+            {
+                reportAll(index);
+                return false;
+            }
+            return true;
+        });
+    }
+
+    template <typename F>
+    auto SpatialIndex::queryRay(const math::Ray& ray, float32 maxDistance, F&& function) const -> void
+    {
+        const auto inverseDirection = math::Vector3f(1.0f / ray.direction.x, 1.0f / ray.direction.y, 1.0f / ray.direction.z);
+        traverse([&](uint32 index) {
+            const auto& node     = _nodes[index];
+            auto        distance = 0.0f;
+            if (not math::intersectRay(node.bounds, ray.origin, inverseDirection, maxDistance, distance))
+            {
+                return false;
+            }
+            if (node.leaf())
+            {
+                function(node.entity, distance);
+            }
+            return true;
+        });
+    }
+}
@@ -0,0 +1,168 @@
+/// \file SystemScheduler.hpp
+
+#pragma once
+
+#include "Containers/Vector.hpp"
+#include "CoreDefines.hpp"
+#include "CoreTypes.hpp"
+#include "Scene/ComponentType.hpp"
+#include "Scene/EntityCommandBuffer.hpp"
+#include "Scene/EntityRegistery.hpp"
+#include "Threading/JobSystem.hpp"
+
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace qurb
+{
+    /// \brief The components a system reads and writes.
+    ///
+    /// Two systems conflict when one of them writes a component the other reads or writes, conflicting systems run in
+    /// the order they were added and the others may run concurrently.
+    struct SystemAccess
+    {
+        ComponentSignature reads;
+        ComponentSignature writes;
+
+    public:
+        template <typename... Ts>
+        auto read() -> SystemAccess&;
+
+        template <typename... Ts>
+        auto write() -> SystemAccess&;
+
+        [[nodiscard]] auto conflictsWith(const SystemAccess& other) const -> bool;
+    };
+
+    /// \brief The state handed to a system while it runs.
+    class SystemContext final
+    {
+    public:
+        SystemContext(EntityRegistery& registery, EntityCommandBuffer& commands, JobSystem& jobSystem, float32 deltaTime);
+
+    public:
+        [[nodiscard]] auto registery() const -> EntityRegistery& { return _registery; }
+        [[nodiscard]] auto jobSystem() const -> JobSystem& { return _jobSystem; }
+
+        /// \brief Structural changes recorded here are applied once every system of the frame is done.
+        [[nodiscard]] auto commands() const -> EntityCommandBuffer& { return _commands; }
+
+        [[nodiscard]] auto deltaTime() const -> float32 { return _deltaTime; }
+
+        /// \brief Calls `function(Ts&...)` for every entity owning all of `Ts`, split in ranges of `grainSize` entities
+        /// processed concurrently. `function` must only touch the components it is given.
+        template <typename... Ts, typename F>
+        auto parallelEach(F&& function, usize grainSize = 4096) const -> void;
+
+    private:
+        EntityRegistery&     _registery;
+        EntityCommandBuffer& _commands;
+        JobSystem&           _jobSystem;
+        float32              _deltaTime;
+    };
+
+    /// \brief The time spent in one system during the last `SystemScheduler::run`.
+    struct SystemTiming
+    {
+        std::string name;
+        float64     milliseconds;
+    };
+
+    /// \brief Runs a set of systems every frame, concurrently when their component accesses do not conflict.
+    ///
+    /// Each system depends on every system added before it that it conflicts with. The graph is rebuilt only when a
+    /// system is added, then every frame a system is submitted to the job system as soon as its dependencies are done.
+    class QURB_API SystemScheduler final
+    {
+    public:
+        using SystemFunction = std::function<void(const SystemContext& context)>;
+
+    public:
+        explicit SystemScheduler(JobSystem& jobSystem);
+
+        SystemScheduler(const SystemScheduler&)                    = delete;
+        auto operator=(const SystemScheduler&) -> SystemScheduler& = delete;
+
+    public:
+        auto addSystem(std::string name, const SystemAccess& access, SystemFunction function) -> void;
+
+        /// \brief Runs every system once and returns when all of them are done, after playing back their commands.
+        auto run(EntityRegistery& registery, float32 deltaTime) -> void;
+
+        [[nodiscard]] auto systemCount() const -> usize { return _systems.size(); }
+
+        [[nodiscard]] auto timings() const -> const Vector<SystemTiming>& { return _timings; }
+
+        /// \brief The wall time of the last `run`.
+        [[nodiscard]] auto frameMilliseconds() const -> float64 { return _frameMilliseconds; }
+
+        /// \brief Logs the timings of the last `run`, with the parallelism achieved over a serial execution.
+        auto logTimings() const -> void;
+
+    private:
+        struct System
+        {
+            SystemFunction function;
+            SystemAccess   access;
+            Vector<uint32> successors;
+            uint32         dependencyCount;
+        };
+
+    private:
+        auto buildGraph() -> void;
+        auto schedule(uint32 system, const SystemContext& context, JobCounter& counter) -> void;
+
+    private:
+        JobSystem&                    _jobSystem;
+        EntityCommandBuffer           _commands;
+        Vector<System>                _systems;
+        Vector<SystemTiming>          _timings;  // Parallel to _systems.
+        std::unique_ptr<JobCounter[]> _pendingDependencies;
+        float64                       _frameMilliseconds = 0.0;
+        bool                          _graphDirty        = false;
+    };
+
+    //------------------------------------------------------------------------------------------------------------------
+    // struct SystemAccess
+    //------------------------------------------------------------------------------------------------------------------
+
+    template <typename... Ts>
+    auto SystemAccess::read() -> SystemAccess&
+    {
+        reads |= ComponentType::signature<Ts...>();
+        return *this;
+    }
+
+    template <typename... Ts>
+    auto SystemAccess::write() -> SystemAccess&
+    {
+        writes |= ComponentType::signature<Ts...>();
+        return *this;
+    }
+
+    inline auto SystemAccess::conflictsWith(const SystemAccess& other) const -> bool
+    {
+        return (writes & (other.reads | other.writes)).any() or (other.writes & reads).any();
+    }
+
+    //------------------------------------------------------------------------------------------------------------------
+    // class SystemContext
+    //------------------------------------------------------------------------------------------------------------------
+
+    inline SystemContext::SystemContext(EntityRegistery& registery, EntityCommandBuffer& commands, JobSystem& jobSystem, float32 deltaTime)
+        : _registery(registery)
+        , _commands(commands)
+        , _jobSystem(jobSystem)
+        , _deltaTime(deltaTime)
+    {}
+
+    template <typename... Ts, typename F>
+    auto SystemContext::parallelEach(F&& function, usize grainSize) const -> void
+    {
+        const auto view = _registery.view<Ts...>();
+        _jobSystem.parallelFor(view.walkSize(), grainSize, [&view, &function](usize begin, usize end) {
+            view.each(begin, end, function);
+        });
+    }
+}
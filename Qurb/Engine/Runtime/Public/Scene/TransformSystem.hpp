@@ -0,0 +1,118 @@
+/// \file TransformSystem.hpp
+
+#pragma once
+
+#include "Containers/Vector.hpp"
+#include "CoreDefines.hpp"
+#include "CoreTypes.hpp"
+#include "Debug/Ensure.hpp"
+#include "Math/Matrix4x4.hpp"
+#include "Scene/Components.hpp"
+#include "Scene/EntityId.hpp"
+#include "Scene/EntityRegistery.hpp"
+
+namespace qurb
+{
+    /// \brief Maintains the world matrix of every `TransformComponent`, following the `ParentComponent` hierarchy.
+    ///
+    /// Transforms are kept in topological order, parents before their children, and their world matrices in a
+    /// contiguous array in the same order. The transforms report their changes to the system, `update` only visits the
+    /// changed transforms and their descendants: a static scene costs nothing per frame. The order is rebuilt, visiting
+    /// every transform, when the hierarchy changes or transforms are added or removed, which the registery reports
+    /// through its component versions.
+    class QURB_API TransformSystem final
+    {
+    public:
+        TransformSystem() = default;
+
+        TransformSystem(const TransformSystem&)                    = delete;
+        auto operator=(const TransformSystem&) -> TransformSystem& = delete;
+
+    public:
+        /// \brief Attaches `child` to `parent`, or detaches it when `parent` is `invalidEntityId`, keeping the parent and
+        /// children components of both sides in sync.
+        auto setParent(EntityRegistery& registery, EntityId child, EntityId parent) -> void;
+
+        /// \brief Recomputes the world matrices of the dirty transforms and of their descendants.
+        auto update(EntityRegistery& registery) -> void;
+
+        /// \brief Every world matrix, indexed by `TransformComponent::worldIndex`.
+        [[nodiscard]] auto worldMatrices() const -> const Vector<math::Matrix4x4f>& { return _worldMatrices; }
+
+        /// \brief The world matrix of a transform placed by an `update`, added transforms have none until the next one.
+        [[nodiscard]] auto worldMatrix(const TransformComponent& transformComponent) const -> const math::Matrix4x4f&;
+
+        /// \brief The number of world matrices recomputed by the last `update`.
+        [[nodiscard]] auto updatedCount() const -> usize { return _updatedNodes.size(); }
+
+        /// \brief Whether the last `update` recomputed the world matrix of `transformComponent`.
+        [[nodiscard]] auto updated(const TransformComponent& transformComponent) const -> bool;
+
+    private:
+        struct Node
+        {
+            EntityId entity;
+            uint32   parent;      // Index of the parent node, or invalidNode for a root.
+            uint32   firstChild;  // The children of a node are contiguous, appended together by `rebuild`.
+            uint32   childCount;
+        };
+
+    private:
+        /// \brief Rebuilds the topological order, prunes the destroyed children of the hierarchy and recomputes every
+        /// world matrix.
+        auto rebuild(EntityRegistery& registery) -> void;
+
+        /// \brief The nodes reported changed since the last update, gathered from the transforms themselves when the
+        /// change list overflowed.
+        auto collectChangedNodes(EntityRegistery& registery) -> void;
+
+        /// \brief Recomputes the world matrices of `root` and of its descendants.
+        auto updateSubtree(EntityRegistery& registery, uint32 root) -> void;
+
+        /// \brief Recomputes the world matrices of the nodes set in `_dirtyNodes` and of their descendants, in a single
+        /// pass over every node.
+        auto updateDirtyNodes(EntityRegistery& registery) -> void;
+
+        /// \brief Gathers the transforms whose local matrix is stale in `_staleLocals`, visiting every transform.
+        auto collectStaleLocals(EntityRegistery& registery) -> void;
+
+        /// \brief Rebuilds the local matrices of `_staleLocals` with the batched kernels.
+        auto composeLocalMatrices() -> void;
+
+    private:
+        static constexpr auto invalidNode = TransformComponent::invalidWorldIndex;
+
+    private:
+        Vector<Node>                _nodes;          // Parents before children.
+        Vector<math::Matrix4x4f>    _worldMatrices;  // Parallel to _nodes.
+        Vector<uint8>               _dirtyNodes;     // Parallel to _nodes, set until the next update once recomputed.
+        Vector<uint32>              _updatedNodes;   // The nodes set in _dirtyNodes.
+        Vector<uint32>              _changedNodes;   // Reported changed, then sorted parents first.
+        Vector<uint32>              _subtreeStack;   // The nodes left to recompute by `updateSubtree`.
+        TransformChangeList         _changes;        // Pushed to by the transforms indexed by `rebuild`.
+        Vector<TransformComponent*> _staleLocals;    // Transforms whose local matrix must be rebuilt.
+        Vector<float32>             _localStreams;   // Their position, rotation and scale, one array per component.
+        Vector<math::Matrix4x4f>    _localMatrices;  // Parallel to _staleLocals.
+
+        // The component versions of the registery when the order was last rebuilt.
+        uint64 _transformVersion = 0;
+        uint64 _parentVersion    = 0;
+        bool   _hierarchyChanged = true;
+    };
+
+    //------------------------------------------------------------------------------------------------------------------
+    // class TransformSystem
+    //------------------------------------------------------------------------------------------------------------------
+
+    inline auto TransformSystem::worldMatrix(const TransformComponent& transformComponent) const -> const math::Matrix4x4f&
+    {
+        ensure(transformComponent.worldIndex() < _worldMatrices.size(), "The transform has not been placed by an update yet.");
+        return _worldMatrices[transformComponent.worldIndex()];
+    }
+
+    inline auto TransformSystem::updated(const TransformComponent& transformComponent) const -> bool
+    {
+        const auto index = transformComponent.worldIndex();
+        return index < _dirtyNodes.size() and _dirtyNodes[index] != 0;
+    }
+}
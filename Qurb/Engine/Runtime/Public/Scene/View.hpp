@@ -0,0 +1,397 @@
+/// \file View.hpp
+
+#pragma once
+
+#include "Containers/Vector.hpp"
+#include "CoreTypes.hpp"
+#include "Scene/ArchetypeStorage.hpp"
+#include "Scene/ComponentPool.hpp"
+#include "Scene/ComponentType.hpp"
+#include "Scene/EntityId.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+
+namespace qurb
+{
+    /// \brief A range over every entity owning all of `Ts`, yielding a `std::tuple<Ts&...>` per entity.
+    ///
+    /// Component ids and storage are resolved once when the view is created. With component pools the iteration is
+    /// driven by the smallest pool and other entities are rejected with a single signature test. With archetypes the
+    /// view walks the columns of the matching chunks directly. A view is invalidated by adding or removing components.
+    /// Entities owning any of a set of other components can be left out with `exclude`.
+    template <typename... Ts>
+    class View final
+    {
+    public:
+        class Iterator final
+        {
+        public:
+            using value_type        = std::tuple<Ts&...>;
+            using difference_type   = std::ptrdiff_t;
+            using iterator_category = std::forward_iterator_tag;
+
+        public:
+            Iterator() = default;
+
+        public:
+            auto operator*() const -> value_type;
+            auto operator++() -> Iterator&;
+            auto operator++(int) -> Iterator;
+            auto operator==(const Iterator& other) const -> bool;
+
+        private:
+            friend class View;
+
+        private:
+            Iterator(const View* view, uint32 archetype, uint32 chunk, uint32 row);
+
+            /// \brief Advances to the first position at or after the current one that matches the view.
+            auto settle() -> void;
+
+        private:
+            const View*        _view      = nullptr;
+            uint32             _archetype = 0;
+            uint32             _chunk     = 0;
+            uint32             _row       = 0;  // Dense index of the driving pool, or row in the current chunk.
+            uint32             _rows      = 0;
+            std::tuple<Ts*...> _columns   = {};
+        };
+
+    public:
+        /// \brief Creates a view over component pools, any null pool makes the view empty.
+        View(const Vector<ComponentSignature>& signatures, ComponentPool<Ts>*... pools);
+
+        /// \brief Creates a view over the archetypes of `storage` owning all of `Ts`.
+        explicit View(const ArchetypeStorage& storage);
+
+    public:
+        auto begin() const -> Iterator;
+        auto end() const -> Iterator;
+
+        /// \brief Calls `function(Ts&...)`, or `function(EntityId, Ts&...)`, for every entity of the view, without going
+        /// through the iterator.
+        template <typename F>
+        auto each(F&& function) const -> void;
+
+        /// \brief The number of positions walked by the view: the size of the driving pool, or the rows of the matching
+        /// archetypes. An upper bound of the number of entities with component pools.
+        [[nodiscard]] auto walkSize() const -> usize;
+
+        /// \brief A copy of the view leaving out the entities owning any of `Us`. Excluded archetypes are dropped
+        /// whole, excluded pool entities are rejected by the signature test before any component is fetched.
+        template <typename... Us>
+        [[nodiscard]] auto exclude() const -> View;
+
+        /// \brief Calls `function(Ts&...)`, or `function(EntityId, Ts&...)`, for the entities at walk positions
+        /// `[begin, end)`, so that disjoint ranges can be processed concurrently.
+        template <typename F>
+        auto each(usize begin, usize end, F&& function) const -> void;
+
+    private:
+        template <typename F>
+        static auto invoke(F& function, EntityId id, Ts&... components) -> void;
+
+        auto poolEntityCount() const -> uint32;
+        auto matches(EntityId id) const -> bool;
+
+        template <typename T>
+        auto poolComponent(uint32 index, EntityId id) const -> T&;
+
+    private:
+        const Vector<ComponentSignature>* _signatures = nullptr;
+        const SparseSet*                  _driver     = nullptr;
+        std::tuple<ComponentPool<Ts>*...> _pools      = {};
+        Vector<Archetype*>                _archetypes;
+        ComponentSignature                _excluded;
+        bool                              _archetypeStorage = false;
+    };
+
+    //------------------------------------------------------------------------------------------------------------------
+    // class View
+    //------------------------------------------------------------------------------------------------------------------
+
+    template <typename... Ts>
+    View<Ts...>::View(const Vector<ComponentSignature>& signatures, ComponentPool<Ts>*... pools)
+        : _signatures(&signatures)
+        , _pools(pools...)
+    {
+        if (((pools == nullptr) or ...))
+        {
+            return;
+        }
+
+        ((_driver = (_driver == nullptr or pools->size() < _driver->size()) ? pools : _driver), ...);
+    }
+
+    template <typename... Ts>
+    View<Ts...>::View(const ArchetypeStorage& storage)
+        : _archetypeStorage(true)
+    {
+        const auto& required = ComponentType::signature<Ts...>();
+        for (const auto& archetype : storage.archetypes())
+        {
+            if (not archetype->empty() and (archetype->signature() & required) == required)
+            {
+                _archetypes.pushBack(archetype.get());
+            }
+        }
+    }
+
+    template <typename... Ts>
+    auto View<Ts...>::begin() const -> Iterator
+    {
+        auto iterator = Iterator(this, 0, 0, 0);
+        iterator.settle();
+        return iterator;
+    }
+
+    template <typename... Ts>
+    auto View<Ts...>::end() const -> Iterator
+    {
+        if (_archetypeStorage)
+        {
+            return Iterator(this, static_cast<uint32>(_archetypes.size()), 0, 0);
+        }
+        return Iterator(this, 0, 0, poolEntityCount());
+    }
+
+    template <typename... Ts>
+    template <typename F>
+    auto View<Ts...>::each(F&& function) const -> void
+    {
+        each(0, walkSize(), std::forward<F>(function));
+    }
+
+    template <typename... Ts>
+    auto View<Ts...>::walkSize() const -> usize
+    {
+        if (not _archetypeStorage)
+        {
+            return poolEntityCount();
+        }
+
+        usize rows = 0;
+        for (const auto* archetype : _archetypes)
+        {
+            rows += archetype->size();
+        }
+        return rows;
+    }
+
+    template <typename... Ts>
+    template <typename... Us>
+    auto View<Ts...>::exclude() const -> View
+    {
+        const auto& excluded = ComponentType::signature<Us...>();
+
+        auto view = *this;
+        view._excluded |= excluded;
+
+        if (_archetypeStorage)
+        {
+            view._archetypes.clear();
+            for (auto* archetype : _archetypes)
+            {
+                if ((archetype->signature() & excluded).none())
+                {
+                    view._archetypes.pushBack(archetype);
+                }
+            }
+        }
+        return view;
+    }
+
+    template <typename... Ts>
+    template <typename F>
+    auto View<Ts...>::each(usize begin, usize end, F&& function) const -> void
+    {
+        if (not _archetypeStorage)
+        {
+            for (auto index = static_cast<uint32>(begin); index < end; ++index)
+            {
+                const auto id = _driver->entities()[index];
+                if (matches(id))
+                {
+                    invoke(function, id, poolComponent<Ts>(index, id)...);
+                }
+            }
+            return;
+        }
+
+        // Walk positions are the rows of the matching archetypes laid end to end.
+        usize base = 0;
+        for (const auto* archetype : _archetypes)
+        {
+            const usize size = archetype->size();
+            if (base >= end)
+            {
+                break;
+            }
+            if (base + size <= begin)
+            {
+                base += size;
+                continue;
+            }
+
+            const auto first    = std::max(begin, base) - base;
+            const auto last     = std::min(end, base + size) - base;
+            const auto capacity = archetype->chunkCapacity();
+
+            for (auto chunk = static_cast<uint32>(first / capacity); chunk * capacity < last; ++chunk)
+            {
+                const auto chunkBegin = usize(chunk) * capacity;
+                const auto rowBegin   = static_cast<uint32>(std::max(first, chunkBegin) - chunkBegin);
+                const auto rowEnd     = static_cast<uint32>(std::min(last, chunkBegin + capacity) - chunkBegin);
+                const auto entities   = archetype->entities(chunk);
+                const auto columns    = std::tuple<Ts*...> {archetype->template column<Ts>(chunk)...};
+
+                for (auto row = rowBegin; row < rowEnd; ++row)
+                {
+                    invoke(function, entities[row], std::get<Ts*>(columns)[row]...);
+                }
+            }
+
+            base += size;
+        }
+    }
+
+    template <typename... Ts>
+    template <typename F>
+    auto View<Ts...>::invoke(F& function, EntityId id, Ts&... components) -> void
+    {
+        if constexpr (std::is_invocable_v<F&, EntityId, Ts&...>)
+        {
+            function(id, components...);
+        }
+        else
+        {
+            function(components...);
+        }
+    }
+
+    template <typename... Ts>
+    auto View<Ts...>::poolEntityCount() const -> uint32
+    {
+        return _driver != nullptr ? static_cast<uint32>(_driver->size()) : 0;
+    }
+
+    template <typename... Ts>
+    auto View<Ts...>::matches(EntityId id) const -> bool
+    {
+        // A single component view is driven by its own pool, every entity matches unless some are excluded.
+        if constexpr (sizeof...(Ts) == 1)
+        {
+            return _excluded.none() or ((*_signatures)[entityIndex(id)] & _excluded).none();
+        }
+        else
+        {
+            const auto& required  = ComponentType::signature<Ts...>();
+            const auto& signature = (*_signatures)[entityIndex(id)];
+            return (signature & required) == required and (signature & _excluded).none();
+        }
+    }
+
+    template <typename... Ts>
+    template <typename T>
+    auto View<Ts...>::poolComponent(uint32 index, EntityId id) const -> T&
+    {
+        auto* pool = std::get<ComponentPool<T>*>(_pools);
+        return pool == _driver ? pool->components()[index] : pool->at(id);
+    }
+
+    //------------------------------------------------------------------------------------------------------------------
+    // class View::Iterator
+    //------------------------------------------------------------------------------------------------------------------
+
+    template <typename... Ts>
+    View<Ts...>::Iterator::Iterator(const View* view, uint32 archetype, uint32 chunk, uint32 row)
+        : _view(view)
+        , _archetype(archetype)
+        , _chunk(chunk)
+        , _row(row)
+    {}
+
+    template <typename... Ts>
+    auto View<Ts...>::Iterator::operator*() const -> value_type
+    {
+        if (_view->_archetypeStorage)
+        {
+            return value_type(std::get<Ts*>(_columns)[_row]...);
+        }
+
+        const auto id = _view->_driver->entities()[_row];
+        return value_type(_view->template poolComponent<Ts>(_row, id)...);
+    }
+
+    template <typename... Ts>
+    auto View<Ts...>::Iterator::operator++() -> Iterator&
+    {
+        ++_row;
+        settle();
+        return *this;
+    }
+
+    template <typename... Ts>
+    auto View<Ts...>::Iterator::operator++(int) -> Iterator
+    {
+        auto previous = *this;
+        ++*this;
+        return previous;
+    }
+
+    template <typename... Ts>
+    auto View<Ts...>::Iterator::operator==(const Iterator& other) const -> bool
+    {
+        return _archetype == other._archetype and _chunk == other._chunk and _row == other._row;
+    }
+
+    template <typename... Ts>
+    auto View<Ts...>::Iterator::settle() -> void
+    {
+        if (not _view->_archetypeStorage)
+        {
+            const auto count = _view->poolEntityCount();
+            while (_row < count and not _view->matches(_view->_driver->entities()[_row]))
+            {
+                ++_row;
+            }
+            return;
+        }
+
+        const auto& archetypes = _view->_archetypes;
+        while (_archetype < archetypes.size())
+        {
+            const auto* archetype = archetypes[_archetype];
+            if (_row < _rows)
+            {
+                return;
+            }
+
+            // Move on to the next chunk, or the first chunk of the next archetype, and cache its columns.
+            if (_rows != 0)
+            {
+                _row = 0;
+                if (++_chunk == archetype->chunkCount())
+                {
+                    _chunk = 0;
+                    if (++_archetype == archetypes.size())
+                    {
+                        break;
+                    }
+                    archetype = archetypes[_archetype];
+                }
+            }
+
+            _rows    = archetype->chunkRows(_chunk);
+            _columns = std::tuple<Ts*...> {archetype->template column<Ts>(_chunk)...};
+        }
+
+        _chunk = 0;
+        _row   = 0;
+        _rows  = 0;
+    }
+}
@@ -42,6 +42,14 @@ project "Runtime"
         }
     filter {}
 
+    filter { "system:not macosx" }
+        removefiles { "Private/Platform/MacOS/**" }
+    filter {}
+
+    filter { "system:not linux" }
+        removefiles { "Private/Platform/Linux/**" }
+    filter {}
+
     filter { "configurations:Debug" }
         runtime "Debug"
         optimize "Off"
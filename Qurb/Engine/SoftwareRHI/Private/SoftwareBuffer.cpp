@@ -0,0 +1,91 @@
+#include "SoftwareBuffer.hpp"
+
+#include <Debug/Ensure.hpp>
+#include <Log/Log.hpp>
+
+#include <cstring>
+
+namespace qurb::rhi::software
+{
+    Buffer::Buffer(const BufferDescriptor& descriptor)
+        : base(descriptor)
+        , _data(nullptr)
+        , _mapped(false)
+        , _mappedOffset(0)
+        , _mappedSize(0)
+    {
+        ensure(_size > 0, "Cannot create a zero size Buffer.");
+        if (_usage == BufferUsage::Immutable)
+        {
+            ensure(descriptor.initialData != nullptr, "Immutable buffer requires initial data.");
+        }
+
+        _data = static_cast<std::byte*>(::operator new(_size));
+        if (descriptor.initialData != nullptr)
+        {
+            std::memcpy(_data, descriptor.initialData, _size);
+        }
+    }
+
+    Buffer::~Buffer()
+    {
+        ::operator delete(_data, _size);
+    }
+
+    auto Buffer::map(usize offset, usize size) -> void*
+    {
+        if (_usage == BufferUsage::Immutable)
+        {
+            Log::warn("Cannot map an immutable buffer");
+            return nullptr;
+        }
+
+        ensure(size <= _size and offset <= _size - size, "Mapped range out of the buffer.");
+
+        if (_usage == BufferUsage::Persistent)
+        {
+            return _data + offset;
+        }
+
+        ensure(not _mapped, "Buffer already mapped.");
+
+        _mapped       = true;
+        _mappedOffset = offset;
+        _mappedSize   = size;
+        return _data + offset;
+    }
+
+    auto Buffer::unmap() -> void
+    {
+        if (_usage == BufferUsage::Immutable)
+        {
+            Log::warn("Cannot unmap an immutable buffer");
+            return;
+        }
+        if (_usage == BufferUsage::Persistent)
+        {
+            return;
+        }
+
+        ensure(_mapped, "Buffer not mapped.");
+
+        _mapped = false;
+    }
+
+    auto Buffer::flushRange(usize offset, usize size) -> void
+    {
+        if (_usage == BufferUsage::Immutable)
+        {
+            Log::warn("Cannot flush an immutable buffer");
+            return;
+        }
+        if (_usage == BufferUsage::Persistent)
+        {
+            ensure(size <= _size and offset <= _size - size, "Flushed range out of the buffer.");
+            return;
+        }
+
+        ensure(_mapped, "Buffer not mapped.");
+        ensure(offset >= _mappedOffset and size <= _mappedSize and offset - _mappedOffset <= _mappedSize - size, "Flushed range out of the mapped range.");
+    }
+}
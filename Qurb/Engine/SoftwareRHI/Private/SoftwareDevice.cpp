@@ -0,0 +1,84 @@
+#include "SoftwareDevice.hpp"
+
+#include "SoftwareBuffer.hpp"
+#include "SoftwarePipelineState.hpp"
+#include "SoftwareRenderContext.hpp"
+#include "SoftwareRenderTarget.hpp"
+#include "SoftwareShaderProgram.hpp"
+#include "SoftwareSwapChain.hpp"
+#include "SoftwareTexture.hpp"
+
+#include <Log/Log.hpp>
+
+namespace qurb::rhi::software
+{
+    Device::Device(uint32 workerCount)
+        : _jobSystem(workerCount)
+        , _shaders()
+        , _shadersMutex()
+    {
+        registerShader(objectShaderName, makeObjectShader());
+    }
+
+    auto Device::createRenderContext(const RenderContextDescriptor& descriptor) -> rhi::RenderContext*
+    {
+        return new RenderContext(this, descriptor);
+    }
+
+    auto Device::createBuffer(const BufferDescriptor& descriptor) -> rhi::Buffer*
+    {
+        return new Buffer(descriptor);
+    }
+
+    auto Device::createRenderTarget(const RenderTargetDescriptor&) -> rhi::RenderTarget*
+    {
+        // The descriptor carries no size, the caller resizes the target before rendering to it.
+        return new RenderTarget(0, 0);
+    }
+
+    auto Device::createSwapChain(const SwapChainDescriptor& descriptor) -> rhi::SwapChain*
+    {
+        return new SwapChain(descriptor);
+    }
+
+    auto Device::createShaderProgram(const ShaderProgramDescriptor& descriptor) -> rhi::ShaderProgram*
+    {
+        {
+            auto lock = std::scoped_lock(_shadersMutex);
+            if (const auto it = _shaders.find(descriptor.shaderName); it != _shaders.end())
+            {
+                return new ShaderProgram(descriptor, it->second);
+            }
+        }
+
+        Log::warn("No software shader named {}, drawing with the fallback shader", descriptor.shaderName);
+        return new ShaderProgram(descriptor, makeFallbackShader());
+    }
+
+    auto Device::createPipelineState(const PipelineStateDescriptor& descriptor) -> rhi::PipelineState*
+    {
+        return new PipelineState(descriptor);
+    }
+
+    auto Device::createTexture(const TextureDescriptor& descriptor) -> rhi::Texture*
+    {
+        return new Texture(descriptor);
+    }
+
+    auto Device::registerShader(std::string_view name, Shader shader) -> void
+    {
+        auto lock = std::scoped_lock(_shadersMutex);
+        if (const auto it = _shaders.find(name); it != _shaders.end())
+        {
+            it->second = std::move(shader);
+            return;
+        }
+        _shaders.emplace(std::string(name), std::move(shader));
+    }
+
+    auto Device::hasShader(std::string_view name) const -> bool
+    {
+        auto lock = std::scoped_lock(_shadersMutex);
+        return _shaders.contains(name);
+    }
+}
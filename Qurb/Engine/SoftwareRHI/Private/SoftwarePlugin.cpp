@@ -0,0 +1,11 @@
+#include "SoftwarePlugin.hpp"
+
+using namespace qurb;
+
+extern "C"
+{
+    QURB_SOFTWARE_RHI_API auto createPlugin(DynamicLibrary* library) -> Plugin*
+    {
+        return new rhi::software::Plugin(std::move(*library));
+    }
+}
@@ -0,0 +1,614 @@
+#include "SoftwareRasterizer.hpp"
+
+#include "SoftwareShaderProgram.hpp"
+
+#include <Math/Simd.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+
+namespace qurb::rhi::software
+{
+    namespace
+    {
+        /// \brief The vertex shader invocations run by one job, in whole instances.
+        constexpr auto verticesPerJob = usize(1024);
+
+        /// \brief The relative error allowed on an edge function when classifying whole blocks, well above the rounding
+        /// of single precision.
+        constexpr auto marginScale = 1.0e-5f;
+
+        /// \brief A vertex after the perspective division, in pixels with y down. The varyings are divided by w.
+        struct ScreenVertex
+        {
+            float32  x;
+            float32  y;
+            float32  z;
+            float32  inverseW;
+            Varyings varyings;
+        };
+
+        auto packChannel(float32 value) -> uint32
+        {
+            return static_cast<uint32>(std::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f);
+        }
+
+        auto packColor(float32 r, float32 g, float32 b, float32 a) -> uint32
+        {
+            return packChannel(r) | (packChannel(g) << 8) | (packChannel(b) << 16) | (packChannel(a) << 24);
+        }
+    }
+
+    Rasterizer::Rasterizer(JobSystem& jobSystem)
+        : _jobSystem(&jobSystem)
+        , _draws()
+        , _constants()
+        , _instanceOffsets()
+        , _triangleOffsets()
+        , _triangles()
+        , _bins()
+        , _tileCount(0)
+        , _chunkCount(0)
+        , _statistics()
+        , _trianglesRasterized(0)
+        , _binEntries(0)
+        , _fragmentsShaded(0)
+    {}
+
+    auto Rasterizer::execute(
+        RenderTarget& renderTarget, const Color& clearColor, std::span<const DrawCommand> draws, std::span<const std::byte> constants)
+        -> void
+    {
+        _draws     = draws;
+        _constants = constants;
+        _statistics = RasterizerStatistics();
+        _trianglesRasterized.store(0, std::memory_order_relaxed);
+        _binEntries.store(0, std::memory_order_relaxed);
+        _fragmentsShaded.store(0, std::memory_order_relaxed);
+
+        processVertices(renderTarget, draws, constants);
+
+        const auto tileCountX = (renderTarget.width() + tileSize - 1) / tileSize;
+        const auto tileCountY = (renderTarget.height() + tileSize - 1) / tileSize;
+        binTriangles(tileCountX, tileCountY);
+
+        _jobSystem->parallelFor(static_cast<usize>(tileCountX) * tileCountY, 1, [&](usize begin, usize end) {
+            for (auto tile = begin; tile < end; ++tile)
+            {
+                shadeTile(renderTarget, clearColor, static_cast<uint32>(tile), tileCountX);
+            }
+        });
+
+        _statistics.trianglesRasterized = _trianglesRasterized.load(std::memory_order_relaxed);
+        _statistics.binEntries          = _binEntries.load(std::memory_order_relaxed);
+        _statistics.fragmentsShaded     = _fragmentsShaded.load(std::memory_order_relaxed);
+
+        _draws     = {};
+        _constants = {};
+    }
+
+    auto Rasterizer::processVertices(RenderTarget& renderTarget, std::span<const DrawCommand> draws, std::span<const std::byte> constants)
+        -> void
+    {
+        _instanceOffsets.resize(draws.size() + 1);
+        _triangleOffsets.resize(draws.size());
+
+        usize instanceCount = 0;
+        usize triangleCount = 0;
+        usize vertexCount   = 0;
+        for (usize i = 0; i < draws.size(); ++i)
+        {
+            _instanceOffsets[i] = instanceCount;
+            _triangleOffsets[i] = triangleCount;
+            instanceCount += draws[i].instanceCount;
+            triangleCount += static_cast<usize>(draws[i].vertexCount / 3) * draws[i].instanceCount;
+            vertexCount += static_cast<usize>(draws[i].vertexCount) * draws[i].instanceCount;
+        }
+        _instanceOffsets[draws.size()] = instanceCount;
+
+        _statistics.trianglesSubmitted = triangleCount;
+        _triangles.resize(triangleCount * 2);
+
+        if (instanceCount == 0)
+        {
+            return;
+        }
+
+        const auto grainSize = std::max(usize(1), verticesPerJob / std::max(usize(1), vertexCount / instanceCount));
+        _jobSystem->parallelFor(instanceCount, grainSize, [&](usize begin, usize end) {
+            auto  vertices   = Vector<ClipVertex>();
+            auto  draw       = static_cast<usize>(std::upper_bound(_instanceOffsets.begin(), _instanceOffsets.end(), begin) - _instanceOffsets.begin() - 1);
+            usize rasterized = 0;
+            for (auto instance = begin; instance < end; ++instance)
+            {
+                // Skips the draws without instances too.
+                while (_instanceOffsets[draw + 1] <= instance)
+                {
+                    ++draw;
+                }
+
+                const auto& command       = draws[draw];
+                const auto& shaderProgram = *command.shaderProgram;
+                const auto& shader        = shaderProgram.shader();
+                const auto  localInstance = instance - _instanceOffsets[draw];
+
+                auto input = VertexInput {
+                    .buffers          = command.vertexBuffers,
+                    .constants        = constants.subspan(command.constantsOffset, command.constantsSize),
+                    .attributeOffsets = shaderProgram.attributeOffsets().data(),
+                    .attributeCount   = static_cast<uint32>(shaderProgram.attributeOffsets().size()),
+                    .stride           = shaderProgram.stride(),
+                    .vertexIndex      = 0,
+                    .instanceIndex    = command.firstInstance + static_cast<uint32>(localInstance),
+                };
+
+                const auto trianglesPerInstance = command.vertexCount / 3;
+                vertices.resize(static_cast<usize>(trianglesPerInstance) * 3);
+                for (uint32 i = 0; i < trianglesPerInstance * 3; ++i)
+                {
+                    input.vertexIndex    = command.firstVertex + i;
+                    vertices[i].position = shader.vertex(input, vertices[i].varyings);
+                }
+
+                const auto firstSlot = 2 * (_triangleOffsets[draw] + localInstance * trianglesPerInstance);
+                for (uint32 i = 0; i < trianglesPerInstance; ++i)
+                {
+                    const auto triangle = std::span<const ClipVertex, 3>(vertices.data() + i * 3, 3);
+                    rasterized += setupTriangle(renderTarget, triangle, shader.varyingCount, static_cast<uint32>(draw), firstSlot + i * 2);
+                }
+            }
+            _trianglesRasterized.fetch_add(rasterized, std::memory_order_relaxed);
+        });
+    }
+
+    auto Rasterizer::setupTriangle(
+        const RenderTarget& renderTarget, std::span<const ClipVertex, 3> triangle, uint32 varyingCount, uint32 draw, usize slot) -> uint32
+    {
+        // Clips against the near plane, z >= 0, which also keeps w positive. A triangle crossing it becomes a quad.
+        auto  polygon     = std::array<ClipVertex, 4>();
+        usize vertexCount = 0;
+        for (usize i = 0; i < 3; ++i)
+        {
+            const auto& current = triangle[i];
+            const auto& next    = triangle[(i + 1) % 3];
+            if (current.position.z >= 0.0f)
+            {
+                polygon[vertexCount++] = current;
+            }
+            if ((current.position.z >= 0.0f) != (next.position.z >= 0.0f))
+            {
+                const auto t      = current.position.z / (current.position.z - next.position.z);
+                auto&      vertex = polygon[vertexCount++];
+                vertex.position   = math::Vector4f(
+                    current.position.x + (next.position.x - current.position.x) * t,
+                    current.position.y + (next.position.y - current.position.y) * t,
+                    current.position.z + (next.position.z - current.position.z) * t,
+                    current.position.w + (next.position.w - current.position.w) * t);
+                for (uint32 k = 0; k < varyingCount; ++k)
+                {
+                    vertex.varyings[k] = current.varyings[k] + (next.varyings[k] - current.varyings[k]) * t;
+                }
+            }
+        }
+
+        const auto width  = static_cast<float32>(renderTarget.width());
+        const auto height = static_cast<float32>(renderTarget.height());
+
+        auto screen = std::array<ScreenVertex, 4>();
+        for (usize i = 0; i < vertexCount; ++i)
+        {
+            const auto& position = polygon[i].position;
+            const auto  inverseW = 1.0f / position.w;
+
+            screen[i].x        = (position.x * inverseW * 0.5f + 0.5f) * width;
+            screen[i].y        = (0.5f - position.y * inverseW * 0.5f) * height;
+            screen[i].z        = position.z * inverseW;
+            screen[i].inverseW = inverseW;
+            for (uint32 k = 0; k < varyingCount; ++k)
+            {
+                screen[i].varyings[k] = polygon[i].varyings[k] * inverseW;
+            }
+        }
+
+        auto setup = [&](Triangle& out, const ScreenVertex& v0, const ScreenVertex& v1, const ScreenVertex& v2) -> bool {
+            out.minX = 1;
+            out.maxX = 0;
+
+            // Edge i is opposite to vertex i. Swapping the ends of an edge exactly negates its function, so the two
+            // triangles sharing an edge agree on which side each pixel lies.
+            const auto vertices = std::array<const ScreenVertex*, 3> {&v0, &v1, &v2};
+            for (usize i = 0; i < 3; ++i)
+            {
+                const auto& a = *vertices[(i + 1) % 3];
+                const auto& b = *vertices[(i + 2) % 3];
+                out.edgeA[i]  = a.y - b.y;
+                out.edgeB[i]  = b.x - a.x;
+                out.edgeC[i]  = a.x * b.y - a.y * b.x;
+            }
+
+            auto area = out.edgeA[0] * v0.x + out.edgeB[0] * v0.y + out.edgeC[0];
+            if (not (std::abs(area) > 0.0f) or not std::isfinite(area))
+            {
+                return false;
+            }
+
+            // Both windings are drawn, the edges of clockwise triangles are flipped to be positive inside.
+            const auto sign = area < 0.0f ? -1.0f : 1.0f;
+            area *= sign;
+            for (usize i = 0; i < 3; ++i)
+            {
+                out.edgeA[i] *= sign;
+                out.edgeB[i] *= sign;
+                out.edgeC[i] = out.edgeC[i] * sign + out.edgeA[i] * 0.5f + out.edgeB[i] * 0.5f;  // Pixel centers.
+
+                // A pixel center on a top or left edge belongs to the triangle, on the others to its neighbour.
+                const auto topLeft = out.edgeA[i] > 0.0f or (out.edgeA[i] == 0.0f and out.edgeB[i] > 0.0f);
+                out.edgeBias[i]    = topLeft ? -std::numeric_limits<float32>::min() : 0.0f;
+
+                // Bounds the rounding of the edge function anywhere on the target.
+                out.edgeMargin[i] = (std::abs(out.edgeA[i]) * width + std::abs(out.edgeB[i]) * height + std::abs(out.edgeC[i])) * marginScale;
+            }
+
+            const auto minX = std::min({v0.x, v1.x, v2.x});
+            const auto maxX = std::max({v0.x, v1.x, v2.x});
+            const auto minY = std::min({v0.y, v1.y, v2.y});
+            const auto maxY = std::max({v0.y, v1.y, v2.y});
+
+            out.minX = static_cast<int32>(std::floor(std::clamp(minX, -1.0f, width)));
+            out.maxX = static_cast<int32>(std::ceil(std::clamp(maxX, -1.0f, width)));
+            out.minY = static_cast<int32>(std::floor(std::clamp(minY, -1.0f, height)));
+            out.maxY = static_cast<int32>(std::ceil(std::clamp(maxY, -1.0f, height)));
+            out.minX = std::max(out.minX, 0);
+            out.minY = std::max(out.minY, 0);
+            out.maxX = std::min(out.maxX, static_cast<int32>(renderTarget.width()) - 1);
+            out.maxY = std::min(out.maxY, static_cast<int32>(renderTarget.height()) - 1);
+            if (out.minY > out.maxY)
+            {
+                out.minX = 1;
+                out.maxX = 0;
+            }
+            if (out.empty())
+            {
+                return false;
+            }
+
+            out.depth       = {v0.z, v1.z - v0.z, v2.z - v0.z};
+            out.minDepth    = std::min({v0.z, v1.z, v2.z});
+            out.inverseW    = {v0.inverseW, v1.inverseW - v0.inverseW, v2.inverseW - v0.inverseW};
+            out.inverseArea = 1.0f / area;
+            out.draw        = draw;
+            for (uint32 k = 0; k < varyingCount; ++k)
+            {
+                out.varyings[0][k] = v0.varyings[k];
+                out.varyings[1][k] = v1.varyings[k] - v0.varyings[k];
+                out.varyings[2][k] = v2.varyings[k] - v0.varyings[k];
+            }
+            return true;
+        };
+
+        auto& first  = _triangles[slot];
+        auto& second = _triangles[slot + 1];
+        first.minX   = 1;
+        first.maxX   = 0;
+        second.minX  = 1;
+        second.maxX  = 0;
+
+        uint32 kept = 0;
+        if (vertexCount >= 3)
+        {
+            kept += setup(first, screen[0], screen[1], screen[2]);
+        }
+        if (vertexCount == 4)
+        {
+            kept += setup(second, screen[0], screen[2], screen[3]);
+        }
+        return kept;
+    }
+
+    auto Rasterizer::binTriangles(uint32 tileCountX, uint32 tileCountY) -> void
+    {
+        const auto tileCount = static_cast<usize>(tileCountX) * tileCountY;
+
+        _tileCount  = tileCount;
+        _chunkCount = (_triangles.size() + chunkSize - 1) / chunkSize;
+        if (_bins.size() < _chunkCount * tileCount)
+        {
+            _bins.resize(_chunkCount * tileCount);
+        }
+
+        _jobSystem->parallelFor(_chunkCount, 1, [&](usize begin, usize end) {
+            usize entries = 0;
+            for (auto chunk = begin; chunk < end; ++chunk)
+            {
+                auto* bins = _bins.data() + chunk * tileCount;
+                for (usize tile = 0; tile < tileCount; ++tile)
+                {
+                    bins[tile].clear();
+                }
+
+                const auto last = std::min(_triangles.size(), (chunk + 1) * chunkSize);
+                for (auto slot = chunk * chunkSize; slot < last; ++slot)
+                {
+                    const auto& triangle = _triangles[slot];
+                    if (triangle.empty())
+                    {
+                        continue;
+                    }
+
+                    const auto tileMinX = static_cast<uint32>(triangle.minX) / tileSize;
+                    const auto tileMaxX = static_cast<uint32>(triangle.maxX) / tileSize;
+                    const auto tileMinY = static_cast<uint32>(triangle.minY) / tileSize;
+                    const auto tileMaxY = static_cast<uint32>(triangle.maxY) / tileSize;
+                    for (auto tileY = tileMinY; tileY <= tileMaxY; ++tileY)
+                    {
+                        for (auto tileX = tileMinX; tileX <= tileMaxX; ++tileX)
+                        {
+                            bins[tileY * tileCountX + tileX].pushBack(static_cast<uint32>(slot));
+                        }
+                    }
+                    entries += static_cast<usize>(tileMaxX - tileMinX + 1) * (tileMaxY - tileMinY + 1);
+                }
+            }
+            _binEntries.fetch_add(entries, std::memory_order_relaxed);
+        });
+    }
+
+    auto Rasterizer::shadeTile(RenderTarget& renderTarget, const Color& clearColor, uint32 tile, uint32 tileCountX) -> void
+    {
+        const auto x0 = static_cast<int32>((tile % tileCountX) * tileSize);
+        const auto y0 = static_cast<int32>((tile / tileCountX) * tileSize);
+        const auto x1 = std::min(x0 + static_cast<int32>(tileSize), static_cast<int32>(renderTarget.width()));
+        const auto y1 = std::min(y0 + static_cast<int32>(tileSize), static_cast<int32>(renderTarget.height()));
+
+        const auto clear = packColor(clearColor.r, clearColor.g, clearColor.b, clearColor.a);
+        for (auto y = y0; y < y1; ++y)
+        {
+            const auto row = static_cast<usize>(y) * renderTarget.stride();
+            std::fill(renderTarget.colors() + row + x0, renderTarget.colors() + row + x1, clear);
+            std::fill(renderTarget.depths() + row + x0, renderTarget.depths() + row + x1, 1.0f);
+        }
+
+        auto blockDepths = std::array<float32, blocksPerTile * blocksPerTile>();
+        blockDepths.fill(1.0f);
+
+        uint64 fragments = 0;
+        for (usize chunk = 0; chunk < _chunkCount; ++chunk)
+        {
+            for (const auto slot : _bins[chunk * _tileCount + tile])
+            {
+                const auto& triangle = _triangles[slot];
+                fragments += rasterize(renderTarget, triangle, _draws[triangle.draw], blockDepths, x0, y0, x1, y1);
+            }
+        }
+        _fragmentsShaded.fetch_add(fragments, std::memory_order_relaxed);
+    }
+
+    auto Rasterizer::rasterize(
+        RenderTarget&      renderTarget,
+        const Triangle&    triangle,
+        const DrawCommand& draw,
+        std::span<float32> blockDepths,
+        int32              x0,
+        int32              y0,
+        int32              x1,
+        int32              y1) -> uint64
+    {
+        const auto& shader = draw.shaderProgram->shader();
+
+        const auto minX = std::max(triangle.minX, x0);
+        const auto maxX = std::min(triangle.maxX, x1 - 1);
+        const auto minY = std::max(triangle.minY, y0);
+        const auto maxY = std::min(triangle.maxY, y1 - 1);
+
+        auto input = FragmentInput {
+            .varyings  = {},
+            .position  = math::Vector4f(),
+            .constants = _constants.subspan(draw.constantsOffset, draw.constantsSize),
+            .textures  = &draw.textures,
+        };
+
+        auto* colors = renderTarget.colors();
+        auto* depths = renderTarget.depths();
+
+        // The barycentric weights of the second and third vertices, and the depth, of the four pixels of a group.
+        alignas(16) float32 weights1[4];
+        alignas(16) float32 weights2[4];
+        alignas(16) float32 depth[4];
+
+        uint64 fragments  = 0;
+        auto   shadeGroup = [&](uint32 mask, int32 x, int32 y, usize offset) {
+            for (uint32 lane = 0; lane < 4; ++lane)
+            {
+                if ((mask & (1u << lane)) == 0)
+                {
+                    continue;
+                }
+
+                const auto l1       = weights1[lane];
+                const auto l2       = weights2[lane];
+                const auto inverseW = triangle.inverseW[0] + l1 * triangle.inverseW[1] + l2 * triangle.inverseW[2];
+                const auto w        = 1.0f / inverseW;
+                for (uint32 k = 0; k < shader.varyingCount; ++k)
+                {
+                    input.varyings[k] = (triangle.varyings[0][k] + l1 * triangle.varyings[1][k] + l2 * triangle.varyings[2][k]) * w;
+                }
+                input.position = math::Vector4f(
+                    static_cast<float32>(x + static_cast<int32>(lane)) + 0.5f, static_cast<float32>(y) + 0.5f, depth[lane], inverseW);
+
+                const auto color      = shader.fragment(input);
+                colors[offset + lane] = packColor(color.x, color.y, color.z, color.w);
+            }
+            fragments += static_cast<uint64>(std::popcount(mask));
+        };
+
+        // Tests the four pixels from `(x, y)` against the edges unless the block is covered, and against the depth
+        // buffer, then shades the ones passing. Returns whether any passed.
+#if defined(QURB_SIMD_SCALAR)
+        const auto width = static_cast<int32>(renderTarget.width());
+
+        auto rasterizeGroup = [&](int32 x, int32 y, bool covered) -> bool {
+            const auto fy     = static_cast<float32>(y);
+            const auto offset = static_cast<usize>(y) * renderTarget.stride() + static_cast<usize>(x);
+
+            uint32 mask = 0;
+            for (uint32 lane = 0; lane < 4; ++lane)
+            {
+                const auto px    = x + static_cast<int32>(lane);
+                const auto fx    = static_cast<float32>(px);
+                const auto edge0 = triangle.edgeA[0] * fx + (triangle.edgeB[0] * fy + triangle.edgeC[0]);
+                const auto edge1 = triangle.edgeA[1] * fx + (triangle.edgeB[1] * fy + triangle.edgeC[1]);
+                const auto edge2 = triangle.edgeA[2] * fx + (triangle.edgeB[2] * fy + triangle.edgeC[2]);
+                const auto inside =
+                    px < width and (covered or (edge0 > triangle.edgeBias[0] and edge1 > triangle.edgeBias[1] and edge2 > triangle.edgeBias[2]));
+                if (not inside)
+                {
+                    continue;
+                }
+
+                weights1[lane] = edge1 * triangle.inverseArea;
+                weights2[lane] = edge2 * triangle.inverseArea;
+                depth[lane]    = triangle.depth[0] + weights1[lane] * triangle.depth[1] + weights2[lane] * triangle.depth[2];
+                if (depth[lane] < depths[offset + lane])
+                {
+                    depths[offset + lane] = depth[lane];
+                    mask |= 1u << lane;
+                }
+            }
+
+            if (mask == 0)
+            {
+                return false;
+            }
+            shadeGroup(mask, x, y, offset);
+            return true;
+        };
+#else
+        using namespace math::simd;
+
+        const auto lanes  = set(0.0f, 1.0f, 2.0f, 3.0f);
+        const auto width  = broadcast(static_cast<float32>(renderTarget.width()));
+        const auto a0     = broadcast(triangle.edgeA[0]);
+        const auto a1     = broadcast(triangle.edgeA[1]);
+        const auto a2     = broadcast(triangle.edgeA[2]);
+        const auto bias0  = broadcast(triangle.edgeBias[0]);
+        const auto bias1  = broadcast(triangle.edgeBias[1]);
+        const auto bias2  = broadcast(triangle.edgeBias[2]);
+        const auto area   = broadcast(triangle.inverseArea);
+        const auto depth0 = broadcast(triangle.depth[0]);
+        const auto depth1 = broadcast(triangle.depth[1]);
+        const auto depth2 = broadcast(triangle.depth[2]);
+
+        auto rasterizeGroup = [&](int32 x, int32 y, bool covered) -> bool {
+            // The edge functions at absolute coordinates rather than stepped, to stay exactly opposite to the ones of
+            // the neighbouring triangles.
+            const auto fy    = static_cast<float32>(y);
+            const auto xs    = add(broadcast(static_cast<float32>(x)), lanes);
+            const auto edge0 = multiplyAdd(a0, xs, broadcast(triangle.edgeB[0] * fy + triangle.edgeC[0]));
+            const auto edge1 = multiplyAdd(a1, xs, broadcast(triangle.edgeB[1] * fy + triangle.edgeC[1]));
+            const auto edge2 = multiplyAdd(a2, xs, broadcast(triangle.edgeB[2] * fy + triangle.edgeC[2]));
+
+            auto inside = lessThan(xs, width);
+            if (not covered)
+            {
+                inside = bitAnd(inside, bitAnd(greaterThan(edge0, bias0), greaterThan(edge1, bias1)));
+                inside = bitAnd(inside, greaterThan(edge2, bias2));
+                if (moveMask(inside) == 0)
+                {
+                    return false;
+                }
+            }
+
+            const auto l1 = mul(edge1, area);
+            const auto l2 = mul(edge2, area);
+            const auto z  = multiplyAdd(l2, depth2, multiplyAdd(l1, depth1, depth0));
+
+            const auto offset = static_cast<usize>(y) * renderTarget.stride() + static_cast<usize>(x);
+            const auto before = load(depths + offset);
+            const auto passed = bitAnd(inside, lessThan(z, before));
+            const auto mask   = moveMask(passed);
+            if (mask == 0)
+            {
+                return false;
+            }
+
+            store(depths + offset, select(passed, z, before));
+            store(weights1, l1);
+            store(weights2, l2);
+            store(depth, z);
+            shadeGroup(mask, x, y, offset);
+            return true;
+        };
+#endif
+
+        // Walks the blocks of the tile overlapped by the triangle. A block is skipped when it lies outside an edge, or
+        // when everything it holds is nearer than the triangle, and its pixels skip the edge tests when it lies inside
+        // every edge. The classification evaluates the edges at the block corners with a margin for rounding, the
+        // pixels near an edge always take the exact per pixel test.
+        const auto blockMinX = (minX - x0) / static_cast<int32>(blockSize);
+        const auto blockMaxX = (maxX - x0) / static_cast<int32>(blockSize);
+        const auto blockMinY = (minY - y0) / static_cast<int32>(blockSize);
+        const auto blockMaxY = (maxY - y0) / static_cast<int32>(blockSize);
+        for (auto blockY = blockMinY; blockY <= blockMaxY; ++blockY)
+        {
+            for (auto blockX = blockMinX; blockX <= blockMaxX; ++blockX)
+            {
+                auto& blockDepth = blockDepths[static_cast<usize>(blockY) * blocksPerTile + static_cast<usize>(blockX)];
+                if (triangle.minDepth >= blockDepth)
+                {
+                    continue;
+                }
+
+                const auto bx0 = x0 + blockX * static_cast<int32>(blockSize);
+                const auto by0 = y0 + blockY * static_cast<int32>(blockSize);
+                const auto bx1 = std::min(bx0 + static_cast<int32>(blockSize), x1) - 1;
+                const auto by1 = std::min(by0 + static_cast<int32>(blockSize), y1) - 1;
+
+                auto covered = true;
+                auto outside = false;
+                for (usize i = 0; i < 3; ++i)
+                {
+                    const auto a       = triangle.edgeA[i];
+                    const auto b       = triangle.edgeB[i];
+                    const auto nearX   = static_cast<float32>(a > 0.0f ? bx0 : bx1);
+                    const auto nearY   = static_cast<float32>(b > 0.0f ? by0 : by1);
+                    const auto farX    = static_cast<float32>(a > 0.0f ? bx1 : bx0);
+                    const auto farY    = static_cast<float32>(b > 0.0f ? by1 : by0);
+                    const auto lowest  = a * nearX + b * nearY + triangle.edgeC[i];
+                    const auto highest = a * farX + b * farY + triangle.edgeC[i];
+                    outside            = outside or highest < -triangle.edgeMargin[i];
+                    covered            = covered and lowest > triangle.edgeMargin[i];
+                }
+                if (outside)
+                {
+                    continue;
+                }
+
+                const auto groupMinX = std::max(bx0, minX) & ~3;  // Blocks start on a multiple of four.
+                const auto groupMaxX = std::min(bx1, maxX);
+                auto       written   = false;
+                for (auto y = std::max(by0, minY); y <= std::min(by1, maxY); ++y)
+                {
+                    for (auto x = groupMinX; x <= groupMaxX; x += 4)
+                    {
+                        written = rasterizeGroup(x, y, covered) or written;
+                    }
+                }
+
+                if (written)
+                {
+                    auto farthest = 0.0f;
+                    for (auto y = by0; y <= by1; ++y)
+                    {
+                        const auto* row = depths + static_cast<usize>(y) * renderTarget.stride();
+                        farthest        = std::max(farthest, *std::max_element(row + bx0, row + bx1 + 1));
+                    }
+                    blockDepth = farthest;
+                }
+            }
+        }
+
+        return fragments;
+    }
+}
@@ -0,0 +1,11 @@
+#include "SoftwareRenderBackend.hpp"
+
+#include "SoftwareDevice.hpp"
+
+namespace qurb::rhi::software
+{
+    auto RenderBackend::createDevice() const -> rhi::Device*
+    {
+        return new Device();
+    }
+}
@@ -0,0 +1,174 @@
+#include "SoftwareRenderContext.hpp"
+
+#include "SoftwareBuffer.hpp"
+#include "SoftwarePipelineState.hpp"
+#include "SoftwareTexture.hpp"
+
+#include <Debug/Ensure.hpp>
+#include <Log/Log.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+namespace qurb::rhi::software
+{
+    RenderContext::RenderContext(Device* device, const RenderContextDescriptor& descriptor)
+        : base(descriptor)
+        , _device(device)
+        , _swapChain(new SwapChain(descriptor.swapChainDescriptor))
+        , _rasterizer(device->jobSystem())
+        , _renderTarget(nullptr)
+        , _clearColor(Color::black)
+        , _draws()
+        , _constants()
+        , _pipelineState(nullptr)
+        , _vertexBuffers()
+        , _textures()
+        , _constantsOffset(0)
+        , _constantsSize(0)
+        , _framesPresented(0)
+        , _capturePath()
+        , _inFrame(false)
+    {
+        _device->retain();
+
+        if (const auto* path = std::getenv("QURB_SOFTWARE_CAPTURE"))
+        {
+            _capturePath = path;
+        }
+    }
+
+    RenderContext::~RenderContext()
+    {
+        _swapChain->release();
+        _device->release();
+    }
+
+    auto RenderContext::beginFrame() -> void
+    {
+        ensure(not _inFrame, "Frame already begun.");
+
+        _inFrame = true;
+    }
+
+    auto RenderContext::endFrame() -> void
+    {
+        ensure(_inFrame, "Frame not begun.");
+
+        _inFrame = false;
+    }
+
+    auto RenderContext::present() -> void
+    {
+        ++_framesPresented;
+
+        // Written at every present, the window may outlive the run.
+        if (not _capturePath.empty() and not _swapChain->renderTarget()->save(_capturePath))
+        {
+            Log::error("Software render context could not write {}, capture disabled", _capturePath);
+            _capturePath.clear();
+        }
+    }
+
+    auto RenderContext::beginRenderPass(rhi::RenderTarget* renderTarget, const RenderPassDescriptor& descriptor) -> void
+    {
+        ensure(_inFrame, "Render pass outside of a frame.");
+        ensure(_renderTarget == nullptr, "Render pass already begun.");
+        ensure(renderTarget != nullptr, "Render pass without a render target.");
+
+        _renderTarget    = static_cast<RenderTarget*>(renderTarget);
+        _clearColor      = descriptor.clearColor;
+        _pipelineState   = nullptr;
+        _vertexBuffers   = {};
+        _textures        = {};
+        _constantsOffset = 0;
+        _constantsSize   = 0;
+        _draws.clear();
+        _constants.clear();
+    }
+
+    auto RenderContext::endRenderPass() -> void
+    {
+        ensure(_renderTarget != nullptr, "Render pass not begun.");
+
+        _rasterizer.execute(*_renderTarget, _clearColor, {_draws.data(), _draws.size()}, {_constants.data(), _constants.size()});
+        _renderTarget = nullptr;
+    }
+
+    auto RenderContext::pushConstants(const void* data, usize size) -> void
+    {
+        ensure(_renderTarget != nullptr, "Push constants outside of a render pass.");
+
+        // Every push is kept until the pass executes, each draw reads the last one before it.
+        _constantsOffset = static_cast<uint32>(_constants.size());
+        _constantsSize   = static_cast<uint32>(size);
+        const auto needed = _constants.size() + size;
+        if (needed > _constants.capacity())
+        {
+            // Grown geometrically, an exact resize would copy every earlier push for each new one.
+            _constants.reserve(std::max(needed, _constants.capacity() * 2));
+        }
+        _constants.resize(needed);
+        std::memcpy(_constants.data() + _constantsOffset, data, size);
+    }
+
+    auto RenderContext::bindPipelineState(rhi::PipelineState* pipelineState) -> void
+    {
+        ensure(_renderTarget != nullptr, "Binding a pipeline state outside of a render pass.");
+        ensure(pipelineState != nullptr, "Binding a null pipeline state.");
+
+        _pipelineState = static_cast<const PipelineState*>(pipelineState);
+    }
+
+    auto RenderContext::bindVertexBuffer(rhi::Buffer* vertexBuffer, uint32 slot, uint32 offset) -> void
+    {
+        ensure(_renderTarget != nullptr, "Binding a vertex buffer outside of a render pass.");
+        ensure(vertexBuffer->type() == BufferType::Vertex, "Binding wrong buffer type.");
+        ensure(slot < maxVertexBuffers, "Vertex buffer slot {} out of range.", slot);
+
+        _vertexBuffers[slot] = static_cast<const Buffer*>(vertexBuffer)->data() + offset;
+    }
+
+    auto RenderContext::bindFragmentTexture(rhi::Texture* texture, uint32 slot) -> void
+    {
+        ensure(_renderTarget != nullptr, "Binding a texture outside of a render pass.");
+        ensure(texture != nullptr, "Binding a null texture.");
+        ensure(slot < maxTextures, "Texture slot {} out of range.", slot);
+
+        _textures[slot] = static_cast<const Texture*>(texture);
+    }
+
+    auto RenderContext::draw(uint32 vertexCount, uint32 firstVertex) -> void
+    {
+        drawInstanced(vertexCount, firstVertex, 1, 0);
+    }
+
+    auto RenderContext::drawInstanced(uint32 vertexCount, uint32 firstVertex, uint32 instanceCount, uint32 firstInstance) -> void
+    {
+        ensure(_renderTarget != nullptr, "Drawing outside of a render pass.");
+        ensure(_pipelineState != nullptr, "Drawing without a pipeline state.");
+
+        _draws.pushBack(DrawCommand {
+            .shaderProgram   = _pipelineState->shaderProgram(),
+            .vertexBuffers   = _vertexBuffers,
+            .textures        = _textures,
+            .constantsOffset = _constantsOffset,
+            .constantsSize   = _constantsSize,
+            .vertexCount     = vertexCount,
+            .firstVertex     = firstVertex,
+            .instanceCount   = instanceCount,
+            .firstInstance   = firstInstance,
+        });
+    }
+
+    auto RenderContext::executeCommandLists(std::span<const CommandList> commandLists) -> void
+    {
+        ensure(_renderTarget != nullptr, "Executing command lists outside of a render pass.");
+
+        for (const auto& commandList : commandLists)
+        {
+            commandList.forEach(CommandTranslator {*this});
+        }
+    }
+}
@@ -0,0 +1,54 @@
+#include "SoftwareRenderTarget.hpp"
+
+#include <format>
+#include <fstream>
+#include <string>
+
+namespace qurb::rhi::software
+{
+    RenderTarget::RenderTarget(uint32 width, uint32 height)
+        : _width(0)
+        , _height(0)
+        , _stride(0)
+        , _colors()
+        , _depths()
+    {
+        resize(width, height);
+    }
+
+    auto RenderTarget::resize(uint32 width, uint32 height) -> void
+    {
+        _width  = width;
+        _height = height;
+        _stride = (width + rowAlignment - 1) / rowAlignment * rowAlignment;
+
+        const auto size = static_cast<usize>(_stride) * _height;
+        _colors.resize(size);
+        _depths.resize(size);
+    }
+
+    auto RenderTarget::save(std::string_view path) const -> bool
+    {
+        auto file = std::ofstream(std::string(path), std::ios::binary);
+        if (not file)
+        {
+            return false;
+        }
+
+        file << std::format("P6\n{} {}\n255\n", _width, _height);
+
+        auto row = std::string(static_cast<usize>(_width) * 3, '\0');
+        for (uint32 y = 0; y < _height; ++y)
+        {
+            for (uint32 x = 0; x < _width; ++x)
+            {
+                const auto color = pixel(x, y);
+                row[x * 3 + 0]   = static_cast<char>(color & 0xffu);
+                row[x * 3 + 1]   = static_cast<char>((color >> 8) & 0xffu);
+                row[x * 3 + 2]   = static_cast<char>((color >> 16) & 0xffu);
+            }
+            file.write(row.data(), static_cast<std::streamsize>(row.size()));
+        }
+        return static_cast<bool>(file);
+    }
+}
@@ -0,0 +1,51 @@
+#include "SoftwareShader.hpp"
+
+#include <Math/Matrix4x4.hpp>
+#include <Math/Vector2.hpp>
+#include <Math/Vector3.hpp>
+#include <Scene/SceneRenderer.hpp>
+
+namespace qurb::rhi::software
+{
+    namespace
+    {
+        /// \brief `projection * view * world * position`, the layout `SceneRenderer` binds its buffers with.
+        auto transformObject(const VertexInput& input) -> math::Vector4f
+        {
+            const auto position   = input.attribute<math::Vector3f>(0);
+            const auto world      = input.fetch<math::Matrix4x4f>(SceneRenderer::instanceBufferSlot, input.instanceIndex);
+            const auto view       = input.fetch<math::Matrix4x4f>(SceneRenderer::sceneConstantsSlot, 0);
+            const auto projection = input.fetch<math::Matrix4x4f>(SceneRenderer::sceneConstantsSlot, 1);
+            return projection * (view * (world * math::Vector4f(position.x, position.y, position.z, 1.0f)));
+        }
+    }
+
+    auto makeObjectShader() -> Shader
+    {
+        return Shader {
+            .vertex =
+                [](const VertexInput& input, Varyings& varyings) {
+                    const auto uv = input.attribute<math::Vector2f>(1);
+                    varyings[0]   = uv.x;
+                    varyings[1]   = uv.y;
+                    return transformObject(input);
+                },
+            .fragment =
+                [](const FragmentInput& input) {
+                    const auto u = input.varyings[0];
+                    const auto v = input.varyings[1];
+                    return math::Vector4f(u, v, 1.0f - u, 1.0f);
+                },
+            .varyingCount = 2,
+        };
+    }
+
+    auto makeFallbackShader() -> Shader
+    {
+        return Shader {
+            .vertex       = [](const VertexInput& input, Varyings&) { return transformObject(input); },
+            .fragment     = [](const FragmentInput&) { return math::Vector4f(1.0f, 0.0f, 1.0f, 1.0f); },
+            .varyingCount = 0,
+        };
+    }
+}
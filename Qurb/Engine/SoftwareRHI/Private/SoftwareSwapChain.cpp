@@ -0,0 +1,39 @@
+#include "SoftwareSwapChain.hpp"
+
+#include <Platform/Window.hpp>
+
+namespace qurb::rhi::software
+{
+    namespace
+    {
+        auto windowSize(const Window& window) -> math::Vector2i
+        {
+            return {static_cast<int32>(window.size().x), static_cast<int32>(window.size().y)};
+        }
+    }
+
+    SwapChain::SwapChain(const SwapChainDescriptor& descriptor)
+        : base(descriptor)
+        , _renderTarget(nullptr)
+    {
+        const auto size = windowSize(_window);
+        _renderTarget   = new RenderTarget(static_cast<uint32>(size.x), static_cast<uint32>(size.y));
+    }
+
+    SwapChain::~SwapChain()
+    {
+        _renderTarget->release();
+    }
+
+    auto SwapChain::nextRenderTarget() -> rhi::RenderTarget*
+    {
+        const auto size   = windowSize(_window);
+        const auto width  = static_cast<uint32>(size.x);
+        const auto height = static_cast<uint32>(size.y);
+        if (width != _renderTarget->width() or height != _renderTarget->height())
+        {
+            _renderTarget->resize(width, height);
+        }
+        return _renderTarget;
+    }
+}
@@ -0,0 +1,60 @@
+#include "SoftwareTexture.hpp"
+
+#include <Log/Log.hpp>
+
+#include <cmath>
+#include <cstring>
+
+namespace qurb::rhi::software
+{
+    Texture::Texture(const TextureDescriptor& descriptor)
+        : _width(descriptor.width)
+        , _height(descriptor.height)
+        , _format(descriptor.format)
+        , _texels()
+    {
+        const auto texelCount = static_cast<usize>(_width) * _height;
+        switch (_format)
+        {
+            using enum TextureFormat;
+
+            case RGBA8Unorm:
+            case RGBA8Srgb:
+            case BGRA8Unorm:
+                _texels.resize(texelCount);
+                if (descriptor.data != nullptr)
+                {
+                    std::memcpy(_texels.data(), descriptor.data, texelCount * sizeof(uint32));
+                }
+                if (_format == BGRA8Unorm)
+                {
+                    for (auto& texel : _texels)
+                    {
+                        texel = (texel & 0xff00ff00u) | ((texel & 0xffu) << 16) | ((texel >> 16) & 0xffu);
+                    }
+                }
+                break;
+
+            default: Log::warn("Software textures only sample RGBA8 formats"); break;
+        }
+    }
+
+    auto Texture::sample(float32 u, float32 v) const -> math::Vector4f
+    {
+        if (_texels.empty())
+        {
+            return math::Vector4f(0.0f, 0.0f, 0.0f, 1.0f);
+        }
+
+        const auto x     = static_cast<uint32>((u - std::floor(u)) * static_cast<float32>(_width)) % _width;
+        const auto y     = static_cast<uint32>((v - std::floor(v)) * static_cast<float32>(_height)) % _height;
+        const auto texel = _texels[static_cast<usize>(y) * _width + x];
+
+        constexpr auto scale = 1.0f / 255.0f;
+        return math::Vector4f(
+            static_cast<float32>(texel & 0xffu) * scale,
+            static_cast<float32>((texel >> 8) & 0xffu) * scale,
+            static_cast<float32>((texel >> 16) & 0xffu) * scale,
+            static_cast<float32>(texel >> 24) * scale);
+    }
+}
@@ -0,0 +1,45 @@
+/// \file SoftwareBuffer.hpp
+
+#pragma once
+
+#include "SoftwareRHI.hpp"
+
+#include <RHI/Buffer.hpp>
+
+#include <cstddef>
+
+namespace qurb::rhi::software
+{
+    /// \brief A buffer in CPU memory, read directly by the shaders. Draws read it when the render pass executes, at
+    /// `RenderContext::endRenderPass`. Writes are visible as soon as they are made: `unmap` and `flushRange` only check
+    /// the ranges.
+    class QURB_SOFTWARE_RHI_API Buffer final : public rhi::Buffer
+    {
+    public:
+        using base = rhi::Buffer;
+
+    public:
+        explicit Buffer(const BufferDescriptor& descriptor);
+        ~Buffer() override;
+
+    public:
+        using base::map;
+
+        auto map(usize offset, usize size) -> void* override;
+        auto unmap() -> void override;
+        auto flushRange(usize offset, usize size) -> void override;
+
+        [[nodiscard]] auto data() const -> const std::byte*;
+
+    private:
+        std::byte* _data;
+        bool       _mapped;
+        usize      _mappedOffset;
+        usize      _mappedSize;
+    };
+
+    inline auto Buffer::data() const -> const std::byte*
+    {
+        return _data;
+    }
+}
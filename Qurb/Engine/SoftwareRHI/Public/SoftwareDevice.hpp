@@ -0,0 +1,59 @@
+/// \file SoftwareDevice.hpp
+
+#pragma once
+
+#include "SoftwareRHI.hpp"
+#include "SoftwareShader.hpp"
+
+#include <RHI/Device.hpp>
+#include <Threading/JobSystem.hpp>
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+namespace qurb::rhi::software
+{
+    /// \brief A device rendering on the CPU, its render contexts rasterize over the workers of its own job system.
+    ///
+    /// Shader programs take their shader from a library of C++ callables keyed by shader name, which holds
+    /// `Object.Builtin` from the start. Programs naming a shader the library does not know draw in flat magenta.
+    class QURB_SOFTWARE_RHI_API Device final : public rhi::Device
+    {
+    public:
+        using base = rhi::Device;
+
+        static constexpr auto objectShaderName = std::string_view("Object.Builtin");
+
+    public:
+        explicit Device(uint32 workerCount = JobSystem::defaultWorkerCount());
+        ~Device() override = default;
+
+    public:
+        auto createRenderContext(const RenderContextDescriptor& descriptor) -> rhi::RenderContext* override;
+        auto createBuffer(const BufferDescriptor& descriptor) -> rhi::Buffer* override;
+        auto createRenderTarget(const RenderTargetDescriptor& descriptor) -> rhi::RenderTarget* override;
+        auto createSwapChain(const SwapChainDescriptor& descriptor) -> rhi::SwapChain* override;
+        auto createShaderProgram(const ShaderProgramDescriptor& descriptor) -> rhi::ShaderProgram* override;
+        auto createPipelineState(const PipelineStateDescriptor& descriptor) -> rhi::PipelineState* override;
+        auto createTexture(const TextureDescriptor& descriptor) -> rhi::Texture* override;
+
+        /// \brief Adds or replaces the shader named `name`. The programs already created keep their shader.
+        auto registerShader(std::string_view name, Shader shader) -> void;
+
+        [[nodiscard]] auto hasShader(std::string_view name) const -> bool;
+
+        [[nodiscard]] auto jobSystem() -> JobSystem&;
+
+    private:
+        JobSystem                                  _jobSystem;
+        std::map<std::string, Shader, std::less<>> _shaders;
+        mutable std::mutex                         _shadersMutex;
+    };
+
+    inline auto Device::jobSystem() -> JobSystem&
+    {
+        return _jobSystem;
+    }
+}
@@ -0,0 +1,35 @@
+/// \file SoftwarePipelineState.hpp
+
+#pragma once
+
+#include "SoftwareRHI.hpp"
+#include "SoftwareShaderProgram.hpp"
+
+#include <RHI/PipelineState.hpp>
+
+namespace qurb::rhi::software
+{
+    /// \brief The shader program of a pipeline. The rasterizer always depth tests with `Less`, writes depth, does not
+    /// cull and does not blend, the other fields of the descriptor are ignored.
+    class QURB_SOFTWARE_RHI_API PipelineState final : public rhi::PipelineState
+    {
+    public:
+        using base = rhi::PipelineState;
+
+    public:
+        explicit PipelineState(const PipelineStateDescriptor& descriptor);
+        ~PipelineState() override = default;
+
+    public:
+        [[nodiscard]] auto shaderProgram() const -> const ShaderProgram*;
+    };
+
+    inline PipelineState::PipelineState(const PipelineStateDescriptor& descriptor)
+        : base(descriptor)
+    {}
+
+    inline auto PipelineState::shaderProgram() const -> const ShaderProgram*
+    {
+        return static_cast<const ShaderProgram*>(_descriptor.shaderProgram);
+    }
+}
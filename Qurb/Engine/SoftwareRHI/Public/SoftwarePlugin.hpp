@@ -0,0 +1,53 @@
+/// \file SoftwarePlugin.hpp
+
+#pragma once
+
+#include "SoftwareRenderBackend.hpp"
+#include "SoftwareRHI.hpp"
+
+#include <RHI/Plugin.hpp>
+
+namespace qurb::rhi::software
+{
+    /// \brief The `Plugin` class.
+    class QURB_SOFTWARE_RHI_API Plugin final : public rhi::Plugin
+    {
+    public:
+        using base = rhi::Plugin;
+
+    public:
+        explicit Plugin(DynamicLibrary&& library);
+        ~Plugin() override = default;
+
+    public:
+        auto name() const -> std::string_view override;
+        auto description() const -> std::string_view override;
+        auto version() const -> std::string_view override;
+
+        auto createRenderBackend() const -> rhi::RenderBackend* override;
+    };
+
+    inline Plugin::Plugin(DynamicLibrary&& library)
+        : base(std::move(library))
+    {}
+
+    inline auto Plugin::name() const -> std::string_view
+    {
+        return "Qurb Render Hardware Interface - Software";
+    }
+
+    inline auto Plugin::description() const -> std::string_view
+    {
+        return "Rasterizes on the CPU over the job system, into render targets that can be written to disk.";
+    }
+
+    inline auto Plugin::version() const -> std::string_view
+    {
+        return "0.1";
+    }
+
+    inline auto Plugin::createRenderBackend() const -> rhi::RenderBackend*
+    {
+        return new RenderBackend();
+    }
+}
@@ -0,0 +1,9 @@
+/// \file SoftwareRHI.hpp
+
+#pragma once
+
+#ifdef QURB_SOFTWARE_RHI_EXPORT
+    #define QURB_SOFTWARE_RHI_API __attribute__((visibility("default")))
+#else
+    #define QURB_SOFTWARE_RHI_API
+#endif
@@ -0,0 +1,160 @@
+/// \file SoftwareRasterizer.hpp
+
+#pragma once
+
+#include "SoftwareRenderTarget.hpp"
+#include "SoftwareRHI.hpp"
+#include "SoftwareShader.hpp"
+
+#include <Containers/Vector.hpp>
+#include <Renderer/Color.hpp>
+#include <Threading/JobSystem.hpp>
+
+#include <atomic>
+#include <span>
+
+namespace qurb::rhi::software
+{
+    class ShaderProgram;
+
+    /// \brief A draw recorded by a `RenderContext`, with the state bound when it was issued.
+    struct DrawCommand
+    {
+        const ShaderProgram*                           shaderProgram;
+        std::array<const std::byte*, maxVertexBuffers> vertexBuffers;
+        std::array<const Texture*, maxTextures>        textures;
+        uint32                                         constantsOffset;  // Into the push constants of the render pass.
+        uint32                                         constantsSize;
+        uint32                                         vertexCount;
+        uint32                                         firstVertex;
+        uint32                                         instanceCount;
+        uint32                                         firstInstance;
+    };
+
+    /// \brief What the last `Rasterizer::execute` processed.
+    struct RasterizerStatistics
+    {
+        uint64 trianglesSubmitted  = 0;
+        uint64 trianglesRasterized = 0;  // After clipping, and dropping the degenerate and off-screen ones.
+        uint64 binEntries          = 0;  // Triangles times the tiles they overlap.
+        uint64 fragmentsShaded     = 0;  // Fragments passing the depth test.
+    };
+
+    /// \brief Renders the draws of a render pass, in three stages run over a job system.
+    ///
+    /// 1. The vertex shaders run per instance in parallel. Each triangle is clipped against the near plane and set up in
+    ///    screen space into slots fixed by its position in the pass, so that the submission order survives.
+    /// 2. The triangle slots are split in chunks binned in parallel into tiles of `tileSize` pixels, each chunk keeping
+    ///    its own list per tile.
+    /// 3. The tiles are shaded in parallel, each one walking the lists of its chunks in order. Within a tile, the edge
+    ///    functions are evaluated four pixels at a time, with a top-left fill rule so that the triangles sharing an
+    ///    edge cover each pixel once, and the fragments passing the depth test run the fragment shader.
+    ///
+    /// Every pixel is written by one job only and sees its triangles in submission order, so the image does not depend
+    /// on the number of threads. Triangles are drawn as a list, three vertices each.
+    class QURB_SOFTWARE_RHI_API Rasterizer final
+    {
+    public:
+        static constexpr auto tileSize = uint32(64);
+
+    public:
+        explicit Rasterizer(JobSystem& jobSystem);
+
+        Rasterizer(const Rasterizer&)                    = delete;
+        auto operator=(const Rasterizer&) -> Rasterizer& = delete;
+
+    public:
+        /// \brief Clears `renderTarget` to `clearColor` and a depth of one, then draws `draws`.
+        auto execute(
+            RenderTarget& renderTarget, const Color& clearColor, std::span<const DrawCommand> draws, std::span<const std::byte> constants)
+            -> void;
+
+        [[nodiscard]] auto statistics() const -> const RasterizerStatistics&;
+
+    private:
+        /// \brief A clipped triangle in screen space, ready to be rasterized.
+        ///
+        /// The edge functions are `a * x + b * y + c` at the pixel `(x, y)`, positive inside. The depth, `1 / w` and
+        /// the varyings over `w` are stored at the first vertex, with their differences to the second and third ones, and
+        /// interpolated with the edge functions of these two vertices over the area.
+        struct Triangle
+        {
+            std::array<float32, 3>  edgeA;
+            std::array<float32, 3>  edgeB;
+            std::array<float32, 3>  edgeC;
+            std::array<float32, 3>  edgeBias;    // A pixel is inside when every edge function is greater than its bias.
+            std::array<float32, 3>  edgeMargin;  // Bounds the rounding of the edge functions.
+            std::array<float32, 3>  depth;
+            std::array<float32, 3>  inverseW;
+            std::array<Varyings, 3> varyings;
+            float32                 inverseArea;
+            float32                 minDepth;
+            int32                   minX;  // The pixel bounds, inclusive, empty for the slots holding no triangle.
+            int32                   minY;
+            int32                   maxX;
+            int32                   maxY;
+            uint32                  draw;
+
+        public:
+            [[nodiscard]] auto empty() const -> bool { return minX > maxX; }
+        };
+
+        /// \brief A vertex after the vertex shader, in clip space.
+        struct ClipVertex
+        {
+            math::Vector4f position;
+            Varyings       varyings;
+        };
+
+    private:
+        auto processVertices(RenderTarget& renderTarget, std::span<const DrawCommand> draws, std::span<const std::byte> constants)
+            -> void;
+        auto binTriangles(uint32 tileCountX, uint32 tileCountY) -> void;
+        auto shadeTile(RenderTarget& renderTarget, const Color& clearColor, uint32 tile, uint32 tileCountX) -> void;
+
+        /// \brief Clips `triangle` against the near plane and sets up the one or two triangles left at `slot` and
+        /// `slot + 1`, returns how many were kept.
+        auto setupTriangle(const RenderTarget& renderTarget, std::span<const ClipVertex, 3> triangle, uint32 varyingCount, uint32 draw, usize slot)
+            -> uint32;
+
+        /// \brief Rasterizes `triangle` within the tile `[x0, x1) x [y0, y1)`, whose blocks have the farthest depths
+        /// `blockDepths`, and returns the number of fragments shaded.
+        auto rasterize(
+            RenderTarget&      renderTarget,
+            const Triangle&    triangle,
+            const DrawCommand& draw,
+            std::span<float32> blockDepths,
+            int32              x0,
+            int32              y0,
+            int32              x1,
+            int32              y1) -> uint64;
+
+    private:
+        /// \brief The triangle slots binned by one job.
+        static constexpr auto chunkSize = usize(4096);
+
+        /// \brief Tiles are rasterized by blocks of `blockSize` pixels, each keeping its farthest depth.
+        static constexpr auto blockSize     = uint32(8);
+        static constexpr auto blocksPerTile = usize(tileSize / blockSize);
+
+    private:
+        JobSystem*                   _jobSystem;
+        std::span<const DrawCommand> _draws;
+        std::span<const std::byte>   _constants;
+        Vector<usize>                _instanceOffsets;  // Per draw, the instances of the pass before it.
+        Vector<usize>                _triangleOffsets;  // Per draw, the triangles of the pass before it.
+        Vector<Triangle>             _triangles;        // Two slots per triangle of the pass.
+        Vector<Vector<uint32>>       _bins;             // Per chunk, per tile, the slots overlapping the tile.
+        usize                        _tileCount;
+        usize                        _chunkCount;
+        RasterizerStatistics         _statistics;
+        std::atomic<uint64>          _trianglesRasterized;
+        std::atomic<uint64>          _binEntries;
+        std::atomic<uint64>          _fragmentsShaded;
+    };
+
+    inline auto Rasterizer::statistics() const -> const RasterizerStatistics&
+    {
+        return _statistics;
+    }
+}
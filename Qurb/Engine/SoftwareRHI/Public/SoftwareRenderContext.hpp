@@ -0,0 +1,94 @@
+/// \file SoftwareRenderContext.hpp
+
+#pragma once
+
+#include "SoftwareDevice.hpp"
+#include "SoftwareRasterizer.hpp"
+#include "SoftwareRHI.hpp"
+#include "SoftwareSwapChain.hpp"
+
+#include <RHI/RenderContext.hpp>
+
+#include <string>
+
+namespace qurb::rhi::software
+{
+    class PipelineState;
+
+    /// \brief A render context recording the draws of a render pass and rasterizing them at `endRenderPass`.
+    ///
+    /// Buffers are read when the pass executes, like a GPU would read them after submission. When the
+    /// `QURB_SOFTWARE_CAPTURE` environment variable names a file, each presented frame is written to it as a PPM image,
+    /// leaving the last one.
+    class QURB_SOFTWARE_RHI_API RenderContext final : public rhi::RenderContext
+    {
+    public:
+        using base = rhi::RenderContext;
+
+    public:
+        RenderContext(Device* device, const RenderContextDescriptor& descriptor);
+        ~RenderContext() override;
+
+    public:
+        auto swapChain() -> rhi::SwapChain* override;
+
+        auto beginFrame() -> void override;
+        auto endFrame() -> void override;
+
+        auto present() -> void override;
+
+        auto beginRenderPass(rhi::RenderTarget* renderTarget, const RenderPassDescriptor& descriptor) -> void override;
+        auto endRenderPass() -> void override;
+
+        auto pushConstants(const void* data, usize size) -> void override;
+
+        auto bindPipelineState(rhi::PipelineState* pipelineState) -> void override;
+
+        auto bindVertexBuffer(rhi::Buffer* vertexBuffer, uint32 slot, uint32 offset) -> void override;
+
+        auto bindFragmentTexture(rhi::Texture* texture, uint32 slot) -> void override;
+
+        auto draw(uint32 vertexCount, uint32 firstVertex) -> void override;
+
+        auto drawInstanced(uint32 vertexCount, uint32 firstVertex, uint32 instanceCount, uint32 firstInstance) -> void override;
+
+        auto executeCommandLists(std::span<const CommandList> commandLists) -> void override;
+
+        /// \brief What the last render pass processed.
+        [[nodiscard]] auto statistics() const -> const RasterizerStatistics&;
+
+        [[nodiscard]] auto framesPresented() const -> uint64;
+
+    private:
+        Device*                                        _device;
+        SwapChain*                                     _swapChain;
+        Rasterizer                                     _rasterizer;
+        RenderTarget*                                  _renderTarget;  // Of the current render pass.
+        Color                                          _clearColor;
+        Vector<DrawCommand>                            _draws;
+        Vector<std::byte>                              _constants;
+        const PipelineState*                           _pipelineState;
+        std::array<const std::byte*, maxVertexBuffers> _vertexBuffers;
+        std::array<const Texture*, maxTextures>        _textures;
+        uint32                                         _constantsOffset;
+        uint32                                         _constantsSize;
+        uint64                                         _framesPresented;
+        std::string                                    _capturePath;
+        bool                                           _inFrame;
+    };
+
+    inline auto RenderContext::swapChain() -> rhi::SwapChain*
+    {
+        return _swapChain;
+    }
+
+    inline auto RenderContext::statistics() const -> const RasterizerStatistics&
+    {
+        return _rasterizer.statistics();
+    }
+
+    inline auto RenderContext::framesPresented() const -> uint64
+    {
+        return _framesPresented;
+    }
+}
@@ -0,0 +1,92 @@
+/// \file SoftwareRenderTarget.hpp
+
+#pragma once
+
+#include "SoftwareRHI.hpp"
+
+#include <Containers/Vector.hpp>
+#include <RHI/RenderTarget.hpp>
+
+#include <string_view>
+
+namespace qurb::rhi::software
+{
+    /// \brief An 8-bit RGBA color attachment and a 32-bit float depth attachment in CPU memory.
+    ///
+    /// Rows are padded to a multiple of four pixels, so that the rasterizer reads and writes whole groups of four.
+    class QURB_SOFTWARE_RHI_API RenderTarget final : public rhi::RenderTarget
+    {
+    public:
+        using base = rhi::RenderTarget;
+
+        /// \brief The alignment of the rows, in pixels.
+        static constexpr auto rowAlignment = uint32(4);
+
+    public:
+        RenderTarget(uint32 width, uint32 height);
+        ~RenderTarget() override = default;
+
+    public:
+        /// \brief Reallocates the attachments, their contents are undefined until the next render pass.
+        auto resize(uint32 width, uint32 height) -> void;
+
+        [[nodiscard]] auto width() const -> uint32;
+        [[nodiscard]] auto height() const -> uint32;
+
+        /// \brief The distance between two rows, in pixels.
+        [[nodiscard]] auto stride() const -> uint32;
+
+        /// \brief RGBA, red in the lowest byte.
+        [[nodiscard]] auto colors() -> uint32*;
+        [[nodiscard]] auto colors() const -> const uint32*;
+        [[nodiscard]] auto depths() -> float32*;
+
+        [[nodiscard]] auto pixel(uint32 x, uint32 y) const -> uint32;
+
+        /// \brief Writes the color attachment to `path` as a binary PPM image, dropping alpha.
+        /// \return Whether the file could be written.
+        auto save(std::string_view path) const -> bool;
+
+    private:
+        uint32          _width;
+        uint32          _height;
+        uint32          _stride;
+        Vector<uint32>  _colors;
+        Vector<float32> _depths;
+    };
+
+    inline auto RenderTarget::width() const -> uint32
+    {
+        return _width;
+    }
+
+    inline auto RenderTarget::height() const -> uint32
+    {
+        return _height;
+    }
+
+    inline auto RenderTarget::stride() const -> uint32
+    {
+        return _stride;
+    }
+
+    inline auto RenderTarget::colors() -> uint32*
+    {
+        return _colors.data();
+    }
+
+    inline auto RenderTarget::colors() const -> const uint32*
+    {
+        return _colors.data();
+    }
+
+    inline auto RenderTarget::depths() -> float32*
+    {
+        return _depths.data();
+    }
+
+    inline auto RenderTarget::pixel(uint32 x, uint32 y) const -> uint32
+    {
+        return _colors[static_cast<usize>(y) * _stride + x];
+    }
+}
@@ -0,0 +1,110 @@
+/// \file SoftwareShader.hpp
+///
+/// The shaders of the software backend are C++ callables. A `ShaderProgram` looks its shader up by name in the
+/// `Device`, the vertex and fragment function names of its descriptor are ignored.
+
+#pragma once
+
+#include "SoftwareRHI.hpp"
+
+#include <CoreTypes.hpp>
+#include <Math/Vector4.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <span>
+
+namespace qurb::rhi::software
+{
+    class Texture;
+
+    static constexpr auto maxVaryings      = uint32(8);
+    static constexpr auto maxVertexBuffers = uint32(8);
+    static constexpr auto maxTextures      = uint32(8);
+
+    /// \brief The values a vertex shader passes to the fragment shader, interpolated with perspective correction.
+    using Varyings = std::array<float32, maxVaryings>;
+
+    /// \brief What a vertex shader reads: the bound vertex buffers, the push constants of the draw and the indices of the
+    /// vertex and instance being processed.
+    struct VertexInput
+    {
+        std::array<const std::byte*, maxVertexBuffers> buffers;  // Past the offset they were bound at, or null.
+        std::span<const std::byte>                     constants;
+        const uint32*                                  attributeOffsets;  // Within a vertex of slot 0.
+        uint32                                         attributeCount;
+        uint32                                         stride;
+        uint32                                         vertexIndex;
+        uint32                                         instanceIndex;
+
+    public:
+        /// \brief Element `index` of an array of `T` bound at `slot`.
+        template <typename T>
+        [[nodiscard]] auto fetch(uint32 slot, usize index) const -> T;
+
+        /// \brief Attribute `location` of the buffer layout for the current vertex, read from slot 0. Attributes absent
+        /// from the layout read as `T()`.
+        template <typename T>
+        [[nodiscard]] auto attribute(uint32 location) const -> T;
+    };
+
+    /// \brief What a fragment shader reads.
+    struct FragmentInput
+    {
+        Varyings                                       varyings;
+        math::Vector4f                                 position;  // Window coordinates of the pixel center, depth, 1 / w.
+        std::span<const std::byte>                     constants;
+        const std::array<const Texture*, maxTextures>* textures;
+
+    public:
+        [[nodiscard]] auto texture(uint32 slot) const -> const Texture* { return (*textures)[slot]; }
+    };
+
+    /// \brief Returns the clip space position of the vertex and writes its varyings.
+    using VertexFunction = std::function<math::Vector4f(const VertexInput& input, Varyings& varyings)>;
+
+    /// \brief Returns the color of the fragment, each channel in [0, 1].
+    using FragmentFunction = std::function<math::Vector4f(const FragmentInput& input)>;
+
+    /// \brief A vertex and a fragment function, both called from several threads at once.
+    struct Shader
+    {
+        VertexFunction   vertex;
+        FragmentFunction fragment;
+        uint32           varyingCount = 0;  // How many leading varyings are interpolated, at most `maxVaryings`.
+    };
+
+    /// \brief The shader drawing `SceneRenderer` batches: the position and uv attributes of slot 0 are transformed by
+    /// the world matrix of the instance and the view and projection matrices, and colored by their uv.
+    QURB_SOFTWARE_RHI_API auto makeObjectShader() -> Shader;
+
+    /// \brief The object shader transform with a flat magenta color, used for shader names the device does not know.
+    QURB_SOFTWARE_RHI_API auto makeFallbackShader() -> Shader;
+
+    //------------------------------------------------------------------------------------------------------------------
+    // struct VertexInput
+    //------------------------------------------------------------------------------------------------------------------
+
+    template <typename T>
+    auto VertexInput::fetch(uint32 slot, usize index) const -> T
+    {
+        T value;
+        std::memcpy(&value, buffers[slot] + index * sizeof(T), sizeof(T));
+        return value;
+    }
+
+    template <typename T>
+    auto VertexInput::attribute(uint32 location) const -> T
+    {
+        if (location >= attributeCount)
+        {
+            return T();
+        }
+
+        T value;
+        std::memcpy(&value, buffers[0] + static_cast<usize>(vertexIndex) * stride + attributeOffsets[location], sizeof(T));
+        return value;
+    }
+}
@@ -0,0 +1,64 @@
+/// \file SoftwareShaderProgram.hpp
+
+#pragma once
+
+#include "SoftwareRHI.hpp"
+#include "SoftwareShader.hpp"
+
+#include <RHI/ShaderProgram.hpp>
+
+namespace qurb::rhi::software
+{
+    /// \brief A shader of the device library and the offsets of the attributes of its buffer layout.
+    class QURB_SOFTWARE_RHI_API ShaderProgram final : public rhi::ShaderProgram
+    {
+    public:
+        using base = rhi::ShaderProgram;
+
+    public:
+        ShaderProgram(const ShaderProgramDescriptor& descriptor, Shader shader);
+        ~ShaderProgram() override = default;
+
+    public:
+        [[nodiscard]] auto shader() const -> const Shader&;
+
+        /// \brief The offset of each attribute of the buffer layout within a vertex, tightly packed.
+        [[nodiscard]] auto attributeOffsets() const -> const Vector<uint32>&;
+
+        /// \brief The size of a vertex of the buffer layout.
+        [[nodiscard]] auto stride() const -> uint32;
+
+    private:
+        Shader         _shader;
+        Vector<uint32> _attributeOffsets;
+        uint32         _stride;
+    };
+
+    inline ShaderProgram::ShaderProgram(const ShaderProgramDescriptor& descriptor, Shader shader)
+        : base(descriptor)
+        , _shader(std::move(shader))
+        , _attributeOffsets()
+        , _stride(0)
+    {
+        for (const auto& element : descriptor.bufferLayout)
+        {
+            _attributeOffsets.pushBack(_stride);
+            _stride += static_cast<uint32>(shaderDataTypeSize(element.dataType));
+        }
+    }
+
+    inline auto ShaderProgram::shader() const -> const Shader&
+    {
+        return _shader;
+    }
+
+    inline auto ShaderProgram::attributeOffsets() const -> const Vector<uint32>&
+    {
+        return _attributeOffsets;
+    }
+
+    inline auto ShaderProgram::stride() const -> uint32
+    {
+        return _stride;
+    }
+}
@@ -0,0 +1,36 @@
+/// \file SoftwareSwapChain.hpp
+
+#pragma once
+
+#include "SoftwareRenderTarget.hpp"
+#include "SoftwareRHI.hpp"
+
+#include <RHI/SwapChain.hpp>
+
+namespace qurb::rhi::software
+{
+    /// \brief A swap chain handing out the same in-memory render target every frame, resized to follow the window.
+    class QURB_SOFTWARE_RHI_API SwapChain final : public rhi::SwapChain
+    {
+    public:
+        using base = rhi::SwapChain;
+
+    public:
+        explicit SwapChain(const SwapChainDescriptor& descriptor);
+        ~SwapChain() override;
+
+    public:
+        auto nextRenderTarget() -> rhi::RenderTarget* override;
+
+        /// \brief The render target of the last frame.
+        [[nodiscard]] auto renderTarget() const -> const RenderTarget*;
+
+    private:
+        RenderTarget* _renderTarget;
+    };
+
+    inline auto SwapChain::renderTarget() const -> const RenderTarget*
+    {
+        return _renderTarget;
+    }
+}
@@ -0,0 +1,54 @@
+/// \file SoftwareTexture.hpp
+
+#pragma once
+
+#include "SoftwareRHI.hpp"
+
+#include <Containers/Vector.hpp>
+#include <Math/Vector4.hpp>
+#include <RHI/Texture.hpp>
+
+namespace qurb::rhi::software
+{
+    /// \brief A texture of 8-bit RGBA texels in CPU memory, sampled by the fragment shaders.
+    ///
+    /// Only the `RGBA8Unorm`, `RGBA8Srgb` and `BGRA8Unorm` formats keep their data, the others sample as opaque black.
+    class QURB_SOFTWARE_RHI_API Texture final : public rhi::Texture
+    {
+    public:
+        using base = rhi::Texture;
+
+    public:
+        explicit Texture(const TextureDescriptor& descriptor);
+        ~Texture() override = default;
+
+    public:
+        [[nodiscard]] auto width() const -> uint32;
+        [[nodiscard]] auto height() const -> uint32;
+        [[nodiscard]] auto format() const -> TextureFormat;
+
+        /// \brief The nearest texel to `(u, v)`, repeating the texture outside of [0, 1].
+        [[nodiscard]] auto sample(float32 u, float32 v) const -> math::Vector4f;
+
+    private:
+        uint32         _width;
+        uint32         _height;
+        TextureFormat  _format;
+        Vector<uint32> _texels;  // RGBA, red in the lowest byte.
+    };
+
+    inline auto Texture::width() const -> uint32
+    {
+        return _width;
+    }
+
+    inline auto Texture::height() const -> uint32
+    {
+        return _height;
+    }
+
+    inline auto Texture::format() const -> TextureFormat
+    {
+        return _format;
+    }
+}
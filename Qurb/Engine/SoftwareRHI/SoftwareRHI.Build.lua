@@ -0,0 +1,46 @@
+-- Qurb.SoftwareRHI
+
+project "SoftwareRHI"
+    kind "SharedLib"
+    language "C++"
+    cppdialect "C++23"
+
+    targetname "QurbSoftwareRHI"
+    targetdir "%{wks.location}/Binaries/%{cfg.buildcfg}"
+    objdir "%{wks.location}/Binaries/Intermediate/%{cfg.buildcfg}"
+
+    files {
+        "Public/**.cpp",
+        "Public/**.hpp",
+        "Private/**.cpp",
+        "Private/**.hpp",
+    }
+
+    defines {
+        "QURB_SOFTWARE_RHI_EXPORT"
+    }
+
+    links {
+        "Core",
+        "Runtime",
+    }
+
+    includedirs {
+        "Public",
+        "Private",
+
+        include_dirs["Engine.Core"],
+        include_dirs["Engine.Runtime"],
+    }
+
+    filter { "configurations:Debug" }
+        runtime "Debug"
+        optimize "Off"
+        symbols "On"
+    filter {}
+
+    filter { "configurations:Release" }
+        runtime "Release"
+        optimize "On"
+        symbols "Off"
+    filter {}
@@ -1,5 +1,7 @@
 include "Core/Core.Build.lua"
 include "Runtime/Runtime.Build.lua"
+include "NullRHI/NullRHI.Build.lua"
+include "SoftwareRHI/SoftwareRHI.Build.lua"
 
 filter { "system:macosx" }
     include "MetalRHI/MetalRHI.Build.lua"
@@ -0,0 +1,202 @@
+#include "Benchmark.hpp"
+
+#include <Containers/Vector.hpp>
+#include <Math/Batch.hpp>
+#include <Math/Matrix4x4.hpp>
+#include <Math/Simd.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <format>
+#include <random>
+
+namespace qurb::benchmark
+{
+    namespace
+    {
+        using math::Matrix4x4f;
+        using math::QuaternionF;
+        using math::Vector3f;
+        using math::Vector4f;
+
+        /// \brief The same transforms and points, as structures and as one array per component.
+        struct Inputs
+        {
+            Vector<Vector3f>    positions;
+            Vector<QuaternionF> rotations;
+            Vector<Vector3f>    scales;
+            Vector<float32>     streams[10];  // Position, rotation and scale components.
+
+            Vector<Vector4f> points;
+            Vector<float32>  pointStreams[3];
+        };
+
+        auto makeInputs(usize count) -> Inputs
+        {
+            auto random   = std::mt19937(7);
+            auto unit     = std::uniform_real_distribution<float32>(-1.0f, 1.0f);
+            auto angle    = std::uniform_real_distribution<float32>(-180.0f, 180.0f);
+            auto positive = std::uniform_real_distribution<float32>(0.5f, 2.0f);
+
+            auto inputs = Inputs();
+            for (usize i = 0; i < count; ++i)
+            {
+                const auto position = Vector3f(unit(random), unit(random), unit(random)) * 10.0f;
+                const auto rotation = QuaternionF(Vector3f(angle(random), angle(random), angle(random)));
+                const auto scale    = Vector3f(positive(random), positive(random), positive(random));
+                inputs.positions.pushBack(position);
+                inputs.rotations.pushBack(rotation);
+                inputs.scales.pushBack(scale);
+
+                const float32 components[10] = {
+                    position.x, position.y, position.z, rotation.x(), rotation.y(), rotation.z(), rotation.w(), scale.x, scale.y, scale.z,
+                };
+                for (usize component = 0; component < 10; ++component)
+                {
+                    inputs.streams[component].pushBack(components[component]);
+                }
+
+                const auto point = Vector4f(unit(random), unit(random), unit(random), 1.0f) * 100.0f;
+                inputs.points.pushBack(Vector4f(point.x, point.y, point.z, 1.0f));
+                inputs.pointStreams[0].pushBack(point.x);
+                inputs.pointStreams[1].pushBack(point.y);
+                inputs.pointStreams[2].pushBack(point.z);
+            }
+            return inputs;
+        }
+
+        auto transformStreams(const Inputs& inputs) -> math::batch::TransformStreams
+        {
+            auto stream = [&](usize component) {
+                return std::span<const float32>(inputs.streams[component].data(), inputs.streams[component].size());
+            };
+
+            return math::batch::TransformStreams {
+                .positionX = stream(0),
+                .positionY = stream(1),
+                .positionZ = stream(2),
+                .rotationX = stream(3),
+                .rotationY = stream(4),
+                .rotationZ = stream(5),
+                .rotationW = stream(6),
+                .scaleX    = stream(7),
+                .scaleY    = stream(8),
+                .scaleZ    = stream(9),
+            };
+        }
+
+        auto pointStreams(const Inputs& inputs) -> math::batch::PointStreams<const float32>
+        {
+            auto stream = [&](usize axis) {
+                return std::span<const float32>(inputs.pointStreams[axis].data(), inputs.pointStreams[axis].size());
+            };
+            return {.x = stream(0), .y = stream(1), .z = stream(2)};
+        }
+
+        auto pointStreams(Vector<float32> (&streams)[3]) -> math::batch::PointStreams<float32>
+        {
+            auto stream = [&](usize axis) {
+                return std::span<float32>(streams[axis].data(), streams[axis].size());
+            };
+            return {.x = stream(0), .y = stream(1), .z = stream(2)};
+        }
+
+        /// \brief The largest difference between two values, relative to the magnitude of the reference.
+        auto relativeError(float32 actual, float32 expected) -> float32
+        {
+            return std::abs(actual - expected) / std::max(1.0f, std::abs(expected));
+        }
+
+        auto logError(std::string_view name, float32 error, float32 tolerance) -> void
+        {
+            if (error > tolerance)
+            {
+                Log::error("{:<24} max relative error {:.3e} above the {:.0e} tolerance", name, error, tolerance);
+            }
+            else
+            {
+                Log::info("{:<24} max relative error {:.3e}", name, error);
+            }
+        }
+
+        auto runValidation(const Inputs& inputs) -> void
+        {
+            const auto count = inputs.positions.size();
+
+            auto matrices = Vector<Matrix4x4f>(count);
+            math::batch::composeMatrices(transformStreams(inputs), std::span(matrices.data(), count));
+
+            auto composeError = 0.0f;
+            for (usize i = 0; i < count; ++i)
+            {
+                const auto expected = math::transformMatrix(inputs.positions[i], inputs.rotations[i], inputs.scales[i]);
+                for (usize j = 0; j < 16; ++j)
+                {
+                    composeError = std::max(composeError, relativeError(matrices[i].data()[j], expected.data()[j]));
+                }
+            }
+            logError("composeMatrices", composeError, 1e-5f);
+
+            Vector<float32> out[3] = {Vector<float32>(count), Vector<float32>(count), Vector<float32>(count)};
+            math::batch::transformPoints(matrices[0], pointStreams(inputs), pointStreams(out));
+
+            auto pointError = 0.0f;
+            for (usize i = 0; i < count; ++i)
+            {
+                const auto expected = matrices[0] * inputs.points[i];
+                pointError          = std::max(pointError, relativeError(out[0][i], expected.x));
+                pointError          = std::max(pointError, relativeError(out[1][i], expected.y));
+                pointError          = std::max(pointError, relativeError(out[2][i], expected.z));
+            }
+            logError("transformPoints", pointError, 1e-5f);
+        }
+
+        auto runKernelBenchmark(const Inputs& inputs) -> void
+        {
+            const auto count    = inputs.positions.size();
+            auto       matrices = Vector<Matrix4x4f>(count);
+            auto       vectors  = Vector<Vector4f>(count);
+
+            measure(std::format("transformMatrix per element ({} transforms)", count), count, [&] {
+                for (usize i = 0; i < count; ++i)
+                {
+                    matrices[i] = math::transformMatrix(inputs.positions[i], inputs.rotations[i], inputs.scales[i]);
+                }
+                doNotOptimize(matrices.data());
+            });
+
+            const auto streams = transformStreams(inputs);
+            measure(std::format("composeMatrices x{} ({} transforms)", math::batch::width, count), count, [&] {
+                math::batch::composeMatrices(streams, std::span(matrices.data(), count));
+                doNotOptimize(matrices.data());
+            });
+
+            const auto& matrix = matrices[count / 2];
+            measure(std::format("Matrix4x4 * Vector4 per point ({} points)", count), count, [&] {
+                for (usize i = 0; i < count; ++i)
+                {
+                    vectors[i] = matrix * inputs.points[i];
+                }
+                doNotOptimize(vectors.data());
+            });
+
+            Vector<float32> out[3] = {Vector<float32>(count), Vector<float32>(count), Vector<float32>(count)};
+            const auto      points = pointStreams(inputs);
+            const auto      result = pointStreams(out);
+            measure(std::format("transformPoints x{} ({} points)", math::batch::width, count), count, [&] {
+                math::batch::transformPoints(matrix, points, result);
+                doNotOptimize(out[0].data());
+            });
+        }
+    }
+
+    auto runBatchMathBenchmarks() -> void
+    {
+        Log::info("Batch kernels use {}, {} elements per register", math::simd::instructionSet, math::batch::width);
+
+        // An odd count exercises the scalar tail.
+        const auto inputs = makeInputs(100'003);
+        runValidation(inputs);
+        runKernelBenchmark(inputs);
+    }
+}
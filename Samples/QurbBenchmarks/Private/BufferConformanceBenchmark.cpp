@@ -0,0 +1,198 @@
+#include "Benchmark.hpp"
+
+#include <Containers/Vector.hpp>
+#include <NullDevice.hpp>
+#include <Plugins/PluginManager.hpp>
+#include <RHI/Buffer.hpp>
+#include <Renderer/Renderer.hpp>
+
+#include <cstddef>
+#include <cstring>
+#include <format>
+#include <string_view>
+
+namespace qurb::benchmark
+{
+    namespace
+    {
+        /// \brief A backend loaded through the plugin path, without a window: only its device is used.
+        struct Backend
+        {
+            PluginManager pluginManager;
+            Renderer      renderer;
+
+        public:
+            explicit Backend(std::string_view name)
+            {
+                pluginManager.loadPlugins({name});
+                renderer.loadBackend(pluginManager, name);
+            }
+
+            [[nodiscard]] auto device() -> rhi::Device* { return renderer.device(); }
+        };
+
+        constexpr auto bufferSize = usize(4'096);
+
+        auto createBuffer(rhi::Device* device, rhi::BufferUsage usage, const void* initialData = nullptr) -> rhi::Buffer*
+        {
+            return device->createBuffer(
+                rhi::BufferDescriptor {
+                    .initialData = initialData,
+                    .bufferSize  = bufferSize,
+                    .bufferType  = rhi::BufferType::Vertex,
+                    .bufferUsage = usage,
+                });
+        }
+
+        /// \brief Whether `size` bytes at `data` all equal `value`.
+        auto filledWith(const void* data, usize size, std::byte value) -> bool
+        {
+            const auto* bytes = static_cast<const std::byte*>(data);
+            for (usize i = 0; i < size; ++i)
+            {
+                if (bytes[i] != value)
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        /// \brief A dynamic buffer keeps its contents across maps, and a range map writes that range only.
+        auto checkDynamicBuffer(rhi::Device* device) -> bool
+        {
+            constexpr auto offset = usize(1'024);
+            constexpr auto size   = usize(256);
+
+            auto initialData = Vector<std::byte>(bufferSize, std::byte(0x11));
+            auto buffer      = rhi::BufferRef(createBuffer(device, rhi::BufferUsage::Dynamic, initialData.data()));
+
+            auto  passed = true;
+            auto* whole  = buffer->map();
+            passed       = passed and whole != nullptr and filledWith(whole, bufferSize, std::byte(0x11));
+            std::memset(whole, 0x22, bufferSize);
+            buffer->unmap();
+
+            auto* range = buffer->map(offset, size);
+            passed      = passed and range != nullptr and filledWith(range, size, std::byte(0x22));
+            std::memset(range, 0x33, size);
+            buffer->flushRange(offset + size / 2, size / 2);
+            buffer->unmap();
+
+            const auto* bytes = static_cast<const std::byte*>(buffer->map());
+            passed            = passed and filledWith(bytes, offset, std::byte(0x22)) and filledWith(bytes + offset, size, std::byte(0x33));
+            passed            = passed and filledWith(bytes + offset + size, bufferSize - offset - size, std::byte(0x22));
+            buffer->unmap();
+            return passed;
+        }
+
+        /// \brief A persistent buffer maps the same memory every time, without unmapping.
+        auto checkPersistentBuffer(rhi::Device* device) -> bool
+        {
+            auto buffer = rhi::BufferRef(createBuffer(device, rhi::BufferUsage::Persistent));
+
+            auto* whole = static_cast<std::byte*>(buffer->map());
+            std::memset(whole, 0x44, bufferSize);
+            buffer->flushRange(0, bufferSize);
+
+            auto* range = static_cast<std::byte*>(buffer->map(512, 128));
+            std::memset(range, 0x55, 128);
+            buffer->flushRange(512, 128);
+
+            return whole != nullptr and buffer->map() == whole and range == whole + 512 and filledWith(whole, 512, std::byte(0x44)) and
+                   filledWith(whole + 512, 128, std::byte(0x55)) and filledWith(whole + 640, bufferSize - 640, std::byte(0x44));
+        }
+
+        /// \brief An immutable buffer cannot be mapped, which logs a warning.
+        auto checkImmutableBuffer(rhi::Device* device) -> bool
+        {
+            auto initialData = Vector<std::byte>(bufferSize, std::byte(0x66));
+            auto buffer      = rhi::BufferRef(createBuffer(device, rhi::BufferUsage::Immutable, initialData.data()));
+            return buffer->map() == nullptr;
+        }
+
+        auto runConformance(std::string_view backendName) -> void
+        {
+            auto backend = Backend(backendName);
+
+            const auto dynamicBuffer    = checkDynamicBuffer(backend.device());
+            const auto persistentBuffer = checkPersistentBuffer(backend.device());
+            const auto immutableBuffer  = checkImmutableBuffer(backend.device());
+            Log::info(
+                "{} buffers: dynamic {}, persistent {}, immutable {}",
+                backendName,
+                check(dynamicBuffer) ? "ok" : "FAILED",
+                check(persistentBuffer) ? "ok" : "FAILED",
+                check(immutableBuffer) ? "ok" : "FAILED");
+        }
+
+        /// \brief Updates a few bytes of a large dynamic buffer, mapping all of it or the updated range only.
+        auto runRangeUpdateBenchmark(usize updateSize) -> void
+        {
+            constexpr auto bufferSize  = usize(1'024 * 1'024);
+            constexpr auto updateCount = usize(10'000);
+
+            auto  backend = Backend("QurbNullRHI");
+            auto* device  = static_cast<rhi::null::Device*>(backend.device());
+            auto  buffer  = rhi::BufferRef(device->createBuffer(
+                rhi::BufferDescriptor {
+                    .initialData = nullptr,
+                    .bufferSize  = bufferSize,
+                    .bufferType  = rhi::BufferType::Vertex,
+                    .bufferUsage = rhi::BufferUsage::Dynamic,
+                }));
+
+            auto persistentBuffer = rhi::BufferRef(device->createBuffer(
+                rhi::BufferDescriptor {
+                    .initialData = nullptr,
+                    .bufferSize  = bufferSize,
+                    .bufferType  = rhi::BufferType::Vertex,
+                    .bufferUsage = rhi::BufferUsage::Persistent,
+                }));
+
+            auto uploadedPerUpdate = [&](auto&& update) {
+                device->resetStatistics();
+                update();
+                const auto statistics = device->statistics();
+                return statistics.bytesUploaded + statistics.bytesFlushed;
+            };
+
+            const auto whole = uploadedPerUpdate([&] {
+                auto* data = static_cast<std::byte*>(buffer->map());
+                std::memset(data + bufferSize / 2, 0x77, updateSize);
+                buffer->unmap();
+            });
+            const auto range = uploadedPerUpdate([&] {
+                std::memset(buffer->map(bufferSize / 2, updateSize), 0x77, updateSize);
+                buffer->unmap();
+            });
+            const auto flushed = uploadedPerUpdate([&] {
+                std::memset(persistentBuffer->map(bufferSize / 2, updateSize), 0x77, updateSize);
+                persistentBuffer->flushRange(bufferSize / 2, updateSize);
+            });
+
+            measure(std::format("Update {} bytes of {} mapping the range ({} updates)", updateSize, bufferSize, updateCount), updateCount, [&] {
+                for (usize i = 0; i < updateCount; ++i)
+                {
+                    std::memset(buffer->map((i * updateSize) % (bufferSize - updateSize), updateSize), 0x77, updateSize);
+                    buffer->unmap();
+                }
+            });
+            Log::info(
+                "Null RHI bytes uploaded per update of {} bytes: {} mapping the buffer, {} mapping the range, {} flushing a persistent buffer",
+                updateSize,
+                whole,
+                range,
+                flushed);
+        }
+    }
+
+    auto runBufferConformanceBenchmarks() -> void
+    {
+        runConformance("QurbNullRHI");
+        runConformance("QurbSoftwareRHI");
+
+        runRangeUpdateBenchmark(64);
+        runRangeUpdateBenchmark(4'096);
+    }
+}
@@ -0,0 +1,181 @@
+#include "Benchmark.hpp"
+
+#include <Containers/Vector.hpp>
+#include <Math/Vector3.hpp>
+#include <NullDevice.hpp>
+#include <NullRenderContext.hpp>
+#include <Platform/Platform.hpp>
+#include <Platform/Window.hpp>
+#include <Plugins/PluginManager.hpp>
+#include <RHI/CommandList.hpp>
+#include <Renderer/Renderer.hpp>
+#include <Threading/JobSystem.hpp>
+
+#include <format>
+
+namespace qurb::benchmark
+{
+    namespace
+    {
+        /// \brief The null backend loaded through the plugin path, with a headless window and its render context.
+        struct NullBackend
+        {
+            PluginManager pluginManager;
+            Renderer      renderer;
+            Platform      platform;
+            Window        window = Window(WindowDescriptor {.title = "CommandList benchmark", .size = {1280.0f, 720.0f}});
+
+        public:
+            NullBackend()
+            {
+                pluginManager.loadPlugins({"QurbNullRHI"});
+                renderer.loadBackend(pluginManager, "QurbNullRHI");
+                renderer.onWindowCreate(window);
+            }
+
+            [[nodiscard]] auto device() -> rhi::Device* { return renderer.device(); }
+
+            [[nodiscard]] auto renderContext() -> rhi::null::RenderContext*
+            {
+                return static_cast<rhi::null::RenderContext*>(window.renderContext());
+            }
+        };
+
+        /// \brief The pipeline state and vertex buffers the draws bind, created on the null device.
+        struct Resources
+        {
+            rhi::ShaderProgram*  shaderProgram;
+            rhi::PipelineState*  pipelineState;
+            Vector<rhi::Buffer*> vertexBuffers;
+
+        public:
+            Resources(rhi::Device* device, usize meshCount)
+            {
+                auto shaderProgramDescriptor         = rhi::ShaderProgramDescriptor();
+                shaderProgramDescriptor.shaderName   = "Benchmark.CommandList";
+                shaderProgramDescriptor.bufferLayout = {{rhi::ShaderDataType::Float3, "position"}};
+                shaderProgram                        = device->createShaderProgram(shaderProgramDescriptor);
+
+                auto pipelineStateDescriptor          = rhi::PipelineStateDescriptor();
+                pipelineStateDescriptor.shaderProgram = shaderProgram;
+                pipelineState                         = device->createPipelineState(pipelineStateDescriptor);
+
+                const auto vertices = Vector<math::Vector3f>(3, math::Vector3f::one);
+                for (usize i = 0; i < meshCount; ++i)
+                {
+                    vertexBuffers.pushBack(device->createBuffer(
+                        rhi::BufferDescriptor {
+                            .initialData = vertices.data(),
+                            .bufferSize  = vertices.size() * sizeof(math::Vector3f),
+                            .bufferType  = rhi::BufferType::Vertex,
+                            .bufferUsage = rhi::BufferUsage::Immutable,
+                        }));
+                }
+            }
+
+            ~Resources()
+            {
+                for (auto* vertexBuffer : vertexBuffers)
+                {
+                    vertexBuffer->release();
+                }
+                pipelineState->release();
+                shaderProgram->release();
+            }
+        };
+
+        /// \brief The commands of draws `[begin, end)`: each binds a vertex buffer, pushes its index and draws.
+        template <typename Recorder>
+        auto recordDraws(Recorder& recorder, const Resources& resources, usize begin, usize end) -> void
+        {
+            recorder.bindPipelineState(resources.pipelineState);
+            for (auto i = begin; i < end; ++i)
+            {
+                const auto index = static_cast<uint32>(i);
+                recorder.bindVertexBuffer(resources.vertexBuffers[i % resources.vertexBuffers.size()], 0, 0);
+                recorder.pushConstants(&index, sizeof(index));
+                recorder.drawInstanced(3, 0, 1, index);
+            }
+        }
+
+        auto runCommandListBenchmark(NullBackend& backend, JobSystem& jobSystem, usize drawCount, usize listCount) -> void
+        {
+            auto*      renderContext = backend.renderContext();
+            const auto resources     = Resources(backend.device(), 64);
+            auto*      renderTarget  = renderContext->swapChain()->nextRenderTarget();
+
+            auto renderPass = [&](auto&& function) {
+                renderContext->beginFrame();
+                renderContext->beginRenderPass(renderTarget, rhi::RenderPassDescriptor());
+                function();
+                renderContext->endRenderPass();
+                renderContext->endFrame();
+            };
+
+            // Every command through the virtual methods of the render context.
+            auto* context = static_cast<rhi::RenderContext*>(renderContext);
+            renderContext->resetStatistics();
+            measure(std::format("Immediate ({} draws)", drawCount), drawCount, [&] {
+                renderPass([&] { recordDraws(*context, resources, 0, drawCount); });
+            });
+            const auto immediate = renderContext->statistics();
+
+            // Recorded on one thread, then translated by the backend.
+            auto commandList = rhi::CommandList();
+            measure(std::format("Command list record ({} draws)", drawCount), drawCount, [&] {
+                commandList.reset();
+                recordDraws(commandList, resources, 0, drawCount);
+            });
+            measure(std::format("Command list execute ({} draws, {} commands)", drawCount, commandList.commandCount()), drawCount, [&] {
+                renderPass([&] { renderContext->executeCommandLists(std::span(&commandList, 1)); });
+            });
+
+            // Recorded in `listCount` lists on the job system, then submitted in order.
+            auto commandLists = Vector<rhi::CommandList>();
+            for (usize i = 0; i < listCount; ++i)
+            {
+                commandLists.emplaceBack();
+            }
+            const auto drawsPerList = (drawCount + listCount - 1) / listCount;
+
+            renderContext->resetStatistics();
+            measure(
+                std::format("Command lists parallel record and execute ({} draws, {} lists, {} workers)", drawCount, listCount, jobSystem.workerCount()),
+                drawCount,
+                [&] {
+                    jobSystem.parallelFor(listCount, 1, [&](usize begin, usize end) {
+                        for (auto list = begin; list < end; ++list)
+                        {
+                            commandLists[list].reset();
+                            recordDraws(commandLists[list], resources, list * drawsPerList, std::min((list + 1) * drawsPerList, drawCount));
+                        }
+                    });
+                    renderPass([&] { renderContext->executeCommandLists(std::span(commandLists.data(), commandLists.size())); });
+                });
+
+            // Both paths reached the backend with the same commands, per frame.
+            const auto& recorded = renderContext->statistics();
+            const auto  matches  = recorded.drawCalls * immediate.frames == immediate.drawCalls * recorded.frames and
+                                   recorded.vertexBufferBinds * immediate.frames == immediate.vertexBufferBinds * recorded.frames and
+                                   recorded.pushConstantBytes * immediate.frames == immediate.pushConstantBytes * recorded.frames and
+                                   recorded.commandListsExecuted == recorded.frames * listCount;
+            Log::info(
+                "Null RHI per frame: {} draws, {} vertex buffer binds, {} push constant bytes, {} command lists, commands {}",
+                recorded.drawCalls / recorded.frames,
+                recorded.vertexBufferBinds / recorded.frames,
+                recorded.pushConstantBytes / recorded.frames,
+                recorded.commandListsExecuted / recorded.frames,
+                check(matches) ? "match" : "DIFFER");
+        }
+    }
+
+    auto runCommandListBenchmarks() -> void
+    {
+        auto backend   = NullBackend();
+        auto jobSystem = JobSystem();
+
+        const auto listCount = usize(std::max(jobSystem.workerCount(), 1u) * 4);
+        runCommandListBenchmark(backend, jobSystem, 10'000, listCount);
+        runCommandListBenchmark(backend, jobSystem, 100'000, listCount);
+    }
+}
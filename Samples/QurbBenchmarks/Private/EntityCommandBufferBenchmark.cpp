@@ -0,0 +1,113 @@
+#include "Benchmark.hpp"
+
+#include <Containers/Vector.hpp>
+#include <Scene/Components.hpp>
+#include <Scene/Entity.hpp>
+#include <Scene/EntityCommandBuffer.hpp>
+#include <Scene/EntityRegistery.hpp>
+#include <Threading/JobSystem.hpp>
+
+#include <format>
+
+namespace qurb::benchmark
+{
+    namespace
+    {
+        auto storageName(EntityStorageType storageType) -> const char*
+        {
+            return storageType == EntityStorageType::Archetypes ? "archetypes" : "pools";
+        }
+
+        /// \brief Spawns `entityCount` entities with a transform and a mesh, then destroys every other one.
+        auto runSpawnBenchmark(EntityStorageType storageType, usize entityCount) -> void
+        {
+            measure(std::format("spawn direct {} ({} entities)", storageName(storageType), entityCount), entityCount, [&] {
+                auto registery = EntityRegistery(storageType);
+                auto entities  = Vector<EntityId>();
+                for (usize i = 0; i < entityCount; ++i)
+                {
+                    auto entity = registery.createEntity();
+                    entity.addComponent<TransformComponent>();
+                    entity.addComponent<MeshComponent>();
+                    entities.pushBack(entity.id());
+                }
+                for (usize i = 0; i < entityCount; i += 2)
+                {
+                    registery.destroyEntity(entities[i]);
+                }
+                doNotOptimize(registery.entityCount());
+            });
+
+            auto commands = EntityCommandBuffer();
+            measure(std::format("spawn deferred {} ({} entities)", storageName(storageType), entityCount), entityCount, [&] {
+                auto registery = EntityRegistery(storageType);
+                for (usize i = 0; i < entityCount; ++i)
+                {
+                    const auto id = commands.createEntity();
+                    commands.addComponent<TransformComponent>(id);
+                    commands.addComponent<MeshComponent>(id);
+                }
+                commands.playback(registery);
+
+                for (usize i = 0; i < entityCount; i += 2)
+                {
+                    commands.destroyEntity(commands.createdEntities()[i]);
+                }
+                commands.playback(registery);
+                doNotOptimize(registery.entityCount());
+            });
+
+            // Every worker records into its own stream, only playback touches the registery.
+            auto jobSystem = JobSystem();
+            measure(
+                std::format("spawn deferred {} {} workers ({} entities)", storageName(storageType), jobSystem.workerCount(), entityCount),
+                entityCount,
+                [&] {
+                    auto registery = EntityRegistery(storageType);
+                    jobSystem.parallelFor(entityCount, 4096, [&](usize begin, usize end) {
+                        for (auto i = begin; i < end; ++i)
+                        {
+                            const auto id = commands.createEntity();
+                            commands.addComponent<TransformComponent>(id);
+                            commands.addComponent<MeshComponent>(id);
+                        }
+                    });
+                    commands.playback(registery);
+                    doNotOptimize(registery.entityCount());
+                });
+        }
+
+        /// \brief Single spawns played back into an empty registery, then entities added directly: the reserves of the
+        /// playbacks must leave room for the direct adds.
+        auto runSmallPlaybackCheck(EntityStorageType storageType) -> void
+        {
+            auto registery = EntityRegistery(storageType);
+            auto commands  = EntityCommandBuffer();
+            for (usize i = 0; i < 3; ++i)
+            {
+                commands.addComponent<TransformComponent>(commands.createEntity());
+                commands.playback(registery);
+                registery.createEntity().addComponent<TransformComponent>();
+            }
+
+            auto transforms = usize(0);
+            registery.each<TransformComponent>([&](TransformComponent&) { ++transforms; });
+            Log::info(
+                "Single spawn playbacks {}: {} entities, {} transforms, {}",
+                storageName(storageType),
+                registery.entityCount(),
+                transforms,
+                check(registery.entityCount() == 6 and transforms == 6) ? "ok" : "UNEXPECTED");
+        }
+    }
+
+    auto runEntityCommandBufferBenchmarks() -> void
+    {
+        for (const auto storageType : {EntityStorageType::ComponentPools, EntityStorageType::Archetypes})
+        {
+            runSmallPlaybackCheck(storageType);
+            runSpawnBenchmark(storageType, 100'000);
+            runSpawnBenchmark(storageType, 1'000'000);
+        }
+    }
+}
@@ -0,0 +1,295 @@
+#include "Benchmark.hpp"
+
+#include <Containers/Vector.hpp>
+#include <Scene/Components.hpp>
+#include <Scene/Entity.hpp>
+#include <Scene/EntityRegistery.hpp>
+#include <Scene/Scene.hpp>
+
+#include <format>
+#include <random>
+#include <unordered_set>
+#include <vector>
+
+namespace qurb::benchmark
+{
+    namespace
+    {
+        /// \brief The per-entity `std::vector<bool>` mask the registery used before signatures, kept as a baseline.
+        class VectorMaskRegistery
+        {
+        public:
+            auto createEntity() -> EntityId
+            {
+                _masks.emplaceBack();
+                return _masks.size() - 1;
+            }
+
+            auto addComponent(EntityId id, usize componentId) -> void
+            {
+                if (componentId >= _masks[id].size())
+                {
+                    _masks[id].resize(componentId + 1, false);
+                }
+                _masks[id][componentId] = true;
+            }
+
+            auto hasComponent(EntityId id, usize componentId) -> bool
+            {
+                auto& mask = _masks[id];
+                if (componentId >= mask.size())
+                {
+                    mask.resize(componentId + 1, false);
+                }
+                return mask[componentId];
+            }
+
+        private:
+            Vector<std::vector<bool>> _masks;
+        };
+
+        /// \brief The `std::unordered_set` free list the registery used before generational handles, kept as a baseline.
+        class UnorderedSetFreeList
+        {
+        public:
+            auto createEntity() -> EntityId
+            {
+                if (_freeEntities.empty())
+                {
+                    return _entityCount++;
+                }
+
+                const auto id = *_freeEntities.begin();
+                _freeEntities.erase(id);
+                return id;
+            }
+
+            auto destroyEntity(EntityId id) -> void { _freeEntities.insert(id); }
+
+        private:
+            std::unordered_set<EntityId> _freeEntities;
+            EntityId                     _entityCount = 0;
+        };
+
+        constexpr usize transformId = 0;
+        constexpr usize meshId      = 1;
+        constexpr usize materialId  = 2;
+
+        auto runQueryBenchmark(usize entityCount) -> void
+        {
+            auto random       = std::mt19937(42);
+            auto distribution = std::uniform_int_distribution<uint32>(0, 3);
+
+            auto baseline  = VectorMaskRegistery();
+            auto registery = EntityRegistery();
+
+            // Create every entity up front so that component pools are sized once.
+            auto entities = Vector<Entity>();
+            entities.reserve(entityCount);
+            for (usize i = 0; i < entityCount; ++i)
+            {
+                baseline.createEntity();
+                entities.pushBack(registery.createEntity());
+            }
+
+            for (usize i = 0; i < entityCount; ++i)
+            {
+                const auto baselineId = static_cast<EntityId>(i);
+                auto&      entity     = entities[i];
+
+                baseline.addComponent(baselineId, transformId);
+                entity.addComponent<TransformComponent>();
+
+                // Roughly half of the entities are renderable, a quarter only have a mesh.
+                const auto kind = distribution(random);
+                if (kind >= 1)
+                {
+                    baseline.addComponent(baselineId, meshId);
+                    entity.addComponent<MeshComponent>();
+                }
+                if (kind >= 2)
+                {
+                    baseline.addComponent(baselineId, materialId);
+                    entity.addComponent<MaterialComponent>();
+                }
+            }
+
+            measure(std::format("hasComponents<3> vector<bool> mask ({} entities)", entityCount), entityCount, [&] {
+                usize matches = 0;
+                for (EntityId id = 0; id < entityCount; ++id)
+                {
+                    matches += baseline.hasComponent(id, transformId) and baseline.hasComponent(id, meshId) and baseline.hasComponent(id, materialId);
+                }
+                doNotOptimize(matches);
+            });
+
+            measure(std::format("hasComponents<3> signature ({} entities)", entityCount), entityCount, [&] {
+                usize matches = 0;
+                for (EntityId id = 0; id < entityCount; ++id)
+                {
+                    matches += registery.hasComponents<TransformComponent, MeshComponent, MaterialComponent>(id);
+                }
+                doNotOptimize(matches);
+            });
+        }
+
+        auto runComponentPoolBenchmark(usize entityCount) -> void
+        {
+            auto registery = EntityRegistery();
+            auto entities  = Vector<Entity>();
+            entities.reserve(entityCount);
+            for (usize i = 0; i < entityCount; ++i)
+            {
+                entities.pushBack(registery.createEntity());
+            }
+
+            // One entity in sixteen owns a transform, the pool must only walk those.
+            for (usize i = 0; i < entityCount; i += 16)
+            {
+                entities[i].addComponent<TransformComponent>();
+            }
+
+            measure(std::format("ComponentPool iterate 1/16 live ({} entities)", entityCount), entityCount / 16, [&] {
+                for (auto& transformComponent : registery.componentPool<TransformComponent>())
+                {
+                    transformComponent.rotate({0.0f, 0.0f, 1.0f});
+                }
+                doNotOptimize(registery.componentPool<TransformComponent>().components().data());
+            });
+
+            measure(std::format("ComponentPool add/remove churn ({} entities)", entityCount), 2 * entityCount, [&] {
+                for (auto& entity : entities)
+                {
+                    entity.addComponent<MeshComponent>();
+                }
+                for (auto& entity : entities)
+                {
+                    entity.removeComponent<MeshComponent>();
+                }
+            });
+
+            // A single rare component on the last entity should only cost one sparse page.
+            entities.back().addComponent<CameraComponent>();
+            Log::info(
+                "ComponentPool memory: camera pool {} KiB, registery {} KiB ({} entities)",
+                registery.componentPool<CameraComponent>().memoryUsage() / 1024,
+                registery.memoryUsage() / 1024,
+                entityCount);
+        }
+
+        /// \brief Keeps `liveCount` entities alive while destroying and spawning one at a time, like a particle system.
+        auto runSpawnBenchmark(usize liveCount) -> void
+        {
+            constexpr usize operations = 1'000'000;
+
+            auto random  = std::mt19937(42);
+            auto victims = Vector<usize>();
+            victims.reserve(operations);
+            for (usize i = 0; i < operations; ++i)
+            {
+                victims.pushBack(random() % liveCount);
+            }
+
+            auto baseline = UnorderedSetFreeList();
+            auto handles  = Vector<EntityId>();
+            for (usize i = 0; i < liveCount; ++i)
+            {
+                handles.pushBack(baseline.createEntity());
+            }
+
+            measure(std::format("spawn/despawn unordered_set free list ({} live)", liveCount), operations, [&] {
+                for (const auto victim : victims)
+                {
+                    baseline.destroyEntity(handles[victim]);
+                    handles[victim] = baseline.createEntity();
+                }
+            });
+
+            auto bare = EntityRegistery();
+            handles.clear();
+            for (usize i = 0; i < liveCount; ++i)
+            {
+                handles.pushBack(bare.createEntity().id());
+            }
+
+            measure(std::format("spawn/despawn generational free list ({} live)", liveCount), operations, [&] {
+                for (const auto victim : victims)
+                {
+                    bare.destroyEntity(handles[victim]);
+                    handles[victim] = bare.createEntity().id();
+                }
+            });
+
+            auto registery = EntityRegistery();
+            handles.clear();
+            for (usize i = 0; i < liveCount; ++i)
+            {
+                auto entity = registery.createEntity();
+                entity.addComponent<TransformComponent>();
+                handles.pushBack(entity.id());
+            }
+
+            measure(std::format("spawn/despawn generational + Transform ({} live)", liveCount), operations, [&] {
+                for (const auto victim : victims)
+                {
+                    registery.destroyEntity(handles[victim]);
+                    auto entity = registery.createEntity();
+                    entity.addComponent<TransformComponent>();
+                    handles[victim] = entity.id();
+                }
+            });
+
+            // The scene also lists its entities, a despawn must not search that list.
+            auto scene = Scene();
+            handles.clear();
+            for (usize i = 0; i < liveCount; ++i)
+            {
+                handles.pushBack(scene.createEntity().id());
+            }
+
+            measure(std::format("spawn/despawn Scene entities ({} live)", liveCount), operations, [&] {
+                for (const auto victim : victims)
+                {
+                    scene.destroyEntity(Entity(scene.registery(), handles[victim]));
+                    handles[victim] = scene.createEntity().id();
+                }
+            });
+
+            auto listed = scene.entities().size() == liveCount;
+            for (const auto& entity : scene.entities())
+            {
+                listed = listed and entity.isAlive();
+            }
+            Log::info("Scene entity list after {} spawn/despawn: {} entities, {}", operations, scene.entities().size(), check(listed) ? "ok" : "UNEXPECTED");
+
+            // Every other handle was destroyed once, half of them are stale.
+            auto stale = Vector<EntityId>();
+            for (usize i = 0; i < liveCount; ++i)
+            {
+                stale.pushBack(i % 2 == 0 ? handles[i] : makeEntityId(entityIndex(handles[i]), entityGeneration(handles[i]) + 1));
+            }
+
+            measure(std::format("isAlive stale-handle check ({} handles)", liveCount), liveCount, [&] {
+                usize alive = 0;
+                for (const auto id : stale)
+                {
+                    alive += registery.isAlive(id);
+                }
+                doNotOptimize(alive);
+            });
+        }
+    }
+
+    auto runEntityRegisteryBenchmarks() -> void
+    {
+        runQueryBenchmark(10'000);
+        runQueryBenchmark(100'000);
+        runQueryBenchmark(1'000'000);
+
+        runComponentPoolBenchmark(100'000);
+        runComponentPoolBenchmark(1'000'000);
+
+        runSpawnBenchmark(10'000);
+        runSpawnBenchmark(100'000);
+    }
+}
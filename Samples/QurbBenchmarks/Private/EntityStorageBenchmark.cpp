@@ -0,0 +1,149 @@
+#include "Benchmark.hpp"
+
+#include <Containers/Vector.hpp>
+#include <Scene/Components.hpp>
+#include <Scene/Entity.hpp>
+#include <Scene/EntityRegistery.hpp>
+
+#include <format>
+#include <random>
+#include <string_view>
+
+namespace qurb::benchmark
+{
+    namespace
+    {
+        auto storageName(EntityStorageType storageType) -> std::string_view
+        {
+            return storageType == EntityStorageType::Archetypes ? "archetypes" : "pools";
+        }
+
+        /// \brief Fills `registery` with `entityCount` entities, all with a transform and three quarters renderable.
+        auto populate(EntityRegistery& registery, usize entityCount) -> Vector<Entity>
+        {
+            auto random       = std::mt19937(42);
+            auto distribution = std::uniform_int_distribution<uint32>(0, 3);
+
+            auto entities = Vector<Entity>();
+            entities.reserve(entityCount);
+            for (usize i = 0; i < entityCount; ++i)
+            {
+                entities.pushBack(registery.createEntity());
+            }
+
+            for (auto& entity : entities)
+            {
+                entity.addComponent<TransformComponent>();
+
+                const auto kind = distribution(random);
+                if (kind >= 1)
+                {
+                    entity.addComponent<MeshComponent>();
+                }
+                if (kind >= 2)
+                {
+                    entity.addComponent<MaterialComponent>();
+                }
+            }
+
+            return entities;
+        }
+
+        auto runStorageBenchmark(EntityStorageType storageType, usize entityCount) -> void
+        {
+            const auto name = storageName(storageType);
+
+            auto registery = EntityRegistery(storageType);
+            auto entities  = populate(registery, entityCount);
+
+            measure(std::format("each<Transform> {} ({} entities)", name, entityCount), entityCount, [&] {
+                registery.each<TransformComponent>([](TransformComponent& transformComponent) {
+                    transformComponent.rotate({0.0f, 0.0f, 1.0f});
+                });
+            });
+
+            // About half of the entities match, the pools have to probe the signature of every mesh owner.
+            measure(std::format("each<Transform, Mesh, Material> {} ({} entities)", name, entityCount), entityCount, [&] {
+                usize matches = 0;
+                registery.each<TransformComponent, MeshComponent, MaterialComponent>(
+                    [&](TransformComponent& transformComponent, MeshComponent&, MaterialComponent&) {
+                        transformComponent.translate({1.0f, 0.0f, 0.0f});
+                        ++matches;
+                    });
+                doNotOptimize(matches);
+            });
+
+            measure(std::format("add/remove Camera churn {} ({} entities)", name, entityCount), 2 * entityCount, [&] {
+                for (auto& entity : entities)
+                {
+                    entity.addComponent<CameraComponent>();
+                }
+                for (auto& entity : entities)
+                {
+                    entity.removeComponent<CameraComponent>();
+                }
+            });
+
+            Log::info("Memory {}: {} KiB ({} entities)", name, registery.memoryUsage() / 1024, entityCount);
+        }
+
+        /// \brief Compares the per-entity `hasComponents`/`getComponents` loop systems used to write with a view.
+        auto runViewBenchmark(EntityStorageType storageType, usize entityCount) -> void
+        {
+            const auto name = storageName(storageType);
+
+            auto registery = EntityRegistery(storageType);
+            auto entities  = populate(registery, entityCount);
+
+            measure(std::format("per-entity getComponents<3> {} ({} entities)", name, entityCount), entityCount, [&] {
+                for (auto& entity : entities)
+                {
+                    if (entity.hasComponents<TransformComponent, MeshComponent, MaterialComponent>())
+                    {
+                        auto [transformComponent, meshComponent, materialComponent] =
+                            entity.getComponents<TransformComponent, MeshComponent, MaterialComponent>();
+                        transformComponent.translate({1.0f, 0.0f, 0.0f});
+                    }
+                }
+            });
+
+            measure(std::format("view<3> range-for {} ({} entities)", name, entityCount), entityCount, [&] {
+                for (auto [transformComponent, meshComponent, materialComponent] : registery.view<TransformComponent, MeshComponent, MaterialComponent>())
+                {
+                    transformComponent.translate({1.0f, 0.0f, 0.0f});
+                }
+            });
+
+            // Excluding a component must leave out exactly its owners, single component views included.
+            auto withoutMesh     = usize(0);
+            auto withoutMaterial = usize(0);
+            for (auto& entity : entities)
+            {
+                withoutMesh += not entity.hasComponent<MeshComponent>();
+                withoutMaterial += entity.hasComponent<MeshComponent>() and not entity.hasComponent<MaterialComponent>();
+            }
+            auto excludedMesh     = usize(0);
+            auto excludedMaterial = usize(0);
+            registery.view<TransformComponent>().exclude<MeshComponent>().each([&](TransformComponent&) { ++excludedMesh; });
+            registery.view<TransformComponent, MeshComponent>().exclude<MaterialComponent>().each([&](TransformComponent&, MeshComponent&) {
+                ++excludedMaterial;
+            });
+            Log::info("View exclude {}: {}", name, check(excludedMesh == withoutMesh and excludedMaterial == withoutMaterial) ? "ok" : "UNEXPECTED");
+        }
+    }
+
+    auto runEntityStorageBenchmarks() -> void
+    {
+        for (const auto entityCount : {usize(10'000), usize(100'000), usize(1'000'000)})
+        {
+            runStorageBenchmark(EntityStorageType::ComponentPools, entityCount);
+            runStorageBenchmark(EntityStorageType::Archetypes, entityCount);
+        }
+
+        for (const auto entityCount : {usize(10'000), usize(1'000'000)})
+        {
+            runViewBenchmark(EntityStorageType::ComponentPools, entityCount);
+            runViewBenchmark(EntityStorageType::Archetypes, entityCount);
+        }
+    }
+}
@@ -0,0 +1,144 @@
+#include "Benchmark.hpp"
+
+#include <Containers/Vector.hpp>
+#include <Math/Matrix4x4.hpp>
+#include <Plugins/PluginManager.hpp>
+#include <RHI/FrameAllocator.hpp>
+#include <Renderer/Renderer.hpp>
+#include <Threading/JobSystem.hpp>
+
+#include <algorithm>
+#include <format>
+
+namespace qurb::benchmark
+{
+    namespace
+    {
+        /// \brief The null backend loaded through the plugin path, without a window: only its device is used.
+        struct NullBackend
+        {
+            PluginManager pluginManager;
+            Renderer      renderer;
+
+        public:
+            NullBackend()
+            {
+                pluginManager.loadPlugins({"QurbNullRHI"});
+                renderer.loadBackend(pluginManager, "QurbNullRHI");
+            }
+
+            [[nodiscard]] auto device() -> rhi::Device* { return renderer.device(); }
+        };
+
+        /// \brief Per-draw constants: a world matrix and a color, the size of a typical push of a material.
+        struct DrawConstants
+        {
+            math::Matrix4x4f world;
+            float32          color[4];
+        };
+
+        auto runAllocationBenchmark(rhi::Device* device, JobSystem& jobSystem, usize allocationCount) -> void
+        {
+            constexpr auto alignment = alignof(DrawConstants);
+
+            auto allocator = rhi::FrameAllocator(device, 3, allocationCount * sizeof(DrawConstants));
+            auto constants = DrawConstants {math::Matrix4x4f::identity, {1.0f, 0.5f, 0.25f, 1.0f}};
+
+            // What the renderer did before for each update: map, write and unmap a dynamic buffer.
+            auto* dynamicBuffer = device->createBuffer(
+                rhi::BufferDescriptor {
+                    .initialData = nullptr,
+                    .bufferSize  = sizeof(DrawConstants),
+                    .bufferType  = rhi::BufferType::Vertex,
+                    .bufferUsage = rhi::BufferUsage::Dynamic,
+                });
+            measure(std::format("Dynamic buffer map/unmap ({} updates)", allocationCount), allocationCount, [&] {
+                for (usize i = 0; i < allocationCount; ++i)
+                {
+                    *dynamicBuffer->map<DrawConstants>() = constants;
+                    dynamicBuffer->unmap();
+                }
+            });
+            dynamicBuffer->release();
+
+            measure(std::format("Frame allocator ({} allocations)", allocationCount), allocationCount, [&] {
+                allocator.beginFrame();
+                for (usize i = 0; i < allocationCount; ++i)
+                {
+                    const auto allocation           = allocator.allocate(sizeof(DrawConstants), alignment);
+                    *allocation.as<DrawConstants>() = constants;
+                    doNotOptimize(allocation.offset);
+                }
+            });
+
+            // Every thread writes the index of its allocations into them, no write may land in another's.
+            auto offsets = Vector<usize>(allocationCount, 0);
+            measure(
+                std::format("Frame allocator parallel ({} allocations, {} workers)", allocationCount, jobSystem.workerCount()),
+                allocationCount,
+                [&] {
+                    allocator.beginFrame();
+                    jobSystem.parallelFor(allocationCount, 4'096, [&](usize begin, usize end) {
+                        for (auto i = begin; i < end; ++i)
+                        {
+                            const auto allocation                    = allocator.allocate(sizeof(DrawConstants), alignment);
+                            allocation.as<DrawConstants>()->color[0] = static_cast<float32>(i);
+                            offsets[i]                               = allocation.offset;
+                        }
+                    });
+                });
+
+            auto* data     = static_cast<const std::byte*>(allocator.buffer()->map());
+            auto  disjoint = allocator.bytesAllocated() == allocationCount * sizeof(DrawConstants);
+            for (usize i = 0; i < allocationCount; ++i)
+            {
+                const auto* written = reinterpret_cast<const DrawConstants*>(data + offsets[i]);
+                disjoint            = disjoint and offsets[i] % alignment == 0 and written->color[0] == static_cast<float32>(i);
+            }
+            Log::info(
+                "Frame allocator: {} bytes allocated in a frame of {}, allocations {}",
+                allocator.bytesAllocated(),
+                allocator.frameSize(),
+                check(disjoint) ? "disjoint" : "OVERLAP");
+        }
+
+        /// \brief The regions rotate with the frames, a full region refuses allocations and growing keeps them apart.
+        auto runRotationCheck(rhi::Device* device) -> void
+        {
+            auto allocator = rhi::FrameAllocator(device, 3, 1024);
+
+            auto rotates = true;
+            for (uint64 frame = 1; frame <= 6; ++frame)
+            {
+                allocator.beginFrame();
+                const auto allocation = allocator.allocate(16);
+                rotates               = rotates and allocation and allocation.offset == (frame % 3) * allocator.frameSize();
+            }
+
+            allocator.beginFrame();
+            const auto  full   = allocator.allocate(allocator.frameSize() + 1);
+            const auto* before = allocator.buffer();
+
+            allocator.beginFrame(4096);
+            const auto grown = allocator.allocate(4096, 16);
+
+            Log::info(
+                "Frame allocator: regions {}, oversized allocation {}, grown to {} bytes a frame, {}",
+                rotates ? "rotate" : "DO NOT ROTATE",
+                full ? "ACCEPTED" : "refused",
+                allocator.frameSize(),
+                check(rotates and not full and grown and allocator.buffer() != before) ? "ok" : "UNEXPECTED");
+        }
+    }
+
+    auto runFrameAllocatorBenchmarks() -> void
+    {
+        // Two workers at least, so that the allocations contend even on a single core.
+        auto backend   = NullBackend();
+        auto jobSystem = JobSystem(std::max(JobSystem::defaultWorkerCount(), 2u));
+
+        runAllocationBenchmark(backend.device(), jobSystem, 10'000);
+        runAllocationBenchmark(backend.device(), jobSystem, 100'000);
+        runRotationCheck(backend.device());
+    }
+}
@@ -0,0 +1,138 @@
+#include "Benchmark.hpp"
+
+#include <Core/FramePipeline.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <thread>
+
+namespace qurb::benchmark
+{
+    namespace
+    {
+        using Clock    = std::chrono::steady_clock;
+        using Duration = std::chrono::duration<float64, std::milli>;
+
+        /// \brief A fixed amount of arithmetic, so that two stages sharing a core take longer instead of overlapping.
+        auto work(uint64 iterations) -> void
+        {
+            auto value = 1.0f;
+            for (uint64 i = 0; i < iterations; ++i)
+            {
+                value = std::sqrt(value + 1.0f);
+            }
+            doNotOptimize(value);
+        }
+
+        /// \brief The iterations of `work` taking one millisecond on an idle core.
+        auto iterationsPerMillisecond() -> uint64
+        {
+            constexpr auto iterations = uint64(1'000'000);
+
+            auto best = 0.0;
+            for (uint32 i = 0; i < 5; ++i)
+            {
+                const auto start = Clock::now();
+                work(iterations);
+                const auto elapsed = Duration(Clock::now() - start).count();
+                best               = i == 0 ? elapsed : std::min(best, elapsed);
+            }
+            return static_cast<uint64>(static_cast<float64>(iterations) / best);
+        }
+
+        /// \brief Keeps the calling thread busy for about `milliseconds`, like simulation or command recording.
+        auto spin(float64 milliseconds) -> void
+        {
+            static const auto rate = iterationsPerMillisecond();
+            work(static_cast<uint64>(milliseconds * static_cast<float64>(rate)));
+        }
+
+        /// \brief A frame costing `updateMilliseconds` of simulation, then `recordMilliseconds` of command recording and
+        /// `gpuWaitMilliseconds` blocked on the GPU, like the frame boundary semaphore of the render context.
+        struct Workload
+        {
+            float64 updateMilliseconds;
+            float64 recordMilliseconds;
+            float64 gpuWaitMilliseconds;
+        };
+
+        auto renderStage(const Workload& workload) -> void
+        {
+            spin(workload.recordMilliseconds);
+            std::this_thread::sleep_for(Duration(workload.gpuWaitMilliseconds));
+        }
+
+        /// \brief Runs `frameCount` frames the way `Engine::runFrame` does and logs the frame statistics.
+        auto runFrames(const FrameLoopDescriptor& descriptor, const Workload& workload, uint32 frameCount) -> void
+        {
+            auto framePipeline = std::unique_ptr<FramePipeline>();
+            if (descriptor.mode == FrameLoopMode::Pipelined)
+            {
+                framePipeline = std::make_unique<FramePipeline>(descriptor.slotCount(), [&](uint32) { renderStage(workload); });
+            }
+
+            auto statistics = FrameStatistics();
+            auto frameStart = Clock::now();
+            for (uint32 frame = 0; frame < frameCount; ++frame)
+            {
+                auto timings = FrameTimings();
+
+                auto       slot  = uint32(0);
+                const auto start = Clock::now();
+                if (framePipeline != nullptr)
+                {
+                    slot           = framePipeline->acquireSlot();
+                    timings.render = framePipeline->renderMilliseconds(slot);
+                }
+                const auto acquired = Clock::now();
+
+                spin(workload.updateMilliseconds);
+                const auto updated = Clock::now();
+
+                if (framePipeline != nullptr)
+                {
+                    framePipeline->submit(slot);
+                }
+                else
+                {
+                    renderStage(workload);
+                    timings.render = Duration(Clock::now() - updated).count();
+                }
+
+                const auto frameEnd = Clock::now();
+                timings.frame       = Duration(frameEnd - frameStart).count();
+                timings.wait        = Duration(acquired - start).count();
+                timings.update      = Duration(updated - acquired).count();
+                frameStart          = frameEnd;
+
+                // The first frames fill the pipeline.
+                if (frame >= descriptor.slotCount())
+                {
+                    statistics.addFrame(timings);
+                }
+            }
+
+            statistics.log(descriptor);
+        }
+    }
+
+    auto runFramePipelineBenchmarks() -> void
+    {
+        // With a single hardware thread the spinning stages cannot overlap, only the GPU wait is hidden.
+        constexpr auto frameCount = uint32(120);
+        for (const auto& workload : {Workload {4.0, 2.0, 6.0}, Workload {6.0, 6.0, 2.0}})
+        {
+            Log::info(
+                "Update {:.0f} ms, record {:.0f} ms, GPU wait {:.0f} ms per frame",
+                workload.updateMilliseconds,
+                workload.recordMilliseconds,
+                workload.gpuWaitMilliseconds);
+
+            runFrames({.mode = FrameLoopMode::Serial}, workload, frameCount);
+            runFrames({.mode = FrameLoopMode::Pipelined, .framesInFlight = 2}, workload, frameCount);
+            runFrames({.mode = FrameLoopMode::Pipelined, .framesInFlight = 3}, workload, frameCount);
+        }
+    }
+}
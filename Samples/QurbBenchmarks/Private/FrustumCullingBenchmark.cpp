@@ -0,0 +1,191 @@
+#include "Benchmark.hpp"
+
+#include <Containers/Vector.hpp>
+#include <Math/Batch.hpp>
+#include <Math/Frustum.hpp>
+#include <Scene/Components.hpp>
+#include <Scene/RenderExtractor.hpp>
+#include <Scene/RenderPacket.hpp>
+#include <Scene/Scene.hpp>
+#include <Threading/JobSystem.hpp>
+
+#include <cmath>
+#include <format>
+#include <random>
+
+namespace qurb::benchmark
+{
+    namespace
+    {
+        /// \brief A camera at the origin looking down +z, seeing about a sixth of a cube centered on it.
+        auto cameraFrustum() -> math::Frustum
+        {
+            return math::makeFrustum(makePerspective(1.0f, 16.0f / 9.0f, 0.1f, 150.0f));
+        }
+
+        /// \brief Random boxes in `[-100, 100]`, with half extents up to 4.
+        struct Boxes
+        {
+            Vector<float32> streams[6];
+
+        public:
+            explicit Boxes(usize count)
+            {
+                auto random   = std::mt19937(7);
+                auto position = std::uniform_real_distribution<float32>(-100.0f, 100.0f);
+                auto extent   = std::uniform_real_distribution<float32>(0.0f, 4.0f);
+                for (usize s = 0; s < 6; ++s)
+                {
+                    streams[s].resize(count);
+                    for (auto& value : streams[s])
+                    {
+                        value = s < 3 ? position(random) : extent(random);
+                    }
+                }
+            }
+
+            [[nodiscard]] auto view() const -> math::batch::BoxStreams<const float32>
+            {
+                return math::batch::BoxStreams<const float32> {
+                    .centerX = streams[0],
+                    .centerY = streams[1],
+                    .centerZ = streams[2],
+                    .extentX = streams[3],
+                    .extentY = streams[4],
+                    .extentZ = streams[5],
+                };
+            }
+        };
+
+        /// \brief One box at a time, the reference the batch kernel is checked against.
+        auto cullBoxScalar(const math::Frustum& frustum, const math::batch::BoxStreams<const float32>& boxes, usize i) -> bool
+        {
+            for (const auto& plane : frustum.planes)
+            {
+                const auto distance = plane.x * boxes.centerX[i] + plane.y * boxes.centerY[i] + plane.z * boxes.centerZ[i] + plane.w;
+                const auto radius   = std::abs(plane.x) * boxes.extentX[i] + std::abs(plane.y) * boxes.extentY[i] + std::abs(plane.z) * boxes.extentZ[i];
+                if (distance + radius < 0.0f)
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        auto runKernelBenchmark(usize boxCount) -> void
+        {
+            const auto frustum = cameraFrustum();
+            const auto boxes   = Boxes(boxCount);
+            auto       visible = Vector<uint8>(boxCount);
+
+            math::batch::cullBoxes(frustum, boxes.view(), visible);
+
+            // Fused multiply adds may round differently, only boxes touching a plane could disagree.
+            usize visibleCount = 0;
+            usize mismatches   = 0;
+            for (usize i = 0; i < boxCount; ++i)
+            {
+                visibleCount += visible[i];
+                mismatches += (visible[i] != 0) != cullBoxScalar(frustum, boxes.view(), i);
+            }
+            Log::info(
+                "cullBoxes {} boxes, {} visible, {} culled, {} mismatches against the scalar test ({} lanes), {}",
+                boxCount,
+                visibleCount,
+                boxCount - visibleCount,
+                mismatches,
+                math::batch::width,
+                check(mismatches == 0) ? "ok" : "UNEXPECTED");
+
+            measure(std::format("cullBoxes batch ({} boxes)", boxCount), boxCount, [&] {
+                math::batch::cullBoxes(frustum, boxes.view(), visible);
+                doNotOptimize(visible.data());
+            });
+
+            measure(std::format("cullBoxes scalar ({} boxes)", boxCount), boxCount, [&] {
+                for (usize i = 0; i < boxCount; ++i)
+                {
+                    visible[i] = cullBoxScalar(frustum, boxes.view(), i);
+                }
+                doNotOptimize(visible.data());
+            });
+        }
+
+        /// \brief Fills a scene with `drawCount` unit cubes around a camera at the origin, with bounds when `bounded`.
+        auto populate(Scene& scene, usize drawCount, bool bounded) -> void
+        {
+            auto random       = std::mt19937(42);
+            auto distribution = std::uniform_real_distribution<float32>(-100.0f, 100.0f);
+
+            auto camera = scene.createEntity();
+            camera.addComponent<TransformComponent>();
+            camera.addComponent<CameraComponent>().camera = Camera(CameraType::Perspective, makePerspective(1.0f, 16.0f / 9.0f, 0.1f, 150.0f));
+
+            auto cube    = BoundsComponent();
+            cube.extents = math::Vector3f(0.5f);
+
+            for (usize i = 0; i < drawCount; ++i)
+            {
+                // Adding a component moves the entity between archetypes, fill each one before adding the next.
+                auto entity = scene.createEntity();
+                entity.addComponent<TransformComponent>().setPosition({distribution(random), distribution(random), distribution(random)});
+
+                auto& meshComponent        = entity.addComponent<MeshComponent>();
+                meshComponent.vertexBuffer = reinterpret_cast<rhi::Buffer*>(256 * (1 + random() % 64));
+                meshComponent.vertexCount  = 36;
+
+                entity.addComponent<MaterialComponent>().pipelineState = reinterpret_cast<rhi::PipelineState*>(256 * (1 + random() % 16));
+                if (bounded)
+                {
+                    entity.addComponent<BoundsComponent>() = cube;
+                }
+            }
+            scene.transformSystem().update(scene.registery());
+        }
+
+        auto runExtractionBenchmark(usize drawCount) -> void
+        {
+            auto unbounded = Scene(EntityStorageType::Archetypes);
+            auto bounded   = Scene(EntityStorageType::Archetypes);
+            populate(unbounded, drawCount, false);
+            populate(bounded, drawCount, true);
+
+            auto packet = RenderPacket();
+            {
+                auto extractor = RenderExtractor();
+                measure(std::format("RenderExtractor extract without bounds ({} draws)", drawCount), drawCount, [&] {
+                    extractor.extract(unbounded, packet);
+                    doNotOptimize(packet.draws.data());
+                });
+            }
+
+            // From the calling thread alone to every hardware thread, the result must not depend on the split.
+            auto serialChecksum = uint64(0);
+            for (const auto workerCount : {uint32(0), JobSystem::defaultWorkerCount()})
+            {
+                auto jobSystem = JobSystem(workerCount);
+                auto extractor = RenderExtractor(&jobSystem);
+                measure(std::format("RenderExtractor extract culled {} workers ({} draws)", workerCount, drawCount), drawCount, [&] {
+                    extractor.extract(bounded, packet);
+                    doNotOptimize(packet.draws.data());
+                });
+
+                serialChecksum = workerCount == 0 ? packet.checksum() : serialChecksum;
+                Log::info(
+                    "RenderPacket {} draws visible, {} culled, {} batches, {} instance matrices, checksum {}",
+                    packet.draws.size(),
+                    packet.culledDrawCount,
+                    packet.batches.size(),
+                    packet.worldMatrices.size(),
+                    check(packet.checksum() == serialChecksum) ? "identical" : "DIFFERENT");
+            }
+        }
+    }
+
+    auto runFrustumCullingBenchmarks() -> void
+    {
+        runKernelBenchmark(1'000'003);
+        runExtractionBenchmark(10'000);
+        runExtractionBenchmark(100'000);
+    }
+}
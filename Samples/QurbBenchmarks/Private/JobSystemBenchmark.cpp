@@ -0,0 +1,86 @@
+#include "Benchmark.hpp"
+
+#include <Containers/Vector.hpp>
+#include <Threading/JobSystem.hpp>
+
+#include <cmath>
+#include <format>
+
+namespace qurb::benchmark
+{
+    namespace
+    {
+        /// \brief A few hundred cycles of arithmetic per element, so that the work dominates the scheduling.
+        auto heavyWork(usize index) -> float32
+        {
+            auto value = static_cast<float32>(index);
+            for (uint32 i = 0; i < 16; ++i)
+            {
+                value = std::sqrt(value * 1.0001f + 1.0f);
+            }
+            return value;
+        }
+
+        /// \brief Splits like a parallel divide and conquer: every job submits two children and waits on them.
+        auto spawnTree(JobSystem& jobSystem, uint32 depth, std::atomic<uint32>& leaves) -> void
+        {
+            if (depth == 0)
+            {
+                leaves.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+
+            auto counter = JobCounter(0);
+            jobSystem.submit([&jobSystem, depth, &leaves] { spawnTree(jobSystem, depth - 1, leaves); }, counter);
+            jobSystem.submit([&jobSystem, depth, &leaves] { spawnTree(jobSystem, depth - 1, leaves); }, counter);
+            jobSystem.wait(counter);
+        }
+
+        auto runScalingBenchmark(uint32 workerCount, float64& baselineMilliseconds) -> void
+        {
+            auto jobSystem = JobSystem(workerCount);
+
+            constexpr auto elementCount = usize(4'000'000);
+            auto           output       = Vector<float32>(elementCount);
+            const auto     result       = measure(std::format("parallelFor heavy {} workers ({} elements)", workerCount, elementCount), elementCount, [&] {
+                jobSystem.parallelFor(elementCount, 16'384, [&](usize begin, usize end) {
+                    for (auto i = begin; i < end; ++i)
+                    {
+                        output[i] = heavyWork(i);
+                    }
+                });
+                doNotOptimize(output.data());
+            });
+
+            if (workerCount == 0)
+            {
+                baselineMilliseconds = result.bestMilliseconds;
+            }
+            Log::info("{} threads speedup {:.2f}x", workerCount + 1, baselineMilliseconds / result.bestMilliseconds);
+
+            // Tiny ranges measure the cost of queuing, splitting and stealing rather than the work itself.
+            measure(std::format("parallelFor grain 1 {} workers ({} jobs)", workerCount, 100'000), 100'000, [&] {
+                jobSystem.parallelFor(100'000, 1, [&](usize begin, usize end) { doNotOptimize(begin + end); });
+            });
+
+            constexpr auto depth = uint32(16);
+            measure(std::format("nested submit and wait {} workers ({} jobs)", workerCount, (2u << depth) - 2), (2u << depth) - 2, [&] {
+                auto leaves = std::atomic<uint32>(0);
+                spawnTree(jobSystem, depth, leaves);
+                doNotOptimize(leaves.load());
+            });
+        }
+    }
+
+    auto runJobSystemBenchmarks() -> void
+    {
+        // From the calling thread alone up to every hardware thread, adding one worker at a time.
+        const auto maxWorkers = JobSystem::defaultWorkerCount();
+
+        auto baselineMilliseconds = 0.0;
+        for (uint32 workerCount = 0; workerCount <= maxWorkers; ++workerCount)
+        {
+            runScalingBenchmark(workerCount, baselineMilliseconds);
+        }
+    }
+}
@@ -0,0 +1,66 @@
+#include "Benchmark.hpp"
+
+#include <Containers/Vector.hpp>
+#include <Log/Log.hpp>
+
+#include <string_view>
+
+using namespace qurb;
+
+struct Suite
+{
+    std::string_view name;
+    auto (*run)() -> void;
+};
+
+auto main(int argc, const char** argv) -> int
+{
+    const auto suites = Vector<Suite> {
+        {"JobSystem", &benchmark::runJobSystemBenchmarks},
+        {"EntityRegistery", &benchmark::runEntityRegisteryBenchmarks},
+        {"EntityStorage", &benchmark::runEntityStorageBenchmarks},
+        {"SystemScheduler", &benchmark::runSystemSchedulerBenchmarks},
+        {"EntityCommandBuffer", &benchmark::runEntityCommandBufferBenchmarks},
+        {"TransformSystem", &benchmark::runTransformSystemBenchmarks},
+        {"Matrix4x4", &benchmark::runMatrix4x4Benchmarks},
+        {"BatchMath", &benchmark::runBatchMathBenchmarks},
+        {"FramePipeline", &benchmark::runFramePipelineBenchmarks},
+        {"RenderPacket", &benchmark::runRenderPacketBenchmarks},
+        {"FrustumCulling", &benchmark::runFrustumCullingBenchmarks},
+        {"SpatialIndex", &benchmark::runSpatialIndexBenchmarks},
+        {"CommandList", &benchmark::runCommandListBenchmarks},
+        {"BufferConformance", &benchmark::runBufferConformanceBenchmarks},
+        {"PipelineCache", &benchmark::runPipelineCacheBenchmarks},
+        {"ShaderCache", &benchmark::runShaderCacheBenchmarks},
+        {"ShaderRegistry", &benchmark::runShaderRegistryBenchmarks},
+        {"FrameAllocator", &benchmark::runFrameAllocatorBenchmarks},
+        {"SceneRenderer", &benchmark::runSceneRendererBenchmarks},
+        {"SoftwareRasterizer", &benchmark::runSoftwareRasterizerBenchmarks},
+    };
+
+    // Run every suite when none is given on the command line.
+    for (const auto& suite : suites)
+    {
+        auto selected = argc <= 1;
+        for (int i = 1; i < argc; ++i)
+        {
+            selected = selected or suite.name == argv[i];
+        }
+
+        if (not selected)
+        {
+            continue;
+        }
+
+        Log::info("=== {} ===", suite.name);
+        suite.run();
+    }
+
+    // A failed self-check fails the run, so that scripts running the suites notice it.
+    if (benchmark::failedCheckCount() != 0)
+    {
+        Log::error("{} checks failed", benchmark::failedCheckCount());
+        return 1;
+    }
+    return 0;
+}
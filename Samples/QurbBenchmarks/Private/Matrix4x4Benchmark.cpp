@@ -0,0 +1,240 @@
+#include "Benchmark.hpp"
+
+#include <Containers/Vector.hpp>
+#include <Math/Matrix4x4.hpp>
+#include <Math/Matrix4x4Kernels.hpp>
+#include <Math/Simd.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <format>
+#include <random>
+
+namespace qurb::benchmark
+{
+    namespace
+    {
+        using math::Matrix4x4f;
+        using math::Vector4f;
+
+        struct Inputs
+        {
+            Vector<Matrix4x4f> general;  // Random, well conditioned.
+            Vector<Matrix4x4f> affine;   // Translation, rotation and non-uniform scale.
+            Vector<Vector4f>   vectors;
+        };
+
+        auto makeInputs(usize count) -> Inputs
+        {
+            auto random   = std::mt19937(42);
+            auto unit     = std::uniform_real_distribution<float32>(-1.0f, 1.0f);
+            auto angle    = std::uniform_real_distribution<float32>(-180.0f, 180.0f);
+            auto positive = std::uniform_real_distribution<float32>(0.5f, 2.0f);
+
+            auto inputs = Inputs();
+            inputs.general.reserve(count);
+            inputs.affine.reserve(count);
+            inputs.vectors.reserve(count);
+            for (usize i = 0; i < count; ++i)
+            {
+                // A dominant diagonal keeps the random matrices far from singular.
+                auto general = Matrix4x4f();
+                for (uint32 row = 0; row < 4; ++row)
+                {
+                    for (uint32 column = 0; column < 4; ++column)
+                    {
+                        general[row, column] = unit(random) + (row == column ? 4.0f : 0.0f);
+                    }
+                }
+                inputs.general.pushBack(general);
+
+                inputs.affine.pushBack(math::transformMatrix(
+                    math::Vector3f(unit(random), unit(random), unit(random)) * 10.0f,
+                    math::QuaternionF(math::Vector3f(angle(random), angle(random), angle(random))),
+                    math::Vector3f(positive(random), positive(random), positive(random))));
+
+                inputs.vectors.pushBack(Vector4f(unit(random), unit(random), unit(random), 1.0f));
+            }
+            return inputs;
+        }
+
+        /// \brief The largest difference between two arrays, relative to the magnitude of the reference.
+        auto relativeError(const float32* actual, const float32* expected, usize count) -> float32
+        {
+            auto error = 0.0f;
+            for (usize i = 0; i < count; ++i)
+            {
+                error = std::max(error, std::abs(actual[i] - expected[i]) / std::max(1.0f, std::abs(expected[i])));
+            }
+            return error;
+        }
+
+        /// \brief Compares a vectorized kernel against the scalar reference over every input and logs the result.
+        template <typename F>
+        auto validate(std::string_view name, usize count, float32 tolerance, F&& compare) -> void
+        {
+            auto error = 0.0f;
+            for (usize i = 0; i < count; ++i)
+            {
+                error = std::max(error, compare(i));
+            }
+
+            if (error > tolerance)
+            {
+                Log::error("{:<24} max relative error {:.3e} above the {:.0e} tolerance", name, error, tolerance);
+            }
+            else
+            {
+                Log::info("{:<24} max relative error {:.3e}{}", name, error, error == 0.0f ? " (bit-exact)" : "");
+            }
+        }
+
+        auto runValidation(const Inputs& inputs) -> void
+        {
+            const auto count = inputs.general.size();
+
+            validate("multiply", count, 1e-6f, [&](usize i) {
+                float32 expected[16];
+                float32 actual[16];
+                const auto* rhs = inputs.general[(i + 1) % count].data();
+                math::scalar::multiply(inputs.general[i].data(), rhs, expected);
+                math::simd::multiply(inputs.general[i].data(), rhs, actual);
+                return relativeError(actual, expected, 16);
+            });
+
+            validate("transpose", count, 0.0f, [&](usize i) {
+                float32 expected[16];
+                float32 actual[16];
+                math::scalar::transpose(inputs.general[i].data(), expected);
+                math::simd::transpose(inputs.general[i].data(), actual);
+                return relativeError(actual, expected, 16);
+            });
+
+            validate("inverse", count, 1e-5f, [&](usize i) {
+                float32 expected[16];
+                float32 actual[16];
+                math::scalar::inverse(inputs.general[i].data(), expected);
+                math::simd::inverse(inputs.general[i].data(), actual);
+                return relativeError(actual, expected, 16);
+            });
+
+            // The affine inverse must agree with the general one, and the general one must actually invert.
+            validate("affineInverse", count, 1e-5f, [&](usize i) {
+                float32 expected[16];
+                float32 actual[16];
+                math::scalar::inverse(inputs.affine[i].data(), expected);
+                math::simd::affineInverse(inputs.affine[i].data(), actual);
+                return relativeError(actual, expected, 16);
+            });
+
+            validate("inverse * matrix", count, 1e-5f, [&](usize i) {
+                const auto product = inputs.general[i].inverse() * inputs.general[i];
+                return relativeError(product.data(), Matrix4x4f::identity.data(), 16);
+            });
+
+            validate("transform", count, 1e-6f, [&](usize i) {
+                float32 expected[4];
+                float32 actual[4];
+                math::scalar::transform(inputs.affine[i].data(), &inputs.vectors[i].x, expected);
+                math::simd::transform(inputs.affine[i].data(), &inputs.vectors[i].x, actual);
+                return relativeError(actual, expected, 4);
+            });
+        }
+
+        auto runKernelBenchmark(const Inputs& inputs) -> void
+        {
+            const auto count   = inputs.general.size();
+            auto       results = Vector<Matrix4x4f>(count);
+            auto       vectors = Vector<Vector4f>(count);
+
+            measure(std::format("multiply scalar ({} matrices)", count), count, [&] {
+                for (usize i = 0; i < count; ++i)
+                {
+                    math::scalar::multiply(inputs.affine[i].data(), inputs.general[i].data(), results[i].data());
+                }
+                doNotOptimize(results.data());
+            });
+
+            measure(std::format("multiply {} ({} matrices)", math::simd::instructionSet, count), count, [&] {
+                for (usize i = 0; i < count; ++i)
+                {
+                    math::simd::multiply(inputs.affine[i].data(), inputs.general[i].data(), results[i].data());
+                }
+                doNotOptimize(results.data());
+            });
+
+            measure(std::format("transpose scalar ({} matrices)", count), count, [&] {
+                for (usize i = 0; i < count; ++i)
+                {
+                    math::scalar::transpose(inputs.general[i].data(), results[i].data());
+                }
+                doNotOptimize(results.data());
+            });
+
+            measure(std::format("transpose {} ({} matrices)", math::simd::instructionSet, count), count, [&] {
+                for (usize i = 0; i < count; ++i)
+                {
+                    math::simd::transpose(inputs.general[i].data(), results[i].data());
+                }
+                doNotOptimize(results.data());
+            });
+
+            measure(std::format("inverse scalar ({} matrices)", count), count, [&] {
+                for (usize i = 0; i < count; ++i)
+                {
+                    math::scalar::inverse(inputs.general[i].data(), results[i].data());
+                }
+                doNotOptimize(results.data());
+            });
+
+            measure(std::format("inverse {} ({} matrices)", math::simd::instructionSet, count), count, [&] {
+                for (usize i = 0; i < count; ++i)
+                {
+                    math::simd::inverse(inputs.general[i].data(), results[i].data());
+                }
+                doNotOptimize(results.data());
+            });
+
+            measure(std::format("affineInverse scalar ({} matrices)", count), count, [&] {
+                for (usize i = 0; i < count; ++i)
+                {
+                    math::scalar::affineInverse(inputs.affine[i].data(), results[i].data());
+                }
+                doNotOptimize(results.data());
+            });
+
+            measure(std::format("affineInverse {} ({} matrices)", math::simd::instructionSet, count), count, [&] {
+                for (usize i = 0; i < count; ++i)
+                {
+                    math::simd::affineInverse(inputs.affine[i].data(), results[i].data());
+                }
+                doNotOptimize(results.data());
+            });
+
+            measure(std::format("transform scalar ({} vectors)", count), count, [&] {
+                for (usize i = 0; i < count; ++i)
+                {
+                    math::scalar::transform(inputs.affine[i].data(), &inputs.vectors[i].x, &vectors[i].x);
+                }
+                doNotOptimize(vectors.data());
+            });
+
+            measure(std::format("transform {} ({} vectors)", math::simd::instructionSet, count), count, [&] {
+                for (usize i = 0; i < count; ++i)
+                {
+                    math::simd::transform(inputs.affine[i].data(), &inputs.vectors[i].x, &vectors[i].x);
+                }
+                doNotOptimize(vectors.data());
+            });
+        }
+    }
+
+    auto runMatrix4x4Benchmarks() -> void
+    {
+        Log::info("Matrix4x4 kernels use {}", math::simd::instructionSet);
+
+        const auto inputs = makeInputs(100'000);
+        runValidation(inputs);
+        runKernelBenchmark(inputs);
+    }
+}
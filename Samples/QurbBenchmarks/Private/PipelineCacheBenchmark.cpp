@@ -0,0 +1,89 @@
+#include "Benchmark.hpp"
+
+#include <Containers/Vector.hpp>
+#include <RHI/PipelineCache.hpp>
+#include <Threading/JobSystem.hpp>
+
+#include <atomic>
+#include <format>
+
+namespace qurb::benchmark
+{
+    namespace
+    {
+        /// \brief `count` keys over two render target layouts, as if half of the pipelines rendered to an offscreen target.
+        auto makeKeys(usize count) -> Vector<rhi::PipelineKey>
+        {
+            auto keys = Vector<rhi::PipelineKey>();
+            for (usize i = 0; i < count; ++i)
+            {
+                auto formats       = rhi::AttachmentFormats();
+                formats.colors[0]  = i % 2 == 0 ? 80u : 115u;
+                formats.colorCount = 1;
+                formats.depth      = 252;
+                keys.pushBack(rhi::PipelineKey {0x9E3779B97F4A7C15ull * (i / 2 + 1), formats});
+            }
+            return keys;
+        }
+
+        auto runLookupBenchmark(JobSystem& jobSystem, usize keyCount) -> void
+        {
+            constexpr auto lookupCount = usize(1'000'000);
+
+            const auto keys    = makeKeys(keyCount);
+            auto       cache   = rhi::PipelineCache<uint64>();
+            auto       created = std::atomic<usize>(0);
+            auto       create  = [&] { return created.fetch_add(1, std::memory_order_relaxed); };
+
+            measure(std::format("Pipeline cache first lookups ({} keys)", keyCount), keyCount, [&] {
+                for (const auto& key : keys)
+                {
+                    doNotOptimize(cache.getOrCreate(key, create));
+                }
+            }, 1);
+
+            cache.resetStatistics();
+            measure(std::format("Pipeline cache lookups ({} keys)", keyCount), lookupCount, [&] {
+                auto sum = uint64(0);
+                for (usize i = 0; i < lookupCount; ++i)
+                {
+                    sum += cache.getOrCreate(keys[i % keyCount], create);
+                }
+                doNotOptimize(sum);
+            });
+
+            measure(
+                std::format("Pipeline cache parallel lookups ({} keys, {} workers)", keyCount, jobSystem.workerCount()),
+                lookupCount,
+                [&] {
+                    jobSystem.parallelFor(lookupCount, 16'384, [&](usize begin, usize end) {
+                        auto sum = uint64(0);
+                        for (auto i = begin; i < end; ++i)
+                        {
+                            sum += cache.getOrCreate(keys[i % keyCount], create);
+                        }
+                        doNotOptimize(sum);
+                    });
+                });
+
+            // Every pipeline was built by its first lookup only.
+            const auto statistics = cache.statistics();
+            Log::info(
+                "Pipeline cache: {} entries, {} created, {} hits and {} misses after warm-up, {}",
+                statistics.entries,
+                created.load(),
+                statistics.hits,
+                statistics.misses,
+                check(statistics.entries == keyCount and created.load() == keyCount and statistics.misses == 0) ? "ok" : "UNEXPECTED");
+        }
+    }
+
+    auto runPipelineCacheBenchmarks() -> void
+    {
+        auto jobSystem = JobSystem();
+
+        runLookupBenchmark(jobSystem, 16);
+        runLookupBenchmark(jobSystem, 256);
+        runLookupBenchmark(jobSystem, 4'096);
+    }
+}
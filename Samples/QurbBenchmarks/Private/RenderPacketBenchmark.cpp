@@ -0,0 +1,181 @@
+#include "Benchmark.hpp"
+
+#include <Algorithm/RadixSort.hpp>
+#include <Scene/Components.hpp>
+#include <Scene/RenderExtractor.hpp>
+#include <Scene/RenderPacket.hpp>
+#include <Scene/Scene.hpp>
+
+#include <algorithm>
+#include <format>
+#include <random>
+
+namespace qurb::benchmark
+{
+    namespace
+    {
+        /// \brief A distinct fake RHI object, extraction only copies the pointers.
+        template <typename T>
+        auto fakeObject(usize index) -> T*
+        {
+            return reinterpret_cast<T*>((index + 1) * 256);
+        }
+
+        /// \brief Fills a scene with `drawCount` drawables sharing `meshCount` meshes and `materialCount` materials.
+        auto populate(Scene& scene, usize drawCount, usize meshCount, usize materialCount) -> void
+        {
+            auto random       = std::mt19937(42);
+            auto distribution = std::uniform_real_distribution<float32>(-100.0f, 100.0f);
+
+            auto camera = scene.createEntity();
+            camera.addComponent<TransformComponent>().setPosition({0.0f, 0.0f, -10.0f});
+            camera.addComponent<CameraComponent>();
+
+            for (usize i = 0; i < drawCount; ++i)
+            {
+                // Adding a component moves the entity between archetypes, fill each one before adding the next.
+                auto entity = scene.createEntity();
+                entity.addComponent<TransformComponent>().setPosition({distribution(random), distribution(random), distribution(random)});
+
+                auto& meshComponent        = entity.addComponent<MeshComponent>();
+                meshComponent.vertexBuffer = fakeObject<rhi::Buffer>(random() % meshCount);
+                meshComponent.vertexCount  = 36;
+
+                entity.addComponent<MaterialComponent>().pipelineState = fakeObject<rhi::PipelineState>(random() % materialCount);
+            }
+            scene.transformSystem().update(scene.registery());
+        }
+
+        /// \brief The pipeline and vertex buffer binds `SceneRenderer::render` issues for `draws`, skipping redundant ones.
+        auto countBinds(const RenderPacket& packet, const Vector<RenderDraw>& draws) -> usize
+        {
+            auto binds             = usize(0);
+            auto boundPipeline     = uint32(-1);
+            auto boundVertexBuffer = static_cast<rhi::Buffer*>(nullptr);
+            for (const auto& draw : draws)
+            {
+                const auto pipeline     = packet.materials[draw.material].pipeline;
+                auto*      vertexBuffer = packet.meshes[draw.mesh].vertexBuffer;
+                binds += (pipeline != boundPipeline) + (vertexBuffer != boundVertexBuffer);
+                boundPipeline     = pipeline;
+                boundVertexBuffer = vertexBuffer;
+            }
+            return binds;
+        }
+
+        auto runSortBenchmark(const RenderPacket& packet) -> void
+        {
+            const auto drawCount = packet.draws.size();
+
+            // The draws in scene order, as they were before sorting.
+            auto unsorted = packet.draws;
+            std::ranges::sort(unsorted, {}, &RenderDraw::transform);
+
+            const auto sorted = std::ranges::is_sorted(packet.draws, {}, &RenderDraw::sortKey);
+            Log::info(
+                "RenderPacket {} draws sorted {}, {} binds in scene order, {} binds sorted (of {} without elimination)",
+                drawCount,
+                check(sorted) ? "yes" : "NO",
+                countBinds(packet, unsorted),
+                countBinds(packet, packet.draws),
+                2 * drawCount);
+
+            auto draws   = Vector<RenderDraw>(drawCount);
+            auto scratch = Vector<RenderDraw>(drawCount);
+            measure(std::format("radix sort draws ({} draws)", drawCount), drawCount, [&] {
+                std::ranges::copy(unsorted, draws.begin());
+                radixSort(std::span(draws), std::span(scratch), [](const RenderDraw& draw) { return draw.sortKey; });
+                doNotOptimize(draws.data());
+            });
+
+            measure(std::format("std::stable_sort draws ({} draws)", drawCount), drawCount, [&] {
+                std::ranges::copy(unsorted, draws.begin());
+                std::ranges::stable_sort(draws, {}, &RenderDraw::sortKey);
+                doNotOptimize(draws.data());
+            });
+        }
+
+        auto runExtractionBenchmark(EntityStorageType storageType, usize drawCount) -> void
+        {
+            auto scene = Scene(storageType);
+            populate(scene, drawCount, 64, 16);
+
+            const auto storageName = storageType == EntityStorageType::Archetypes ? "archetypes" : "pools";
+
+            auto extractor = RenderExtractor();
+            auto packet    = RenderPacket();
+            measure(std::format("RenderExtractor extract {} ({} draws)", storageName, drawCount), drawCount, [&] {
+                extractor.extract(scene, packet);
+                doNotOptimize(packet.draws.data());
+            });
+
+            // Extracting the same scene state again, or copying the packet, must not change its content.
+            const auto checksum = packet.checksum();
+            auto       replayed = RenderPacket();
+            auto       replayer = RenderExtractor();
+            replayer.extract(scene, replayed);
+            const auto copied = packet;
+            Log::info(
+                "RenderPacket {} draws in {} instanced batches, {} meshes, {} materials, checksum {:016x}, replay {}, copy {}",
+                packet.draws.size(),
+                packet.batches.size(),
+                packet.meshes.size(),
+                packet.materials.size(),
+                checksum,
+                check(replayed.checksum() == checksum) ? "identical" : "DIFFERENT",
+                check(copied.checksum() == checksum) ? "identical" : "DIFFERENT");
+
+            measure(std::format("RenderPacket checksum ({} draws)", drawCount), drawCount, [&] {
+                doNotOptimize(packet.checksum());
+            });
+
+            runSortBenchmark(packet);
+
+            // A drawable added since the last transform update has no world matrix yet, it is drawn from the next one.
+            auto added = scene.createEntity();
+            added.addComponent<TransformComponent>();
+            added.addComponent<MeshComponent>().vertexBuffer      = fakeObject<rhi::Buffer>(0);
+            added.addComponent<MaterialComponent>().pipelineState = fakeObject<rhi::PipelineState>(0);
+            replayer.extract(scene, replayed);
+            const auto skipped = replayed.checksum() == checksum;
+            scene.transformSystem().update(scene.registery());
+            replayer.extract(scene, replayed);
+            Log::info(
+                "RenderPacket drawable added before the transform update: {}",
+                check(skipped and replayed.draws.size() + replayed.culledDrawCount == drawCount + 1) ? "ok" : "UNEXPECTED");
+        }
+
+        /// \brief Meshes drawing different ranges of one vertex buffer must not share a mesh handle.
+        auto runSharedBufferCheck() -> void
+        {
+            auto scene = Scene();
+            for (const auto vertexCount : {36u, 24u, 36u})
+            {
+                auto entity = scene.createEntity();
+                entity.addComponent<TransformComponent>();
+
+                auto& meshComponent        = entity.addComponent<MeshComponent>();
+                meshComponent.vertexBuffer = fakeObject<rhi::Buffer>(0);
+                meshComponent.vertexCount  = vertexCount;
+
+                entity.addComponent<MaterialComponent>().pipelineState = fakeObject<rhi::PipelineState>(0);
+            }
+            scene.transformSystem().update(scene.registery());
+
+            auto extractor = RenderExtractor();
+            auto packet    = RenderPacket();
+            extractor.extract(scene, packet);
+            Log::info("RenderPacket meshes sharing a vertex buffer: {}, {}", packet.meshes.size(), check(packet.meshes.size() == 2) ? "ok" : "UNEXPECTED");
+        }
+    }
+
+    auto runRenderPacketBenchmarks() -> void
+    {
+        runSharedBufferCheck();
+        for (const auto storageType : {EntityStorageType::ComponentPools, EntityStorageType::Archetypes})
+        {
+            runExtractionBenchmark(storageType, 10'000);
+            runExtractionBenchmark(storageType, 100'000);
+        }
+    }
+}
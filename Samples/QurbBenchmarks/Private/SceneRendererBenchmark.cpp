@@ -0,0 +1,193 @@
+#include "Benchmark.hpp"
+
+#include <Containers/Vector.hpp>
+#include <NullDevice.hpp>
+#include <NullRenderContext.hpp>
+#include <Platform/Platform.hpp>
+#include <Platform/Window.hpp>
+#include <Plugins/PluginManager.hpp>
+#include <Renderer/Renderer.hpp>
+#include <Scene/Components.hpp>
+#include <Scene/RenderPacket.hpp>
+#include <Scene/Scene.hpp>
+#include <Scene/SceneRenderer.hpp>
+#include <Threading/JobSystem.hpp>
+
+#include <format>
+#include <random>
+
+namespace qurb::benchmark
+{
+    namespace
+    {
+        constexpr auto vertexCount = uint32(36);
+
+        /// \brief The null backend loaded through the plugin path, with a headless window and its render context.
+        struct NullBackend
+        {
+            PluginManager pluginManager;
+            Renderer      renderer;
+            Platform      platform;
+            Window        window = Window(WindowDescriptor {.title = "SceneRenderer benchmark", .size = {1280.0f, 720.0f}});
+
+        public:
+            NullBackend()
+            {
+                pluginManager.loadPlugins({"QurbNullRHI"});
+                renderer.loadBackend(pluginManager, "QurbNullRHI");
+                renderer.onWindowCreate(window);
+            }
+
+            [[nodiscard]] auto device() -> rhi::null::Device* { return static_cast<rhi::null::Device*>(renderer.device()); }
+
+            [[nodiscard]] auto renderContext() -> rhi::null::RenderContext*
+            {
+                return static_cast<rhi::null::RenderContext*>(window.renderContext());
+            }
+        };
+
+        /// \brief The meshes and pipeline states shared by the drawables, created on the null device.
+        struct Resources
+        {
+            Vector<rhi::Buffer*>        vertexBuffers;
+            Vector<rhi::ShaderProgram*> shaderPrograms;
+            Vector<rhi::PipelineState*> pipelineStates;
+
+        public:
+            Resources(rhi::Device* device, usize meshCount, usize materialCount)
+            {
+                const auto vertices = Vector<math::Vector3f>(vertexCount, math::Vector3f::one);
+                for (usize i = 0; i < meshCount; ++i)
+                {
+                    vertexBuffers.pushBack(device->createBuffer(
+                        rhi::BufferDescriptor {
+                            .initialData = vertices.data(),
+                            .bufferSize  = vertices.size() * sizeof(math::Vector3f),
+                            .bufferType  = rhi::BufferType::Vertex,
+                            .bufferUsage = rhi::BufferUsage::Immutable,
+                        }));
+                }
+
+                for (usize i = 0; i < materialCount; ++i)
+                {
+                    auto shaderProgramDescriptor         = rhi::ShaderProgramDescriptor();
+                    shaderProgramDescriptor.shaderName   = std::format("Benchmark.{}", i);
+                    shaderProgramDescriptor.bufferLayout = {{rhi::ShaderDataType::Float3, "position"}};
+                    shaderPrograms.pushBack(device->createShaderProgram(shaderProgramDescriptor));
+
+                    auto pipelineStateDescriptor          = rhi::PipelineStateDescriptor();
+                    pipelineStateDescriptor.shaderProgram = shaderPrograms.back();
+                    pipelineStates.pushBack(device->createPipelineState(pipelineStateDescriptor));
+                }
+            }
+
+            ~Resources()
+            {
+                for (auto* object : pipelineStates)
+                {
+                    object->release();
+                }
+                for (auto* object : shaderPrograms)
+                {
+                    object->release();
+                }
+                for (auto* object : vertexBuffers)
+                {
+                    object->release();
+                }
+            }
+        };
+
+        /// \brief Fills a scene with `drawCount` drawables in front of the camera, so that none is culled.
+        auto populate(Scene& scene, const Resources& resources, usize drawCount) -> void
+        {
+            auto random   = std::mt19937(42);
+            auto position = std::uniform_real_distribution<float32>(-20.0f, 20.0f);
+
+            auto camera = scene.createEntity();
+            camera.addComponent<TransformComponent>().setPosition({0.0f, 0.0f, -150.0f});
+            camera.addComponent<CameraComponent>().camera =
+                Camera(CameraType::Perspective, makePerspective(1.0f, 16.0f / 9.0f, 0.1f, 1000.0f));
+
+            for (usize i = 0; i < drawCount; ++i)
+            {
+                auto entity = scene.createEntity();
+                entity.addComponent<TransformComponent>().setPosition({position(random), position(random), position(random)});
+
+                auto& meshComponent        = entity.addComponent<MeshComponent>();
+                meshComponent.vertexBuffer = resources.vertexBuffers[random() % resources.vertexBuffers.size()];
+                meshComponent.vertexCount  = vertexCount;
+
+                const auto material                                    = random() % resources.pipelineStates.size();
+                entity.addComponent<MaterialComponent>().shaderProgram = resources.shaderPrograms[material];
+                entity.getComponent<MaterialComponent>().pipelineState = resources.pipelineStates[material];
+            }
+            scene.transformSystem().update(scene.registery());
+        }
+
+        auto runRenderBenchmark(NullBackend& backend, JobSystem& jobSystem, usize drawCount, usize meshCount, usize materialCount) -> void
+        {
+            auto* device        = backend.device();
+            auto* renderContext = backend.renderContext();
+
+            const auto resources = Resources(device, meshCount, materialCount);
+            auto       scene     = Scene(EntityStorageType::Archetypes);
+            populate(scene, resources, drawCount);
+
+            auto sceneRenderer = SceneRenderer(scene, device, &jobSystem);
+            auto packet        = RenderPacket();
+            measure(std::format("SceneRenderer extract ({} draws)", drawCount), drawCount, [&] { sceneRenderer.extract(packet); });
+
+            device->resetStatistics();
+            device->pipelineCache().resetStatistics();
+            renderContext->resetStatistics();
+            measure(std::format("SceneRenderer render null RHI ({} draws, {} meshes)", drawCount, meshCount), drawCount, [&] {
+                renderContext->beginFrame();
+                sceneRenderer.render(renderContext, packet);
+                renderContext->present();
+                renderContext->endFrame();
+            });
+
+            // The null render context saw exactly the commands the renderer reports, over the warm-up and measured runs.
+            const auto& context  = renderContext->statistics();
+            const auto  uploads  = device->statistics();
+            const auto& rendered = sceneRenderer.statistics();
+            const auto  frames   = context.frames;
+            const auto  matches  = context.drawCalls == frames * rendered.drawsIssued and context.instancesDrawn == frames * drawCount and
+                                   context.pipelineBinds == frames * rendered.pipelineBinds and
+                                   context.verticesDrawn == frames * drawCount * vertexCount;
+            Log::info(
+                "Null RHI per frame: {} draws, {} pipeline binds, {} vertex buffer binds, {} maps, {} bytes uploaded, {} buffers "
+                "created in {} frames, counts {}",
+                context.drawCalls / frames,
+                context.pipelineBinds / frames,
+                context.vertexBufferBinds / frames,
+                uploads.bufferMaps / frames,
+                uploads.bytesUploaded / frames,
+                uploads.buffersCreated,
+                frames,
+                check(matches) ? "match" : "DIFFER");
+
+            // Pipelines are built by the first frame binding them only, whatever the number of binds.
+            const auto pipelines = device->pipelineCache().statistics();
+            Log::info(
+                "Pipeline cache: {} hits, {} misses for {} pipelines over {} frames, {}",
+                pipelines.hits,
+                pipelines.misses,
+                materialCount,
+                frames,
+                check(pipelines.misses <= materialCount and pipelines.hits + pipelines.misses == context.pipelineBinds) ? "ok" : "UNEXPECTED");
+        }
+    }
+
+    auto runSceneRendererBenchmarks() -> void
+    {
+        auto backend   = NullBackend();
+        auto jobSystem = JobSystem();
+
+        runRenderBenchmark(backend, jobSystem, 1'000, 16, 8);
+        runRenderBenchmark(backend, jobSystem, 10'000, 64, 16);
+        runRenderBenchmark(backend, jobSystem, 100'000, 64, 16);
+        runRenderBenchmark(backend, jobSystem, 100'000, 4'096, 256);
+    }
+}
@@ -0,0 +1,139 @@
+#include "Benchmark.hpp"
+
+#include <Containers/Vector.hpp>
+#include <RHI/ShaderCache.hpp>
+
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <random>
+
+namespace qurb::benchmark
+{
+    namespace
+    {
+        /// \brief `count` artifacts of `size` random bytes, the size of the binaries of a small material each.
+        auto makeArtifacts(usize count, usize size) -> Vector<Vector<std::byte>>
+        {
+            auto random    = std::mt19937_64(42);
+            auto artifacts = Vector<Vector<std::byte>>();
+            for (usize i = 0; i < count; ++i)
+            {
+                auto artifact = Vector<std::byte>();
+                artifact.resize(size);
+                for (auto& byte : artifact)
+                {
+                    byte = static_cast<std::byte>(random());
+                }
+                artifacts.pushBack(std::move(artifact));
+            }
+            return artifacts;
+        }
+
+        auto makeKey(usize index) -> rhi::ShaderCacheKey
+        {
+            return rhi::ShaderCacheKeyHasher().add(std::format("Benchmark.Shader{}", index)).add("vertexMain").add("fragmentMain").key();
+        }
+
+        /// \brief Starts the process again: every artifact through `loadOrCreate`, with the cache emptied first or not.
+        auto runStart(rhi::ShaderCache& cache, const Vector<Vector<std::byte>>& artifacts, bool cold) -> void
+        {
+            if (cold)
+            {
+                cache.clear();
+            }
+            for (usize i = 0; i < artifacts.size(); ++i)
+            {
+                doNotOptimize(cache.loadOrCreate(makeKey(i), [&] { return artifacts[i]; }).size());
+            }
+        }
+
+        auto runStartBenchmark(const std::filesystem::path& directory, usize shaderCount, usize artifactSize) -> void
+        {
+            const auto artifacts = makeArtifacts(shaderCount, artifactSize);
+            auto       cache     = rhi::ShaderCache(directory, 1);
+
+            // The compiles are not part of it: the cold start shows what the cache adds to them, the warm start replaces them.
+            const auto label = std::format("{} shaders of {} KiB", shaderCount, artifactSize / 1024);
+            measure(std::format("Shader cache cold start, stores ({})", label), shaderCount, [&] { runStart(cache, artifacts, true); });
+            measure(std::format("Shader cache warm start, loads ({})", label), shaderCount, [&] { runStart(cache, artifacts, false); });
+
+            // Warm starts load exactly what the cold start stored.
+            auto matches = true;
+            for (usize i = 0; i < shaderCount; ++i)
+            {
+                const auto loaded = cache.load(makeKey(i));
+                matches = matches and loaded.has_value() and loaded->size() == artifacts[i].size() and
+                          std::equal(loaded->begin(), loaded->end(), artifacts[i].begin());
+            }
+            Log::info("Shader cache: warm start artifacts {}", check(matches) ? "match" : "DIFFER");
+            cache.clear();
+        }
+
+        /// \brief Damages entries the ways a crash, a disk or an upgrade would, each must be rejected once then stored again.
+        auto runCorruptionCheck(const std::filesystem::path& directory) -> void
+        {
+            const auto artifacts = makeArtifacts(4, 16 * 1024);
+            auto       cache     = rhi::ShaderCache(directory, 1);
+            cache.clear();
+            for (usize i = 0; i < artifacts.size(); ++i)
+            {
+                cache.store(makeKey(i), std::span<const std::byte>(artifacts[i].data(), artifacts[i].size()));
+            }
+
+            const auto entryPath = [&](usize index) { return directory / (makeKey(index).toString() + ".bin"); };
+
+            // A flipped byte in the payload.
+            {
+                auto file = std::fstream(entryPath(0), std::ios::binary | std::ios::in | std::ios::out);
+                file.seekp(static_cast<std::streamoff>(std::filesystem::file_size(entryPath(0)) / 2));
+                file.put('\x5A');
+            }
+            // A write cut short.
+            std::filesystem::resize_file(entryPath(1), std::filesystem::file_size(entryPath(1)) - 100);
+            // An entry of another key under this name.
+            std::filesystem::copy_file(entryPath(3), entryPath(2), std::filesystem::copy_options::overwrite_existing);
+
+            cache.resetStatistics();
+            for (usize i = 0; i < 3; ++i)
+            {
+                cache.loadOrCreate(makeKey(i), [&] { return artifacts[i]; });
+            }
+            const auto damaged = cache.statistics();
+
+            // An upgraded backend rejects what the previous version stored.
+            auto       upgraded           = rhi::ShaderCache(directory, 2);
+            const auto stale              = upgraded.load(makeKey(3));
+            const auto upgradedStatistics = upgraded.statistics();
+
+            cache.resetStatistics();
+            for (usize i = 0; i < 3; ++i)
+            {
+                doNotOptimize(cache.load(makeKey(i)).has_value());
+            }
+            const auto repaired = cache.statistics();
+
+            const auto passed = damaged.rejected == 3 and damaged.stores == 3 and not stale.has_value() and
+                                upgradedStatistics.rejected == 1 and repaired.hits == 3;
+            Log::info(
+                "Shader cache: {} damaged entries rejected, {} stale version rejected, {} repaired entries loaded, {}",
+                damaged.rejected,
+                upgradedStatistics.rejected,
+                repaired.hits,
+                check(passed) ? "ok" : "UNEXPECTED");
+            cache.clear();
+        }
+    }
+
+    auto runShaderCacheBenchmarks() -> void
+    {
+        auto       error     = std::error_code();
+        const auto directory = std::filesystem::temp_directory_path(error) / "QurbShaderCacheBenchmark";
+
+        runStartBenchmark(directory, 64, 16 * 1024);
+        runStartBenchmark(directory, 64, 256 * 1024);
+        runCorruptionCheck(directory);
+
+        std::filesystem::remove_all(directory, error);
+    }
+}
@@ -0,0 +1,116 @@
+#include "Benchmark.hpp"
+
+#include <Containers/Vector.hpp>
+#include <Plugins/PluginManager.hpp>
+#include <Renderer/Renderer.hpp>
+#include <Renderer/ShaderRegistry.hpp>
+#include <Threading/JobSystem.hpp>
+
+#include <algorithm>
+#include <format>
+
+namespace qurb::benchmark
+{
+    namespace
+    {
+        /// \brief The null backend loaded through the plugin path, without a window: only its device is used.
+        struct NullBackend
+        {
+            PluginManager pluginManager;
+            Renderer      renderer;
+
+        public:
+            NullBackend()
+            {
+                pluginManager.loadPlugins({"QurbNullRHI"});
+                renderer.loadBackend(pluginManager, "QurbNullRHI");
+            }
+
+            [[nodiscard]] auto device() -> rhi::Device* { return renderer.device(); }
+        };
+
+        /// \brief The shader program of each of `materialCount` materials, cycling over `shaderCount` shaders.
+        auto makeDescriptors(usize materialCount, usize shaderCount) -> Vector<rhi::ShaderProgramDescriptor>
+        {
+            auto descriptors = Vector<rhi::ShaderProgramDescriptor>();
+            for (usize i = 0; i < materialCount; ++i)
+            {
+                auto descriptor                 = rhi::ShaderProgramDescriptor();
+                descriptor.shaderName           = std::format("Benchmark.Shader{}", i % shaderCount);
+                descriptor.vertexFunctionName   = "vertex_main";
+                descriptor.fragmentFunctionName = "fragment_main";
+                descriptor.bufferLayout         = {{rhi::ShaderDataType::Float3, "position"}, {rhi::ShaderDataType::Float2, "uv"}};
+                descriptors.pushBack(descriptor);
+            }
+            return descriptors;
+        }
+
+        auto runLoadBenchmark(NullBackend& backend, JobSystem& jobSystem, usize materialCount, usize shaderCount) -> void
+        {
+            auto*      device      = backend.device();
+            const auto descriptors = makeDescriptors(materialCount, shaderCount);
+            const auto label       = std::format("{} materials, {} shaders", materialCount, shaderCount);
+
+            // What every material did before: a program of its own.
+            measure(std::format("Program per material ({})", label), materialCount, [&] {
+                auto programs = Vector<rhi::ShaderProgram*>();
+                for (const auto& descriptor : descriptors)
+                {
+                    programs.pushBack(device->createShaderProgram(descriptor));
+                }
+                for (auto* program : programs)
+                {
+                    program->release();
+                }
+            });
+
+            measure(std::format("Shader registry loads ({})", label), materialCount, [&] {
+                auto registry = ShaderRegistry(device, &jobSystem);
+                auto programs = Vector<rhi::Ref<rhi::ShaderProgram>>();
+                for (const auto& descriptor : descriptors)
+                {
+                    programs.pushBack(registry.load(descriptor));
+                }
+            });
+
+            // Requests return at once, and resolve to one shared program per shader once compiled.
+            auto registry = ShaderRegistry(device, &jobSystem);
+
+            auto handles = Vector<ShaderHandle>();
+            for (const auto& descriptor : descriptors)
+            {
+                handles.pushBack(registry.request(descriptor));
+            }
+            auto resolved = true;
+            for (const auto& handle : handles)
+            {
+                resolved = resolved and handle;
+            }
+
+            registry.waitIdle();
+            auto shared = true;
+            for (usize i = 0; i < handles.size(); ++i)
+            {
+                shared = shared and handles[i].ready() and handles[i].program().get() == handles[i % shaderCount].program().get();
+            }
+
+            const auto statistics = registry.statistics();
+            Log::info(
+                "Shader registry: {} requests, {} programs compiled, {} ready, {}",
+                statistics.requests,
+                statistics.programs,
+                statistics.ready,
+                check(resolved and shared and statistics.programs == shaderCount and statistics.ready == shaderCount) ? "ok" : "UNEXPECTED");
+        }
+    }
+
+    auto runShaderRegistryBenchmarks() -> void
+    {
+        // Two workers at least, so that the requests compile in the background even on a single core.
+        auto backend   = NullBackend();
+        auto jobSystem = JobSystem(std::max(JobSystem::defaultWorkerCount(), 2u));
+
+        runLoadBenchmark(backend, jobSystem, 1'000, 16);
+        runLoadBenchmark(backend, jobSystem, 10'000, 16);
+    }
+}
@@ -0,0 +1,347 @@
+#include "Benchmark.hpp"
+
+#include <Containers/Vector.hpp>
+#include <Math/Vector2.hpp>
+#include <Math/Vector3.hpp>
+#include <Platform/Platform.hpp>
+#include <Platform/Window.hpp>
+#include <Plugins/PluginManager.hpp>
+#include <Renderer/Renderer.hpp>
+#include <Scene/Components.hpp>
+#include <Scene/RenderPacket.hpp>
+#include <Scene/Scene.hpp>
+#include <Scene/SceneRenderer.hpp>
+#include <SoftwareDevice.hpp>
+#include <SoftwareRenderContext.hpp>
+#include <Threading/JobSystem.hpp>
+
+#include <cmath>
+#include <format>
+#include <random>
+
+namespace qurb::benchmark
+{
+    namespace
+    {
+        constexpr auto width  = 1280.0f;
+        constexpr auto height = 720.0f;
+
+        struct Vertex
+        {
+            math::Vector3f position;
+            math::Vector2f uv;
+        };
+
+        /// \brief The software backend loaded through the plugin path, with a headless window and its render context.
+        struct SoftwareBackend
+        {
+            PluginManager pluginManager;
+            Renderer      renderer;
+            Platform      platform;
+            Window        window = Window(WindowDescriptor {.title = "SoftwareRasterizer benchmark", .size = {width, height}});
+
+        public:
+            SoftwareBackend()
+            {
+                pluginManager.loadPlugins({"QurbSoftwareRHI"});
+                renderer.loadBackend(pluginManager, "QurbSoftwareRHI");
+                renderer.onWindowCreate(window);
+            }
+
+            [[nodiscard]] auto device() -> rhi::software::Device* { return static_cast<rhi::software::Device*>(renderer.device()); }
+
+            [[nodiscard]] auto renderContext() -> rhi::software::RenderContext*
+            {
+                return static_cast<rhi::software::RenderContext*>(window.renderContext());
+            }
+        };
+
+        /// \brief The quad of the sandbox and the pipeline drawing it with the builtin object shader.
+        struct QuadResources
+        {
+            rhi::Buffer*        vertexBuffer;
+            rhi::ShaderProgram* shaderProgram;
+            rhi::PipelineState* pipelineState;
+
+        public:
+            explicit QuadResources(rhi::Device* device)
+            {
+                const auto vertices = Vector<Vertex> {
+                    {{-1.0f, -1.0f, 0.0f}, {0.0f, 0.0f}},
+                    {{1.0f, -1.0f, 0.0f},  {1.0f, 0.0f}},
+                    {{1.0f, 1.0f, 0.0f},   {1.0f, 1.0f}},
+                    {{-1.0f, -1.0f, 0.0f}, {0.0f, 0.0f}},
+                    {{1.0f, 1.0f, 0.0f},   {1.0f, 1.0f}},
+                    {{-1.0f, 1.0f, 0.0f},  {0.0f, 1.0f}},
+                };
+                vertexBuffer = device->createBuffer(
+                    rhi::BufferDescriptor {
+                        .initialData = vertices.data(),
+                        .bufferSize  = vertices.size() * sizeof(Vertex),
+                        .bufferType  = rhi::BufferType::Vertex,
+                        .bufferUsage = rhi::BufferUsage::Immutable,
+                    });
+
+                auto shaderProgramDescriptor         = rhi::ShaderProgramDescriptor();
+                shaderProgramDescriptor.shaderName   = std::string(rhi::software::Device::objectShaderName);
+                shaderProgramDescriptor.bufferLayout = {
+                    {rhi::ShaderDataType::Float3, "position"},
+                    {rhi::ShaderDataType::Float2, "uv"      },
+                };
+                shaderProgram = device->createShaderProgram(shaderProgramDescriptor);
+
+                auto pipelineStateDescriptor          = rhi::PipelineStateDescriptor();
+                pipelineStateDescriptor.shaderProgram = shaderProgram;
+                pipelineState                         = device->createPipelineState(pipelineStateDescriptor);
+            }
+
+            ~QuadResources()
+            {
+                pipelineState->release();
+                shaderProgram->release();
+                vertexBuffer->release();
+            }
+
+            auto addQuad(Scene& scene, const math::Vector3f& position, const math::Vector3f& scale, float32 angle) const -> void
+            {
+                auto  entity    = scene.createEntity();
+                auto& transform = entity.addComponent<TransformComponent>();
+                transform.setPosition(position);
+                transform.setScale(scale);
+                transform.rotate({0.0f, 0.0f, angle});
+
+                auto& meshComponent        = entity.addComponent<MeshComponent>();
+                meshComponent.vertexBuffer = vertexBuffer;
+                meshComponent.vertexCount  = 6;
+
+                auto& materialComponent         = entity.addComponent<MaterialComponent>();
+                materialComponent.shaderProgram = shaderProgram;
+                materialComponent.pipelineState = pipelineState;
+            }
+        };
+
+        auto addCamera(Scene& scene, const math::Vector3f& position, float32 fov) -> void
+        {
+            auto camera = scene.createEntity();
+            camera.addComponent<TransformComponent>().setPosition(position);
+            camera.addComponent<CameraComponent>().camera = Camera(CameraType::Perspective, makePerspective(fov, width / height, 0.1f, 1000.0f));
+        }
+
+        /// \brief The four quads of the sandbox, seen from its camera.
+        auto populateSandbox(Scene& scene, const QuadResources& resources) -> void
+        {
+            addCamera(scene, {0.0f, 0.0f, -1.5f}, 45.0f);
+            for (const auto& position : {math::Vector3f(-1.0f, -1.0f, 1.0f), {1.0f, -1.0f, 1.0f}, {1.0f, 1.0f, 1.0f}, {-1.0f, 1.0f, 1.0f}})
+            {
+                resources.addQuad(scene, position / 2.0f, {0.25f, 0.25f, 1.0f}, 30.0f);
+            }
+            scene.transformSystem().update(scene.registery());
+        }
+
+        /// \brief `count` overlapping quads of random size, depth and rotation filling the view.
+        auto populateField(Scene& scene, const QuadResources& resources, usize count) -> void
+        {
+            auto random   = std::mt19937(42);
+            auto position = std::uniform_real_distribution<float32>(-1.0f, 1.0f);
+            auto size     = std::uniform_real_distribution<float32>(0.5f, 4.0f);
+            auto angle    = std::uniform_real_distribution<float32>(0.0f, 90.0f);
+
+            addCamera(scene, {0.0f, 0.0f, -60.0f}, 1.0f);
+            for (usize i = 0; i < count; ++i)
+            {
+                const auto depth = 20.0f * position(random);
+                const auto scale = size(random);
+                resources.addQuad(scene, {36.0f * position(random), 20.0f * position(random), depth}, {scale, scale, 1.0f}, angle(random));
+            }
+            scene.transformSystem().update(scene.registery());
+        }
+
+        auto renderFrame(rhi::RenderContext* renderContext, SceneRenderer& sceneRenderer, const RenderPacket& packet) -> void
+        {
+            renderContext->beginFrame();
+            sceneRenderer.render(renderContext, packet);
+            renderContext->present();
+            renderContext->endFrame();
+        }
+
+        auto renderTarget(rhi::software::RenderContext* renderContext) -> const rhi::software::RenderTarget*
+        {
+            return static_cast<rhi::software::SwapChain*>(renderContext->swapChain())->renderTarget();
+        }
+
+        auto sameImage(const rhi::software::RenderTarget* lhs, const rhi::software::RenderTarget* rhs) -> bool
+        {
+            for (uint32 y = 0; y < lhs->height(); ++y)
+            {
+                for (uint32 x = 0; x < lhs->width(); ++x)
+                {
+                    if (lhs->pixel(x, y) != rhs->pixel(x, y))
+                    {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
+
+        auto runSceneBenchmark(SoftwareBackend& backend, JobSystem& jobSystem, std::string_view name, usize quadCount) -> void
+        {
+            auto* device        = backend.device();
+            auto* renderContext = backend.renderContext();
+
+            const auto resources = QuadResources(device);
+            auto       scene     = Scene(EntityStorageType::Archetypes);
+            if (quadCount == 0)
+            {
+                populateSandbox(scene, resources);
+            }
+            else
+            {
+                populateField(scene, resources, quadCount);
+            }
+
+            auto sceneRenderer = SceneRenderer(scene, device, &jobSystem);
+            auto packet        = RenderPacket();
+            sceneRenderer.extract(packet);
+
+            const auto label = std::format("{} ({} draws, {} workers)", name, packet.draws.size(), device->jobSystem().workerCount());
+            measure(std::format("Software frame {}", label), 1, [&] { renderFrame(renderContext, sceneRenderer, packet); });
+
+            const auto& statistics = renderContext->statistics();
+            Log::info(
+                "Software rasterizer: {} triangles, {} rasterized, {} bin entries, {} fragments shaded",
+                statistics.trianglesSubmitted,
+                statistics.trianglesRasterized,
+                statistics.binEntries,
+                statistics.fragmentsShaded);
+
+            // The same frame on a device without workers must give the same image.
+            auto  serialDevice  = rhi::software::Device(0);
+            auto* serialContext = static_cast<rhi::software::RenderContext*>(serialDevice.createRenderContext(
+                rhi::RenderContextDescriptor {.swapChainDescriptor = {.window = backend.window}}));
+            auto serialRenderer = SceneRenderer(scene, &serialDevice, &jobSystem);
+            measure(std::format("Software frame {} single thread", name), 1, [&] { renderFrame(serialContext, serialRenderer, packet); }, 3);
+
+            const auto path = std::format("SoftwareRasterizer.{}.ppm", name);
+            Log::info(
+                "Images with and without workers {}, written to {}: {}",
+                check(sameImage(renderTarget(renderContext), renderTarget(serialContext))) ? "match" : "DIFFER",
+                path,
+                check(renderTarget(renderContext)->save(path)) ? "ok" : "FAILED");
+
+            serialContext->release();
+        }
+
+        /// \brief A rectangle cut in jittered triangles, each one nearer than the previous ones. A pixel covered twice
+        /// would be shaded twice and a pixel left out not at all, so the shaded fragments match the pixel centers in the
+        /// rectangle only when the fill rule is watertight.
+        auto runCoverageCheck(SoftwareBackend& backend) -> void
+        {
+            auto* device        = backend.device();
+            auto* renderContext = backend.renderContext();
+
+            device->registerShader(
+                "Benchmark.ScreenSpace",
+                rhi::software::Shader {
+                    .vertex =
+                        [](const rhi::software::VertexInput& input, rhi::software::Varyings&) {
+                            const auto position = input.attribute<math::Vector3f>(0);
+                            return math::Vector4f(position.x, position.y, position.z, 1.0f);
+                        },
+                    .fragment = [](const rhi::software::FragmentInput&) { return math::Vector4f(1.0f); },
+                });
+
+            constexpr auto cells  = 24;
+            constexpr auto left   = -0.613f;
+            constexpr auto right  = 0.721f;
+            constexpr auto bottom = -0.577f;
+            constexpr auto top    = 0.839f;
+
+            auto random  = std::mt19937(9);
+            auto jitter  = std::uniform_real_distribution<float32>(-0.25f, 0.25f);
+            auto corners = Vector<math::Vector2f>();
+            for (int32 j = 0; j <= cells; ++j)
+            {
+                for (int32 i = 0; i <= cells; ++i)
+                {
+                    const auto inner = i > 0 and i < cells and j > 0 and j < cells;
+                    const auto u     = (static_cast<float32>(i) + (inner ? jitter(random) : 0.0f)) / cells;
+                    const auto v     = (static_cast<float32>(j) + (inner ? jitter(random) : 0.0f)) / cells;
+                    corners.pushBack({i == cells ? right : left + (right - left) * u, j == cells ? top : bottom + (top - bottom) * v});
+                }
+            }
+
+            auto vertices = Vector<math::Vector3f>();
+            auto depth    = 0.9f;
+            auto addTriangle = [&](int32 a, int32 b, int32 c) {
+                for (const auto corner : {a, b, c})
+                {
+                    vertices.pushBack({corners[corner].x, corners[corner].y, depth});
+                }
+                depth -= 0.0005f;
+            };
+            for (int32 j = 0; j < cells; ++j)
+            {
+                for (int32 i = 0; i < cells; ++i)
+                {
+                    const auto corner = j * (cells + 1) + i;
+                    addTriangle(corner, corner + 1, corner + cells + 2);
+                    addTriangle(corner + cells + 2, corner + cells + 1, corner);  // Opposite winding.
+                }
+            }
+
+            auto* vertexBuffer = device->createBuffer(
+                rhi::BufferDescriptor {
+                    .initialData = vertices.data(),
+                    .bufferSize  = vertices.size() * sizeof(math::Vector3f),
+                    .bufferType  = rhi::BufferType::Vertex,
+                    .bufferUsage = rhi::BufferUsage::Immutable,
+                });
+            auto shaderProgramDescriptor         = rhi::ShaderProgramDescriptor();
+            shaderProgramDescriptor.shaderName   = "Benchmark.ScreenSpace";
+            shaderProgramDescriptor.bufferLayout = {{rhi::ShaderDataType::Float3, "position"}};
+            auto* shaderProgram                  = device->createShaderProgram(shaderProgramDescriptor);
+            auto  pipelineStateDescriptor        = rhi::PipelineStateDescriptor();
+            pipelineStateDescriptor.shaderProgram = shaderProgram;
+            auto* pipelineState                  = device->createPipelineState(pipelineStateDescriptor);
+
+            renderContext->beginFrame();
+            renderContext->beginRenderPass(renderContext->swapChain()->nextRenderTarget(), rhi::RenderPassDescriptor());
+            renderContext->bindPipelineState(pipelineState);
+            renderContext->bindVertexBuffer(vertexBuffer, 0, 0);
+            renderContext->draw(static_cast<uint32>(vertices.size()), 0);
+            renderContext->endRenderPass();
+            renderContext->endFrame();
+
+            // Pixel centers on the left and top edges are inside, on the right and bottom ones outside.
+            auto centers = [](float32 lower, float32 upper) {
+                return static_cast<int64>(std::ceil(upper - 0.5f)) - static_cast<int64>(std::ceil(lower - 0.5f));
+            };
+            const auto expected = centers((left * 0.5f + 0.5f) * width, (right * 0.5f + 0.5f) * width) *
+                                  centers((0.5f - top * 0.5f) * height, (0.5f - bottom * 0.5f) * height);
+            const auto shaded = static_cast<int64>(renderContext->statistics().fragmentsShaded);
+            Log::info(
+                "Coverage of {} triangles: {} fragments shaded for {} pixel centers, {}",
+                vertices.size() / 3,
+                shaded,
+                expected,
+                check(shaded == expected) ? "watertight" : "DIFFER");
+
+            pipelineState->release();
+            shaderProgram->release();
+            vertexBuffer->release();
+        }
+    }
+
+    auto runSoftwareRasterizerBenchmarks() -> void
+    {
+        auto backend   = SoftwareBackend();
+        auto jobSystem = JobSystem();
+
+        runCoverageCheck(backend);
+        runSceneBenchmark(backend, jobSystem, "Sandbox", 0);
+        runSceneBenchmark(backend, jobSystem, "Field1k", 1'000);
+        runSceneBenchmark(backend, jobSystem, "Field10k", 10'000);
+        runSceneBenchmark(backend, jobSystem, "Field100k", 100'000);
+    }
+}
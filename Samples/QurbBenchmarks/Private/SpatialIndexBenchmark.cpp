@@ -0,0 +1,232 @@
+#include "Benchmark.hpp"
+
+#include <Containers/Vector.hpp>
+#include <Math/Aabb.hpp>
+#include <Math/Frustum.hpp>
+#include <Math/Matrix4x4.hpp>
+#include <Scene/Components.hpp>
+#include <Scene/Scene.hpp>
+#include <Scene/SpatialIndex.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <format>
+#include <limits>
+#include <random>
+
+namespace qurb::benchmark
+{
+    namespace
+    {
+        constexpr auto queryCount = usize(256);
+
+        /// \brief The side of the cube holding `count` objects about four units apart.
+        auto worldSize(usize count) -> float32
+        {
+            return 4.0f * std::cbrt(static_cast<float32>(count));
+        }
+
+        /// \brief Random boxes with half extents up to 1 in a cube centered on the origin.
+        auto randomBoxes(usize count) -> Vector<math::Aabb>
+        {
+            const auto half     = worldSize(count) * 0.5f;
+            auto       random   = std::mt19937(7);
+            auto       position = std::uniform_real_distribution<float32>(-half, half);
+            auto       extent   = std::uniform_real_distribution<float32>(0.1f, 1.0f);
+
+            auto boxes = Vector<math::Aabb>(count);
+            for (auto& box : boxes)
+            {
+                const auto center = math::Vector3f(position(random), position(random), position(random));
+                box               = math::Aabb::fromCenterExtents(center, math::Vector3f(extent(random), extent(random), extent(random)));
+            }
+            return boxes;
+        }
+
+        /// \brief Random rays starting inside the cube.
+        auto randomRays(usize count, usize objectCount) -> Vector<math::Ray>
+        {
+            const auto half      = worldSize(objectCount) * 0.5f;
+            auto       random    = std::mt19937(11);
+            auto       position  = std::uniform_real_distribution<float32>(-half, half);
+            auto       direction = std::uniform_real_distribution<float32>(-1.0f, 1.0f);
+
+            auto rays = Vector<math::Ray>(count);
+            for (auto& ray : rays)
+            {
+                ray.origin    = math::Vector3f(position(random), position(random), position(random));
+                ray.direction = math::Vector3f(direction(random), direction(random), direction(random));
+            }
+            return rays;
+        }
+
+        auto runIndexBenchmark(usize count) -> void
+        {
+            const auto boxes   = randomBoxes(count);
+            const auto rays    = randomRays(queryCount, count);
+            const auto spheres = randomRays(queryCount, count);  // Only the origins are used, as centers.
+            const auto radius  = 8.0f;
+
+            auto index   = SpatialIndex();
+            auto proxies = Vector<SpatialIndex::ProxyId>(count);
+            measure(std::format("SpatialIndex insert incremental ({} objects)", count), count, [&] {
+                index.clear();
+                for (usize i = 0; i < count; ++i)
+                {
+                    proxies[i] = index.insert(static_cast<EntityId>(i), boxes[i]);
+                }
+            }, 3);
+            Log::info("SpatialIndex incremental: height {}, area ratio {:.1f}", index.height(), index.areaRatio());
+
+            measure(std::format("SpatialIndex rebuild SAH ({} objects)", count), count, [&] { index.rebuild(); }, 3);
+            Log::info("SpatialIndex SAH: height {}, area ratio {:.1f}", index.height(), index.areaRatio());
+
+            // Reference queries scan the enlarged boxes, the index must return exactly the same entities.
+            auto fatBoxes = Vector<math::Aabb>(count);
+            for (usize i = 0; i < count; ++i)
+            {
+                fatBoxes[i] = index.bounds(proxies[i]);
+            }
+
+            // A camera at the origin looking down +z up to the side of the cube.
+            const auto frustum = math::makeFrustum(makePerspective(1.0f, 16.0f / 9.0f, 0.1f, worldSize(count) * 0.5f));
+            usize      indexed = 0;
+            usize      linear  = 0;
+            measure(std::format("SpatialIndex frustum query ({} objects)", count), count, [&] {
+                indexed = 0;
+                index.queryFrustum(frustum, [&](EntityId) { ++indexed; });
+            });
+            measure(std::format("Linear frustum scan ({} objects)", count), count, [&] {
+                linear = 0;
+                for (const auto& box : fatBoxes)
+                {
+                    linear += math::classify(frustum, box) != math::Containment::Outside;
+                }
+            });
+            Log::info("Frustum: {} visible through the index, {} by the scan, {}", indexed, linear, check(indexed == linear) ? "match" : "DIFFER");
+
+            measure(std::format("SpatialIndex {} sphere queries ({} objects)", queryCount, count), queryCount, [&] {
+                indexed = 0;
+                for (const auto& sphere : spheres)
+                {
+                    index.querySphere(sphere.origin, radius, [&](EntityId) { ++indexed; });
+                }
+            });
+            measure(std::format("Linear {} sphere scans ({} objects)", queryCount, count), queryCount, [&] {
+                linear = 0;
+                for (const auto& sphere : spheres)
+                {
+                    for (const auto& box : fatBoxes)
+                    {
+                        linear += math::overlapsSphere(box, sphere.origin, radius);
+                    }
+                }
+            }, 3);
+            Log::info("Spheres: {} overlaps through the index, {} by the scan, {}", indexed, linear, check(indexed == linear) ? "match" : "DIFFER");
+
+            auto indexedDistance = 0.0f;
+            auto linearDistance  = 0.0f;
+            measure(std::format("SpatialIndex {} raycasts ({} objects)", queryCount, count), queryCount, [&] {
+                indexedDistance = 0.0f;
+                for (const auto& ray : rays)
+                {
+                    const auto hit = index.raycast(ray);
+                    indexedDistance += hit.hit() ? hit.distance : 0.0f;
+                }
+            });
+            measure(std::format("Linear {} raycasts ({} objects)", queryCount, count), queryCount, [&] {
+                linearDistance = 0.0f;
+                for (const auto& ray : rays)
+                {
+                    const auto inverseDirection = math::Vector3f(1.0f / ray.direction.x, 1.0f / ray.direction.y, 1.0f / ray.direction.z);
+                    auto       closest          = std::numeric_limits<float32>::max();
+                    auto       hit              = false;
+                    for (const auto& box : fatBoxes)
+                    {
+                        auto distance = 0.0f;
+                        if (math::intersectRay(box, ray.origin, inverseDirection, closest, distance))
+                        {
+                            closest = distance;
+                            hit     = true;
+                        }
+                    }
+                    linearDistance += hit ? closest : 0.0f;
+                }
+            }, 3);
+            // The same hits are summed in the same order, only the box tests may round differently.
+            const auto closeEnough = std::abs(indexedDistance - linearDistance) <= 1e-4f * std::max(1.0f, linearDistance);
+            Log::info(
+                "Rays: summed hit distance {:.3f} through the index, {:.3f} by the scan, {}",
+                indexedDistance,
+                linearDistance,
+                check(closeEnough) ? "match" : "DIFFER");
+
+            // A tenth of the objects jitters within the margin, another tenth jumps across the world.
+            auto random = std::mt19937(3);
+            auto jitter = std::uniform_real_distribution<float32>(-0.05f, 0.05f);
+            auto jump   = std::uniform_real_distribution<float32>(-worldSize(count) * 0.5f, worldSize(count) * 0.5f);
+            auto moved  = boxes;
+            measure(std::format("SpatialIndex move 10% jitter + 10% jump ({} objects)", count), count / 5, [&] {
+                for (usize i = 0; i < count; i += 10)
+                {
+                    const auto offset = math::Vector3f(jitter(random), jitter(random), jitter(random));
+                    index.move(proxies[i], math::Aabb {.lower = boxes[i].lower + offset, .upper = boxes[i].upper + offset});
+                }
+                for (usize i = 5; i < count; i += 10)
+                {
+                    const auto center = math::Vector3f(jump(random), jump(random), jump(random));
+                    moved[i]          = math::Aabb::fromCenterExtents(center, boxes[i].extents());
+                    index.move(proxies[i], moved[i]);
+                }
+            });
+            Log::info("SpatialIndex after moves: height {}, area ratio {:.1f}", index.height(), index.areaRatio());
+        }
+
+        /// \brief The index kept in sync with a scene where a hundredth of the entities moves every frame.
+        auto runSceneBenchmark(usize count) -> void
+        {
+            const auto boxes = randomBoxes(count);
+            auto       scene = Scene(EntityStorageType::Archetypes);
+            auto       ids   = Vector<EntityId>(count);
+            for (usize i = 0; i < count; ++i)
+            {
+                auto entity = scene.createEntity();
+                entity.addComponent<TransformComponent>().setPosition(boxes[i].center());
+                entity.addComponent<BoundsComponent>().extents = boxes[i].extents();
+                ids[i]                                         = entity.id();
+            }
+            scene.transformSystem().update(scene.registery());
+
+            measure(std::format("Scene spatial index initial update ({} entities)", count), count, [&] {
+                scene.spatialIndex().clear();
+                scene.updateSpatialIndex();
+            }, 3);
+
+            auto random = std::mt19937(5);
+            auto step   = std::uniform_real_distribution<float32>(-0.5f, 0.5f);
+            measure(std::format("Scene transform + spatial index update, 1% moving ({} entities)", count), count, [&] {
+                for (usize i = 0; i < count; i += 100)
+                {
+                    scene.registery().getComponent<TransformComponent>(ids[i]).translate({step(random), step(random), step(random)});
+                }
+                scene.transformSystem().update(scene.registery());
+                scene.updateSpatialIndex();
+            });
+            Log::info(
+                "Scene spatial index: {} proxies, {} reinserted in the last update, height {}, {}",
+                scene.spatialIndex().proxyCount(),
+                scene.spatialIndex().reinsertedCount(),
+                scene.spatialIndex().height(),
+                check(scene.spatialIndex().proxyCount() == count) ? "ok" : "UNEXPECTED");
+        }
+    }
+
+    auto runSpatialIndexBenchmarks() -> void
+    {
+        runIndexBenchmark(10'000);
+        runIndexBenchmark(100'000);
+        runIndexBenchmark(1'000'000);
+        runSceneBenchmark(10'000);
+        runSceneBenchmark(100'000);
+    }
+}
@@ -0,0 +1,120 @@
+#include "Benchmark.hpp"
+
+#include <Containers/Vector.hpp>
+#include <Math/Vector3.hpp>
+#include <Scene/Components.hpp>
+#include <Scene/Entity.hpp>
+#include <Scene/EntityRegistery.hpp>
+#include <Scene/SystemScheduler.hpp>
+#include <Threading/JobSystem.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <format>
+
+namespace qurb::benchmark
+{
+    namespace
+    {
+        struct VelocityComponent
+        {
+            math::Vector3f linear  = math::Vector3f::one;
+            math::Vector3f angular = math::Vector3f::one;
+        };
+
+        struct HealthComponent
+        {
+            float32 current = 50.0f;
+            float32 maximum = 100.0f;
+        };
+
+        auto addSystems(SystemScheduler& scheduler) -> void
+        {
+            scheduler.addSystem(
+                "Integrate velocities",
+                SystemAccess().write<TransformComponent>().read<VelocityComponent>(),
+                [](const SystemContext& context) {
+                    context.parallelEach<TransformComponent, VelocityComponent>(
+                        [&](TransformComponent& transformComponent, VelocityComponent& velocityComponent) {
+                            transformComponent.translate(velocityComponent.linear * context.deltaTime());
+                            transformComponent.rotate(velocityComponent.angular * context.deltaTime());
+                        });
+                });
+
+            // Writes the velocities the integration reads, so it has to wait for it.
+            scheduler.addSystem(
+                "Damp velocities",
+                SystemAccess().write<VelocityComponent>(),
+                [](const SystemContext& context) {
+                    context.parallelEach<VelocityComponent>([](VelocityComponent& velocityComponent) {
+                        velocityComponent.linear *= 0.99f;
+                        velocityComponent.angular *= 0.99f;
+                    });
+                });
+
+            // Independent of both, free to run alongside them.
+            scheduler.addSystem(
+                "Regenerate health",
+                SystemAccess().write<HealthComponent>(),
+                [](const SystemContext& context) {
+                    context.parallelEach<HealthComponent>([&](HealthComponent& healthComponent) {
+                        healthComponent.current = std::min(healthComponent.maximum, healthComponent.current + std::sqrt(context.deltaTime()));
+                    });
+                });
+
+            scheduler.addSystem(
+                "Build transform matrices",
+                SystemAccess().write<TransformComponent>(),
+                [](const SystemContext& context) {
+                    context.parallelEach<TransformComponent>([](TransformComponent& transformComponent) {
+                        static_cast<void>(transformComponent.transformMatrix());
+                    });
+                });
+        }
+
+        auto runSchedulerBenchmark(EntityStorageType storageType, usize entityCount, uint32 workerCount) -> void
+        {
+            auto registery = EntityRegistery(storageType);
+            for (usize i = 0; i < entityCount; ++i)
+            {
+                auto entity = registery.createEntity();
+                entity.addComponent<TransformComponent>();
+                entity.addComponent<VelocityComponent>();
+                entity.addComponent<HealthComponent>();
+            }
+
+            auto jobSystem = JobSystem(workerCount);
+            auto scheduler = SystemScheduler(jobSystem);
+            addSystems(scheduler);
+
+            const auto storageName = storageType == EntityStorageType::Archetypes ? "archetypes" : "pools";
+            measure(std::format("4 systems {} {} workers ({} entities)", storageName, workerCount, entityCount), entityCount, [&] {
+                scheduler.run(registery, 1.0f / 60.0f);
+            });
+            scheduler.logTimings();
+        }
+    }
+
+    auto runSystemSchedulerBenchmarks() -> void
+    {
+        // From the calling thread alone up to every hardware thread, doubling the workers each time.
+        const auto maxWorkers   = JobSystem::defaultWorkerCount();
+        auto       workerCounts = Vector<uint32> {0};
+        for (uint32 workerCount = 1; workerCount < maxWorkers; workerCount *= 2)
+        {
+            workerCounts.pushBack(workerCount);
+        }
+        if (maxWorkers > 0)
+        {
+            workerCounts.pushBack(maxWorkers);
+        }
+
+        for (const auto storageType : {EntityStorageType::ComponentPools, EntityStorageType::Archetypes})
+        {
+            for (const auto workerCount : workerCounts)
+            {
+                runSchedulerBenchmark(storageType, 1'000'000, workerCount);
+            }
+        }
+    }
+}
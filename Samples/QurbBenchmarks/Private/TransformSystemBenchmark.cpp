@@ -0,0 +1,180 @@
+#include "Benchmark.hpp"
+
+#include <Containers/Vector.hpp>
+#include <Math/Matrix4x4.hpp>
+#include <Scene/Components.hpp>
+#include <Scene/Entity.hpp>
+#include <Scene/EntityRegistery.hpp>
+#include <Scene/TransformSystem.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <format>
+#include <random>
+
+namespace qurb::benchmark
+{
+    namespace
+    {
+        /// \brief The world matrix of `id` rebuilt from scratch like `TransformComponent::transformMatrix` used to: three
+        /// full products per level and the parent chain walked every time.
+        auto naiveWorldMatrix(EntityRegistery& registery, EntityId id) -> math::Matrix4x4f
+        {
+            const auto& transformComponent = registery.getComponent<TransformComponent>(id);
+
+            auto localMatrix = translationMatrix(transformComponent.position());
+            localMatrix *= rotationMatrix(transformComponent.eulerAngles());
+            localMatrix *= scaleMatrix(transformComponent.scale());
+
+            if (not registery.hasComponent<ParentComponent>(id))
+            {
+                return localMatrix;
+            }
+            return naiveWorldMatrix(registery, registery.getComponent<ParentComponent>(id).parent) * localMatrix;
+        }
+
+        /// \brief Builds `rootCount` trees of `depth` levels below the root, each node having `fanOut` children.
+        auto runHierarchyBenchmark(EntityStorageType storageType, usize rootCount, uint32 depth, uint32 fanOut) -> void
+        {
+            auto registery       = EntityRegistery(storageType);
+            auto transformSystem = TransformSystem();
+            auto random          = std::mt19937(42);
+            auto distribution    = std::uniform_real_distribution<float32>(-10.0f, 10.0f);
+
+            auto entities = Vector<EntityId>();
+            auto level    = Vector<EntityId>();
+            for (usize i = 0; i < rootCount; ++i)
+            {
+                auto  entity             = registery.createEntity();
+                auto& transformComponent = entity.addComponent<TransformComponent>();
+                transformComponent.setPosition({distribution(random), distribution(random), distribution(random)});
+                level.pushBack(entity.id());
+                entities.pushBack(entity.id());
+            }
+
+            for (uint32 d = 0; d < depth; ++d)
+            {
+                auto nextLevel = Vector<EntityId>();
+                for (const auto parent : level)
+                {
+                    for (uint32 i = 0; i < fanOut; ++i)
+                    {
+                        auto  entity             = registery.createEntity();
+                        auto& transformComponent = entity.addComponent<TransformComponent>();
+                        transformComponent.setPosition({distribution(random), distribution(random), distribution(random)});
+                        transformComponent.setEulerAngles({distribution(random), distribution(random), distribution(random)});
+                        transformComponent.setScale({0.9f, 0.9f, 0.9f});
+                        transformSystem.setParent(registery, entity.id(), parent);
+                        nextLevel.pushBack(entity.id());
+                        entities.pushBack(entity.id());
+                    }
+                }
+                level = std::move(nextLevel);
+            }
+
+            const auto nodeCount   = entities.size();
+            const auto storageName = storageType == EntityStorageType::Archetypes ? "archetypes" : "pools";
+            transformSystem.update(registery);
+
+            // Every world matrix must match the naive computation.
+            auto maxError = [&] {
+                auto error = 0.0f;
+                for (const auto id : entities)
+                {
+                    const auto  expected = naiveWorldMatrix(registery, id);
+                    const auto& actual   = transformSystem.worldMatrix(registery.getComponent<TransformComponent>(id));
+                    for (uint32 i = 0; i < 16; ++i)
+                    {
+                        error = std::max(error, std::abs(expected.data()[i] - actual.data()[i]));
+                    }
+                }
+                return error;
+            };
+            Log::info("TransformSystem {} nodes max error against the naive matrices: {}", nodeCount, maxError());
+
+            measure(std::format("naive world matrices {} ({} nodes)", storageName, nodeCount), nodeCount, [&] {
+                for (const auto id : entities)
+                {
+                    doNotOptimize(naiveWorldMatrix(registery, id));
+                }
+            });
+
+            measure(std::format("TransformSystem all dirty {} ({} nodes)", storageName, nodeCount), nodeCount, [&] {
+                registery.each<TransformComponent>([](TransformComponent& transformComponent) {
+                    transformComponent.translate(math::Vector3f::zero);
+                });
+                transformSystem.update(registery);
+            });
+
+            // One root in a hundred moves, its whole subtree follows.
+            measure(std::format("TransformSystem 1% roots dirty {} ({} nodes)", storageName, nodeCount), nodeCount, [&] {
+                for (usize i = 0; i < rootCount; i += 100)
+                {
+                    registery.getComponent<TransformComponent>(entities[i]).translate({0.0f, 0.0f, 0.1f});
+                }
+                transformSystem.update(registery);
+            });
+
+            measure(std::format("TransformSystem static {} ({} nodes)", storageName, nodeCount), nodeCount, [&] {
+                transformSystem.update(registery);
+            });
+            Log::info(
+                "TransformSystem static update recomputed {} matrices, {}",
+                transformSystem.updatedCount(),
+                check(transformSystem.updatedCount() == 0) ? "ok" : "UNEXPECTED");
+            Log::info("TransformSystem {} nodes max error after the incremental updates: {}", nodeCount, maxError());
+        }
+
+        /// \brief A transform copied onto a new entity while another is destroyed, the count unchanged, gets a world
+        /// matrix of its own.
+        auto runStructureCheck(EntityStorageType storageType) -> void
+        {
+            auto registery       = EntityRegistery(storageType);
+            auto transformSystem = TransformSystem();
+
+            auto source = registery.createEntity();
+            auto victim = registery.createEntity();
+            source.addComponent<TransformComponent>().setPosition({1.0f, 0.0f, 0.0f});
+            victim.addComponent<TransformComponent>().setPosition({2.0f, 0.0f, 0.0f});
+            transformSystem.update(registery);
+
+            auto copy      = registery.createEntity();
+            auto transform = source.getComponent<TransformComponent>();
+            transform.setPosition({3.0f, 0.0f, 0.0f});
+            copy.addComponent<TransformComponent>(transform);
+            registery.destroyEntity(victim.id());
+            transformSystem.update(registery);
+
+            const auto& copyWorld   = transformSystem.worldMatrix(copy.getComponent<TransformComponent>());
+            const auto& sourceWorld = transformSystem.worldMatrix(source.getComponent<TransformComponent>());
+            const auto  ok          = copyWorld[0, 3] == 3.0f and sourceWorld[0, 3] == 1.0f;
+            Log::info(
+                "TransformSystem copied transform {}: {}",
+                storageType == EntityStorageType::Archetypes ? "archetypes" : "pools",
+                check(ok) ? "ok" : "UNEXPECTED");
+
+            // Children spawned under a parent and despawned, frame after frame, do not pile up in its children list.
+            for (usize i = 0; i < 1'000; ++i)
+            {
+                auto child = registery.createEntity();
+                child.addComponent<TransformComponent>();
+                transformSystem.setParent(registery, child.id(), source.id());
+                transformSystem.update(registery);
+                registery.destroyEntity(child.id());
+                transformSystem.update(registery);
+            }
+            const auto childrenLeft = source.getComponent<ChildrenComponent>().children.size();
+            Log::info("TransformSystem children left after 1000 spawn/despawn: {}, {}", childrenLeft, check(childrenLeft == 0) ? "ok" : "UNEXPECTED");
+        }
+    }
+
+    auto runTransformSystemBenchmarks() -> void
+    {
+        for (const auto storageType : {EntityStorageType::ComponentPools, EntityStorageType::Archetypes})
+        {
+            runHierarchyBenchmark(storageType, 10'000, 2, 4);
+            runHierarchyBenchmark(storageType, 100'000, 2, 4);
+            runStructureCheck(storageType);
+        }
+    }
+}
@@ -0,0 +1,151 @@
+/// \file Benchmark.hpp
+/// \brief A minimal timing harness shared by the engine benchmarks.
+
+#pragma once
+
+#include <CoreTypes.hpp>
+#include <Log/Log.hpp>
+
+#include <chrono>
+#include <string>
+#include <string_view>
+
+namespace qurb::benchmark
+{
+    /// \brief The `Result` struct.
+    struct Result
+    {
+        std::string name;
+        usize       operations;
+        float64     bestMilliseconds;
+        float64     averageMilliseconds;
+
+    public:
+        [[nodiscard]] auto nanosecondsPerOperation() const -> float64;
+        [[nodiscard]] auto operationsPerSecond() const -> float64;
+    };
+
+    /// \brief Prevents the compiler from optimizing away a computed value.
+    template <typename T>
+    auto doNotOptimize(const T& value) -> void;
+
+    /// \brief Runs `function` `repetitions` times after one warm-up run and reports the timings.
+    /// \param name The name printed in the report.
+    /// \param operations The number of operations performed by one call to `function`, used to compute the throughput.
+    /// \param function The function to measure.
+    /// \param repetitions The number of measured runs.
+    template <typename F>
+    auto measure(std::string_view name, usize operations, F&& function, uint32 repetitions = 5) -> Result;
+
+    /// \brief Prints a result on the console.
+    auto report(const Result& result) -> void;
+
+    /// \brief Records the outcome of a self-check, any failed check makes the benchmarks exit with a non-zero status.
+    /// \return `passed`, so that the outcome can be reported where it is checked.
+    auto check(bool passed) -> bool;
+
+    /// \brief The number of checks failed so far.
+    [[nodiscard]] auto failedCheckCount() -> usize;
+
+    //------------------------------------------------------------------------------------------------------------------
+    // Suites
+    //------------------------------------------------------------------------------------------------------------------
+
+    auto runBatchMathBenchmarks() -> void;
+    auto runBufferConformanceBenchmarks() -> void;
+    auto runCommandListBenchmarks() -> void;
+    auto runEntityCommandBufferBenchmarks() -> void;
+    auto runEntityRegisteryBenchmarks() -> void;
+    auto runEntityStorageBenchmarks() -> void;
+    auto runFrameAllocatorBenchmarks() -> void;
+    auto runFramePipelineBenchmarks() -> void;
+    auto runFrustumCullingBenchmarks() -> void;
+    auto runJobSystemBenchmarks() -> void;
+    auto runPipelineCacheBenchmarks() -> void;
+    auto runRenderPacketBenchmarks() -> void;
+    auto runSceneRendererBenchmarks() -> void;
+    auto runShaderCacheBenchmarks() -> void;
+    auto runShaderRegistryBenchmarks() -> void;
+    auto runSoftwareRasterizerBenchmarks() -> void;
+    auto runSpatialIndexBenchmarks() -> void;
+    auto runSystemSchedulerBenchmarks() -> void;
+    auto runTransformSystemBenchmarks() -> void;
+    auto runMatrix4x4Benchmarks() -> void;
+
+    //------------------------------------------------------------------------------------------------------------------
+    // Implementation
+    //------------------------------------------------------------------------------------------------------------------
+
+    inline auto Result::nanosecondsPerOperation() const -> float64
+    {
+        return operations == 0 ? 0.0 : bestMilliseconds * 1'000'000.0 / static_cast<float64>(operations);
+    }
+
+    inline auto Result::operationsPerSecond() const -> float64
+    {
+        return bestMilliseconds == 0.0 ? 0.0 : static_cast<float64>(operations) * 1000.0 / bestMilliseconds;
+    }
+
+    template <typename T>
+    auto doNotOptimize(const T& value) -> void
+    {
+        asm volatile("" : : "r,m"(value) : "memory");
+    }
+
+    template <typename F>
+    auto measure(std::string_view name, usize operations, F&& function, uint32 repetitions) -> Result
+    {
+        using Clock    = std::chrono::steady_clock;
+        using Duration = std::chrono::duration<float64, std::milli>;
+
+        function();
+
+        auto result = Result {
+            .name                = std::string(name),
+            .operations          = operations,
+            .bestMilliseconds    = 0.0,
+            .averageMilliseconds = 0.0,
+        };
+
+        for (uint32 i = 0; i < repetitions; ++i)
+        {
+            const auto start = Clock::now();
+            function();
+            const auto elapsed = Duration(Clock::now() - start).count();
+
+            result.bestMilliseconds = (i == 0 or elapsed < result.bestMilliseconds) ? elapsed : result.bestMilliseconds;
+            result.averageMilliseconds += elapsed / static_cast<float64>(repetitions);
+        }
+
+        report(result);
+        return result;
+    }
+
+    inline auto failedChecks() -> usize&
+    {
+        static auto count = usize(0);
+        return count;
+    }
+
+    inline auto check(bool passed) -> bool
+    {
+        failedChecks() += not passed;
+        return passed;
+    }
+
+    inline auto failedCheckCount() -> usize
+    {
+        return failedChecks();
+    }
+
+    inline auto report(const Result& result) -> void
+    {
+        Log::info(
+            "{:<56} best {:>10.3f} ms | avg {:>10.3f} ms | {:>9.2f} ns/op | {:>12.0f} op/s",
+            result.name,
+            result.bestMilliseconds,
+            result.averageMilliseconds,
+            result.nanosecondsPerOperation(),
+            result.operationsPerSecond());
+    }
+}
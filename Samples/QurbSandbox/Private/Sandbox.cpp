@@ -47,11 +47,15 @@ auto SandboxApplication::initialize() -> void
     _renderContext->retain();
     _renderContext->window().registerEvent<WindowResizeEvent>(bind<&SandboxApplication::onWindowResize>(this));
 
-    _scene         = std::make_unique<Scene>();
-    _sceneRenderer = std::make_unique<SceneRenderer>(*_scene, _device);
+    _shaderRegistry  = std::make_unique<ShaderRegistry>(_device, &_engine->jobSystem());
+    _scene           = std::make_unique<Scene>();
+    _sceneRenderer   = std::make_unique<SceneRenderer>(*_scene, _device, &_engine->jobSystem());
+    _systemScheduler = std::make_unique<SystemScheduler>(_engine->jobSystem());
+    _renderPackets.resize(_frameLoop.slotCount());
 
     createCamera();
     createQuad();
+    createSystems();
 
     onWindowResize(WindowResizeEvent(_renderContext->window()));
 
@@ -60,24 +64,14 @@ auto SandboxApplication::initialize() -> void
 
 auto SandboxApplication::shutdown() -> void
 {
-    for (auto& entity : _scene->entities())
-    {
-        if (entity.hasComponent<MaterialComponent>())
-        {
-            auto& materialComponent = entity.getComponent<MaterialComponent>();
-            materialComponent.pipelineState->release();
-            materialComponent.shaderProgram->release();
-        }
-
-        if (entity.hasComponent<MeshComponent>())
-        {
-            auto& meshComponent = entity.getComponent<MeshComponent>();
-            meshComponent.vertexBuffer->release();
-        }
-    }
+    _quadPipelineState->release();
+    _quadShaderProgram.reset();
+    _quadVertexBuffer->release();
 
+    _systemScheduler.reset();
     _sceneRenderer.reset();
     _scene.reset();
+    _shaderRegistry.reset();
 
     _renderContext->window().unregisterEvent<WindowResizeEvent>(bind<&SandboxApplication::onWindowResize>(this));
     _renderContext->release();
@@ -91,25 +85,19 @@ auto SandboxApplication::shutdown() -> void
 
 auto SandboxApplication::update(float32 deltaTime) -> void
 {
-    static auto time = 0.0f;
-    time += deltaTime;
+    _systemScheduler->run(_scene->registery(), deltaTime);
+}
 
-    for (auto& entity : _scene->entities())
-    {
-        if (entity.hasComponent<CameraComponent>())
-        {
-            continue;
-        }
-        auto& transformComponent = entity.getComponent<TransformComponent>();
-        transformComponent.eulerAngles.z += deltaTime * 50.0f;
-    }
+auto SandboxApplication::extract(uint32 slot) -> void
+{
+    _sceneRenderer->extract(_renderPackets[slot]);
 }
 
-auto SandboxApplication::render() -> void
+auto SandboxApplication::render(uint32 slot) -> void
 {
     _renderContext->beginFrame();
 
-    _sceneRenderer->render(_renderContext);
+    _sceneRenderer->render(_renderContext, _renderPackets[slot]);
 
     _renderContext->present();
     _renderContext->endFrame();
@@ -117,17 +105,13 @@ auto SandboxApplication::render() -> void
 
 auto SandboxApplication::onWindowResize(const WindowResizeEvent& event) -> bool
 {
-    for (auto& entity : _scene->entities())
+    for (auto [cameraComponent] : _scene->registery().view<CameraComponent>())
     {
-        if (entity.hasComponent<CameraComponent>())
-        {
-            auto&   cameraComponent = entity.getComponent<CameraComponent>();
-            float32 aspectRatio     = static_cast<float32>(event.window.size().x) / static_cast<float32>(event.window.size().y);
-            // auto  projection       = makeOrthographic(0.0f, event.window.size().x, 0.0f, event.window.size().y, 0.1, 1000);
-            auto projection        = makePerspective(45.0f, aspectRatio, 0.1f, 1000.0f);
-            cameraComponent.camera = Camera(CameraType::Perspective, projection);
-            break;
-        }
+        float32 aspectRatio = static_cast<float32>(event.window.size().x) / static_cast<float32>(event.window.size().y);
+        // auto  projection       = makeOrthographic(0.0f, event.window.size().x, 0.0f, event.window.size().y, 0.1, 1000);
+        auto projection        = makePerspective(45.0f, aspectRatio, 0.1f, 1000.0f);
+        cameraComponent.camera = Camera(CameraType::Perspective, projection);
+        break;
     }
 
     return false;
@@ -145,6 +129,34 @@ auto SandboxApplication::createQuad() -> void
         {-1.0f, 1.0f,  1.0f},
     };
 
+    _quadVertexBuffer = _device->createBuffer(
+        rhi::BufferDescriptor {
+            .initialData = vertices.data(),
+            .bufferSize  = sizeof(Vertex3d) * vertices.size(),
+            .bufferType  = rhi::BufferType::Vertex,
+            .bufferUsage = rhi::BufferUsage::Immutable,
+        });
+
+    rhi::ShaderProgramDescriptor shaderProgramDescriptor;
+    shaderProgramDescriptor.shaderName           = "Object.Builtin";
+    shaderProgramDescriptor.vertexFunctionName   = "vertex_main";
+    shaderProgramDescriptor.fragmentFunctionName = "fragment_main";
+    shaderProgramDescriptor.bufferLayout         = Vertex3d::vertexFormat();
+
+    _quadShaderProgram = _shaderRegistry->load(shaderProgramDescriptor);
+
+    rhi::PipelineStateDescriptor pipelineStateDescriptor;
+    pipelineStateDescriptor.shaderProgram = _quadShaderProgram.get();
+
+    _quadPipelineState = _device->createPipelineState(pipelineStateDescriptor);
+
+    auto vertexPositions = Vector<math::Vector3f>();
+    for (const auto& vertex : vertices)
+    {
+        vertexPositions.pushBack(vertex.position);
+    }
+    const auto quadBounds = BoundsComponent::fromPoints(vertexPositions);
+
     for (int i = 0; i < quadCount; ++i)
     {
         _scene->createEntity();
@@ -161,30 +173,15 @@ auto SandboxApplication::createQuad() -> void
         auto& meshComponent      = entity.addComponent<MeshComponent>();
         auto& materialComponent  = entity.addComponent<MaterialComponent>();
 
-        transformComponent.position = positions[i] / 2.0f;
-        transformComponent.scale    = {.25f, .25f, 1.0f};
-
-        meshComponent.vertexBuffer = _device->createBuffer(
-            rhi::BufferDescriptor {
-                .bufferSize  = sizeof(Vertex3d) * vertices.size(),
-                .bufferType  = rhi::BufferType::Vertex,
-                .bufferUsage = rhi::BufferUsage::Immutable,
-                .initialData = vertices.data(),
-            });
-        meshComponent.vertexCount = static_cast<uint32>(vertices.size());
-
-        rhi::ShaderProgramDescriptor shaderProgramDescriptor;
-        shaderProgramDescriptor.shaderName           = "Object.Builtin";
-        shaderProgramDescriptor.vertexFunctionName   = "vertex_main";
-        shaderProgramDescriptor.fragmentFunctionName = "fragment_main";
-        shaderProgramDescriptor.bufferLayout         = Vertex3d::vertexFormat();
+        transformComponent.setPosition(positions[i] / 2.0f);
+        transformComponent.setScale({.25f, .25f, 1.0f});
 
-        materialComponent.shaderProgram = _device->createShaderProgram(shaderProgramDescriptor);
+        meshComponent.vertexBuffer      = _quadVertexBuffer;
+        meshComponent.vertexCount       = static_cast<uint32>(vertices.size());
+        materialComponent.shaderProgram = _quadShaderProgram.get();
+        materialComponent.pipelineState = _quadPipelineState;
 
-        rhi::PipelineStateDescriptor pipelineStateDescriptor;
-        pipelineStateDescriptor.shaderProgram = materialComponent.shaderProgram;
-
-        materialComponent.pipelineState = _device->createPipelineState(pipelineStateDescriptor);
+        entity.addComponent<BoundsComponent>() = quadBounds;
     }
 }
 
@@ -197,13 +194,39 @@ auto SandboxApplication::createCamera() -> void
     auto& transformComponent = cameraEntity.addComponent<TransformComponent>();
     auto& cameraComponent    = cameraEntity.addComponent<CameraComponent>();
 
-    transformComponent.position = {0.0f, 0.0f, -1.5f};
+    transformComponent.setPosition({0.0f, 0.0f, -1.5f});
+}
+
+auto SandboxApplication::createSystems() -> void
+{
+    // Only the quads carry a mesh, the camera is left in place.
+    _systemScheduler->addSystem(
+        "Rotate quads",
+        SystemAccess().write<TransformComponent>().read<MeshComponent>(),
+        [](const SystemContext& context) {
+            context.parallelEach<TransformComponent, MeshComponent>([&](TransformComponent& transformComponent, MeshComponent&) {
+                transformComponent.rotate({0.0f, 0.0f, context.deltaTime() * 50.0f});
+            });
+        });
+
+    // Writes transforms too, so the scheduler runs it once the rotation is done. Only the rotated quads are recomputed.
+    _systemScheduler->addSystem(
+        "Update transforms",
+        SystemAccess().write<TransformComponent>().read<ParentComponent, ChildrenComponent>(),
+        [this](const SystemContext& context) { _scene->transformSystem().update(context.registery()); });
+
+    // Reads the transforms, so it runs after the update above and only refits the quads that left their leaf.
+    _systemScheduler->addSystem(
+        "Update spatial index",
+        SystemAccess().read<TransformComponent, BoundsComponent>(),
+        [this](const SystemContext&) { _scene->updateSpatialIndex(); });
 }
 
 auto qurb::createApplication() -> Application*
 {
     ApplicationDescriptor descriptor = {
-        .name = "Qurb Sandbox",
+        .name      = "Qurb Sandbox",
+        .frameLoop = {.mode = FrameLoopMode::Pipelined, .framesInFlight = 3},
     };
 
     return new SandboxApplication(descriptor);
@@ -5,8 +5,11 @@
 #include <Events/WindowEvents.hpp>
 #include <RHI/Device.hpp>
 #include <RHI/RenderContext.hpp>
+#include <Renderer/ShaderRegistry.hpp>
+#include <Scene/RenderPacket.hpp>
 #include <Scene/Scene.hpp>
 #include <Scene/SceneRenderer.hpp>
+#include <Scene/SystemScheduler.hpp>
 
 using namespace qurb;
 
@@ -21,25 +24,38 @@ public:
     auto shutdown() -> void override;
 
     auto update(float32 deltaTime) -> void override;
-    auto render() -> void override;
+    auto extract(uint32 slot) -> void override;
+    auto render(uint32 slot) -> void override;
 
 private:
     auto onWindowResize(const WindowResizeEvent& event) -> bool;
 
     auto createQuad() -> void;
     auto createCamera() -> void;
+    auto createSystems() -> void;
 
 private:
-    rhi::Device*                   _device;
-    rhi::RenderContext*            _renderContext;
-    std::unique_ptr<Scene>         _scene;
-    std::unique_ptr<SceneRenderer> _sceneRenderer;
+    rhi::Device*                     _device;
+    rhi::RenderContext*              _renderContext;
+    std::unique_ptr<ShaderRegistry>  _shaderRegistry;
+    rhi::Buffer*                     _quadVertexBuffer;  // Shared by every quad, so that they render as one batch.
+    rhi::Ref<rhi::ShaderProgram>     _quadShaderProgram;
+    rhi::PipelineState*              _quadPipelineState;
+    std::unique_ptr<Scene>           _scene;
+    std::unique_ptr<SceneRenderer>   _sceneRenderer;
+    std::unique_ptr<SystemScheduler> _systemScheduler;
+    Vector<RenderPacket>             _renderPackets;  // One per frame slot.
 };
 
 inline SandboxApplication::SandboxApplication(const ApplicationDescriptor& descriptor)
     : Application(descriptor)
     , _device(nullptr)
     , _renderContext(nullptr)
+    , _shaderRegistry(nullptr)
+    , _quadVertexBuffer(nullptr)
+    , _quadShaderProgram(nullptr)
+    , _quadPipelineState(nullptr)
     , _scene(nullptr)
     , _sceneRenderer(nullptr)
+    , _systemScheduler(nullptr)
 {}
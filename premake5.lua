@@ -1,6 +1,8 @@
 include_dirs = {}
 include_dirs["Engine.Core"] = "%{wks.location}/Qurb/Engine/Core/Public"
 include_dirs["Engine.Runtime"] = "%{wks.location}/Qurb/Engine/Runtime/Public"
+include_dirs["Engine.NullRHI"] = "%{wks.location}/Qurb/Engine/NullRHI/Public"
+include_dirs["Engine.SoftwareRHI"] = "%{wks.location}/Qurb/Engine/SoftwareRHI/Public"
 
 workspace "Qurb"
     configurations { "Debug", "Release" }
@@ -18,5 +20,6 @@ workspace "Qurb"
     group ""
 
     group "Samples"
+        include "Samples/QurbBenchmarks/QurbBenchmarks.Build.lua"
         include "Samples/QurbSandbox/QurbSandbox.Build.lua"
     group ""